@@ -84,6 +84,9 @@ focus/RangeComp.h
 geocode/baseband.h
 geocode/geocodeSlc.h
 geometry/DEMInterpolator.h
+geometry/detail/HeightStatsPyramid.h
+geometry/detail/HeightStatsPyramid.icc
+geometry/detail/QuantizedHeights.h
 geometry/loadDem.h
 geometry/forward.h
 geometry/Shapes.h
@@ -92,20 +95,26 @@ geometry/Geo2rdr.h
 geometry/Geo2rdr.icc
 geocode/GeocodeCov.h
 geocode/GeocodeCov.icc
+geocode/GeocodePlan.h
 geocode/GeocodePolygon.h
+geocode/detail/AsyncBlockWriter.h
 geometry/geometry.h
 geometry/RTC.h
+geometry/RTCAreaCache.h
 geometry/Topo.h
 geometry/Topo.icc
 geometry/TopoLayers.h
 geometry/metadataCubes.h
 geogrid/relocateRaster.h
 image/forward.h
+image/OffsetModel.h
 image/ResampSlc.h
 image/ResampSlc.icc
 image/Tile.h
 image/Tile.icc
 io/Constants.h
+io/DataStream.h
+io/DataStream.icc
 io/forward.h
 io/gdal/Buffer.h
 io/gdal/Buffer.icc
@@ -125,7 +134,14 @@ io/IH5.h
 io/IH5.icc
 io/Raster.h
 io/Raster.icc
+io/RasterBlockCache.h
+io/RasterBlockCache.icc
+io/RasterView.h
 io/Serialization.h
+matchtemplate/ampcor/correlators/kernels.h
+matchtemplate/ampcor/correlators/Parallel.h
+matchtemplate/pycpuampcor/cpuAmpcorController.h
+matchtemplate/pycpuampcor/cpuAmpcorParameter.h
 math/Bessel.h
 math/complexOperations.h
 math/Stats.h
@@ -166,6 +182,8 @@ signal/Signal.icc
 signal/filterKernel.h
 signal/decimate.h
 signal/convolve.h
+unwrap/ConnectedComponents.h
+unwrap/ConnectedComponents.icc
 unwrap/icu/ICU.h
 unwrap/icu/ICU.icc
 unwrap/icu/LabelMap.h
@@ -183,6 +201,7 @@ unwrap/ortools/permutation.h
 unwrap/ortools/zvector.h
 unwrap/phass/ASSP.h
 unwrap/phass/BMFS.h
+unwrap/phass/BucketQueue.h
 unwrap/phass/CannyEdgeDetector.h
 unwrap/phass/ChangeDetector.h
 unwrap/phass/constants.h
@@ -44,17 +44,23 @@ focus/RangeComp.cpp
 geocode/baseband.cpp
 geocode/geocodeSlc.cpp
 geometry/DEMInterpolator.cpp
+geometry/detail/HeightStatsPyramid.cpp
+geometry/detail/QuantizedHeights.cpp
 geometry/loadDem.cpp
 geometry/Geo2rdr.cpp
 geocode/GeocodeCov.cpp
+geocode/GeocodePlan.cpp
 geocode/GeocodePolygon.cpp
+geocode/detail/AsyncBlockWriter.cpp
 geometry/geometry.cpp
 geometry/RTC.cpp
+geometry/RTCAreaCache.cpp
 geometry/Topo.cpp
 geometry/TopoLayers.cpp
 geometry/metadataCubes.cpp
 geogrid/relocateRaster.cpp
 image/ResampSlc.cpp
+io/DataStream.cpp
 io/gdal/Dataset.cpp
 io/gdal/detail/MemoryMap.cpp
 io/gdal/GeoTransform.cpp
@@ -62,6 +68,24 @@ io/gdal/SpatialReference.cpp
 io/IH5.cpp
 io/IH5Dataset.cpp
 io/Raster.cpp
+matchtemplate/ampcor/correlators/c2r.cpp
+matchtemplate/ampcor/correlators/correlate.cpp
+matchtemplate/ampcor/correlators/correlateFFT.cpp
+matchtemplate/ampcor/correlators/covariance.cpp
+matchtemplate/ampcor/correlators/deramp.cpp
+matchtemplate/ampcor/correlators/detect.cpp
+matchtemplate/ampcor/correlators/maxcor.cpp
+matchtemplate/ampcor/correlators/migrate.cpp
+matchtemplate/ampcor/correlators/nudge.cpp
+matchtemplate/ampcor/correlators/offsets.cpp
+matchtemplate/ampcor/correlators/Parallel.cpp
+matchtemplate/ampcor/correlators/r2c.cpp
+matchtemplate/ampcor/correlators/refStats.cpp
+matchtemplate/ampcor/correlators/sat.cpp
+matchtemplate/ampcor/correlators/snr.cpp
+matchtemplate/ampcor/correlators/tgtStats.cpp
+matchtemplate/pycpuampcor/cpuAmpcorController.cpp
+matchtemplate/pycpuampcor/cpuAmpcorParameter.cpp
 math/Bessel.cpp
 math/Stats.cpp
 math/polyfunc.cpp
@@ -86,6 +110,7 @@ signal/Signal.cpp
 signal/filterKernel.cpp
 signal/decimate.cpp
 signal/convolve.cpp
+unwrap/ConnectedComponents.cpp
 unwrap/icu/Grass.cpp
 unwrap/icu/Neutron.cpp
 unwrap/icu/PhaseGrad.cpp
@@ -174,6 +174,10 @@ public:
     // Inherit overloads for other datatypes
     using super_t::interpolate;
 
+    /** Normalized sinc kernel, one row of sincLen taps per fractional
+     *  offset (sincSub rows). */
+    const Matrix<double>& kernel() const { return _kernel; }
+
 private:
     // Compute sinc coefficients
     void _sinc_coef(double beta, double relfiltlen, int decfactor,
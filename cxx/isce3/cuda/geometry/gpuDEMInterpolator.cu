@@ -32,9 +32,15 @@ gpuDEMInterpolator(const isce3::geometry::DEMInterpolator & demInterp) :
         size_t bytes = length() * width() * sizeof(float);
         checkCudaErrors(cudaMalloc(&_dem, bytes));
 
-        // copy DEM data
-        checkCudaErrors(
-                cudaMemcpy(_dem, demInterp.data(), bytes, cudaMemcpyHostToDevice));
+        // copy DEM data, decoding quantized heights on the host first
+        if (demInterp.heightStorage() == isce3::geometry::HeightStorage::Float32) {
+            checkCudaErrors(cudaMemcpy(_dem, demInterp.data(), bytes,
+                                       cudaMemcpyHostToDevice));
+        } else {
+            const auto heights = demInterp.heights();
+            checkCudaErrors(cudaMemcpy(_dem, heights.data(), bytes,
+                                       cudaMemcpyHostToDevice));
+        }
     }
 }
 
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <chrono>
 #include <cmath>
+#include <mutex>
 
 // isce3::core
 #include <isce3/core/Constants.h>
@@ -89,14 +90,17 @@ resamp(isce3::io::Raster & inputSlc, isce3::io::Raster & outputSlc,
             tile.rowEnd(tile.rowStart() + _linesPerTile);
         }
 
-        // Initialize offsets tiles
+        // Initialize offsets tiles; tiles are processed one at a time, so
+        // the I/O lock is not shared with any other thread
         isce3::image::Tile<float> azOffTile, rgOffTile;
+        std::mutex ioMutex;
         _initializeOffsetTiles(tile, azOffsetRaster, rgOffsetRaster,
-                               azOffTile, rgOffTile, outWidth);
+                               azOffTile, rgOffTile, outWidth, ioMutex);
 
         // Get corresponding image indices
         std::cout << "Reading in image data for tile " << tileCount << std::endl;
         _initializeTile(tile, inputSlc, azOffTile, outLength, rowBuffer, chipSize/2);
+        _removeCarrier(&tile);
 
         // Perform interpolation
         std::cout << "Interpolating tile " << tileCount << std::endl;
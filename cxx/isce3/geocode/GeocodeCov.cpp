@@ -20,6 +20,7 @@
 #include <isce3/signal/signalUtils.h>
 
 #include "GeocodeHelpers.h"
+#include "detail/AsyncBlockWriter.h"
 
 using isce3::core::OrbitInterpBorderMode;
 using isce3::core::Vec3;
@@ -414,6 +415,11 @@ void Geocode<T>::geocodeInterp(
     info << "nBlocks: " << nBlocks << pyre::journal::newline;
 
     info << "starting geocoding" << pyre::journal::endl;
+
+    // output blocks are written by a dedicated I/O thread so that GDAL
+    // writes of a block overlap geo2rdr and interpolation of the next one
+    detail::AsyncBlockWriter writer;
+
     // loop over the blocks of the geocoded Grid
     for (int block = 0; block < nBlocks; ++block) {
         info << "block: " << block << pyre::journal::endl;
@@ -545,21 +551,17 @@ void Geocode<T>::geocodeInterp(
         } // end loops over lines and pixel of output grid
 
         // (optional arg) flush rdr position values
-        if (out_geo_rdr != nullptr)
-#pragma omp critical
-        {
-            out_geo_rdr->setBlock(out_geo_rdr_a.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 1);
-            out_geo_rdr->setBlock(out_geo_rdr_r.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 2);
+        if (out_geo_rdr != nullptr) {
+            writer.setBlock(*out_geo_rdr, std::move(out_geo_rdr_a), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 1);
+            writer.setBlock(*out_geo_rdr, std::move(out_geo_rdr_r), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 2);
         }
 
         // (optional arg) flush interpolated DEM values
-        if (out_geo_dem != nullptr)
-#pragma omp critical
-        {
-            out_geo_dem->setBlock(out_geo_dem_array.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, 1);
+        if (out_geo_dem != nullptr) {
+            writer.setBlock(*out_geo_dem, std::move(out_geo_dem_array), 0,
+                    lineStart, geogrid.width(), geoBlockLength, 1);
         }
 
         // Add extra margin for interpolation
@@ -582,8 +584,6 @@ void Geocode<T>::geocodeInterp(
 
         // define the matrix based on the rasterbands data type
         isce3::core::Matrix<T_out> rdrDataBlock(rdrBlockLength, rdrBlockWidth);
-        isce3::core::Matrix<T_out> geoDataBlock(
-                geoBlockLength, geogrid.width());
 
         // set NaN values according to T_out, i.e. real (NaN) or complex (NaN,
         // NaN)
@@ -591,12 +591,16 @@ void Geocode<T>::geocodeInterp(
         T_out nan_t_out = 0;
         nan_t_out *= std::numeric_limits<T_out_real>::quiet_NaN();
 
-        // fill both matrices with NaN
         rdrDataBlock.fill(nan_t_out);
-        geoDataBlock.fill(nan_t_out);
 
         // for each band in the input:
         for (int band = 0; band < nbands; ++band) {
+            // each band has its own output block since it is handed over to
+            // the writer I/O thread
+            isce3::core::Matrix<T_out> geoDataBlock(
+                    geoBlockLength, geogrid.width());
+            geoDataBlock.fill(nan_t_out);
+
             info << "band: " << band << pyre::journal::endl;
             // get a block of data
             info << "get data block " << pyre::journal::endl;
@@ -678,17 +682,19 @@ void Geocode<T>::geocodeInterp(
 
             // (optional arg) if band == 0, flush RTC values
             if (out_geo_rtc_band != nullptr) {
-                out_geo_rtc->setBlock(out_geo_rtc_array.data(), 0, lineStart,
-                        geogrid.width(), geoBlockLength, 1);
+                writer.setBlock(*out_geo_rtc, std::move(out_geo_rtc_array), 0,
+                        lineStart, geogrid.width(), geoBlockLength, 1);
             }
 
             // set output block of data
             info << "set output " << pyre::journal::endl;
-            outputRaster.setBlock(geoDataBlock.data(), 0, lineStart,
-                    geogrid.width(), geoBlockLength, band + 1);
+            writer.setBlock(outputRaster, std::move(geoDataBlock), 0,
+                    lineStart, geogrid.width(), geoBlockLength, band + 1);
         }
     } // end loop over block of output grid
 
+    writer.finish();
+
     double geotransform[] = {geogrid.startX(), geogrid.spacingX(), 0,
             geogrid.startY(), 0, geogrid.spacingY()};
     if (geogrid.spacingY() > 0) {
@@ -1166,48 +1172,42 @@ inline void _saveOptionalFiles(int block_x, int block_size_x, int block_y,
         isce3::io::Raster* out_geo_nlooks,
         isce3::core::Matrix<float>& out_geo_nlooks_array,
         isce3::io::Raster* out_geo_rtc,
-        isce3::core::Matrix<float>& out_geo_rtc_array)
+        isce3::core::Matrix<float>& out_geo_rtc_array,
+        detail::AsyncBlockWriter& writer)
 {
+    // arrays are handed over to the writer I/O thread
 
-    if (out_geo_rdr != nullptr)
-#pragma omp critical
-    {
-        out_geo_rdr->setBlock(out_geo_rdr_a.data(),
+    if (out_geo_rdr != nullptr) {
+        writer.setBlock(*out_geo_rdr, std::move(out_geo_rdr_a),
                 block_x * block_size_with_upsampling_x,
                 block_y * block_size_with_upsampling_y,
                 this_block_size_with_upsampling_x + 1,
                 this_block_size_with_upsampling_y + 1, 1);
-        out_geo_rdr->setBlock(out_geo_rdr_r.data(),
+        writer.setBlock(*out_geo_rdr, std::move(out_geo_rdr_r),
                 block_x * block_size_with_upsampling_x,
                 block_y * block_size_with_upsampling_y,
                 this_block_size_with_upsampling_x + 1,
                 this_block_size_with_upsampling_y + 1, 2);
     }
 
-    if (out_geo_dem != nullptr)
-#pragma omp critical
-    {
-        out_geo_dem->setBlock(out_geo_dem_array.data(),
+    if (out_geo_dem != nullptr) {
+        writer.setBlock(*out_geo_dem, std::move(out_geo_dem_array),
                 block_x * block_size_with_upsampling_x,
                 block_y * block_size_with_upsampling_y,
                 this_block_size_with_upsampling_x + 1,
                 this_block_size_with_upsampling_y + 1, 1);
     }
 
-    if (out_geo_nlooks != nullptr)
-#pragma omp critical
-    {
-        out_geo_nlooks->setBlock(out_geo_nlooks_array.data(),
+    if (out_geo_nlooks != nullptr) {
+        writer.setBlock(*out_geo_nlooks, std::move(out_geo_nlooks_array),
                 block_x * block_size_x, block_y * block_size_y,
                 this_block_size_x, this_block_size_y, 1);
     }
 
-    if (out_geo_rtc != nullptr)
-#pragma omp critical
-    {
-        out_geo_rtc->setBlock(out_geo_rtc_array.data(), block_x * block_size_x,
-                block_y * block_size_y, this_block_size_x, this_block_size_y,
-                1);
+    if (out_geo_rtc != nullptr) {
+        writer.setBlock(*out_geo_rtc, std::move(out_geo_rtc_array),
+                block_x * block_size_x, block_y * block_size_y,
+                this_block_size_x, this_block_size_y, 1);
     }
 }
 
@@ -1719,6 +1719,11 @@ void Geocode<T>::geocodeAreaProj(
          << pyre::journal::newline;
 
     info << "starting geocoding" << pyre::journal::endl;
+
+    // output blocks are written by a dedicated I/O thread so that GDAL
+    // writes overlap the processing of the following blocks
+    detail::AsyncBlockWriter writer;
+
     if (!std::is_same<T, T_out>::value && nbands_off_diag_terms == 0) {
         _Pragma("omp parallel for schedule(dynamic)") for (int block_y = 0;
                                                            block_y < nblocks_y;
@@ -1736,7 +1741,8 @@ void Geocode<T>::geocodeAreaProj(
                         rtc_raster, input_raster, offset_y, offset_x,
                         output_raster, rtc_area, rtc_min_value, abs_cal_factor,
                         clip_min, clip_max, min_nlooks, radar_grid_nlooks,
-                        flag_upsample_radar_grid, geocode_memory_mode, info);
+                        flag_upsample_radar_grid, geocode_memory_mode, writer,
+                        info);
             }
         }
     } else {
@@ -1756,10 +1762,12 @@ void Geocode<T>::geocodeAreaProj(
                         rtc_raster, input_raster, offset_y, offset_x,
                         output_raster, rtc_area, rtc_min_value, abs_cal_factor,
                         clip_min, clip_max, min_nlooks, radar_grid_nlooks,
-                        flag_upsample_radar_grid, geocode_memory_mode, info);
+                        flag_upsample_radar_grid, geocode_memory_mode, writer,
+                        info);
             }
         }
     }
+    writer.finish();
     printf("\rgeocode progress: 100%%\n");
 
     double geotransform[] = {
@@ -1928,7 +1936,7 @@ void Geocode<T>::_runBlock(
         float rtc_min_value, double abs_cal_factor, float clip_min,
         float clip_max, float min_nlooks, float radar_grid_nlooks,
         bool flag_upsample_radar_grid, geocodeMemoryMode geocode_memory_mode,
-        pyre::journal::info_t& info)
+        detail::AsyncBlockWriter& writer, pyre::journal::info_t& info)
 {
 
     using isce3::math::complex_operations::operator*;
@@ -2038,7 +2046,7 @@ void Geocode<T>::_runBlock(
                 this_block_size_with_upsampling_x,
                 this_block_size_with_upsampling_y, out_geo_rdr, out_geo_rdr_a,
                 out_geo_rdr_r, out_geo_dem, out_geo_dem_array, out_geo_nlooks,
-                out_geo_nlooks_array, out_geo_rtc, out_geo_rtc_array);
+                out_geo_nlooks_array, out_geo_rtc, out_geo_rtc_array, writer);
 
         isce3::core::Matrix<T_out> geoDataBlock(
                 this_block_size_y, this_block_size_x);
@@ -2047,22 +2055,16 @@ void Geocode<T>::_runBlock(
         geoDataBlock.fill(nan_t_out);
 
         for (int band = 0; band < nbands; ++band) {
-#pragma omp critical
-            {
-                output_raster.setBlock(geoDataBlock.data(),
-                        block_x * block_size_x, block_y * block_size_y,
-                        this_block_size_x, this_block_size_y, band + 1);
-            }
+            writer.setBlock(output_raster, geoDataBlock,
+                    block_x * block_size_x, block_y * block_size_y,
+                    this_block_size_x, this_block_size_y, band + 1);
         }
 
         if (nbands_off_diag_terms > 0) {
             for (int band = 0; band < nbands_off_diag_terms; ++band) {
-#pragma omp critical
-                {
-                    out_off_diag_terms->setBlock(geoDataBlock.data(),
-                            block_x * block_size_x, block_y * block_size_y,
-                            this_block_size_x, this_block_size_y, band + 1);
-                }
+                writer.setBlock(*out_off_diag_terms, geoDataBlock,
+                        block_x * block_size_x, block_y * block_size_y,
+                        this_block_size_x, this_block_size_y, band + 1);
             }
         }
         return;
@@ -2244,7 +2246,7 @@ void Geocode<T>::_runBlock(
                     this_block_size_with_upsampling_y, out_geo_rdr,
                     out_geo_rdr_a, out_geo_rdr_r, out_geo_dem,
                     out_geo_dem_array, out_geo_nlooks, out_geo_nlooks_array,
-                    out_geo_rtc, out_geo_rtc_array);
+                    out_geo_rtc, out_geo_rtc_array, writer);
 
             isce3::core::Matrix<T_out> geoDataBlock(
                     this_block_size_y, this_block_size_x);
@@ -2253,22 +2255,16 @@ void Geocode<T>::_runBlock(
             geoDataBlock.fill(nan_t_out);
 
             for (int band = 0; band < nbands; ++band) {
-                _Pragma("omp critical")
-                {
-                    output_raster.setBlock(geoDataBlock.data(),
-                            block_x * block_size_x, block_y * block_size_y,
-                            this_block_size_x, this_block_size_y, band + 1);
-                }
+                writer.setBlock(output_raster, geoDataBlock,
+                        block_x * block_size_x, block_y * block_size_y,
+                        this_block_size_x, this_block_size_y, band + 1);
             }
 
             if (nbands_off_diag_terms > 0) {
                 for (int band = 0; band < nbands_off_diag_terms; ++band) {
-                    _Pragma("omp critical")
-                    {
-                        out_off_diag_terms->setBlock(geoDataBlock.data(),
-                                block_x * block_size_x, block_y * block_size_y,
-                                this_block_size_x, this_block_size_y, band + 1);
-                    }
+                    writer.setBlock(*out_off_diag_terms, geoDataBlock,
+                            block_x * block_size_x, block_y * block_size_y,
+                            this_block_size_x, this_block_size_y, band + 1);
                 }
             }
 
@@ -2779,13 +2775,9 @@ void Geocode<T>::_runBlock(
                     geoDataBlock[band]->operator()(i, j) = clip_max;
             }
         }
-        _Pragma("omp critical")
-        {
-            output_raster.setBlock(geoDataBlock[band]->data(),
-                                   block_x * block_size_x,
-                                   block_y * block_size_y, this_block_size_x,
-                                   this_block_size_y, band + 1);
-        }
+        writer.setBlock(output_raster, std::move(*geoDataBlock[band]),
+                block_x * block_size_x, block_y * block_size_y,
+                this_block_size_x, this_block_size_y, band + 1);
     }
 
     geoDataBlock.clear();
@@ -2827,13 +2819,10 @@ void Geocode<T>::_runBlock(
                 }
             }
 
-            _Pragma("omp critical")
-            {
-                out_off_diag_terms->setBlock(
-                        geoDataBlockOffDiag[band]->data(),
-                        block_x * block_size_x, block_y * block_size_y,
-                        this_block_size_x, this_block_size_y, band + 1);
-            }
+            writer.setBlock(*out_off_diag_terms,
+                    std::move(*geoDataBlockOffDiag[band]),
+                    block_x * block_size_x, block_y * block_size_y,
+                    this_block_size_x, this_block_size_y, band + 1);
         }
     }
 
@@ -2844,7 +2833,7 @@ void Geocode<T>::_runBlock(
             block_size_with_upsampling_y, this_block_size_with_upsampling_x,
             this_block_size_with_upsampling_y, out_geo_rdr, out_geo_rdr_a,
             out_geo_rdr_r, out_geo_dem, out_geo_dem_array, out_geo_nlooks,
-            out_geo_nlooks_array, out_geo_rtc, out_geo_rtc_array);
+            out_geo_nlooks_array, out_geo_rtc, out_geo_rtc_array, writer);
 }
 
 template class Geocode<float>;
@@ -23,6 +23,10 @@
 
 namespace isce3 { namespace geocode {
 
+namespace detail {
+class AsyncBlockWriter;
+}
+
 /** Enumeration type to indicate the algorithm used for geocoding */
 enum geocodeOutputMode {
     INTERP = 0,
@@ -465,7 +469,8 @@ private:
             double abs_cal_factor, float clip_min, float clip_max,
             float min_nlooks, float radar_grid_nlooks,
             bool flag_upsample_radar_grid,
-            geocodeMemoryMode geocode_memory_mode, pyre::journal::info_t& info);
+            geocodeMemoryMode geocode_memory_mode,
+            detail::AsyncBlockWriter& writer, pyre::journal::info_t& info);
 
     std::string _get_nbytes_str(long nbytes);
 
@@ -0,0 +1,471 @@
+#include "GeocodePlan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <type_traits>
+
+#include <gdal_priv.h>
+#include <pyre/journal.h>
+
+#include <isce3/core/Interpolator.h>
+#include <isce3/core/Matrix.h>
+#include <isce3/core/Projections.h>
+#include <isce3/core/TypeTraits.h>
+#include <isce3/except/Error.h>
+#include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/geometry.h>
+#include <isce3/geometry/loadDem.h>
+
+using isce3::core::Vec3;
+using isce3::io::Raster;
+
+namespace isce3 { namespace geocode {
+
+namespace {
+
+/** Bilinear interpolation from the upper-left neighbor and fractional
+ * offsets. Matches isce3::core::BilinearInterpolator, including the
+ * handling of pixels falling on integer radar coordinates. */
+template<typename T>
+inline T bilinear(const isce3::core::Matrix<T>& z, const int row,
+        const int col, const float weight_y, const float weight_x)
+{
+    using T_real = typename isce3::real<T>::type;
+    const T q11 = z(row, col);
+    if (weight_y == 0 && weight_x == 0)
+        return q11;
+    if (weight_y == 0)
+        return q11 * static_cast<T_real>(1 - weight_x) +
+               z(row, col + 1) * static_cast<T_real>(weight_x);
+    if (weight_x == 0)
+        return q11 * static_cast<T_real>(1 - weight_y) +
+               z(row + 1, col) * static_cast<T_real>(weight_y);
+    const T top = q11 * static_cast<T_real>(1 - weight_x) +
+                  z(row, col + 1) * static_cast<T_real>(weight_x);
+    const T bottom = z(row + 1, col) * static_cast<T_real>(1 - weight_x) +
+                     z(row + 1, col + 1) * static_cast<T_real>(weight_x);
+    return top * static_cast<T_real>(1 - weight_y) +
+           bottom * static_cast<T_real>(weight_y);
+}
+
+/** Number of radar pixels read by an interpolation method on either side of
+ * the upper-left neighbor of a point, so that the block margin holds the
+ * whole kernel (order 6 biquintic and SINC_LEN sinc kernels, as built by
+ * isce3::core::createInterpolator with default parameters). */
+int interpHalfWidth(const isce3::core::dataInterpMethod method)
+{
+    switch (method) {
+    case isce3::core::BICUBIC_METHOD: return 2;
+    case isce3::core::BIQUINTIC_METHOD: return 4;
+    case isce3::core::SINC_METHOD: return isce3::core::SINC_LEN / 2;
+    default: return 1;
+    }
+}
+
+} // namespace
+
+GeocodePlan::GeocodePlan(const isce3::product::GeoGridParameters& geogrid,
+        const isce3::container::RadarGeometry& rdr_geom,
+        const Raster& dem_raster, const size_t lines_per_block,
+        const isce3::core::dataInterpMethod data_interp_method,
+        const isce3::core::dataInterpMethod dem_interp_method,
+        const double threshold, const int maxiter, const double dr,
+        const float invalid_value, const int interp_margin) :
+    _lines_per_block(lines_per_block),
+    _geogrid(geogrid),
+    _rdr_geom(rdr_geom),
+    _ellipsoid(isce3::core::makeProjection(dem_raster.getEPSG())->ellipsoid()),
+    _dem_raster(dem_raster),
+    _data_interp_method(data_interp_method),
+    _dem_interp_method(dem_interp_method),
+    _invalid_value(invalid_value),
+    _interp_margin(std::max(interp_margin, interpHalfWidth(data_interp_method)))
+{
+    if (_lines_per_block == 0) {
+        throw isce3::except::DomainError(
+                ISCE_SRCINFO(), "lines per block must be positive");
+    }
+    if (interp_margin < 0) {
+        throw isce3::except::DomainError(
+                ISCE_SRCINFO(), "interpolation margin must be non-negative");
+    }
+    _n_blocks = (_geogrid.length() + _lines_per_block - 1) / _lines_per_block;
+
+    _geo2rdr_params.threshold = threshold;
+    _geo2rdr_params.maxiter = maxiter;
+    _geo2rdr_params.delta_range = dr;
+}
+
+void GeocodePlan::setBlockRdrCoordGrid(const size_t block_number)
+{
+    // make sure block index does not exceed actual number of blocks
+    if (block_number >= _n_blocks) {
+        throw isce3::except::DomainError(
+                ISCE_SRCINFO(), "block number exceeds max number of blocks");
+    }
+
+    const auto& radar_grid = _rdr_geom.radarGrid();
+    const size_t geo_width = _geogrid.width();
+
+    // Get block extents (of the geocoded grid)
+    _line_start = block_number * _lines_per_block;
+    _geo_block_length =
+            std::min(_lines_per_block, _geogrid.length() - _line_start);
+    const size_t block_size = _geo_block_length * geo_width;
+
+    // load a block of DEM for the current geocoded grid with a margin of
+    // 50 DEM pixels
+    const int dem_margin_in_pixels = 50;
+    isce3::geometry::DEMInterpolator dem_interp = isce3::geometry::loadDEM(
+            _dem_raster, _geogrid, _line_start, _geo_block_length, geo_width,
+            dem_margin_in_pixels, _dem_interp_method);
+
+    auto proj = isce3::core::makeProjection(_geogrid.epsg());
+
+    // radar grid indices of each geogrid pixel (NaN if invalid)
+    std::vector<double> radar_x(block_size);
+    std::vector<double> radar_y(block_size);
+
+    int az_first_line = radar_grid.length() - 1;
+    int az_last_line = 0;
+    int range_first_pixel = radar_grid.width() - 1;
+    int range_last_pixel = 0;
+
+#pragma omp parallel for reduction(min : az_first_line, range_first_pixel)    \
+        reduction(max : az_last_line, range_last_pixel)
+    for (size_t kk = 0; kk < block_size; ++kk) {
+
+        const size_t block_line = kk / geo_width;
+        const size_t pixel = kk % geo_width;
+        const size_t line = _line_start + block_line;
+
+        radar_x[kk] = std::numeric_limits<double>::quiet_NaN();
+        radar_y[kk] = std::numeric_limits<double>::quiet_NaN();
+
+        // x and y coordinates of the output geocoded grid
+        const Vec3 xyz {_geogrid.startX() + _geogrid.spacingX() * (0.5 + pixel),
+                _geogrid.startY() + _geogrid.spacingY() * (0.5 + line), 0.0};
+
+        Vec3 llh = proj->inverse(xyz);
+        llh[2] = dem_interp.interpolateLonLat(llh[0], llh[1]);
+
+        double aztime = radar_grid.sensingMid();
+        double srange;
+        const int converged = isce3::geometry::geo2rdr(llh, _ellipsoid,
+                _rdr_geom.orbit(), _rdr_geom.doppler(), aztime, srange,
+                radar_grid.wavelength(), radar_grid.lookSide(),
+                _geo2rdr_params.threshold, _geo2rdr_params.maxiter,
+                _geo2rdr_params.delta_range);
+        if (!converged)
+            continue;
+
+        // get the row and column index in the radar grid
+        const double rdr_y = (aztime - radar_grid.sensingStart()) /
+                             radar_grid.azimuthTimeInterval();
+        const double rdr_x = (srange - radar_grid.startingRange()) /
+                             radar_grid.rangePixelSpacing();
+
+        if (rdr_y < 0 || rdr_x < 0 || rdr_y >= radar_grid.length() ||
+                rdr_x >= radar_grid.width())
+            continue;
+
+        az_first_line = std::min(
+                az_first_line, static_cast<int>(std::floor(rdr_y)));
+        az_last_line = std::max(
+                az_last_line, static_cast<int>(std::ceil(rdr_y) - 1));
+        range_first_pixel = std::min(
+                range_first_pixel, static_cast<int>(std::floor(rdr_x)));
+        range_last_pixel = std::max(
+                range_last_pixel, static_cast<int>(std::ceil(rdr_x) - 1));
+
+        radar_x[kk] = rdr_x;
+        radar_y[kk] = rdr_y;
+    }
+
+    // Add extra margin for interpolation
+    const int interp_margin = _interp_margin;
+    az_first_line = std::max(az_first_line - interp_margin, 0);
+    range_first_pixel = std::max(range_first_pixel - interp_margin, 0);
+    az_last_line = std::min(az_last_line + interp_margin,
+            static_cast<int>(radar_grid.length() - 1));
+    range_last_pixel = std::min(range_last_pixel + interp_margin,
+            static_cast<int>(radar_grid.width() - 1));
+
+    _rdr_row.assign(block_size, -1);
+    _rdr_col.assign(block_size, -1);
+    _weight_y.assign(block_size, 0.f);
+    _weight_x.assign(block_size, 0.f);
+    _n_valid = 0;
+
+    // check if block entirely out of the radar grid
+    if (az_first_line > az_last_line || range_first_pixel > range_last_pixel) {
+        _az_first_line = 0;
+        _range_first_pixel = 0;
+        _rdr_block_length = 0;
+        _rdr_block_width = 0;
+
+        pyre::journal::debug_t debug(
+                "isce.geocode.GeocodePlan.setBlockRdrCoordGrid");
+        debug << block_number << " is out of bounds. calls to "
+              << "geocodeRasterBlock will not geocode." << pyre::journal::endl;
+        return;
+    }
+
+    _az_first_line = az_first_line;
+    _range_first_pixel = range_first_pixel;
+    _rdr_block_length = az_last_line - az_first_line + 1;
+    _rdr_block_width = range_last_pixel - range_first_pixel + 1;
+
+    // store upper-left radar neighbors and interpolation weights, moving the
+    // origin to the top-left of the radar block
+    const int rdr_block_length = _rdr_block_length;
+    const int rdr_block_width = _rdr_block_width;
+    size_t n_valid = 0;
+
+#pragma omp parallel for reduction(+ : n_valid)
+    for (size_t kk = 0; kk < block_size; ++kk) {
+        const double rdr_y = radar_y[kk] - az_first_line;
+        const double rdr_x = radar_x[kk] - range_first_pixel;
+
+        if (std::isnan(rdr_y) || std::isnan(rdr_x) || rdr_x < interp_margin ||
+                rdr_y < interp_margin ||
+                rdr_x >= (rdr_block_width - interp_margin) ||
+                rdr_y >= (rdr_block_length - interp_margin))
+            continue;
+
+        const int row = static_cast<int>(std::floor(rdr_y));
+        const int col = static_cast<int>(std::floor(rdr_x));
+        _rdr_row[kk] = row;
+        _rdr_col[kk] = col;
+        _weight_y[kk] = static_cast<float>(rdr_y - row);
+        _weight_x[kk] = static_cast<float>(rdr_x - col);
+        ++n_valid;
+    }
+    _n_valid = n_valid;
+}
+
+void GeocodePlan::_rasterDtypeInterpCheck(const int dtype,
+        isce3::core::dataInterpMethod interp_method) const
+{
+    if ((dtype == GDT_Byte || dtype == GDT_UInt32) &&
+            interp_method != isce3::core::NEAREST_METHOD) {
+        std::string err_str {
+                "int type of raster can only use nearest neighbor interp"};
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), err_str);
+    }
+
+    // the plan only keeps pixels whose kernel fits in the radar block
+    if (interpHalfWidth(interp_method) > _interp_margin) {
+        std::string err_str {"interpolation margin of the plan ("
+                + std::to_string(_interp_margin)
+                + ") is smaller than the half-width of the interpolation "
+                  "kernel (" + std::to_string(interpHalfWidth(interp_method))
+                + ")"};
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), err_str);
+    }
+}
+
+template<typename T>
+T GeocodePlan::_invalidValue(const float invalid_value)
+{
+    if constexpr (std::is_same_v<T, unsigned char> ||
+                  std::is_same_v<T, unsigned int>) {
+        if (std::isnan(invalid_value))
+            return std::numeric_limits<T>::max();
+        return static_cast<T>(invalid_value);
+    } else if constexpr (isce3::is_complex<T>()) {
+        using T_real = typename isce3::real<T>::type;
+        return T(static_cast<T_real>(invalid_value),
+                static_cast<T_real>(invalid_value));
+    } else {
+        return static_cast<T>(invalid_value);
+    }
+}
+
+template<typename T>
+void GeocodePlan::_geocodeRasterBlock(Raster& output_raster,
+        Raster& input_raster, isce3::core::dataInterpMethod interp_method,
+        const float invalid_value_f)
+{
+    const size_t geo_width = _geogrid.width();
+    const size_t block_size = _geo_block_length * geo_width;
+    const T invalid_value = _invalidValue<T>(invalid_value_f);
+
+    // interpolator for methods not evaluated from the stored weights
+    std::unique_ptr<isce3::core::Interpolator<T>> interp;
+    if constexpr (isce3::is_floating_or_complex_v<T>) {
+        if (interp_method != isce3::core::NEAREST_METHOD &&
+                interp_method != isce3::core::BILINEAR_METHOD)
+            interp.reset(isce3::core::createInterpolator<T>(interp_method));
+    }
+
+    isce3::core::Matrix<T> geo_data_block(_geo_block_length, geo_width);
+    isce3::core::Matrix<T> rdr_data_block;
+    if (_n_valid > 0)
+        rdr_data_block.resize(_rdr_block_length, _rdr_block_width);
+
+    const int nbands = input_raster.numBands();
+    for (int band = 0; band < nbands; ++band) {
+
+        // entire block out of bounds: set block to invalid value
+        if (_n_valid == 0) {
+            geo_data_block.fill(invalid_value);
+            output_raster.setBlock(geo_data_block.data(), 0, _line_start,
+                    geo_width, _geo_block_length, band + 1);
+            continue;
+        }
+
+        input_raster.getBlock(rdr_data_block.data(), _range_first_pixel,
+                _az_first_line, _rdr_block_width, _rdr_block_length,
+                band + 1);
+
+#pragma omp parallel for
+        for (size_t kk = 0; kk < block_size; ++kk) {
+            const size_t i = kk / geo_width;
+            const size_t j = kk % geo_width;
+            const int row = _rdr_row[kk];
+            const int col = _rdr_col[kk];
+            if (row < 0) {
+                geo_data_block(i, j) = invalid_value;
+                continue;
+            }
+            const float weight_y = _weight_y[kk];
+            const float weight_x = _weight_x[kk];
+            if (interp_method == isce3::core::NEAREST_METHOD) {
+                geo_data_block(i, j) = rdr_data_block(row + (weight_y >= 0.5f),
+                        col + (weight_x >= 0.5f));
+                continue;
+            }
+            if constexpr (isce3::is_floating_or_complex_v<T>) {
+                if (interp_method == isce3::core::BILINEAR_METHOD)
+                    geo_data_block(i, j) = bilinear(
+                            rdr_data_block, row, col, weight_y, weight_x);
+                else
+                    geo_data_block(i, j) = interp->interpolate(
+                            col + static_cast<double>(weight_x),
+                            row + static_cast<double>(weight_y),
+                            rdr_data_block);
+            }
+        }
+
+        output_raster.setBlock(geo_data_block.data(), 0, _line_start,
+                geo_width, _geo_block_length, band + 1);
+    }
+}
+
+void GeocodePlan::geocodeRasterBlock(Raster& output_raster,
+        Raster& input_raster, isce3::core::dataInterpMethod interp_method,
+        const float invalid_value)
+{
+    const int dtype = input_raster.dtype();
+    _rasterDtypeInterpCheck(dtype, interp_method);
+
+    switch (dtype) {
+    case GDT_Float32:
+        _geocodeRasterBlock<float>(output_raster, input_raster, interp_method,
+                invalid_value);
+        break;
+    case GDT_CFloat32:
+        _geocodeRasterBlock<std::complex<float>>(
+                output_raster, input_raster, interp_method,
+                invalid_value);
+        break;
+    case GDT_Float64:
+        _geocodeRasterBlock<double>(
+                output_raster, input_raster, interp_method,
+                invalid_value);
+        break;
+    case GDT_CFloat64:
+        _geocodeRasterBlock<std::complex<double>>(
+                output_raster, input_raster, interp_method,
+                invalid_value);
+        break;
+    case GDT_Byte:
+        _geocodeRasterBlock<unsigned char>(
+                output_raster, input_raster, interp_method,
+                invalid_value);
+        break;
+    case GDT_UInt32:
+        _geocodeRasterBlock<unsigned int>(
+                output_raster, input_raster, interp_method,
+                invalid_value);
+        break;
+    default:
+        throw isce3::except::RuntimeError(
+                ISCE_SRCINFO(), "unsupported datatype");
+    }
+}
+
+void GeocodePlan::geocodeRasters(
+        std::vector<std::reference_wrapper<Raster>> output_rasters,
+        std::vector<std::reference_wrapper<Raster>> input_rasters,
+        const std::vector<isce3::core::dataInterpMethod>& interp_methods,
+        const std::vector<float>& invalid_values)
+{
+    pyre::journal::info_t info("isce.geocode.GeocodePlan.geocodeRasters");
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // check if vectors are of same length
+    if (output_rasters.size() != input_rasters.size()) {
+        throw isce3::except::LengthError(
+                ISCE_SRCINFO(), "number of input and output rasters not equal");
+    }
+    const auto n_raster_pairs = output_rasters.size();
+
+    std::vector<isce3::core::dataInterpMethod> methods = interp_methods;
+    if (methods.empty())
+        methods.assign(n_raster_pairs, _data_interp_method);
+    if (methods.size() != n_raster_pairs) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "number of interpolation methods and rasters not equal");
+    }
+
+    std::vector<float> invalids = invalid_values;
+    if (invalids.empty())
+        invalids.assign(n_raster_pairs, _invalid_value);
+    if (invalids.size() != n_raster_pairs) {
+        throw isce3::except::LengthError(ISCE_SRCINFO(),
+                "number of invalid values and rasters not equal");
+    }
+
+    // check if raster types consistent with data interp method
+    for (size_t i_raster = 0; i_raster < n_raster_pairs; ++i_raster)
+        _rasterDtypeInterpCheck(
+                input_rasters[i_raster].get().dtype(), methods[i_raster]);
+
+    info << "number of rasters: " << n_raster_pairs << pyre::journal::newline;
+    info << "number of blocks: " << _n_blocks << pyre::journal::endl;
+
+    // solve the geometry of each block once and apply it to all rasters
+    for (size_t i_block = 0; i_block < _n_blocks; ++i_block) {
+        setBlockRdrCoordGrid(i_block);
+        for (size_t i_raster = 0; i_raster < n_raster_pairs; ++i_raster)
+            geocodeRasterBlock(output_rasters[i_raster],
+                    input_rasters[i_raster], methods[i_raster],
+                    invalids[i_raster]);
+    }
+
+    double geotransform[] = {_geogrid.startX(), _geogrid.spacingX(), 0,
+            _geogrid.startY(), 0, _geogrid.spacingY()};
+    if (_geogrid.spacingY() > 0) {
+        geotransform[3] =
+                _geogrid.startY() + _geogrid.length() * _geogrid.spacingY();
+        geotransform[5] = -_geogrid.spacingY();
+    }
+    for (auto& output_raster : output_rasters) {
+        output_raster.get().setGeoTransform(geotransform);
+        output_raster.get().setEPSG(_geogrid.epsg());
+    }
+
+    auto elapsed_time_milliseconds =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - start_time);
+    float elapsed_time = ((float) elapsed_time_milliseconds.count()) / 1e3;
+    info << "elapsed time (GEO-PLAN) [s]: " << elapsed_time
+         << pyre::journal::endl;
+}
+
+}} // namespace isce3::geocode
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include <isce3/core/forward.h>
+
+#include <isce3/container/RadarGeometry.h>
+#include <isce3/core/Constants.h>
+#include <isce3/core/Ellipsoid.h>
+#include <isce3/geometry/detail/Geo2Rdr.h>
+#include <isce3/io/Raster.h>
+#include <isce3/product/GeoGridParameters.h>
+
+namespace isce3 { namespace geocode {
+
+/** Geocoding plan shared by rasters with a common radar grid and geogrid.
+ *
+ * Geocoding by interpolation is dominated by the geo2rdr solution of each
+ * geogrid pixel, which only depends on the geometry and not on the rasters
+ * being geocoded. A plan breaks the geogrid into blocks of lines and, for
+ * each block, solves geo2rdr once and stores the radar coordinates of every
+ * geogrid pixel as the integer index of its upper-left radar neighbor
+ * together with the fractional interpolation weights. The stored block
+ * plan is then applied to any number of input rasters, of possibly
+ * different data types and interpolation methods, e.g. all the layers and
+ * polarizations of a GUNW frequency, in a single streaming pass over the
+ * geogrid.
+ *
+ * Nearest neighbor and bilinear interpolation are evaluated directly from
+ * the stored weights; other interpolation methods use the stored radar
+ * coordinates with the corresponding isce3::core::Interpolator.
+ *
+ * Python-ish pseudo code for geocoding several rasters:
+ * import isce3
+ * plan = isce3.geocode.GeocodePlan(geogrid, radar_geometry, dem_raster)
+ * plan.geocode_rasters(output_rasters, input_rasters, interp_methods)
+ */
+class GeocodePlan {
+public:
+    /** Class constructor. Sets values to be shared by all blocks and
+     *  computes the number of blocks needed to cover the geogrid.
+     *
+     * \param[in] geogrid               Geogrid defining output product
+     * \param[in] rdr_geom              Radar geometry describing input rasters
+     * \param[in] dem_raster            DEM used to calculate radar grid indices
+     * \param[in] lines_per_block       Number of lines to be processed per block
+     * \param[in] data_interp_method    Default data interpolation method
+     * \param[in] dem_interp_method     DEM interpolation method
+     * \param[in] threshold             Convergence threshold for geo2rdr
+     * \param[in] maxiter               Maximum iterations for geo2rdr
+     * \param[in] dr                    Step size for numerical gradient for
+     *                                  geo2rdr
+     * \param[in] invalid_value         Default value assigned to invalid
+     *                                  geogrid pixels. NaN is mapped to the
+     *                                  maximum value of unsigned integer
+     *                                  rasters.
+     * \param[in] interp_margin         Margin (in radar pixels) kept around
+     *                                  the radar block and required between
+     *                                  a valid pixel and the border of the
+     *                                  radar block. Raised to the half-width
+     *                                  of the kernel of data_interp_method;
+     *                                  rasters geocoded with wider kernels
+     *                                  are rejected.
+     */
+    GeocodePlan(const isce3::product::GeoGridParameters& geogrid,
+            const isce3::container::RadarGeometry& rdr_geom,
+            const isce3::io::Raster& dem_raster,
+            const size_t lines_per_block = 1000,
+            const isce3::core::dataInterpMethod data_interp_method =
+                    isce3::core::BILINEAR_METHOD,
+            const isce3::core::dataInterpMethod dem_interp_method =
+                    isce3::core::BIQUINTIC_METHOD,
+            const double threshold = 1e-8, const int maxiter = 50,
+            const double dr = 10,
+            const float invalid_value =
+                    std::numeric_limits<float>::quiet_NaN(),
+            const int interp_margin = 5);
+
+    /** Solve geo2rdr for all geogrid pixels of a block and store their
+     *  radar grid indices and interpolation weights. The block plan can
+     *  then be repeatedly applied by geocodeRasterBlock.
+     *
+     * \param[in] block_number      Index of block
+     */
+    void setBlockRdrCoordGrid(const size_t block_number);
+
+    /** Geocode all bands of a raster over the block last set with
+     *  setBlockRdrCoordGrid.
+     *
+     * \param[in] output_raster     Geocoded raster
+     * \param[in] input_raster      Raster to be geocoded
+     * \param[in] interp_method     Data interpolation method
+     * \param[in] invalid_value     Value assigned to invalid geogrid pixels.
+     *                              NaN is mapped to the maximum value of
+     *                              unsigned integer rasters.
+     */
+    void geocodeRasterBlock(isce3::io::Raster& output_raster,
+            isce3::io::Raster& input_raster,
+            isce3::core::dataInterpMethod interp_method,
+            float invalid_value);
+
+    /** Geocode all bands of a raster over the block last set with
+     *  setBlockRdrCoordGrid using the default invalid value.
+     *
+     * \param[in] output_raster     Geocoded raster
+     * \param[in] input_raster      Raster to be geocoded
+     * \param[in] interp_method     Data interpolation method
+     */
+    void geocodeRasterBlock(isce3::io::Raster& output_raster,
+            isce3::io::Raster& input_raster,
+            isce3::core::dataInterpMethod interp_method)
+    {
+        geocodeRasterBlock(
+                output_raster, input_raster, interp_method, _invalid_value);
+    }
+
+    /** Geocode a raster over the block last set with setBlockRdrCoordGrid
+     *  using the default data interpolation method.
+     *
+     * \param[in] output_raster     Geocoded raster
+     * \param[in] input_raster      Raster to be geocoded
+     */
+    void geocodeRasterBlock(
+            isce3::io::Raster& output_raster, isce3::io::Raster& input_raster)
+    {
+        geocodeRasterBlock(output_raster, input_raster, _data_interp_method);
+    }
+
+    /** Geocode rasters with a shared geogrid in a single pass over the
+     *  blocks of the geogrid. The geometry of each block is solved once
+     *  and applied to all rasters.
+     *
+     * \param[in] output_rasters    Geocoded rasters
+     * \param[in] input_rasters     Rasters to be geocoded
+     * \param[in] interp_methods    Data interpolation method of each raster.
+     *                              If empty, the default data interpolation
+     *                              method is used for all rasters.
+     * \param[in] invalid_values    Invalid value of each raster. If empty,
+     *                              the default invalid value is used for all
+     *                              rasters.
+     */
+    void geocodeRasters(
+            std::vector<std::reference_wrapper<isce3::io::Raster>> output_rasters,
+            std::vector<std::reference_wrapper<isce3::io::Raster>> input_rasters,
+            const std::vector<isce3::core::dataInterpMethod>& interp_methods =
+                    {},
+            const std::vector<float>& invalid_values = {});
+
+    size_t numBlocks() const { return _n_blocks; }
+    size_t linesPerBlock() const { return _lines_per_block; }
+    int interpMargin() const { return _interp_margin; }
+
+    /** Number of geogrid lines of the block last set */
+    size_t blockLength() const { return _geo_block_length; }
+
+    /** Number of valid geogrid pixels of the block last set */
+    size_t numValidPixels() const { return _n_valid; }
+
+private:
+    template<typename T>
+    void _geocodeRasterBlock(isce3::io::Raster& output_raster,
+            isce3::io::Raster& input_raster,
+            isce3::core::dataInterpMethod interp_method,
+            float invalid_value);
+
+    template<typename T>
+    static T _invalidValue(float invalid_value);
+
+    void _rasterDtypeInterpCheck(
+            const int dtype, isce3::core::dataInterpMethod interp_method) const;
+
+    // number of lines to be processed in a block
+    size_t _lines_per_block;
+
+    // total number of blocks necessary to geocode the geogrid
+    size_t _n_blocks;
+
+    // geogrid defining output product
+    isce3::product::GeoGridParameters _geogrid;
+
+    // radar geometry describing input rasters
+    isce3::container::RadarGeometry _rdr_geom;
+
+    // ellipsoid based on EPSG of the DEM, which the DEM heights refer to
+    isce3::core::Ellipsoid _ellipsoid;
+
+    // geo2rdr params used in radar index calculation
+    isce3::geometry::detail::Geo2RdrParams _geo2rdr_params;
+
+    // DEM used to calculate radar grid indices
+    isce3::io::Raster _dem_raster;
+
+    isce3::core::dataInterpMethod _data_interp_method;
+    isce3::core::dataInterpMethod _dem_interp_method;
+
+    // default value applied to invalid geogrid pixels
+    float _invalid_value;
+
+    // margin (in radar pixels) kept around the radar block and required
+    // between a valid pixel and the border of the radar block
+    int _interp_margin;
+
+    // Plan of the block last passed to setBlockRdrCoordGrid. For each
+    // geogrid pixel: row and column (relative to the radar block) of the
+    // upper-left radar neighbor, or -1 if invalid, and the fractional
+    // offsets from that neighbor.
+    std::vector<int> _rdr_row;
+    std::vector<int> _rdr_col;
+    std::vector<float> _weight_y;
+    std::vector<float> _weight_x;
+
+    // geogrid and radar grid extents of the block last set
+    size_t _line_start = 0;
+    size_t _geo_block_length = 0;
+    size_t _az_first_line = 0;
+    size_t _range_first_pixel = 0;
+    size_t _rdr_block_length = 0;
+    size_t _rdr_block_width = 0;
+    size_t _n_valid = 0;
+};
+
+}} // namespace isce3::geocode
@@ -0,0 +1,73 @@
+#include "AsyncBlockWriter.h"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace isce3 { namespace geocode { namespace detail {
+
+namespace {
+std::size_t defaultMaxPending(std::size_t max_pending)
+{
+    if (max_pending > 0)
+        return max_pending;
+#ifdef _OPENMP
+    return 2 * static_cast<std::size_t>(omp_get_max_threads());
+#else
+    return 2;
+#endif
+}
+} // namespace
+
+AsyncBlockWriter::AsyncBlockWriter(std::size_t max_pending)
+    : _stream(defaultMaxPending(max_pending))
+{}
+
+// Pending writes are completed by the stream
+AsyncBlockWriter::~AsyncBlockWriter() = default;
+
+// Raster::setBlock only reports GDAL failures, so make sure that the write
+// can succeed before handing it over
+void AsyncBlockWriter::_checkWindow(isce3::io::Raster& raster,
+        std::size_t xidx, std::size_t yidx, std::size_t iowidth,
+        std::size_t iolength, std::size_t band)
+{
+    if (raster.access() != GA_Update)
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                "Raster is not open for writing.");
+    if (band < 1 || band > raster.numBands())
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                "Requested band is not in the raster.");
+    if (xidx + iowidth > raster.width() || yidx + iolength > raster.length())
+        throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                "Requested block is not within the raster.");
+}
+
+void AsyncBlockWriter::_submit(std::function<void()> job)
+{
+    _stream.enqueue([this, job = std::move(job)]() {
+        // after an error, drain the queue without writing
+        if (_failed)
+            return;
+        try {
+            job();
+        } catch (...) {
+            _failed = true;
+            throw;
+        }
+    });
+}
+
+void AsyncBlockWriter::finish()
+{
+    try {
+        _stream.synchronize();
+    } catch (...) {
+        _failed = false;
+        throw;
+    }
+}
+
+}}} // namespace isce3::geocode::detail
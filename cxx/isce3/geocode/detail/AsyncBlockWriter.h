@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <isce3/core/Matrix.h>
+#include <isce3/except/Error.h>
+#include <isce3/io/DataStream.h>
+#include <isce3/io/Raster.h>
+
+namespace isce3 { namespace geocode { namespace detail {
+
+/** Raster block writer backed by a dedicated I/O thread.
+ *
+ * Compute threads hand over blocks of output data and return immediately,
+ * so that the (possibly slow) GDAL writes of block k overlap the
+ * computation of the following blocks instead of serializing the compute
+ * threads behind a critical section. Blocks are written in submission
+ * order. The number of pending blocks is bounded: submitting a block
+ * while the queue is full waits for the I/O thread, which bounds memory
+ * usage to about two blocks per compute thread (double buffering).
+ *
+ * All writes to a given raster must go through the same writer while it
+ * is active, since GDAL datasets may not be accessed concurrently.
+ * Errors raised by the I/O thread are rethrown by finish().
+ *
+ * The I/O thread is that of a bounded isce3::io::DataStream.
+ */
+class AsyncBlockWriter {
+public:
+    /** Constructor
+     *
+     * @param[in] max_pending  Maximum number of queued blocks. If zero,
+     * twice the maximum number of OpenMP threads is used.
+     */
+    explicit AsyncBlockWriter(std::size_t max_pending = 0);
+
+    /** Destructor. Waits for all pending writes. */
+    ~AsyncBlockWriter();
+
+    AsyncBlockWriter(const AsyncBlockWriter&) = delete;
+    AsyncBlockWriter& operator=(const AsyncBlockWriter&) = delete;
+
+    /** Queue a block for writing, taking ownership of its data
+     *
+     * @param[in] raster  Output raster
+     * @param[in] block   Block of data
+     * @param[in] xidx    Column of the first pixel of the block
+     * @param[in] yidx    Line of the first pixel of the block
+     * @param[in] iowidth Number of columns to write
+     * @param[in] iolength Number of lines to write
+     * @param[in] band    Raster band (1-based)
+     *
+     * \throws isce3::except::LengthError if the block holds fewer than
+     * iowidth*iolength elements
+     */
+    template<typename T>
+    void setBlock(isce3::io::Raster& raster, isce3::core::Matrix<T>&& block,
+            std::size_t xidx, std::size_t yidx, std::size_t iowidth,
+            std::size_t iolength, std::size_t band = 1)
+    {
+        if (iowidth * iolength > static_cast<std::size_t>(block.size()))
+            throw isce3::except::LengthError(ISCE_SRCINFO(),
+                    "Requested more elements than buffer size.");
+
+        auto data = std::make_shared<isce3::core::Matrix<T>>(std::move(block));
+        _submit([&raster, data, xidx, yidx, iowidth, iolength, band]() {
+            _checkWindow(raster, xidx, yidx, iowidth, iolength, band);
+            raster.setBlock(
+                    data->data(), xidx, yidx, iowidth, iolength, band);
+        });
+    }
+
+    /** Queue a copy of a block for writing */
+    template<typename T>
+    void setBlock(isce3::io::Raster& raster,
+            const isce3::core::Matrix<T>& block, std::size_t xidx,
+            std::size_t yidx, std::size_t iowidth, std::size_t iolength,
+            std::size_t band = 1)
+    {
+        setBlock(raster, isce3::core::Matrix<T>(block), xidx, yidx, iowidth,
+                iolength, band);
+    }
+
+    /** Wait for all pending writes and rethrow the first I/O error, if any */
+    void finish();
+
+private:
+    static void _checkWindow(isce3::io::Raster& raster, std::size_t xidx,
+            std::size_t yidx, std::size_t iowidth, std::size_t iolength,
+            std::size_t band);
+    void _submit(std::function<void()> job);
+
+    // set after an error until it is reported by finish()
+    std::atomic<bool> _failed {false};
+    isce3::io::DataStream _stream;
+};
+
+}}} // namespace isce3::geocode::detail
@@ -1,9 +1,12 @@
 #include "geocodeSlc.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 #include <isce3/core/Constants.h>
 #include <isce3/core/Ellipsoid.h>
+#include <isce3/core/Interpolator.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Poly2d.h>
@@ -20,10 +23,34 @@
 
 namespace isce3::geocode {
 
+namespace {
+
+/** Interpolation plan of a geocoded pixel, shared by all the SLC rasters
+ *  geocoded over a block */
+struct SlcInterpPixel {
+    // line and pixel, with respect to the radar data block, of the center
+    // of the interpolation chip. Negative if the pixel is not interpolated.
+    int line = -1;
+    int pixel = -1;
+
+    // rows of the sinc kernel for the azimuth and range fractional indices
+    int azKernelRow = 0;
+    int rgKernelRow = 0;
+
+    // Doppler demodulation phasor of the first chip line and its increment
+    // from one chip line to the next
+    std::complex<float> doppler0;
+    std::complex<float> dopplerStep;
+
+    // phasor adding back the carrier and flattening the geocoded pixel
+    std::complex<float> reramp;
+};
+
 /**
- * Remove range and azimuth phase carrier from a block of input radar SLC data
+ * Compute the phasors removing the range and azimuth phase carrier from a
+ * block of input radar SLC data
  *
- * @param[out] rdrDataBlock     block of input SLC data in radar grid to be deramped
+ * @param[out] derampPhasors    phasors to be applied to the block of input SLC data
  * @tparam[in] azCarrierPhase   azimuth carrier phase of the SLC data, in radian, as a function of azimuth and range
  * @tparam[in] rgCarrierPhase   range carrier phase of the SLC data, in radian, as a function of azimuth and range
  * @param[in] azimuthFirstLine  line index of the first sample of the block of input data with respect to the origin of the full SLC scene
@@ -32,15 +59,14 @@ namespace isce3::geocode {
  */
 template <typename AzRgFunc>
 void carrierPhaseDeramp(
-        isce3::core::Matrix<std::complex<float>>& rdrDataBlock,
+        isce3::core::Matrix<std::complex<float>>& derampPhasors,
         const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
         const size_t azimuthFirstLine, const size_t rangeFirstPixel,
         const isce3::product::RadarGridParameters& radarGrid)
 {
-    const size_t rdrBlockLength = rdrDataBlock.length();
-    const size_t rdrBlockWidth = rdrDataBlock.width();
+    const size_t rdrBlockLength = derampPhasors.length();
+    const size_t rdrBlockWidth = derampPhasors.width();
 
-    // remove carrier from radar data
 #pragma omp parallel for
     for (size_t ii = 0; ii < rdrBlockLength * rdrBlockWidth; ++ii) {
         auto i = ii / rdrBlockWidth;
@@ -59,81 +85,103 @@ void carrierPhaseDeramp(
         const float carrierPhase = rgCarrierPhase.eval(az, rg)
                 + azCarrierPhase.eval(az, rg);
 
-        // Remove carrier at current radar grid indices
-        const std::complex<float> cpxVal(std::cos(carrierPhase),
-                                         -std::sin(carrierPhase));
-        rdrDataBlock(i, j) *= cpxVal;
+        derampPhasors(i, j) = std::complex<float>(std::cos(carrierPhase),
+                                                  -std::sin(carrierPhase));
     }
 }
 
 
 /**
- * Add back range and azimuth phase carrier and simultaneously flatten the block of geocoded SLC
+ * Compute the interpolation plan of a block of geocoded pixels: location
+ * of the interpolation chip, sinc kernel rows, Doppler demodulation phasors
+ * and the phasor adding back the carrier and flattening the pixel
  *
- * @param[out] geoDataBlock     geocoded SLC data whose phase will be added by carrier phase and flatten by geometrical phase
- * @param[in] rdrDataBlock      radar grid SLC data
+ * @param[out] interpPlan       interpolation plan of each pixel of the geocoded block
+ * @param[in] rangeIndices      range (radar-coordinates x) index of the pixels in geo-grid, NaN if invalid
+ * @param[in] azimuthIndices    azimuth (radar-coordinates y) index of the pixels in geo-grid, NaN if invalid
+ * @param[in] geoBlockLength    number of lines of the geocoded block
+ * @param[in] azimuthFirstLine  line index of the first sample of the radar block
+ * @param[in] rangeFirstPixel   pixel index of the first sample of the radar block
+ * @param[in] rdrBlockLength    number of lines of the radar block
+ * @param[in] rdrBlockWidth     number of pixels of the radar block
  * @tparam[in] azCarrierPhase   azimuth carrier phase of the SLC data, in radian, as a function of azimuth and range
  * @tparam[in] rgCarrierPhase   range carrier phase of the SLC data, in radian, as a function of azimuth and range
- * @param[in] rangeIndices      range (radar-coordinates x) index of the pixels in geo-grid
- * @param[in] azimuthIndices    azimuth (radar-coordinates y) index of the pixels in geo-grid
+ * @param[in] dopplerLUT        native doppler of SLC image
  * @param[in] radarGrid         radar grid parameters
  * @param[in] flatten           flag to flatten the geocoded SLC
- * @param[in] azimuthFirstLine  line index of the first sample of the block
- * @param[in] rangeFirstPixel   pixel index of the first sample of the block
  */
 template <typename AzRgFunc>
-void carrierPhaseRerampAndFlatten(
-        isce3::core::Matrix<std::complex<float>>& geoDataBlock,
-        const isce3::core::Matrix<std::complex<float>>& rdrDataBlock,
+void computeInterpPlan(std::vector<SlcInterpPixel>& interpPlan,
+        const isce3::core::Matrix<double>& rangeIndices,
+        const isce3::core::Matrix<double>& azimuthIndices,
+        const size_t geoBlockLength,
+        const int azimuthFirstLine, const int rangeFirstPixel,
+        const int rdrBlockLength, const int rdrBlockWidth,
         const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
         const isce3::core::LUT2d<double>& dopplerLUT,
-        isce3::core::Matrix<double>& rangeIndices,
-        isce3::core::Matrix<double>& azimuthIndices,
         const isce3::product::RadarGridParameters& radarGrid,
-        const bool flatten, const size_t azimuthFirstLine,
-        const size_t rangeFirstPixel)
+        const bool flatten)
 {
-    const size_t outWidth = geoDataBlock.width();
-    const size_t outLength = geoDataBlock.length();
-    const int inWidth = rdrDataBlock.width();
-    const int inLength = rdrDataBlock.length();
+    const size_t outWidth = rangeIndices.width();
     const int chipHalf = isce3::core::SINC_ONE / 2;
 
 #pragma omp parallel for
-    for (size_t ii = 0; ii < outLength * outWidth; ++ii) {
+    for (size_t ii = 0; ii < geoBlockLength * outWidth; ++ii) {
         auto i = ii / outWidth;
         auto j = ii % outWidth;
 
-        // Get double and int rg/az coordinates (accounting for block offsets)
-        const double RgIndex = rangeIndices(i,j) - rangeFirstPixel;
-        const double AzIndex = azimuthIndices(i,j) - azimuthFirstLine;
+        SlcInterpPixel& interpPixel = interpPlan[ii];
+        interpPixel.line = -1;
+
+        // Skip pixels without a valid geo2rdr solution
+        if (std::isnan(rangeIndices(i, j)) || std::isnan(azimuthIndices(i, j)))
+            continue;
 
-        // Truncate rg/az indices to int
+        // adjust the row and column indicies for the current block,
+        // i.e., moving the origin to the top-left of this radar block.
+        const double RgIndex = rangeIndices(i, j) - rangeFirstPixel;
+        const double AzIndex = azimuthIndices(i, j) - azimuthFirstLine;
+
+        // Truncate rg/az coordinates to int
         const int intRgIndex = static_cast<int>(RgIndex);
         const int intAzIndex = static_cast<int>(AzIndex);
 
-        // Check if chip indices could be outside radar grid (plus interp chip)
-        // i.e. Check if current pixel was interpolated
-        // Skip if chip indices outside int value of radar grid
-        if ((intRgIndex < chipHalf) || (intRgIndex >= (inWidth - chipHalf)))
+        // Save the fractional parts of rg/az coordinates
+        const double fracRgIndex = RgIndex - intRgIndex;
+        const double fracAzIndex = AzIndex - intAzIndex;
+
+        // Check if chip indices could be outside radar grid
+        // Skip if chip indices out of bounds
+        if ((intRgIndex < chipHalf) || (intRgIndex >= (rdrBlockWidth - chipHalf)))
             continue;
-        if ((intAzIndex < chipHalf) || (intAzIndex >= (inLength - chipHalf)))
+        if ((intAzIndex < chipHalf) || (intAzIndex >= (rdrBlockLength - chipHalf)))
             continue;
 
         // Slant Range at the current output pixel
         const double rng = radarGrid.startingRange() +
-                rangeIndices(i,j) * radarGrid.rangePixelSpacing();
+                rangeIndices(i, j) * radarGrid.rangePixelSpacing();
 
         // Azimuth time at the current output pixel
         const double az = radarGrid.sensingStart() +
-                          azimuthIndices(i,j) / radarGrid.prf();
+                          azimuthIndices(i, j) / radarGrid.prf();
 
         // Skip pixel if doppler could not be evaluated
         if (not dopplerLUT.contains(az, rng))
             continue;
 
-        // Simultaneously evaluate carrier
-        // that needs to be added back after interpolation
+        // Doppler phase increment between consecutive lines. The chip lines
+        // are visited from intAzIndex + SINC_HALF downwards, as in
+        // Sinc2dInterpolator.
+        const double doppFreq =
+                dopplerLUT.eval(az, rng) * 2 * M_PI / radarGrid.prf();
+        const double doppPhase0 =
+                doppFreq * (isce3::core::SINC_HALF + fracAzIndex);
+        interpPixel.doppler0 = std::complex<float>(std::cos(doppPhase0),
+                                                   -std::sin(doppPhase0));
+        interpPixel.dopplerStep = std::complex<float>(std::cos(doppFreq),
+                                                      std::sin(doppFreq));
+
+        // Carrier that needs to be added back after interpolation
         const double carrierPhase =
             rgCarrierPhase.eval(az, rng) + azCarrierPhase.eval(az, rng);
 
@@ -141,116 +189,81 @@ void carrierPhaseRerampAndFlatten(
         const double flattenPhase = flatten ?
                 4.0 * (M_PI / radarGrid.wavelength()) * rng : 0.0;
 
-        // Add all the phases together
         const auto totalPhase = carrierPhase + flattenPhase;
-
-        // Update geoDataBlock column and row from index
-        const std::complex<float> cpxVal(std::cos(totalPhase),
-                                         std::sin(totalPhase));
-        geoDataBlock(i, j) *= cpxVal;
+        interpPixel.reramp = std::complex<float>(std::cos(totalPhase),
+                                                 std::sin(totalPhase));
+
+        // Nearest sinc kernel rows of the fractional indices
+        const int sincSub = isce3::core::SINC_SUB;
+        interpPixel.azKernelRow = std::min(
+                std::max(0, static_cast<int>(fracAzIndex * sincSub)),
+                sincSub - 1);
+        interpPixel.rgKernelRow = std::min(
+                std::max(0, static_cast<int>(fracRgIndex * sincSub)),
+                sincSub - 1);
+
+        interpPixel.line = intAzIndex;
+        interpPixel.pixel = intRgIndex;
     }
 }
 
 
 /** Interpolate radar data block to geo data block
  *
- * @param[in] rdrDataBlock      block of SLC data in radar coordinates basebanded in range direction
+ * The separable sinc kernel is applied along range for each chip line and
+ * then along azimuth after Doppler demodulation of the line sums, which is
+ * equivalent to Sinc2dInterpolator applied to the demodulated chip.
+ *
  * @param[out] geoDataBlock     block of data in geo coordinates
- * @param[in] rangeIndices      range (radar-coordinates x) index of the pixels in geo-grid
- * @param[in] azimuthIndices    azimuth (radar-coordinates y) index of the pixels in geo-grid
- * @param[in] azimuthFirstLine  line index of the first sample of the block
- * @param[in] rangeFirstPixel   pixel index of the first sample of the block
- * @param[in] sincInterp        sinc interpolator object
- * @param[in] radarGrid         RadarGridParameters of radar data
- * @param[in] dopplerLUT        native doppler of SLC image
+ * @param[in] rdrDataBlock      block of SLC data in radar coordinates, with the carrier removed
+ * @param[in] interpPlan        interpolation plan of each pixel of the geocoded block
+ * @param[in] nPixels           number of pixels of the geocoded block
+ * @param[in] sincKernel        single precision sinc kernel (SINC_SUB x SINC_LEN)
+ * @param[in] invalidValue      invalid pixel fill value
  */
-void interpolate(const isce3::core::Matrix<std::complex<float>>& rdrDataBlock,
-        isce3::core::Matrix<std::complex<float>>& geoDataBlock,
-        isce3::core::Matrix<double>& rangeIndices,
-        isce3::core::Matrix<double>& azimuthIndices,
-        const int azimuthFirstLine, const int rangeFirstPixel,
-        const isce3::core::Interpolator<std::complex<float>>* sincInterp,
-        const isce3::product::RadarGridParameters& radarGrid,
-        const isce3::core::LUT2d<double>& dopplerLUT)
+void interpolate(isce3::core::Matrix<std::complex<float>>& geoDataBlock,
+        const isce3::core::Matrix<std::complex<float>>& rdrDataBlock,
+        const std::vector<SlcInterpPixel>& interpPlan, const size_t nPixels,
+        const std::vector<float>& sincKernel,
+        const std::complex<float> invalidValue)
 {
-    const int chipSize = isce3::core::SINC_ONE;
-    const int outWidth = geoDataBlock.width();
-    const int outLength = geoDataBlock.length();
-    const int inWidth = rdrDataBlock.width();
-    const int inLength = rdrDataBlock.length();
-    const int chipHalf = chipSize / 2;
+    const int sincHalf = isce3::core::SINC_HALF;
+    const int sincLen = isce3::core::SINC_LEN;
+    std::complex<float>* geoData = geoDataBlock.data();
 
 #pragma omp parallel for
-    for (size_t ii = 0; ii < outLength * outWidth; ++ii) {
-        auto i = ii / outWidth;
-        auto j = ii % outWidth;
-
-        // adjust the row and column indicies for the current block,
-        // i.e., moving the origin to the top-left of this radar block.
-        double RgIndex = rangeIndices(i,j) - rangeFirstPixel;
-        double AzIndex = azimuthIndices(i,j) - azimuthFirstLine;
-
-        // Truncate rg/az coordinates to int
-        const int intRgIndex = static_cast<int>(RgIndex);
-        const int intAzIndex = static_cast<int>(AzIndex);
-
-        // Save the fractional parts of rg/az coordinates
-        const double fracRgIndex = RgIndex - intRgIndex;
-        const double fracAzIndex = AzIndex - intAzIndex;
-
-        // Check if chip indices could be outside radar grid
-        // Skip if chip indices out of bounds
-        if ((intRgIndex < chipHalf) || (intRgIndex >= (inWidth - chipHalf)))
-            continue;
-        if ((intAzIndex < chipHalf) || (intAzIndex >= (inLength - chipHalf)))
+    for (size_t ii = 0; ii < nPixels; ++ii) {
+        const SlcInterpPixel& interpPixel = interpPlan[ii];
+        if (interpPixel.line < 0) {
+            geoData[ii] = invalidValue;
             continue;
+        }
 
-        // Slant Range at the current output pixel
-        const double rng =
-                radarGrid.startingRange() +
-                rangeIndices(i,j) * radarGrid.rangePixelSpacing();
-
-        // Azimuth time at the current output pixel
-        const double az = radarGrid.sensingStart() +
-                          azimuthIndices(i,j) / radarGrid.prf();
-
-        if (not dopplerLUT.contains(az, rng))
-            continue;
-
-        // Evaluate doppler at current range and azimuth time
-        const double doppFreq =
-                dopplerLUT.eval(az, rng) * 2 * M_PI / radarGrid.prf();
-
-        isce3::core::Matrix<std::complex<float>> chip(chipSize, chipSize);
-        // Read data chip
-        for (int ii = 0; ii < chipSize; ++ii) {
-            // Row to read from
-            const int chipRow = intAzIndex + ii - chipHalf;
-
-            // Compute doppler frequency at current row
-            const double doppPhase = doppFreq * (ii - chipHalf + fracAzIndex);
-            const std::complex<float> doppVal(std::cos(doppPhase),
-                                              -std::sin(doppPhase));
+        const float* azKernel = &sincKernel[interpPixel.azKernelRow * sincLen];
+        const float* rgKernel = &sincKernel[interpPixel.rgKernelRow * sincLen];
 
-            for (int jj = 0; jj < chipSize; ++jj) {
-                // Column to read from
-                const int chipCol = intRgIndex + jj - chipHalf;
+        std::complex<float> doppVal = interpPixel.doppler0;
+        std::complex<float> cval(0.0f, 0.0f);
+        for (int i = 0; i < sincLen; ++i) {
+            // last sample of the chip line
+            const std::complex<float>* chipLine = &rdrDataBlock(
+                    interpPixel.line + sincHalf - i,
+                    interpPixel.pixel + sincHalf);
 
-                // Set the data values after doppler demodulation
-                chip(ii, jj) = rdrDataBlock(chipRow, chipCol) * doppVal;
+            std::complex<float> lineSum(0.0f, 0.0f);
+            for (int j = 0; j < sincLen; ++j) {
+                lineSum += chipLine[-j] * rgKernel[j];
             }
+            cval += lineSum * (doppVal * azKernel[i]);
+            doppVal *= interpPixel.dopplerStep;
         }
 
-        // Interpolate chip
-        const std::complex<float> cval =
-                sincInterp->interpolate(isce3::core::SINC_HALF + fracRgIndex,
-                        isce3::core::SINC_HALF + fracAzIndex, chip);
-
-        // Set geoDataBlock column and row from index
-        geoDataBlock(i, j) = cval;
+        geoData[ii] = cval * interpPixel.reramp;
     }
 }
 
+} // namespace
+
 
 template<typename AzRgFunc>
 void geocodeSlc(
@@ -328,24 +341,99 @@ void geocodeSlc(
         const bool flatten,
         const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
         const std::complex<float> invalidValue)
+{
+    geocodeSlc(std::vector<std::reference_wrapper<isce3::io::Raster>> {outputRaster},
+            std::vector<std::reference_wrapper<isce3::io::Raster>> {inputRaster},
+            demRaster, radarGrid, slicedRadarGrid, geoGrid, orbit,
+            nativeDoppler, imageGridDoppler, ellipsoid, thresholdGeo2rdr,
+            numiterGeo2rdr, linesPerBlock, flatten, azCarrierPhase,
+            rgCarrierPhase, invalidValue);
+}
+
+
+template<typename AzRgFunc>
+void geocodeSlc(
+        std::vector<std::reference_wrapper<isce3::io::Raster>> outputRasters,
+        std::vector<std::reference_wrapper<isce3::io::Raster>> inputRasters,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid, const double& thresholdGeo2rdr,
+        const int& numiterGeo2rdr, const size_t& linesPerBlock,
+        const bool flatten, const AzRgFunc& azCarrierPhase,
+        const AzRgFunc& rgCarrierPhase, const std::complex<float> invalidValue)
+{
+    geocodeSlc(outputRasters, inputRasters, demRaster, radarGrid, radarGrid,
+            geoGrid, orbit, nativeDoppler, imageGridDoppler, ellipsoid,
+            thresholdGeo2rdr, numiterGeo2rdr, linesPerBlock,
+            flatten, azCarrierPhase, rgCarrierPhase, invalidValue);
+}
+
+
+template<typename AzRgFunc>
+void geocodeSlc(
+        std::vector<std::reference_wrapper<isce3::io::Raster>> outputRasters,
+        std::vector<std::reference_wrapper<isce3::io::Raster>> inputRasters,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::RadarGridParameters& slicedRadarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid, const double& thresholdGeo2rdr,
+        const int& numiterGeo2rdr, const size_t& linesPerBlock,
+        const bool flatten,
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase,
+        const std::complex<float> invalidValue)
 {
     validate_slice(radarGrid, slicedRadarGrid);
 
-    // number of bands in the input raster
-    size_t nbands = inputRaster.numBands();
-    std::cout << "nbands: " << nbands << std::endl;
+    if (outputRasters.size() != inputRasters.size()) {
+        std::string error_msg("number of output rasters != number of input rasters");
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+
+    for (size_t k = 0; k < inputRasters.size(); ++k) {
+        if (outputRasters[k].get().numBands() < inputRasters[k].get().numBands()) {
+            std::string error_msg("output raster has fewer bands than input raster");
+            throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+        }
+    }
+
     // create projection based on _epsg code
     std::unique_ptr<isce3::core::ProjectionBase> proj(
             isce3::core::createProj(geoGrid.epsg()));
 
-    // Interpolator pointer
-    auto sincInterp = std::make_unique<
-            isce3::core::Sinc2dInterpolator<std::complex<float>>>(
+    // Single precision copy of the sinc kernel, shared by all pixels
+    const isce3::core::Sinc2dInterpolator<std::complex<float>> sincInterp(
             isce3::core::SINC_LEN, isce3::core::SINC_SUB);
+    const auto& kernel = sincInterp.kernel();
+    std::vector<float> sincKernel(kernel.size());
+    for (size_t i = 0; i < sincKernel.size(); ++i) {
+        sincKernel[i] = static_cast<float>(kernel.data()[i]);
+    }
 
     // Compute number of blocks in the output geocoded grid
     size_t nBlocks = (geoGrid.length() + linesPerBlock - 1) / linesPerBlock;
 
+    // Buffers of the geocoded grid, reused by all blocks. The last block
+    // uses the first lines only.
+    const size_t geoGridWidth = geoGrid.width();
+    const size_t maxBlockLength = std::min(linesPerBlock,
+            static_cast<size_t>(geoGrid.length()));
+
+    // X and Y indices (in the radar coordinates) for the
+    // geocoded pixels (after geo2rdr computation)
+    isce3::core::Matrix<double> rangeIndices(maxBlockLength, geoGridWidth);
+    isce3::core::Matrix<double> azimuthIndices(maxBlockLength, geoGridWidth);
+    std::vector<SlcInterpPixel> interpPlan(maxBlockLength * geoGridWidth);
+    isce3::core::Matrix<std::complex<float>> geoDataBlock(maxBlockLength,
+                                                          geoGridWidth);
+
     std::cout << "nBlocks: " << nBlocks << std::endl;
     // loop over the blocks of the geocoded Grid
     for (size_t block = 0; block < nBlocks; ++block) {
@@ -364,11 +452,6 @@ void geocodeSlc(
         isce3::geometry::DEMInterpolator demInterp = isce3::geometry::loadDEM(
                 demRaster, geoGrid, lineStart, geoBlockLength, geoGrid.width());
 
-        // X and Y indices (in the radar coordinates) for the
-        // geocoded pixels (after geo2rdr computation)
-        isce3::core::Matrix<double> rangeIndices(geoBlockLength, geoGrid.width());
-        isce3::core::Matrix<double> azimuthIndices(geoBlockLength, geoGrid.width());
-
         // First and last line of the data block in radar coordinates
         int azimuthFirstLine = radarGrid.length() - 1;
         int azimuthLastLine = 0;
@@ -379,7 +462,6 @@ void geocodeSlc(
 
         // Compute radar coordinates of each geocoded pixel
         // Determine boundary of corresponding radar raster
-        size_t geoGridWidth = geoGrid.width();
 // Loop over lines, samples of the output grid
 #pragma omp parallel for reduction(min                                    \
                                    : azimuthFirstLine,                    \
@@ -391,6 +473,12 @@ void geocodeSlc(
             const size_t line = lineStart + blockLine;
 
             for (size_t pixel = 0; pixel < geoGridWidth; ++pixel) {
+                // mark the pixel invalid until geo2rdr succeeds
+                rangeIndices(blockLine, pixel) =
+                        std::numeric_limits<double>::quiet_NaN();
+                azimuthIndices(blockLine, pixel) =
+                        std::numeric_limits<double>::quiet_NaN();
+
                 // y coordinate in the out put grid
                 // Assuming geoGrid.startY() and geoGrid.startX() represent the top-left
                 // corner of the first pixel, then 0.5 pixel shift is needed to get
@@ -473,50 +561,51 @@ void geocodeSlc(
         size_t rdrBlockLength = azimuthLastLine - azimuthFirstLine + 1;
         size_t rdrBlockWidth = rangeLastPixel - rangeFirstPixel + 1;
 
+        // Carrier phasors of the radar block and interpolation plan of the
+        // geocoded block, computed once and applied to all rasters
+        isce3::core::Matrix<std::complex<float>> derampPhasors(rdrBlockLength,
+                                                               rdrBlockWidth);
+        carrierPhaseDeramp(derampPhasors, azCarrierPhase, rgCarrierPhase,
+                azimuthFirstLine, rangeFirstPixel, radarGrid);
+
+        computeInterpPlan(interpPlan, rangeIndices, azimuthIndices,
+                geoBlockLength, azimuthFirstLine, rangeFirstPixel,
+                rdrBlockLength, rdrBlockWidth, azCarrierPhase, rgCarrierPhase,
+                nativeDoppler, radarGrid, flatten);
+
         // define the matrix based on the rasterbands data type
         isce3::core::Matrix<std::complex<float>> rdrDataBlock(rdrBlockLength,
                                                              rdrBlockWidth);
-        isce3::core::Matrix<std::complex<float>> geoDataBlock(geoBlockLength,
-                                                             geoGrid.width());
-
-        // fill both radar data block with zero
-        rdrDataBlock.zeros();
-
-        // assume all values invalid by default
-        // interpolate and carrierPhaseRerampAndFlatten will only modify valid pixels
-        geoDataBlock.fill(invalidValue);
-
-        // for each band in the input:
-        for (size_t band = 0; band < nbands; ++band) {
-
-            std::cout << "band: " << band << std::endl;
-            // get a block of data
-            std::cout << "get data block " << std::endl;
-            inputRaster.getBlock(rdrDataBlock.data(), rangeFirstPixel,
-                                 azimuthFirstLine, rdrBlockWidth,
-                                 rdrBlockLength, band + 1);
-
-            // Remove doppler and carriers as needd
-            carrierPhaseDeramp(rdrDataBlock, azCarrierPhase, rgCarrierPhase,
-                    azimuthFirstLine, rangeFirstPixel, radarGrid);
-
-            // interpolate the data in radar grid to the geocoded grid.
-            interpolate(rdrDataBlock, geoDataBlock, rangeIndices, azimuthIndices,
-                    azimuthFirstLine, rangeFirstPixel, sincInterp.get(),
-                    radarGrid, nativeDoppler);
-
-            // Add back doppler and carriers as needd
-            carrierPhaseRerampAndFlatten(geoDataBlock, rdrDataBlock, azCarrierPhase,
-                    rgCarrierPhase, nativeDoppler, rangeIndices,
-                    azimuthIndices, radarGrid, flatten,
-                    azimuthFirstLine, rangeFirstPixel);
-
-            // set output
-            std::cout << "set output " << std::endl;
-            outputRaster.setBlock(geoDataBlock.data(), 0, lineStart,
-                                  geoGrid.width(), geoBlockLength, band + 1);
+        const size_t rdrBlockSize = rdrBlockLength * rdrBlockWidth;
+
+        // for each band of each input raster:
+        for (size_t k = 0; k < inputRasters.size(); ++k) {
+            isce3::io::Raster& inputRaster = inputRasters[k];
+            isce3::io::Raster& outputRaster = outputRasters[k];
+
+            for (size_t band = 0; band < inputRaster.numBands(); ++band) {
+                // get a block of data
+                inputRaster.getBlock(rdrDataBlock.data(), rangeFirstPixel,
+                                     azimuthFirstLine, rdrBlockWidth,
+                                     rdrBlockLength, band + 1);
+
+                // Remove carrier
+#pragma omp parallel for
+                for (size_t ii = 0; ii < rdrBlockSize; ++ii) {
+                    rdrDataBlock.data()[ii] *= derampPhasors.data()[ii];
+                }
+
+                // interpolate the data in radar grid to the geocoded grid
+                // and add back the carrier
+                interpolate(geoDataBlock, rdrDataBlock, interpPlan,
+                        geoBlockLength * geoGridWidth, sincKernel,
+                        invalidValue);
+
+                // set output
+                outputRaster.setBlock(geoDataBlock.data(), 0, lineStart,
+                                      geoGridWidth, geoBlockLength, band + 1);
+            }
         }
-        // set output block of data
     } // end loop over block of output grid
 }
 
@@ -549,6 +638,37 @@ template void geocodeSlc<AzRgFunc>(                                     \
         const int& numiterGeo2rdr, const size_t& linesPerBlock,         \
         const bool flatten,                                             \
         const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase, \
+        const std::complex<float> invalidValue);                        \
+template void geocodeSlc<AzRgFunc>(                                     \
+        std::vector<std::reference_wrapper<isce3::io::Raster>> outputRasters, \
+        std::vector<std::reference_wrapper<isce3::io::Raster>> inputRasters, \
+        isce3::io::Raster& demRaster,                                   \
+        const isce3::product::RadarGridParameters& radarGrid,           \
+        const isce3::product::GeoGridParameters& geoGrid,               \
+        const isce3::core::Orbit& orbit,                                \
+        const isce3::core::LUT2d<double>& nativeDoppler,                \
+        const isce3::core::LUT2d<double>& imageGridDoppler,             \
+        const isce3::core::Ellipsoid& ellipsoid,                        \
+        const double& thresholdGeo2rdr,                                 \
+        const int& numiterGeo2rdr, const size_t& linesPerBlock,         \
+        const bool flatten,                                             \
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase, \
+        const std::complex<float> invalidValue);                        \
+template void geocodeSlc<AzRgFunc>(                                     \
+        std::vector<std::reference_wrapper<isce3::io::Raster>> outputRasters, \
+        std::vector<std::reference_wrapper<isce3::io::Raster>> inputRasters, \
+        isce3::io::Raster& demRaster,                                   \
+        const isce3::product::RadarGridParameters& radarGrid,           \
+        const isce3::product::RadarGridParameters& slicedRadarGrid,     \
+        const isce3::product::GeoGridParameters& geoGrid,               \
+        const isce3::core::Orbit& orbit,                                \
+        const isce3::core::LUT2d<double>& nativeDoppler,                \
+        const isce3::core::LUT2d<double>& imageGridDoppler,             \
+        const isce3::core::Ellipsoid& ellipsoid,                        \
+        const double& thresholdGeo2rdr,                                 \
+        const int& numiterGeo2rdr, const size_t& linesPerBlock,         \
+        const bool flatten,                                             \
+        const AzRgFunc& azCarrierPhase, const AzRgFunc& rgCarrierPhase, \
         const std::complex<float> invalidValue)
 
 EXPLICIT_INSTANTIATION(isce3::core::LUT2d<double>);
@@ -1,5 +1,9 @@
 #pragma once
+#include <complex>
 #include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
 #include <isce3/core/forward.h>
 #include <isce3/core/Poly2d.h>
 #include <isce3/io/forward.h>
@@ -89,4 +93,95 @@ void geocodeSlc(isce3::io::Raster& outputRaster, isce3::io::Raster& inputRaster,
                     std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
                                         std::numeric_limits<float>::quiet_NaN()));
 
+/**
+ * Geocode several SLCs sharing a radar grid to a given geogrid, e.g. all
+ * the polarizations of a frequency
+ *
+ * The geo2rdr solution, the sinc interpolation kernel indices, the Doppler
+ * and carrier phases of each block are computed once and applied to all
+ * bands of all input rasters.
+ *
+ * \tparam[in]  AzRgFunc  2-D real-valued function of azimuth and range
+ *
+ * \param[out] outputRasters    output rasters for the geocoded SLCs
+ * \param[in]  inputRasters     input rasters of the SLCs in radar coordinates
+ * \param[in]  demRaster        raster of the DEM
+ * \param[in]  radarGrid        radar grid parameters
+ * \param[in]  geoGrid          geo grid parameters
+ * \param[in]  orbit            orbit
+ * \param[in]  nativeDoppler    2D LUT Doppler of the SLC image
+ * \param[in]  imageGridDoppler 2D LUT Doppler of the image grid
+ * \param[in]  ellipsoid        ellipsoid object
+ * \param[in]  thresholdGeo2rdr threshold for geo2rdr computations
+ * \param[in]  numiterGeo2rdr   maximum number of iterations for Geo2rdr convergence
+ * \param[in]  linesPerBlock    number of lines in each block
+ * \param[in]  flatten          flag to flatten the geocoded SLC
+ * \param[in]  azCarrier        azimuth carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  rgCarrier        range carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  invalidValue     invalid pixel fill value
+ */
+template<typename AzRgFunc = isce3::core::Poly2d>
+void geocodeSlc(
+        std::vector<std::reference_wrapper<isce3::io::Raster>> outputRasters,
+        std::vector<std::reference_wrapper<isce3::io::Raster>> inputRasters,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const double& thresholdGeo2rdr, const int& numiterGeo2rdr,
+        const size_t& linesPerBlock,
+        const bool flatten = true,
+        const AzRgFunc& azCarrier = AzRgFunc(),
+        const AzRgFunc& rgCarrier = AzRgFunc(),
+        const std::complex<float> invalidValue =
+            std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
+                                std::numeric_limits<float>::quiet_NaN()));
+
+/**
+ * Geocode several SLCs sharing a radar grid to a slice of a given geogrid
+ *
+ * \tparam[in]  AzRgFunc  2-D real-valued function of azimuth and range
+ *
+ * \param[out] outputRasters    output rasters for the geocoded SLCs
+ * \param[in]  inputRasters     input rasters of the SLCs in radar coordinates
+ * \param[in]  demRaster        raster of the DEM
+ * \param[in]  radarGrid        full sized radar grid parameters
+ * \param[in]  slicedRadarGrid  sliced radar grid parameters
+ * \param[in]  geoGrid          geo grid parameters
+ * \param[in]  orbit            orbit
+ * \param[in]  nativeDoppler    2D LUT Doppler of the SLC image
+ * \param[in]  imageGridDoppler 2D LUT Doppler of the image grid
+ * \param[in]  ellipsoid        ellipsoid object
+ * \param[in]  thresholdGeo2rdr threshold for geo2rdr computations
+ * \param[in]  numiterGeo2rdr   maximum number of iterations for Geo2rdr convergence
+ * \param[in]  linesPerBlock    number of lines in each block
+ * \param[in]  flatten          flag to flatten the geocoded SLC
+ * \param[in]  azCarrier        azimuth carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  rgCarrier        range carrier phase of the SLC data, in radians, as a function of azimuth and range
+ * \param[in]  invalidValue     invalid pixel fill value
+ */
+template<typename AzRgFunc = isce3::core::Poly2d>
+void geocodeSlc(
+        std::vector<std::reference_wrapper<isce3::io::Raster>> outputRasters,
+        std::vector<std::reference_wrapper<isce3::io::Raster>> inputRasters,
+        isce3::io::Raster& demRaster,
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::product::RadarGridParameters& slicedRadarGrid,
+        const isce3::product::GeoGridParameters& geoGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& nativeDoppler,
+        const isce3::core::LUT2d<double>& imageGridDoppler,
+        const isce3::core::Ellipsoid& ellipsoid,
+        const double& thresholdGeo2rdr, const int& numiterGeo2rdr,
+        const size_t& linesPerBlock,
+        const bool flatten = true,
+        const AzRgFunc& azCarrier = AzRgFunc(),
+        const AzRgFunc& rgCarrier = AzRgFunc(),
+        const std::complex<float> invalidValue =
+            std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
+                                std::numeric_limits<float>::quiet_NaN()));
+
 }} // namespace isce3::geocode
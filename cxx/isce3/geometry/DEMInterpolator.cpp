@@ -5,6 +5,7 @@
 // Copyright 2017-2018
 //
 
+#include <algorithm>
 #include <cmath>
 #include "DEMInterpolator.h"
 
@@ -313,8 +314,9 @@ isce3::error::ErrorCode isce3::geometry::DEMInterpolator::loadDEM(
         return isce3::error::ErrorCode::OutOfBoundsDem;
     }
 
-    // Resize DEM array
+    // Resize DEM array, dropping any previously loaded quantized heights
     _dem.resize(length, width);
+    _quantized = detail::QuantizedHeights();
 
     if (!flag_dem_file_discontinuity) {
         // Read single block from DEM
@@ -434,6 +436,10 @@ isce3::error::ErrorCode isce3::geometry::DEMInterpolator::loadDEM(
     // Initialize internal interpolator
     _interp = std::unique_ptr<isce3::core::Interpolator<float>>(isce3::core::createInterpolator<float>(_interpMethod));
 
+    // Store the heights in the requested format and summarize them once so
+    // that statistics queries don't rescan the DEM
+    _storeHeights();
+
     // Indicate we have loaded a valid raster
     _haveRaster = true;
 
@@ -473,8 +479,9 @@ loadDEM(isce3::io::Raster & demRaster, const int dem_raster_band) {
     _deltax = delta_x;
     _deltay = delta_y;
 
-    // Resize memory
+    // Resize memory, dropping any previously loaded quantized heights
     _dem.resize(length, width);
+    _quantized = detail::QuantizedHeights();
 
     // Read in the DEM
     demRaster.getBlock(_dem.data(), 0, 0, width, length, dem_raster_band);
@@ -482,6 +489,10 @@ loadDEM(isce3::io::Raster & demRaster, const int dem_raster_band) {
     // Initialize internal interpolator
     _interp = std::unique_ptr<isce3::core::Interpolator<float>>(isce3::core::createInterpolator<float>(_interpMethod));
 
+    // Store the heights in the requested format and summarize them once so
+    // that statistics queries don't rescan the DEM
+    _storeHeights();
+
     // Indicate we have loaded a valid raster
     _haveRaster = true;
 }
@@ -493,10 +504,10 @@ declare() const {
     pyre::journal::info_t info("isce.core.DEMInterpolator");
     info << "Actual DEM bounds used:" << pyre::journal::newline
          << "Top Left: " << _xstart << " " << _ystart << pyre::journal::newline
-         << "Bottom Right: " << _xstart + _deltax * (_dem.width() - 1) << " "
-         << _ystart + _deltay * (_dem.length() - 1) << " " << pyre::journal::newline
+         << "Bottom Right: " << _xstart + _deltax * (width() - 1) << " "
+         << _ystart + _deltay * (length() - 1) << " " << pyre::journal::newline
          << "Spacing: " << _deltax << " " << _deltay << pyre::journal::newline
-         << "Dimensions: " << _dem.width() << " " << _dem.length() << pyre::journal::endl;
+         << "Dimensions: " << width() << " " << length() << pyre::journal::endl;
 }
 
 /** @param[out] maxValue Maximum DEM height
@@ -504,33 +515,158 @@ declare() const {
   * @param[in] info Pyre journal channel for printing info. */
 void isce3::geometry::DEMInterpolator::
 computeHeightStats(float & maxValue, float & meanValue, pyre::journal::info_t & info) {
+    float minValue;
+    computeHeightStats(minValue, maxValue, meanValue, info);
+}
+
+/** @param[out] minValue Minimum DEM height
+  * @param[out] maxValue Maximum DEM height
+  * @param[out] meanValue Mean DEM height
+  * @param[in] info Pyre journal channel for printing info.
+  *
+  * Statistics are read from the top of the height pyramid built when the
+  * DEM was loaded, so this call does not scan the DEM. Invalid (NaN) heights
+  * are ignored. */
+void isce3::geometry::DEMInterpolator::
+computeHeightStats(float & minValue, float & maxValue, float & meanValue,
+                   pyre::journal::info_t & info) {
     // Announce myself
     info << "Computing DEM statistics" << pyre::journal::newline;
     // If we don't have a DEM, just use reference height
-    if (!_haveRaster) {
+    const auto stats = _heightStats.stats();
+    if (!_haveRaster || stats.count == 0) {
+        minValue = _refHeight;
         maxValue = _refHeight;
         meanValue = _refHeight;
     } else {
-        maxValue = -10000.0;
-        float sum = 0.0;
-        for (int i = 0; i < int(_dem.length()); ++i) {
-            for (int j = 0; j < int(_dem.width()); ++j) {
-                float value = _dem(i,j);
-                if (value > maxValue)
-                    maxValue = value;
-                sum += value;
-            }
-        }
-        meanValue = sum / (_dem.width() * _dem.length());
+        minValue = stats.min;
+        maxValue = stats.max;
+        meanValue = stats.mean();
     }
     // Store updated statistics
+    _minValue = minValue;
     _meanValue = meanValue;
     _maxValue = maxValue;
     // Announce results
-    info << "Max DEM height: " << maxValue << pyre::journal::newline
+    info << "Min DEM height: " << minValue << pyre::journal::newline
+         << "Max DEM height: " << maxValue << pyre::journal::newline
          << "Average DEM height: " << meanValue << pyre::journal::newline;
 }
 
+/** @param[out] minValue Minimum DEM height within window
+  * @param[out] maxValue Maximum DEM height within window
+  * @param[out] meanValue Mean DEM height within window
+  * @param[in] min_x Minimum X/easting position
+  * @param[in] max_x Maximum X/easting position
+  * @param[in] min_y Minimum Y/northing position
+  * @param[in] max_y Maximum Y/northing position
+  *
+  * The window is clipped to the extents of the loaded DEM. If no DEM is
+  * loaded or the window holds no valid heights, the reference height is
+  * returned. The cost is proportional to the window perimeter rather than
+  * its area. */
+void isce3::geometry::DEMInterpolator::
+computeHeightStats(float & minValue, float & maxValue, float & meanValue,
+                   double min_x, double max_x, double min_y,
+                   double max_y) const {
+
+    minValue = _refHeight;
+    maxValue = _refHeight;
+    meanValue = _refHeight;
+    if (!_haveRaster) {
+        return;
+    }
+
+    // Convert window to (fractional) DEM indices, accounting for the
+    // sign of the spacing
+    double col0 = (min_x - _xstart) / _deltax;
+    double col1 = (max_x - _xstart) / _deltax;
+    double row0 = (min_y - _ystart) / _deltay;
+    double row1 = (max_y - _ystart) / _deltay;
+    if (col1 < col0)
+        std::swap(col0, col1);
+    if (row1 < row0)
+        std::swap(row0, row1);
+
+    const double max_col = static_cast<double>(width());
+    const double max_row = static_cast<double>(length());
+    col0 = std::max(0.0, std::floor(col0));
+    row0 = std::max(0.0, std::floor(row0));
+    col1 = std::min(max_col, std::ceil(col1) + 1);
+    row1 = std::min(max_row, std::ceil(row1) + 1);
+    if (col1 <= col0 || row1 <= row0) {
+        return;
+    }
+
+    const auto first_row = static_cast<size_t>(row0);
+    const auto first_col = static_cast<size_t>(col0);
+    const auto nrows = static_cast<size_t>(row1 - row0);
+    const auto ncols = static_cast<size_t>(col1 - col0);
+    const auto stats = _quantized.empty()
+            ? _heightStats.stats(_dem.data(), first_row, first_col, nrows,
+                                 ncols)
+            : _heightStats.statsWith(_quantized, first_row, first_col,
+                                     nrows, ncols);
+    if (stats.count == 0) {
+        return;
+    }
+    minValue = stats.min;
+    maxValue = stats.max;
+    meanValue = stats.mean();
+}
+
+void isce3::geometry::DEMInterpolator::
+updateHeightStats() {
+    if (!_quantized.empty()) {
+        const auto dem = heights();
+        _heightStats = detail::HeightStatsPyramid(dem.data(), dem.length(),
+                                                  dem.width());
+        return;
+    }
+    _heightStats = detail::HeightStatsPyramid(_dem.data(), _dem.length(),
+                                              _dem.width());
+}
+
+isce3::core::Matrix<float> isce3::geometry::DEMInterpolator::
+heights() const {
+    if (_quantized.empty()) {
+        return _dem;
+    }
+    isce3::core::Matrix<float> dem(_quantized.length(), _quantized.width());
+    _quantized.decode(dem.data(), 0, 0, dem.length(), dem.width());
+    return dem;
+}
+
+void isce3::geometry::DEMInterpolator::
+heightStorage(HeightStorage storage) {
+    if (storage == _heightStorage) {
+        return;
+    }
+    _heightStorage = storage;
+    if (_haveRaster) {
+        _dem = heights();
+        _storeHeights();
+    }
+}
+
+void isce3::geometry::DEMInterpolator::
+_storeHeights() {
+    if (_heightStorage == HeightStorage::Float32) {
+        _quantized = detail::QuantizedHeights();
+        updateHeightStats();
+        return;
+    }
+
+    // Encode, then round trip the float heights so that the statistics
+    // describe the stored values, and release them
+    _quantized = detail::QuantizedHeights(_dem.data(), _dem.length(),
+                                          _dem.width(), _heightStorage);
+    _quantized.decode(_dem.data(), 0, 0, _dem.length(), _dem.width());
+    _heightStats = detail::HeightStatsPyramid(_dem.data(), _dem.length(),
+                                              _dem.width());
+    _dem.resize(0, 0);
+}
+
 // Compute middle latitude and longitude using reference height
 isce3::geometry::DEMInterpolator::cartesian_t
 isce3::geometry::DEMInterpolator::
@@ -606,13 +742,54 @@ interpolateXY(double x, double y) const {
     const int icol = int(std::floor(col));
 
     // If outside bounds, return reference height
-    if (irow < 2 || irow >= int(_dem.length() - 1))
+    if (irow < 2 || irow >= int(length() - 1))
         return _refHeight;
-    if (icol < 2 || icol >= int(_dem.width() - 1))
+    if (icol < 2 || icol >= int(width() - 1))
         return _refHeight;
 
     // Call interpolator and return value
+    if (!_quantized.empty()) {
+        return _interpolateQuantized(col, row, icol, irow);
+    }
     return _interp->interpolate(col, row, _dem);
 }
 
+/** Decode the heights around the interpolation point and interpolate them.
+  * The window is the stencil of the interpolator (built with default
+  * parameters: order 6 biquintic and SINC_LEN sinc kernels) and is clipped
+  * to the DEM, so the interpolators see the same neighborhood and edges as
+  * they do on float storage. */
+double isce3::geometry::DEMInterpolator::
+_interpolateQuantized(double col, double row, int icol, int irow) const {
+
+    // Posts needed before (row, col) and after (row + 1, col + 1)
+    constexpr int maxHalo = std::max(isce3::core::SINC_LEN / 2 - 1, 3);
+    int halo = 0;
+    switch (_interp->method()) {
+        case isce3::core::BICUBIC_METHOD:
+            halo = 1;
+            break;
+        case isce3::core::BIQUINTIC_METHOD:
+            halo = 3;
+            break;
+        case isce3::core::SINC_METHOD:
+            halo = isce3::core::SINC_LEN / 2 - 1;
+            break;
+        default:
+            break;
+    }
+
+    constexpr int span = 2 * maxHalo + 2;
+    const int row0 = std::max(0, irow - halo);
+    const int col0 = std::max(0, icol - halo);
+    const int nrows = std::min(int(length()), irow + halo + 2) - row0;
+    const int ncols = std::min(int(width()), icol + halo + 2) - col0;
+
+    float window[span * span];
+    _quantized.decode(window, row0, col0, nrows, ncols);
+    const Eigen::Map<const isce3::core::EArray2D<float>> heights(window,
+            nrows, ncols);
+    return _interp->interpolate(col - col0, row - row0, heights);
+}
+
 // end of file
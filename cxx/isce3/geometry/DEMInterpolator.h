@@ -20,6 +20,9 @@
 #include <isce3/core/Interpolator.h>
 #include <isce3/error/ErrorCode.h>
 
+#include "detail/HeightStatsPyramid.h"
+#include "detail/QuantizedHeights.h"
+
 // DEMInterpolator declaration
 class isce3::geometry::DEMInterpolator {
 
@@ -30,6 +33,7 @@ class isce3::geometry::DEMInterpolator {
         inline DEMInterpolator() :
             _haveRaster{false},
             _refHeight{0.0},
+            _minValue{0.0},
             _meanValue{0.0},
             _maxValue{0.0},
             _interpMethod{isce3::core::BILINEAR_METHOD} {}
@@ -38,6 +42,7 @@ class isce3::geometry::DEMInterpolator {
         inline DEMInterpolator(float height, int epsg = 4326) :
             _haveRaster{false},
             _refHeight{height},
+            _minValue{height},
             _meanValue{height},
             _maxValue{height},
             _epsgcode{epsg},
@@ -49,6 +54,7 @@ class isce3::geometry::DEMInterpolator {
                                int epsg = 4326) :
             _haveRaster{false},
             _refHeight{height},
+            _minValue{height},
             _meanValue{height},
             _maxValue{height},
             _epsgcode{epsg},
@@ -82,6 +88,16 @@ class isce3::geometry::DEMInterpolator {
         void computeHeightStats(float &maxValue, float &meanValue,
                                 pyre::journal::info_t &info);
 
+        /** Compute min, max and mean DEM height */
+        void computeHeightStats(float &minValue, float &maxValue,
+                                float &meanValue, pyre::journal::info_t &info);
+
+        /** Compute min, max and mean DEM height over a window given in
+         * native DEM coordinates, using the precomputed height pyramid */
+        void computeHeightStats(float &minValue, float &maxValue,
+                                float &meanValue, double min_x, double max_x,
+                                double min_y, double max_y) const;
+
         /** Interpolate at a given longitude and latitude */
         double interpolateLonLat(double lon, double lat) const;
         /** Interpolate at native XY coordinates of DEM */
@@ -122,28 +138,60 @@ class isce3::geometry::DEMInterpolator {
         /** Set reference height of interpolator */
         void refHeight(double h) { _refHeight = h; }
 
+        /** Get min height value */
+        inline double minHeight() const { return _minValue; }
+
         /** Get mean height value */
         inline double meanHeight() const { return _meanValue; }
 
         /** Get max height value */
         inline double maxHeight() const { return _maxValue; }
 
-        /** Get pointer to underlying DEM data */
+        /** Get pointer to underlying DEM data
+         *
+         * Height statistics are precomputed when the DEM is loaded; call
+         * updateHeightStats() after modifying heights through this pointer.
+         * Null when the heights are stored quantized; use heights() to get
+         * a decoded copy instead. */
         float * data() { return _dem.data(); }
 
         /** Get pointer to underlying DEM data */
         const float* data() const { return _dem.data(); }
 
+        /** Get a float copy of the loaded DEM heights, decoding them if
+         * they are stored quantized */
+        isce3::core::Matrix<float> heights() const;
+
         /** Get width of DEM data used for interpolation */
-        inline size_t width() const { return (_haveRaster ? _dem.width() : _width); }
+        inline size_t width() const {
+            if (!_haveRaster)
+                return _width;
+            return _quantized.empty() ? _dem.width() : _quantized.width();
+        }
         /** Set width of DEM data used for interpolation */
         inline void width(int width) { _width = width; }
 
         /** Get length of DEM data used for interpolation */
-        inline size_t length() const { return (_haveRaster ? _dem.length() : _length); }
+        inline size_t length() const {
+            if (!_haveRaster)
+                return _length;
+            return _quantized.empty() ? _dem.length() : _quantized.length();
+        }
         /** Set length of DEM data used for interpolation */
         inline void length(int length) { _length = length; }
 
+        /** Rebuild the min/max/mean height pyramid from the loaded DEM */
+        void updateHeightStats();
+
+        /** Get storage format of the loaded heights */
+        inline HeightStorage heightStorage() const { return _heightStorage; }
+        /** Set storage format of the heights
+         *
+         * Int16 and Float16 storage halve the memory held by the DEM at the
+         * cost of quantizing the heights (see HeightStorage). Applies to
+         * DEMs loaded afterwards and re-encodes a DEM already loaded. */
+        void heightStorage(HeightStorage storage);
+
         /** Get EPSG code for input DEM */
         inline int epsgCode() const { return _epsgcode; }
         /** Set EPSG code for input DEM */
@@ -167,8 +215,11 @@ class isce3::geometry::DEMInterpolator {
         // Constant value if no raster is provided
         float _refHeight;
         // Statistics
+        float _minValue;
         float _meanValue;
         float _maxValue;
+        // Multi-resolution min/max/sum summary of the loaded DEM
+        detail::HeightStatsPyramid _heightStats;
         // Pointer to a ProjectionBase
         int _epsgcode;
         std::shared_ptr<isce3::core::ProjectionBase> _proj;
@@ -177,7 +228,17 @@ class isce3::geometry::DEMInterpolator {
         std::shared_ptr<isce3::core::Interpolator<float>> _interp;
         // 2D array for storing DEM subset
         isce3::core::Matrix<float> _dem;
+        // DEM subset when stored quantized (_dem is empty then)
+        HeightStorage _heightStorage = HeightStorage::Float32;
+        detail::QuantizedHeights _quantized;
         // Starting x/y for DEM subset and spacing
         double _xstart, _ystart, _deltax, _deltay;
         int _width, _length;
+
+        // Store the heights just read into _dem in the requested format and
+        // summarize them
+        void _storeHeights();
+        // Interpolate quantized heights around DEM indices (row, col)
+        double _interpolateQuantized(double col, double row, int icol,
+                                     int irow) const;
 };
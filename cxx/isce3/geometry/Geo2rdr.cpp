@@ -13,8 +13,10 @@
 #include <fstream>
 #include <future>
 #include <valarray>
+#include <vector>
 
 #include <isce3/core/Constants.h>
+#include <isce3/io/DataStream.h>
 
 #include "geometry.h"
 
@@ -94,6 +96,35 @@ geo2rdr(isce3::io::Raster & topoRaster,
     if ((demLength % _linesPerBlock) != 0)
         nBlocks += 1;
 
+    // Valarrays to hold the current and next blocks of topo data
+    std::valarray<double> topoX[2], topoY[2], topoHgt[2];
+    // Valarrays to hold block of geo2rdr results
+    std::valarray<float> rgoff, azoff;
+
+    // Stream reading the next block of topo data and writing the previous
+    // block of results while the current block is processed. A single
+    // stream serializes the accesses to the rasters, which may share a
+    // GDAL dataset.
+    isce3::io::RasterDataStream ioStream;
+    std::vector<std::future<void>> topoLoads;
+
+    auto loadTopoBlock = [&](size_t block) {
+        const size_t lineStart = block * _linesPerBlock;
+        const size_t blockLength = std::min(_linesPerBlock,
+                                            demLength - lineStart);
+        const size_t k = block % 2;
+        topoX[k].resize(blockLength * demWidth);
+        topoY[k].resize(blockLength * demWidth);
+        topoHgt[k].resize(blockLength * demWidth);
+        topoLoads.push_back(ioStream.load(topoRaster, &topoX[k][0], 0,
+                lineStart, demWidth, blockLength, 1));
+        topoLoads.push_back(ioStream.load(topoRaster, &topoY[k][0], 0,
+                lineStart, demWidth, blockLength, 2));
+        topoLoads.push_back(ioStream.load(topoRaster, &topoHgt[k][0], 0,
+                lineStart, demWidth, blockLength, 3));
+    };
+    loadTopoBlock(0);
+
     // Loop over blocks
     size_t converged = 0;
     for (size_t block = 0; block < nBlocks; ++block) {
@@ -119,15 +150,18 @@ geo2rdr(isce3::io::Raster & topoRaster,
              << _doppler.eval(tblock, rngend) << " "
              << pyre::journal::endl;
 
-        // Valarrays to hold input block from topo rasters
-        std::valarray<double> x(blockSize), y(blockSize), hgt(blockSize);
-        // Valarrays to hold block of geo2rdr results
-        std::valarray<float> rgoff(blockSize), azoff(blockSize);
-
-        // Read block of topo data
-        topoRaster.getBlock(x, 0, lineStart, demWidth, blockLength, 1);
-        topoRaster.getBlock(y, 0, lineStart, demWidth, blockLength, 2);
-        topoRaster.getBlock(hgt, 0, lineStart, demWidth, blockLength,3);
+        // Wait for the block of topo data, but not for the writes of the
+        // previous block, then start reading the next one
+        for (auto & load : topoLoads)
+            load.get();
+        topoLoads.clear();
+        if (block + 1 < nBlocks)
+            loadTopoBlock(block + 1);
+        const std::valarray<double> & x = topoX[block % 2];
+        const std::valarray<double> & y = topoY[block % 2];
+        const std::valarray<double> & hgt = topoHgt[block % 2];
+        rgoff.resize(blockSize);
+        azoff.resize(blockSize);
 
         // Loop over DEM lines in block
         for (size_t blockLine = 0; blockLine < blockLength; ++blockLine) {
@@ -172,11 +206,16 @@ geo2rdr(isce3::io::Raster & topoRaster,
         } // end for loop lines in block
 
         // Write block of data
-        rgoffRaster.setBlock(rgoff, 0, lineStart, demWidth, blockLength);
-        azoffRaster.setBlock(azoff, 0, lineStart, demWidth, blockLength);
+        ioStream.store(rgoffRaster, &rgoff[0], 0, lineStart, demWidth,
+                       blockLength);
+        ioStream.store(azoffRaster, &azoff[0], 0, lineStart, demWidth,
+                       blockLength);
 
     } // end for loop blocks in DEM image
 
+    // Wait for the last blocks to be written
+    ioStream.synchronize();
+
     // Print out convergence statistics
     info << "Total convergence: " << converged << " out of "
          << (demWidth * demLength) << pyre::journal::endl;
@@ -3,6 +3,7 @@
 
 #include "RTC.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cmath>
@@ -14,7 +15,10 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <isce3/core/Constants.h>
 #include <isce3/core/DateTime.h>
@@ -25,10 +29,13 @@
 #include <isce3/core/TypeTraits.h>
 #include <isce3/error/ErrorCode.h>
 #include <isce3/geocode/GeocodeCov.h>
+#include <isce3/geocode/detail/AsyncBlockWriter.h>
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/RTCAreaCache.h>
 #include <isce3/geometry/boundingbox.h>
 #include <isce3/geometry/geometry.h>
 #include <isce3/geometry/loadDem.h>
+#include <isce3/io/RasterBlockCache.h>
 #include <isce3/product/GeoGridParameters.h>
 #include <isce3/product/RadarGridParameters.h>
 #include <isce3/signal/Looks.h>
@@ -130,6 +137,36 @@ void _applyRtc(isce3::io::Raster& input_raster, isce3::io::Raster& input_rtc,
     */
     using T_real = typename isce3::real<T>::type;
 
+    /*
+    Blocks are read and written through caches sharing a single lock
+    (the rasters may be datasets of the same file), so that threads only
+    wait on each other for GDAL accesses. The RTC area factors are only
+    read for the first band and then reused from the cache if they fit in
+    its memory budget.
+    */
+    std::mutex raster_mutex;
+    isce3::io::RasterBlockCache<float> input_rtc_cache(input_rtc,
+            block_length, isce3::io::RASTER_BLOCK_CACHE_DEFAULT_MEMORY_BUDGET,
+            2, 16, &raster_mutex);
+    std::unique_ptr<isce3::io::RasterBlockCache<T>> input_cache;
+    std::unique_ptr<isce3::io::RasterBlockCache<std::complex<T>>>
+            input_cache_complex;
+    if (!flag_complex_to_real_squared) {
+        input_cache = std::make_unique<isce3::io::RasterBlockCache<T>>(
+                input_raster, block_length,
+                isce3::io::RASTER_BLOCK_CACHE_DEFAULT_MEMORY_BUDGET, 2, 16,
+                &raster_mutex);
+    } else {
+        input_cache_complex = std::make_unique<
+                isce3::io::RasterBlockCache<std::complex<T>>>(input_raster,
+                block_length,
+                isce3::io::RASTER_BLOCK_CACHE_DEFAULT_MEMORY_BUDGET, 2, 16,
+                &raster_mutex);
+    }
+    isce3::io::RasterBlockCache<T> output_cache(output_raster, block_length,
+            isce3::io::RASTER_BLOCK_CACHE_DEFAULT_MEMORY_BUDGET, 0, 16,
+            &raster_mutex);
+
     // for each band in the input:
     for (size_t band = 0; band < nbands; ++band) {
         info << "applying RTC to band: " << band + 1 << "/" << nbands
@@ -147,20 +184,14 @@ void _applyRtc(isce3::io::Raster& input_raster, isce3::io::Raster& input_rtc,
             }
 
             isce3::core::Matrix<float> rtc_ratio(effective_block_length, width);
-            _Pragma("omp critical")
-            {
-                input_rtc.getBlock(rtc_ratio.data(), 0, block * block_length,
-                        width, effective_block_length, 1);
-            }
+            input_rtc_cache.getBlock(rtc_ratio.data(), 0, block * block_length,
+                    width, effective_block_length, 1);
 
             isce3::core::Matrix<T> radar_data_block(block_length, width);
             if (!flag_complex_to_real_squared) {
-                _Pragma("omp critical")
-                {
-                    input_raster.getBlock(radar_data_block.data(), 0,
-                            block * block_length, width, effective_block_length,
-                            band + 1);
-                }
+                input_cache->getBlock(radar_data_block.data(), 0,
+                        block * block_length, width, effective_block_length,
+                        band + 1);
                 for (int i = 0; i < effective_block_length; ++i)
                     for (int jj = 0; jj < width; ++jj) {
                         float rtc_ratio_value = rtc_ratio(i, jj);
@@ -185,12 +216,9 @@ void _applyRtc(isce3::io::Raster& input_raster, isce3::io::Raster& input_rtc,
             } else {
                 isce3::core::Matrix<std::complex<T>> radar_data_block_complex(
                         block_length, width);
-                _Pragma("omp critical")
-                {
-                    input_raster.getBlock(radar_data_block_complex.data(), 0,
-                            block * block_length, width, effective_block_length,
-                            band + 1);
-                }
+                input_cache_complex->getBlock(radar_data_block_complex.data(),
+                        0, block * block_length, width, effective_block_length,
+                        band + 1);
                 for (int i = 0; i < effective_block_length; ++i)
                     for (int jj = 0; jj < width; ++jj) {
                         float rtc_ratio_value = rtc_ratio(i, jj);
@@ -217,14 +245,15 @@ void _applyRtc(isce3::io::Raster& input_raster, isce3::io::Raster& input_rtc,
             }
 
             // set output
-            _Pragma("omp critical")
-            {
-                output_raster.setBlock(radar_data_block.data(), 0,
-                        block * block_length, width, effective_block_length,
-                        band + 1);
-            }
+            output_cache.setBlock(radar_data_block.data(), 0,
+                    block * block_length, width, effective_block_length,
+                    band + 1);
         }
     }
+
+    // write remaining blocks here rather than on destruction, so that
+    // errors are reported
+    output_cache.flush();
 }
 
 void _applyRtcMinValueDb(isce3::core::Matrix<float>& out_array,
@@ -406,7 +435,7 @@ void areaProjGetNBlocks(const int array_length, const int array_width,
         int* block_length_with_upsampling, int* block_length, int* nblocks_y,
         int* block_width_with_upsampling, int* block_width, int* nblocks_x,
         const int min_block_size, const long long max_block_size,
-        const int nblocks_per_thread)
+        const int nblocks_per_thread, const int nthreads)
 {
 
     int _nblocks_x = 0, _nblocks_y;
@@ -420,7 +449,7 @@ void areaProjGetNBlocks(const int array_length, const int array_width,
     bool flag_2d =
             (block_width != nullptr || block_width_with_upsampling != nullptr ||
                     nblocks_x != nullptr);
-    auto n_threads = _omp_thread_count();
+    auto n_threads = nthreads > 0 ? nthreads : _omp_thread_count();
     if (!flag_2d) {
         min_block_length = min_block_size / (nbands * array_width * type_size);
         max_block_length = max_block_size / (nbands * array_width * type_size);
@@ -635,19 +664,59 @@ void computeRtc(isce3::io::Raster& dem_raster, isce3::io::Raster& output_raster,
 
     const isce3::product::GeoGridParameters geogrid(
             x0, y0, dx, dy, geogrid_width, geogrid_length, epsg);
+
+    /*
+    The RTC area depends only on the geometry and on the RTC options, so it
+    is looked up in the RTC area cache (e.g. for each polarization of the
+    same frequency). Calls requesting auxiliary outputs always recompute.
+    The Raster view of a Matrix needs at least two lines and two columns.
+    */
+    const bool flag_use_cache = out_geo_rdr == nullptr &&
+                                out_geo_grid == nullptr &&
+                                out_nlooks == nullptr &&
+                                radar_grid.length() > 1 &&
+                                radar_grid.width() > 1 &&
+                                isRtcAreaCacheEnabled();
+    std::string cache_key;
+    std::shared_ptr<isce3::core::Matrix<float>> rtc_area;
+    std::unique_ptr<isce3::io::Raster> rtc_area_raster;
+    if (flag_use_cache) {
+        cache_key = getRtcAreaCacheKey(dem_raster, radar_grid, orbit,
+                input_dop, geogrid, input_terrain_radiometry,
+                output_terrain_radiometry, rtc_area_mode, rtc_algorithm,
+                geogrid_upsampling, rtc_min_value_db, radar_grid_nlooks,
+                interp_method, threshold, num_iter, delta_range);
+        if (loadRtcAreaFromCache(cache_key, output_raster))
+            return;
+
+        // compute the RTC area into a buffer that is stored in the cache
+        // without reading it back from the output raster
+        rtc_area = std::make_shared<isce3::core::Matrix<float>>(
+                radar_grid.length(), radar_grid.width());
+        rtc_area_raster = std::make_unique<isce3::io::Raster>(*rtc_area);
+    }
+    isce3::io::Raster& area_raster =
+            flag_use_cache ? *rtc_area_raster : output_raster;
+
     if (rtc_algorithm == rtcAlgorithm::RTC_AREA_PROJECTION) {
-        computeRtcAreaProj(dem_raster, output_raster, radar_grid, orbit,
+        computeRtcAreaProj(dem_raster, area_raster, radar_grid, orbit,
                 input_dop, geogrid, input_terrain_radiometry,
                 output_terrain_radiometry, rtc_area_mode, geogrid_upsampling,
                 rtc_min_value_db, radar_grid_nlooks, out_geo_rdr, out_geo_grid,
                 out_nlooks, rtc_memory_mode, interp_method, threshold, num_iter,
                 delta_range);
     } else {
-        computeRtcBilinearDistribution(dem_raster, output_raster, radar_grid,
+        computeRtcBilinearDistribution(dem_raster, area_raster, radar_grid,
                 orbit, input_dop, geogrid, input_terrain_radiometry,
                 output_terrain_radiometry, rtc_area_mode, geogrid_upsampling,
                 rtc_min_value_db);
     }
+
+    if (flag_use_cache) {
+        output_raster.setBlock(rtc_area->data(), 0, 0, radar_grid.width(),
+                radar_grid.length(), 1);
+        storeRtcAreaInCache(cache_key, std::move(rtc_area));
+    }
 }
 
 void areaProjIntegrateSegment(double y1, double y2, double x1, double x2,
@@ -734,13 +803,107 @@ void areaProjIntegrateSegment(double y1, double y2, double x1, double x2,
     }
 }
 
-void _addArea(double area, isce3::core::Matrix<float>& out_array,
-        float radar_grid_nlooks, isce3::core::Matrix<float>& out_nlooks_array,
-        int length, int width, int x_min, int y_min, int size_x, int size_y,
-        isce3::core::Matrix<double>& w_arr, double nlooks,
-        isce3::core::Matrix<double>& w_arr_out, double& nlooks_out,
-        double x_center, double x_left, double x_right, double y_center,
-        double y_left, double y_right, int plane_orientation)
+/** Radar-grid accumulator for the area (and number of looks) contributions
+ * of a single geogrid block of the area-projection algorithm.
+ *
+ * Each block owns its accumulator so that facets can be splatted without
+ * atomics or critical sections. Storage covers full radar-grid lines and is
+ * allocated on demand over the range of azimuth lines touched by the block,
+ * which is usually a small fraction of the radar grid. */
+class AreaProjBlockAccumulator {
+public:
+    AreaProjBlockAccumulator(int width, bool flag_nlooks) :
+        _width(width), _flag_nlooks(flag_nlooks) {}
+
+    /** Whether the number of looks is accumulated */
+    bool hasNlooks() const { return _flag_nlooks; }
+
+    /** First radar-grid line covered by the accumulator */
+    int firstLine() const { return _y0; }
+
+    /** Number of radar-grid lines covered by the accumulator */
+    int numLines() const { return _nlines; }
+
+    /** Pointer to the accumulated area of a radar-grid line */
+    const double* areaLine(int y) const
+    {
+        return _area.data() + static_cast<size_t>(y - _y0) * _width;
+    }
+
+    /** Pointer to the accumulated number of looks of a radar-grid line */
+    const double* nlooksLine(int y) const
+    {
+        return _nlooks.data() + static_cast<size_t>(y - _y0) * _width;
+    }
+
+    /** Add area and number of looks to radar-grid pixel (y, x) */
+    void add(int y, int x, double area, double nlooks)
+    {
+        if (y < _y0 || y >= _y0 + _nlines)
+            _grow(y);
+        const size_t index = static_cast<size_t>(y - _y0) * _width + x;
+        _area[index] += area;
+        if (_flag_nlooks)
+            _nlooks[index] += nlooks;
+    }
+
+    /** Release accumulated data */
+    void clear()
+    {
+        std::vector<double>().swap(_area);
+        std::vector<double>().swap(_nlooks);
+        _y0 = 0;
+        _nlines = 0;
+    }
+
+private:
+    // Extend line window to include line y, leaving some slack in the
+    // direction of growth to amortize reallocations
+    void _grow(int y)
+    {
+        int new_y0, new_y1;
+        if (_nlines == 0) {
+            new_y0 = y;
+            new_y1 = y + 1;
+        } else {
+            const int slack = std::max(_nlines / 2, 16);
+            new_y0 = std::min(_y0, y - (y < _y0 ? slack : 0));
+            new_y1 = std::max(_y0 + _nlines, y + 1 + (y >= _y0 ? slack : 0));
+        }
+        new_y0 = std::max(new_y0, 0);
+        const int new_nlines = new_y1 - new_y0;
+
+        auto grow_array = [&](std::vector<double>& array) {
+            std::vector<double> new_array(
+                    static_cast<size_t>(new_nlines) * _width, 0);
+            if (!array.empty()) {
+                std::copy(array.begin(), array.end(),
+                        new_array.begin() +
+                                static_cast<size_t>(_y0 - new_y0) * _width);
+            }
+            array.swap(new_array);
+        };
+        grow_array(_area);
+        if (_flag_nlooks)
+            grow_array(_nlooks);
+        _y0 = new_y0;
+        _nlines = new_nlines;
+    }
+
+    int _width;
+    bool _flag_nlooks;
+    int _y0 = 0;
+    int _nlines = 0;
+    std::vector<double> _area;
+    std::vector<double> _nlooks;
+};
+
+void _addArea(double area, AreaProjBlockAccumulator& accumulator,
+        float radar_grid_nlooks, int length, int width, int x_min, int y_min,
+        int size_x, int size_y, isce3::core::Matrix<double>& w_arr,
+        double nlooks, isce3::core::Matrix<double>& w_arr_out,
+        double& nlooks_out, double x_center, double x_left, double x_right,
+        double y_center, double y_left, double y_right, int plane_orientation)
 {
     areaProjIntegrateSegment(y_left, y_right, x_left, x_right, size_y, size_x,
             w_arr, nlooks, plane_orientation);
@@ -762,13 +925,12 @@ void _addArea(double area, isce3::core::Matrix<float>& out_array,
 
             if (x < 0 || y < 0 || y >= length || x >= width)
                 continue;
-            if (out_nlooks_array.data() != nullptr) {
-                const auto out_nlooks =
+            double out_nlooks = 0;
+            if (accumulator.hasNlooks())
+                out_nlooks =
                         radar_grid_nlooks * std::abs(w * (nlooks - nlooks_out));
-                _Pragma("omp atomic") out_nlooks_array(y, x) += out_nlooks;
-            }
             w /= nlooks - nlooks_out;
-            _Pragma("omp atomic") out_array(y, x) += w * area;
+            accumulator.add(y, x, w * area, out_nlooks);
         }
 }
 
@@ -1113,15 +1275,15 @@ void _RunBlock(const int jmax, const int block_size,
         const double geogrid_upsampling,
         isce3::core::dataInterpMethod interp_method,
         isce3::io::Raster& dem_raster, isce3::io::Raster* out_geo_rdr,
-        isce3::io::Raster* out_geo_grid, const double start,
+        isce3::io::Raster* out_geo_grid,
+        isce3::geocode::detail::AsyncBlockWriter& writer, const double start,
         const double pixazm, const double dr, double r0, int xbound, int ybound,
         const isce3::product::GeoGridParameters& geogrid,
         const isce3::product::RadarGridParameters& radar_grid,
         const isce3::core::LUT2d<double>& dop,
         const isce3::core::Ellipsoid& ellipsoid,
         const isce3::core::Orbit& orbit, double threshold, int num_iter,
-        double delta_range, isce3::core::Matrix<float>& out_array,
-        isce3::core::Matrix<float>& out_nlooks_array,
+        double delta_range, AreaProjBlockAccumulator& accumulator,
         isce3::core::ProjectionBase* proj, rtcAreaMode rtc_area_mode,
         rtcInputTerrainRadiometry input_terrain_radiometry,
         rtcOutputTerrainRadiometry output_terrain_radiometry,
@@ -1507,7 +1669,7 @@ void _RunBlock(const int jmax, const int block_size,
                     computeFacet(xyz_c, xyz00, xyz01, target_to_sensor_xyz,
                             p00_c, p01_c, divisor, output_terrain_radiometry);
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, accumulator, radar_grid_nlooks,
                     radar_grid.length(), radar_grid.width(), x_min, y_min,
                     size_x, size_y, w_arr_1, nlooks_1, w_arr_2, nlooks_2,
                     x_c_cut, x00_cut, x01_cut, y_c_cut, y00_cut, y01_cut,
@@ -1518,7 +1680,7 @@ void _RunBlock(const int jmax, const int block_size,
                     p01_c, p11_c, divisor, output_terrain_radiometry);
 
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, accumulator, radar_grid_nlooks,
                     radar_grid.length(), radar_grid.width(), x_min, y_min,
                     size_x, size_y, w_arr_2, nlooks_2, w_arr_1, nlooks_1,
                     x_c_cut, x01_cut, x11_cut, y_c_cut, y01_cut, y11_cut,
@@ -1529,7 +1691,7 @@ void _RunBlock(const int jmax, const int block_size,
                     p11_c, p10_c, divisor, output_terrain_radiometry);
 
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, accumulator, radar_grid_nlooks,
                     radar_grid.length(), radar_grid.width(), x_min, y_min,
                     size_x, size_y, w_arr_1, nlooks_1, w_arr_2, nlooks_2,
                     x_c_cut, x11_cut, x10_cut, y_c_cut, y11_cut, y10_cut,
@@ -1540,7 +1702,7 @@ void _RunBlock(const int jmax, const int block_size,
                     p10_c, p00_c, divisor, output_terrain_radiometry);
 
             // Add area to output grid
-            _addArea(area, out_array, radar_grid_nlooks, out_nlooks_array,
+            _addArea(area, accumulator, radar_grid_nlooks,
                     radar_grid.length(), radar_grid.width(), x_min, y_min,
                     size_x, size_y, w_arr_2, nlooks_2, w_arr_1, nlooks_1,
                     x_c_cut, x10_cut, x00_cut, y_c_cut, y10_cut, y00_cut,
@@ -1548,27 +1710,46 @@ void _RunBlock(const int jmax, const int block_size,
         }
     }
 
-    if (out_geo_rdr != nullptr)
-        _Pragma("omp critical")
-        {
-            out_geo_rdr->setBlock(out_geo_rdr_a.data(), 0,
-                    block * block_size_with_upsampling, jmax + 1,
-                    this_block_size_with_upsampling + 1, 1);
-            out_geo_rdr->setBlock(out_geo_rdr_r.data(), 0,
-                    block * block_size_with_upsampling, jmax + 1,
-                    this_block_size_with_upsampling + 1, 2);
-        }
+    // Hand the blocks over to the I/O thread so that the writes overlap the
+    // computation of the following blocks
+    if (out_geo_rdr != nullptr) {
+        writer.setBlock(*out_geo_rdr, std::move(out_geo_rdr_a), 0,
+                block * block_size_with_upsampling, jmax + 1,
+                this_block_size_with_upsampling + 1, 1);
+        writer.setBlock(*out_geo_rdr, std::move(out_geo_rdr_r), 0,
+                block * block_size_with_upsampling, jmax + 1,
+                this_block_size_with_upsampling + 1, 2);
+    }
 
-    if (out_geo_grid != nullptr)
-        _Pragma("omp critical")
-        {
-            out_geo_grid->setBlock(out_geo_grid_a.data(), 0,
-                    block * block_size_with_upsampling, jmax, this_block_size,
-                    1);
-            out_geo_grid->setBlock(out_geo_grid_r.data(), 0,
-                    block * block_size_with_upsampling, jmax, this_block_size,
-                    2);
-        }
+    if (out_geo_grid != nullptr) {
+        writer.setBlock(*out_geo_grid, std::move(out_geo_grid_a), 0,
+                block * block_size_with_upsampling, jmax, this_block_size, 1);
+        writer.setBlock(*out_geo_grid, std::move(out_geo_grid_r), 0,
+                block * block_size_with_upsampling, jmax, this_block_size, 2);
+    }
+}
+
+/** Add the contributions held by a block accumulator to the output arrays
+ * and release them */
+void _mergeAccumulator(AreaProjBlockAccumulator& accumulator,
+        isce3::core::Matrix<float>& out_array,
+        isce3::core::Matrix<float>& out_nlooks_array)
+{
+    const int y0 = accumulator.firstLine();
+    const int y1 = std::min(y0 + accumulator.numLines(),
+            static_cast<int>(out_array.length()));
+    const int width = out_array.width();
+    for (int y = y0; y < y1; ++y) {
+        const double* block_area = accumulator.areaLine(y);
+        for (int x = 0; x < width; ++x)
+            out_array(y, x) += block_area[x];
+        if (!accumulator.hasNlooks())
+            continue;
+        const double* block_nlooks = accumulator.nlooksLine(y);
+        for (int x = 0; x < width; ++x)
+            out_nlooks_array(y, x) += block_nlooks[x];
+    }
+    accumulator.clear();
 }
 
 void computeRtcAreaProj(isce3::io::Raster& dem_raster,
@@ -1585,7 +1766,8 @@ void computeRtcAreaProj(isce3::io::Raster& dem_raster,
         isce3::io::Raster* out_nlooks,
         isce3::core::MemoryModeBlockY rtc_memory_mode,
         isce3::core::dataInterpMethod interp_method, double threshold,
-        int num_iter, double delta_range)
+        int num_iter, double delta_range, const int min_block_size,
+        const long long max_block_size)
 {
     /*
       Description of the area projection algorithm can be found in Geocode.cpp
@@ -1657,28 +1839,61 @@ void computeRtcAreaProj(isce3::io::Raster& dem_raster,
         block_length_with_upsampling = imax;
         block_length = geogrid.length();
     } else {
+        // Blocks are also the units in which the contributions are summed
+        // (see below), so their size must not depend on the number of
+        // threads for the output to be reproducible
         const int out_nbands = 1;
         areaProjGetNBlocks(imax, jmax, out_nbands, sizeof(T), &info,
                 geogrid_upsampling, &block_length_with_upsampling,
-                &block_length, &nblocks);
+                &block_length, &nblocks, nullptr, nullptr, nullptr,
+                min_block_size, max_block_size, AP_NBLOCKS_PER_THREAD,
+                AP_NOMINAL_THREADS);
     }
 
     info << "block length (with upsampling): " << block_length_with_upsampling
          << pyre::journal::endl;
 
-    _Pragma("omp parallel for schedule(dynamic)") for (int block = 0;
-                                                       block < nblocks; ++block)
-    {
+    /*
+    Each block splats its facets into its own accumulator, so the parallel
+    loop below has no shared writes. As blocks finish, the accumulators are
+    merged into the output arrays in block order and released, so that only
+    the blocks that finished ahead of an earlier, slower block hold memory
+    and the sums do not depend on the number of threads or on the block
+    scheduling.
+    */
+    std::vector<AreaProjBlockAccumulator> block_accumulators(nblocks,
+            AreaProjBlockAccumulator(
+                    radar_grid.width(), out_nlooks != nullptr));
+    std::vector<char> block_done(nblocks, 0);
+    int next_block_to_merge = 0;
+    std::mutex merge_mutex;
+
+    isce3::geocode::detail::AsyncBlockWriter writer;
+
+    _Pragma("omp parallel for schedule(dynamic)")
+    for (int block = 0; block < nblocks; ++block) {
         _RunBlock(jmax, block_length, block_length_with_upsampling, block,
                 numdone, progress_block, geogrid_upsampling, interp_method,
-                dem_raster, out_geo_rdr, out_geo_grid, start, pixazm, dr, r0,
-                xbound, ybound, geogrid, radar_grid, input_dop, ellipsoid,
-                orbit, threshold, num_iter, delta_range, out_array,
-                out_nlooks_array, proj.get(), rtc_area_mode,
+                dem_raster, out_geo_rdr, out_geo_grid, writer, start, pixazm,
+                dr, r0, xbound, ybound, geogrid, radar_grid, input_dop,
+                ellipsoid, orbit, threshold, num_iter, delta_range,
+                block_accumulators[block], proj.get(), rtc_area_mode,
                 input_terrain_radiometry, output_terrain_radiometry,
                 radar_grid_nlooks);
+
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        block_done[block] = 1;
+        while (next_block_to_merge < nblocks &&
+                block_done[next_block_to_merge]) {
+            _mergeAccumulator(block_accumulators[next_block_to_merge],
+                    out_array, out_nlooks_array);
+            ++next_block_to_merge;
+        }
     }
 
+    // Wait for the radar-grid position rasters
+    writer.finish();
+
     printf("\rRTC progress: 100%%\n");
     std::cout << std::endl;
 
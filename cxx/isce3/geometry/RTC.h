@@ -32,6 +32,10 @@ enum rtcOutputTerrainRadiometry {
 
 constexpr static int AP_DEFAULT_MIN_BLOCK_SIZE = 1 << 22;       // 4MB
 constexpr static long long AP_DEFAULT_MAX_BLOCK_SIZE = 1 << 28; // 256MB
+constexpr static int AP_NBLOCKS_PER_THREAD = 4;
+// Number of threads assumed when the blocking must not depend on the
+// actual number of threads
+constexpr static int AP_NOMINAL_THREADS = 64;
 
 /**Enumeration type to indicate RTC area mode (AREA or AREA_FACTOR) */
 enum rtcAreaMode { AREA = 0, AREA_FACTOR = 1 };
@@ -305,6 +309,12 @@ void computeRtcBilinearDistribution(isce3::io::Raster& dem_raster,
  * @param[in] num_iter             Maximum number of Newton-Raphson iterations
  * @param[in] delta_range          Step size used for computing derivative of
  * doppler
+ * @param[in] min_block_size       Minimum block size in Bytes
+ * @param[in] max_block_size       Maximum block size in Bytes
+ *
+ * The blocking does not depend on the number of threads and contributions
+ * are summed in block order, so the output is the same for any number of
+ * threads.
  * */
 void computeRtcAreaProj(isce3::io::Raster& dem,
         isce3::io::Raster& output_raster,
@@ -325,7 +335,9 @@ void computeRtcAreaProj(isce3::io::Raster& dem,
                 isce3::core::MemoryModeBlockY::AutoBlocksY,
         isce3::core::dataInterpMethod interp_method =
                 isce3::core::dataInterpMethod::BIQUINTIC_METHOD,
-        double threshold = 1e-8, int num_iter = 100, double delta_range = 1e-8);
+        double threshold = 1e-8, int num_iter = 100, double delta_range = 1e-8,
+        const int min_block_size = AP_DEFAULT_MIN_BLOCK_SIZE,
+        const long long max_block_size = AP_DEFAULT_MAX_BLOCK_SIZE);
 
 void areaProjIntegrateSegment(double y1, double y2, double x1, double x2,
         int length, int width, isce3::core::Matrix<double>& w_arr,
@@ -352,6 +364,8 @@ std::string getNbytesStr(long long nbytes);
  * @param[in]  max_block_size               Maximum block size in Bytes (per
  * thread)
  * @param[in]  nblocks_per_thread           Target number of blocks per thread
+ * @param[in]  nthreads                     Number of threads to plan for. If
+ * not positive, the maximum number of OpenMP threads is used.
  */
 void areaProjGetNBlocks(const int array_length, const int array_width,
         const int nbands = 1,
@@ -363,7 +377,8 @@ void areaProjGetNBlocks(const int array_length, const int array_width,
         int* nblock_x = nullptr,
         const int min_block_size = AP_DEFAULT_MIN_BLOCK_SIZE,
         const long long max_block_size = AP_DEFAULT_MAX_BLOCK_SIZE,
-        const int nblocks_per_thread = 4);
+        const int nblocks_per_thread = AP_NBLOCKS_PER_THREAD,
+        const int nthreads = 0);
 
 double computeUpsamplingFactor(const DEMInterpolator& dem_interp,
         const isce3::product::RadarGridParameters& radar_grid,
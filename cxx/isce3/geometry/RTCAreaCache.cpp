@@ -0,0 +1,396 @@
+#include "RTCAreaCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <cpl_string.h>
+#include <cpl_vsi.h>
+#include <pyre/journal.h>
+
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Matrix.h>
+#include <isce3/core/Orbit.h>
+#include <isce3/except/Error.h>
+#include <isce3/io/Raster.h>
+#include <isce3/product/GeoGridParameters.h>
+#include <isce3/product/RadarGridParameters.h>
+
+namespace isce3 { namespace geometry {
+
+namespace {
+
+/** 64-bit FNV-1a hash accumulator */
+class Fnv1aHash {
+public:
+    void update(const void* data, std::size_t nbytes)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < nbytes; ++i) {
+            _state ^= bytes[i];
+            _state *= 1099511628211ULL;
+        }
+    }
+
+    template<typename T>
+    void update(const T& value)
+    {
+        update(&value, sizeof(T));
+    }
+
+    void update(const std::string& str)
+    {
+        const std::uint64_t size = str.size();
+        update(size);
+        update(str.data(), str.size());
+    }
+
+    std::string hexdigest() const
+    {
+        std::ostringstream oss;
+        oss << std::hex << std::setw(16) << std::setfill('0') << _state;
+        return oss.str();
+    }
+
+private:
+    std::uint64_t _state = 14695981039346656037ULL;
+};
+
+// Maximum number of DEM lines sampled to fingerprint the heights of DEMs
+// backed by files. Edits to lines left out of the sample are caught by the
+// modification time of the files.
+constexpr int DEM_FINGERPRINT_MAX_LINES = 1024;
+
+struct CacheEntry {
+    std::string key;
+    std::shared_ptr<const isce3::core::Matrix<float>> data;
+};
+
+// In-memory LRU cache (most recently used entries at the front)
+struct RtcAreaCacheState {
+    std::mutex mutex;
+    std::list<CacheEntry> entries;
+    std::size_t nbytes = 0;
+    std::size_t memory_budget = 0;
+    std::size_t hits = 0;
+    std::string directory;
+};
+
+RtcAreaCacheState& cacheState()
+{
+    static RtcAreaCacheState state;
+    return state;
+}
+
+std::size_t entryBytes(const isce3::core::Matrix<float>& data)
+{
+    return data.size() * sizeof(float);
+}
+
+// Evict least recently used entries until the cache fits its budget.
+// Caller must hold the cache mutex.
+void evictToBudget(RtcAreaCacheState& state)
+{
+    while (!state.entries.empty() && state.nbytes > state.memory_budget) {
+        state.nbytes -= entryBytes(*state.entries.back().data);
+        state.entries.pop_back();
+    }
+}
+
+void insertInMemory(const std::string& key,
+        std::shared_ptr<const isce3::core::Matrix<float>> data)
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (entryBytes(*data) > state.memory_budget)
+        return;
+    auto it = std::find_if(state.entries.begin(), state.entries.end(),
+            [&](const CacheEntry& entry) { return entry.key == key; });
+    if (it != state.entries.end()) {
+        state.nbytes -= entryBytes(*it->data);
+        state.entries.erase(it);
+    }
+    state.nbytes += entryBytes(*data);
+    state.entries.push_front({key, std::move(data)});
+    evictToBudget(state);
+}
+
+std::shared_ptr<const isce3::core::Matrix<float>> findInMemory(
+        const std::string& key)
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = std::find_if(state.entries.begin(), state.entries.end(),
+            [&](const CacheEntry& entry) { return entry.key == key; });
+    if (it == state.entries.end())
+        return nullptr;
+    // move to front (most recently used)
+    state.entries.splice(state.entries.begin(), state.entries, it);
+    return state.entries.front().data;
+}
+
+std::string cacheFilename(const std::string& directory, const std::string& key)
+{
+    return directory + "/rtc_area_" + key + ".tif";
+}
+
+bool fileExists(const std::string& filename)
+{
+    std::ifstream f(filename);
+    return f.good();
+}
+
+} // namespace
+
+std::string getRtcAreaCacheKey(isce3::io::Raster& dem_raster,
+        const isce3::product::RadarGridParameters& radar_grid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& input_dop,
+        const isce3::product::GeoGridParameters& geogrid,
+        rtcInputTerrainRadiometry input_terrain_radiometry,
+        rtcOutputTerrainRadiometry output_terrain_radiometry,
+        rtcAreaMode rtc_area_mode, rtcAlgorithm rtc_algorithm,
+        double geogrid_upsampling, float rtc_min_value_db,
+        float radar_grid_nlooks, isce3::core::dataInterpMethod interp_method,
+        double threshold, int num_iter, double delta_range)
+{
+    Fnv1aHash hash;
+
+    // radar grid
+    hash.update(radar_grid.refEpoch().isoformat());
+    hash.update(radar_grid.sensingStart());
+    hash.update(radar_grid.wavelength());
+    hash.update(radar_grid.prf());
+    hash.update(radar_grid.startingRange());
+    hash.update(radar_grid.rangePixelSpacing());
+    hash.update(static_cast<int>(radar_grid.lookSide()));
+    hash.update(static_cast<std::uint64_t>(radar_grid.length()));
+    hash.update(static_cast<std::uint64_t>(radar_grid.width()));
+
+    // orbit
+    hash.update(orbit.referenceEpoch().isoformat());
+    hash.update(static_cast<int>(orbit.interpMethod()));
+    hash.update(orbit.size());
+    for (int i = 0; i < orbit.size(); ++i) {
+        hash.update(orbit.time()[i]);
+        hash.update(orbit.position(i).data(), 3 * sizeof(double));
+        hash.update(orbit.velocity(i).data(), 3 * sizeof(double));
+    }
+
+    // Doppler
+    hash.update(input_dop.haveData());
+    hash.update(input_dop.refValue());
+    if (input_dop.haveData()) {
+        hash.update(input_dop.xStart());
+        hash.update(input_dop.yStart());
+        hash.update(input_dop.xSpacing());
+        hash.update(input_dop.ySpacing());
+        hash.update(input_dop.boundsError());
+        hash.update(static_cast<int>(input_dop.interpMethod()));
+        hash.update(static_cast<std::uint64_t>(input_dop.length()));
+        hash.update(static_cast<std::uint64_t>(input_dop.width()));
+        hash.update(input_dop.data().data(),
+                input_dop.data().size() * sizeof(double));
+    }
+
+    // geogrid
+    hash.update(geogrid.startX());
+    hash.update(geogrid.startY());
+    hash.update(geogrid.spacingX());
+    hash.update(geogrid.spacingY());
+    hash.update(geogrid.width());
+    hash.update(geogrid.length());
+    hash.update(geogrid.epsg());
+
+    // RTC options
+    hash.update(static_cast<int>(input_terrain_radiometry));
+    hash.update(static_cast<int>(output_terrain_radiometry));
+    hash.update(static_cast<int>(rtc_area_mode));
+    hash.update(static_cast<int>(rtc_algorithm));
+    hash.update(geogrid_upsampling);
+    hash.update(rtc_min_value_db);
+    hash.update(radar_grid_nlooks);
+    hash.update(static_cast<int>(interp_method));
+    hash.update(threshold);
+    hash.update(num_iter);
+    hash.update(delta_range);
+
+    // DEM: identity, geolocation and a sample of its heights
+    hash.update(std::string(dem_raster.dataset()->GetDescription()));
+    hash.update(static_cast<std::uint64_t>(dem_raster.width()));
+    hash.update(static_cast<std::uint64_t>(dem_raster.length()));
+    double geotransform[6];
+    dem_raster.getGeoTransform(geotransform);
+    hash.update(geotransform, sizeof(geotransform));
+    hash.update(dem_raster.getEPSG());
+
+    // size and modification time of the files backing the DEM
+    char** dem_files = dem_raster.dataset()->GetFileList();
+    const int n_dem_files = CSLCount(dem_files);
+    hash.update(n_dem_files);
+    for (int i = 0; i < n_dem_files; ++i) {
+        hash.update(std::string(dem_files[i]));
+        VSIStatBufL stat_buf;
+        if (VSIStatL(dem_files[i], &stat_buf) == 0) {
+            hash.update(static_cast<std::int64_t>(stat_buf.st_size));
+            hash.update(static_cast<std::int64_t>(stat_buf.st_mtime));
+        }
+    }
+    CSLDestroy(dem_files);
+
+    // heights: every line of in-memory DEMs, a strided sample of lines
+    // otherwise
+    const int dem_length = dem_raster.length();
+    const int line_stride = (n_dem_files == 0) ? 1 :
+            (dem_length + DEM_FINGERPRINT_MAX_LINES - 1) /
+                    DEM_FINGERPRINT_MAX_LINES;
+    std::vector<float> dem_line(dem_raster.width());
+    for (int line = 0; line < dem_length; line += line_stride) {
+        dem_raster.getLine(dem_line.data(), line, dem_line.size());
+        hash.update(dem_line.data(), dem_line.size() * sizeof(float));
+    }
+    if ((dem_length - 1) % line_stride != 0) {
+        dem_raster.getLine(dem_line.data(), dem_length - 1, dem_line.size());
+        hash.update(dem_line.data(), dem_line.size() * sizeof(float));
+    }
+
+    return hash.hexdigest();
+}
+
+void setRtcAreaCacheMemoryBudget(std::size_t nbytes)
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.memory_budget = nbytes;
+    evictToBudget(state);
+}
+
+std::size_t getRtcAreaCacheMemoryBudget()
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.memory_budget;
+}
+
+void setRtcAreaCacheDirectory(const std::string& path)
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.directory = path;
+}
+
+std::string getRtcAreaCacheDirectory()
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.directory;
+}
+
+bool isRtcAreaCacheEnabled()
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.memory_budget > 0 || !state.directory.empty();
+}
+
+void clearRtcAreaCache()
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.entries.clear();
+    state.nbytes = 0;
+    state.hits = 0;
+}
+
+std::size_t getRtcAreaCacheHitCount()
+{
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.hits;
+}
+
+bool loadRtcAreaFromCache(
+        const std::string& key, isce3::io::Raster& output_raster)
+{
+    pyre::journal::info_t info("isce.geometry.RTCAreaCache");
+
+    auto data = findInMemory(key);
+
+    // fall back to the on-disk cache
+    if (data == nullptr) {
+        const std::string directory = getRtcAreaCacheDirectory();
+        if (directory.empty())
+            return false;
+        const std::string filename = cacheFilename(directory, key);
+        if (!fileExists(filename))
+            return false;
+
+        isce3::io::Raster cached_raster(filename);
+        auto cached_data = std::make_shared<isce3::core::Matrix<float>>(
+                cached_raster.length(), cached_raster.width());
+        cached_raster.getBlock(cached_data->data(), 0, 0,
+                cached_raster.width(), cached_raster.length(), 1);
+        info << "RTC area loaded from disk cache: " << filename
+             << pyre::journal::newline;
+        insertInMemory(key, cached_data);
+        data = cached_data;
+    } else {
+        info << "RTC area loaded from memory cache (key: " << key << ")"
+             << pyre::journal::newline;
+    }
+
+    if (static_cast<size_t>(data->width()) != output_raster.width() ||
+            static_cast<size_t>(data->length()) != output_raster.length()) {
+        std::string error_msg = "cached RTC area dimensions do not match the"
+                                " output raster dimensions";
+        throw isce3::except::LengthError(ISCE_SRCINFO(), error_msg);
+    }
+
+    // setBlock() takes a non-const buffer but does not modify it
+    output_raster.setBlock(const_cast<float*>(data->data()), 0, 0,
+            data->width(), data->length(), 1);
+    info << pyre::journal::endl;
+
+    auto& state = cacheState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    ++state.hits;
+    return true;
+}
+
+void storeRtcAreaInCache(const std::string& key,
+        std::shared_ptr<const isce3::core::Matrix<float>> rtc_area)
+{
+    if (getRtcAreaCacheMemoryBudget() > 0)
+        insertInMemory(key, rtc_area);
+
+    const std::string directory = getRtcAreaCacheDirectory();
+    if (directory.empty())
+        return;
+
+    // write to a temporary file and rename it so that concurrent readers
+    // never see a partially written raster
+    const std::string filename = cacheFilename(directory, key);
+    const std::string tmp_filename = filename + ".tmp";
+    {
+        isce3::io::Raster cached_raster(tmp_filename, rtc_area->width(),
+                rtc_area->length(), 1, GDT_Float32, "GTiff");
+        cached_raster.setBlock(const_cast<float*>(rtc_area->data()), 0, 0,
+                rtc_area->width(), rtc_area->length(), 1);
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        pyre::journal::warning_t warning("isce.geometry.RTCAreaCache");
+        warning << "could not save RTC area to disk cache: " << filename
+                << pyre::journal::endl;
+        std::remove(tmp_filename.c_str());
+    }
+}
+
+}} // namespace isce3::geometry
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <isce3/core/forward.h>
+#include <isce3/io/forward.h>
+#include <isce3/product/forward.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <isce3/core/Constants.h>
+
+#include "RTC.h"
+
+namespace isce3 { namespace geometry {
+
+/** Compute the key identifying an RTC area normalization factor
+ *
+ * The key is a hash of everything that determines the RTC area: radar
+ * grid, orbit state vectors, Doppler LUT, geogrid, RTC options and the
+ * DEM. DEMs backed by files are identified by their dataset description,
+ * dimensions, geotransform, EPSG, the size and modification time of their
+ * files and a strided sample of their heights; in-memory DEMs by all of
+ * their heights. Two calls sharing a key produce identical RTC rasters, e.g.
+ * the polarizations of a GCOV frequency.
+ *
+ * @param[in]  dem_raster          Input DEM raster
+ * @param[in]  radar_grid          Radar Grid
+ * @param[in]  orbit               Orbit
+ * @param[in]  input_dop           Doppler LUT
+ * @param[in]  geogrid             Geogrid used to integrate the DEM facets
+ * @param[in]  input_terrain_radiometry  Input terrain radiometry
+ * @param[in]  output_terrain_radiometry Output terrain radiometry
+ * @param[in]  rtc_area_mode       RTC area mode (AREA or AREA_FACTOR)
+ * @param[in]  rtc_algorithm       RTC algorithm
+ * @param[in]  geogrid_upsampling  Geogrid upsampling (in each direction)
+ * @param[in]  rtc_min_value_db    Minimum value for the RTC area
+ * normalization factor
+ * @param[in]  radar_grid_nlooks   Radar grid number of looks
+ * @param[in]  interp_method       DEM interpolation method
+ * @param[in]  threshold           Azimuth time threshold for convergence (s)
+ * @param[in]  num_iter            Maximum number of Newton-Raphson iterations
+ * @param[in]  delta_range         Step size used for computing Doppler
+ * derivative
+ * @returns Hexadecimal key
+ */
+std::string getRtcAreaCacheKey(isce3::io::Raster& dem_raster,
+        const isce3::product::RadarGridParameters& radar_grid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::LUT2d<double>& input_dop,
+        const isce3::product::GeoGridParameters& geogrid,
+        rtcInputTerrainRadiometry input_terrain_radiometry,
+        rtcOutputTerrainRadiometry output_terrain_radiometry,
+        rtcAreaMode rtc_area_mode, rtcAlgorithm rtc_algorithm,
+        double geogrid_upsampling, float rtc_min_value_db,
+        float radar_grid_nlooks, isce3::core::dataInterpMethod interp_method,
+        double threshold, int num_iter, double delta_range);
+
+/** Set the memory budget (in bytes) of the in-memory RTC area cache.
+ *
+ * Least-recently used entries are evicted when the budget is exceeded. A
+ * budget of zero (default) disables the in-memory cache. */
+void setRtcAreaCacheMemoryBudget(std::size_t nbytes);
+
+/** Get the memory budget (in bytes) of the in-memory RTC area cache */
+std::size_t getRtcAreaCacheMemoryBudget();
+
+/** Set the directory of the on-disk RTC area cache.
+ *
+ * RTC area rasters are stored as GeoTIFF files named after their key and
+ * persist across processes, e.g. for repeat-pass frames on the same track.
+ * An empty path (default) disables the on-disk cache. */
+void setRtcAreaCacheDirectory(const std::string& path);
+
+/** Get the directory of the on-disk RTC area cache */
+std::string getRtcAreaCacheDirectory();
+
+/** Whether either the in-memory or the on-disk cache is enabled */
+bool isRtcAreaCacheEnabled();
+
+/** Drop all entries of the in-memory RTC area cache and reset its hit
+ * count */
+void clearRtcAreaCache();
+
+/** Number of RTC areas served from the cache since it was last cleared */
+std::size_t getRtcAreaCacheHitCount();
+
+/** Copy a cached RTC area into a raster
+ *
+ * @param[in]  key                 Cache key
+ * @param[out] output_raster       Output raster (band 1)
+ * @returns True if the key was found in the cache
+ */
+bool loadRtcAreaFromCache(
+        const std::string& key, isce3::io::Raster& output_raster);
+
+/** Store an RTC area in the cache
+ *
+ * The in-memory cache shares the buffer rather than copying it.
+ *
+ * @param[in]  key                 Cache key
+ * @param[in]  rtc_area            RTC area
+ */
+void storeRtcAreaInCache(const std::string& key,
+        std::shared_ptr<const isce3::core::Matrix<float>> rtc_area);
+
+}} // namespace isce3::geometry
@@ -8,7 +8,9 @@
 #include "boundingbox.h"
 
 // cassert for assert()
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 // pyre::journal
 #include <pyre/journal.h>
@@ -409,4 +411,29 @@ isce3::geometry::BoundingBox isce3::geometry::getGeoBoundingBoxHeightSearch(
 
     return bbox_min;
 }
+
+isce3::geometry::BoundingBox isce3::geometry::getGeoBoundingBoxHeightSearch(
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::core::Orbit& orbit, const isce3::core::ProjectionBase* proj,
+        const isce3::core::LUT2d<double>& doppler,
+        const DEMInterpolator& demInterp, const double margin,
+        const int pointsPerEdge, const double threshold, const int numiter,
+        const double height_threshold) {
+
+    // Restrict the search to the heights actually spanned by the DEM. The
+    // pyramid query over the full DEM extent reads a single summary cell.
+    float min_hgt, max_hgt, mean_hgt;
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    demInterp.computeHeightStats(min_hgt, max_hgt, mean_hgt, -inf, inf,
+                                 -inf, inf);
+
+    const double min_height = std::max(isce3::core::GLOBAL_MIN_HEIGHT,
+            static_cast<double>(min_hgt) - height_threshold);
+    const double max_height = std::min(isce3::core::GLOBAL_MAX_HEIGHT,
+            static_cast<double>(max_hgt) + height_threshold);
+
+    return getGeoBoundingBoxHeightSearch(radarGrid, orbit, proj, doppler,
+            std::min(min_height, max_height), max_height, margin,
+            pointsPerEdge, threshold, numiter, height_threshold);
+}
 //end of file
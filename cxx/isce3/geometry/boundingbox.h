@@ -107,6 +107,38 @@ BoundingBox getGeoBoundingBoxHeightSearch(
         const double margin = 0.0, const int pointsPerEdge = 11,
         const double threshold = 1.0e-8, const int numiter = 15,
         const double height_threshold = 100);
+
+/** Compute bounding box with auto search within the height interval
+ * spanned by a DEM
+ *
+ * The min/ max heights are read from the height pyramid of the DEM
+ * interpolator (padded by height_threshold and clipped to the global
+ * height bounds) instead of searching the global height interval. If the
+ * interpolator has no raster loaded, its reference height is used.
+ *
+ * @param[in] radarGrid    RadarGridParameters object
+ * @param[in] orbit         Orbit object
+ * @param[in] proj          ProjectionBase object indicating desired
+ * projection of output.
+ * @param[in] doppler       LUT2d doppler model
+ * @param[in] demInterp     DEM interpolator
+ * @param[in] margin        Margin to add to estimated bounding box in
+ * decimal degrees
+ * @param[in] pointsPerEge  Number of points to use on each edge of radar
+ * grid
+ * @param[in] threshold     Slant range threshold for convergence
+ * @param[in] numiter       Max number of iterations for convergence
+ * @param[in] height_threshold Height threshold for convergence
+ * The output of this method is an OGREnvelope.
+ */
+BoundingBox getGeoBoundingBoxHeightSearch(
+        const isce3::product::RadarGridParameters& radarGrid,
+        const isce3::core::Orbit& orbit,
+        const isce3::core::ProjectionBase* proj,
+        const isce3::core::LUT2d<double>& doppler,
+        const DEMInterpolator& demInterp, const double margin = 0.0,
+        const int pointsPerEdge = 11, const double threshold = 1.0e-8,
+        const int numiter = 15, const double height_threshold = 100);
 }
 }
 //end of file
@@ -0,0 +1,85 @@
+#include "HeightStatsPyramid.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace isce3 { namespace geometry { namespace detail {
+
+HeightStatsPyramid::HeightStatsPyramid(const float* data, std::size_t length,
+                                       std::size_t width,
+                                       std::size_t leaf_size)
+    : _length(length), _width(width), _leafSize(leaf_size)
+{
+    if (leaf_size == 0) {
+        throw std::invalid_argument("leaf size must be positive");
+    }
+    if (length == 0 || width == 0) {
+        return;
+    }
+
+    // finest level: one cell per leaf tile of DEM posts
+    Level leaf;
+    leaf.length = (length + leaf_size - 1) / leaf_size;
+    leaf.width = (width + leaf_size - 1) / leaf_size;
+    leaf.cells.resize(leaf.length * leaf.width);
+
+    const long leaf_length = static_cast<long>(leaf.length);
+    _Pragma("omp parallel for schedule(dynamic)")
+    for (long ti = 0; ti < leaf_length; ++ti) {
+        const std::size_t row0 = ti * leaf_size;
+        const std::size_t row1 = std::min(row0 + leaf_size, length);
+        for (std::size_t tj = 0; tj < leaf.width; ++tj) {
+            const std::size_t col0 = tj * leaf_size;
+            const std::size_t col1 = std::min(col0 + leaf_size, width);
+            HeightStats& cell = leaf.cells[ti * leaf.width + tj];
+            for (std::size_t i = row0; i < row1; ++i) {
+                for (std::size_t j = col0; j < col1; ++j) {
+                    cell.add(data[i * width + j]);
+                }
+            }
+        }
+    }
+    _levels.push_back(std::move(leaf));
+
+    // coarser levels: each cell merges a 2x2 neighborhood of finer cells
+    while (_levels.back().length > 1 || _levels.back().width > 1) {
+        const Level& fine = _levels.back();
+        Level coarse;
+        coarse.length = (fine.length + 1) / 2;
+        coarse.width = (fine.width + 1) / 2;
+        coarse.cells.resize(coarse.length * coarse.width);
+        for (std::size_t i = 0; i < coarse.length; ++i) {
+            for (std::size_t j = 0; j < coarse.width; ++j) {
+                HeightStats& cell = coarse.cells[i * coarse.width + j];
+                for (std::size_t fi = 2 * i;
+                     fi < std::min(2 * i + 2, fine.length); ++fi) {
+                    for (std::size_t fj = 2 * j;
+                         fj < std::min(2 * j + 2, fine.width); ++fj) {
+                        cell.merge(fine.cells[fi * fine.width + fj]);
+                    }
+                }
+            }
+        }
+        _levels.push_back(std::move(coarse));
+    }
+}
+
+HeightStats HeightStatsPyramid::stats() const
+{
+    if (_levels.empty()) {
+        return HeightStats {};
+    }
+    return _levels.back().cells[0];
+}
+
+HeightStats HeightStatsPyramid::stats(const float* data, std::size_t row0,
+                                      std::size_t col0, std::size_t nrows,
+                                      std::size_t ncols) const
+{
+    const std::size_t width = _width;
+    return statsWith([data, width](std::size_t row, std::size_t col) {
+        return data[row * width + col];
+    }, row0, col0, nrows, ncols);
+}
+
+}}} // namespace isce3::geometry::detail
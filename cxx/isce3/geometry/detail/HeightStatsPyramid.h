@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace isce3 { namespace geometry { namespace detail {
+
+/** Summary statistics of a set of DEM heights. NaN heights are ignored. */
+struct HeightStats {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    double sum = 0.0;
+    std::size_t count = 0;
+
+    /** Accumulate a single height */
+    void add(float value)
+    {
+        if (value != value) {
+            return;
+        }
+        if (value < min)
+            min = value;
+        if (value > max)
+            max = value;
+        sum += value;
+        ++count;
+    }
+
+    /** Merge statistics of another set of heights */
+    void merge(const HeightStats& other)
+    {
+        if (other.min < min)
+            min = other.min;
+        if (other.max > max)
+            max = other.max;
+        sum += other.sum;
+        count += other.count;
+    }
+
+    /** Mean height (NaN if no valid heights were accumulated) */
+    double mean() const
+    {
+        return count > 0 ? sum / count
+                         : std::numeric_limits<double>::quiet_NaN();
+    }
+};
+
+/** Multi-resolution min/max/sum pyramid over a row-major DEM array.
+ *
+ * The finest level summarizes square tiles of leafSize x leafSize DEM
+ * posts and each coarser level summarizes 2x2 cells of the level below,
+ * down to a single cell covering the whole DEM. Statistics over an
+ * arbitrary window are obtained by descending the pyramid, merging the
+ * cells fully contained in the window and only scanning DEM posts in
+ * leaf tiles that straddle the window border.
+ */
+class HeightStatsPyramid {
+public:
+    /** Default size (in DEM posts) of the side of a leaf tile */
+    static constexpr std::size_t defaultLeafSize = 16;
+
+    /** Construct an empty pyramid */
+    HeightStatsPyramid() = default;
+
+    /** Build pyramid from a row-major DEM array
+     *
+     * @param[in] data      Pointer to DEM heights
+     * @param[in] length    Number of DEM rows
+     * @param[in] width     Number of DEM columns
+     * @param[in] leaf_size Side of a leaf tile in DEM posts
+     */
+    HeightStatsPyramid(const float* data, std::size_t length,
+                       std::size_t width,
+                       std::size_t leaf_size = defaultLeafSize);
+
+    /** Whether the pyramid has been built */
+    bool empty() const { return _levels.empty(); }
+
+    /** Number of levels, including the finest (leaf) level */
+    std::size_t numLevels() const { return _levels.size(); }
+
+    /** Statistics of the whole DEM (O(1)) */
+    HeightStats stats() const;
+
+    /** Statistics over a window of the DEM
+     *
+     * The window is clipped to the DEM extents.
+     *
+     * @param[in] data    Pointer to DEM heights used to build the pyramid
+     * @param[in] row0    First row of the window
+     * @param[in] col0    First column of the window
+     * @param[in] nrows   Number of rows in the window
+     * @param[in] ncols   Number of columns in the window
+     */
+    HeightStats stats(const float* data, std::size_t row0, std::size_t col0,
+                      std::size_t nrows, std::size_t ncols) const;
+
+    /** Statistics over a window of the DEM, reading the posts of partially
+     * covered leaf tiles through an accessor
+     *
+     * @param[in] heights Callable returning the height at (row, col)
+     * @param[in] row0    First row of the window
+     * @param[in] col0    First column of the window
+     * @param[in] nrows   Number of rows in the window
+     * @param[in] ncols   Number of columns in the window
+     */
+    template<class Heights>
+    HeightStats statsWith(const Heights& heights, std::size_t row0,
+                          std::size_t col0, std::size_t nrows,
+                          std::size_t ncols) const;
+
+private:
+    struct Level {
+        std::size_t length = 0;
+        std::size_t width = 0;
+        std::vector<HeightStats> cells;
+    };
+
+    template<class Heights>
+    void _query(const Heights& heights, std::size_t level, std::size_t i,
+                std::size_t j, std::size_t row0, std::size_t row1,
+                std::size_t col0, std::size_t col1, HeightStats& out) const;
+
+    std::size_t _length = 0;
+    std::size_t _width = 0;
+    std::size_t _leafSize = defaultLeafSize;
+    std::vector<Level> _levels;
+};
+
+}}} // namespace isce3::geometry::detail
+
+#define ISCE_GEOMETRY_DETAIL_HEIGHTSTATSPYRAMID_ICC
+#include "HeightStatsPyramid.icc"
+#undef ISCE_GEOMETRY_DETAIL_HEIGHTSTATSPYRAMID_ICC
@@ -0,0 +1,123 @@
+#include "QuantizedHeights.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <isce3/except/Error.h>
+
+namespace isce3 { namespace geometry { namespace detail {
+
+std::uint16_t floatToHalf(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::uint32_t magnitude = bits & 0x7fffffffu;
+
+    // infinities and NaNs (keep NaNs quiet)
+    if (magnitude >= 0x7f800000u) {
+        return sign | 0x7c00u | (magnitude > 0x7f800000u ? 0x0200u : 0u);
+    }
+    // 65520 and above round to infinity
+    if (magnitude >= 0x477ff000u) {
+        return sign | 0x7c00u;
+    }
+    // below the smallest normal half: subnormal, in units of 2^-24
+    if (magnitude < 0x38800000u) {
+        float abs_value;
+        std::memcpy(&abs_value, &magnitude, sizeof(abs_value));
+        return sign | static_cast<std::uint32_t>(
+                std::nearbyint(abs_value * 16777216.0f));
+    }
+    // normal: rebias the exponent and round the mantissa to nearest even;
+    // a mantissa carry correctly bumps the exponent
+    std::uint32_t half = ((magnitude >> 23) - 112u) << 10 |
+                         (magnitude & 0x7fffffu) >> 13;
+    const std::uint32_t rest = magnitude & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return sign | half;
+}
+
+float halfToFloat(std::uint16_t half)
+{
+    const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u)
+                               << 16;
+    const std::uint32_t exponent = (half >> 10) & 0x1fu;
+    const std::uint32_t mantissa = half & 0x3ffu;
+
+    if (exponent == 0) {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -value : value;
+    }
+    std::uint32_t bits;
+    if (exponent == 0x1fu) {
+        bits = sign | 0x7f800000u | mantissa << 13;
+    } else {
+        bits = sign | (exponent + 112u) << 23 | mantissa << 13;
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QuantizedHeights::QuantizedHeights(const float* data, std::size_t length,
+                                   std::size_t width, HeightStorage storage)
+    : _codes(length * width), _length(length), _width(width),
+      _storage(storage)
+{
+    if (storage == HeightStorage::Float32) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "quantized heights need Int16 or Float16 storage");
+    }
+    const long size = static_cast<long>(_codes.size());
+
+    if (storage == HeightStorage::Float16) {
+        _Pragma("omp parallel for")
+        for (long k = 0; k < size; ++k) {
+            _codes[k] = floatToHalf(data[k]);
+        }
+        return;
+    }
+
+    // map the height range onto the codes [-32767, 32767]
+    float min_value = std::numeric_limits<float>::max();
+    float max_value = std::numeric_limits<float>::lowest();
+    for (long k = 0; k < size; ++k) {
+        if (std::isfinite(data[k])) {
+            min_value = std::min(min_value, data[k]);
+            max_value = std::max(max_value, data[k]);
+        }
+    }
+    if (min_value <= max_value) {
+        _offset = 0.5 * (static_cast<double>(min_value) + max_value);
+        const double range = static_cast<double>(max_value) - min_value;
+        _scale = range > 0.0 ? range / 65534.0 : 1.0;
+    }
+
+    _Pragma("omp parallel for")
+    for (long k = 0; k < size; ++k) {
+        if (!std::isfinite(data[k])) {
+            _codes[k] = static_cast<std::uint16_t>(_invalid);
+            continue;
+        }
+        const double code = std::round((data[k] - _offset) / _scale);
+        _codes[k] = static_cast<std::uint16_t>(static_cast<std::int16_t>(
+                std::min(32767.0, std::max(-32767.0, code))));
+    }
+}
+
+void QuantizedHeights::decode(float* out, std::size_t row0, std::size_t col0,
+                              std::size_t nrows, std::size_t ncols) const
+{
+    for (std::size_t i = 0; i < nrows; ++i) {
+        const std::uint16_t* codes = &_codes[(row0 + i) * _width + col0];
+        for (std::size_t j = 0; j < ncols; ++j) {
+            out[i * ncols + j] = _decode(codes[j]);
+        }
+    }
+}
+
+}}} // namespace isce3::geometry::detail
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace isce3 { namespace geometry {
+
+/** Storage format of the heights held by a DEMInterpolator */
+enum class HeightStorage {
+    /** 32-bit floating point (exact) */
+    Float32,
+    /** 16-bit integers with a per-DEM scale and offset; the step is the
+     * height range divided by 65534 */
+    Int16,
+    /** IEEE 754 half precision; the step grows with the height, to 4 m
+     * above 4096 m and 8 m above 8192 m */
+    Float16
+};
+
+namespace detail {
+
+/** Encode a float as an IEEE 754 half precision value, rounding to the
+ * nearest even value. Out of range values become infinities. */
+std::uint16_t floatToHalf(float value);
+
+/** Decode an IEEE 754 half precision value */
+float halfToFloat(std::uint16_t bits);
+
+/** Row-major array of DEM heights stored as 16-bit codes
+ *
+ * NaN heights are preserved: Int16 storage reserves the code -32768 for
+ * all non-finite heights, which decode as NaN, and Float16 encodes them as
+ * half precision NaNs.
+ */
+class QuantizedHeights {
+public:
+    /** Construct an empty array */
+    QuantizedHeights() = default;
+
+    /** Encode a row-major array of heights
+     *
+     * @param[in] data    Pointer to DEM heights
+     * @param[in] length  Number of DEM rows
+     * @param[in] width   Number of DEM columns
+     * @param[in] storage Int16 or Float16
+     */
+    QuantizedHeights(const float* data, std::size_t length,
+                     std::size_t width, HeightStorage storage);
+
+    /** Whether the array holds no heights */
+    bool empty() const { return _codes.empty(); }
+
+    /** Number of rows */
+    std::size_t length() const { return _length; }
+
+    /** Number of columns */
+    std::size_t width() const { return _width; }
+
+    /** Storage format */
+    HeightStorage storage() const { return _storage; }
+
+    /** Decoded height at (row, col) */
+    float operator()(std::size_t row, std::size_t col) const
+    {
+        return _decode(_codes[row * _width + col]);
+    }
+
+    /** Decode a window of heights into a row-major buffer
+     *
+     * @param[out] out    Buffer of at least nrows * ncols heights
+     * @param[in]  row0   First row of the window
+     * @param[in]  col0   First column of the window
+     * @param[in]  nrows  Number of rows in the window
+     * @param[in]  ncols  Number of columns in the window
+     */
+    void decode(float* out, std::size_t row0, std::size_t col0,
+                std::size_t nrows, std::size_t ncols) const;
+
+private:
+    static constexpr std::int16_t _invalid = -32768;
+
+    float _decode(std::uint16_t code) const
+    {
+        if (_storage == HeightStorage::Float16) {
+            return halfToFloat(code);
+        }
+        const auto value = static_cast<std::int16_t>(code);
+        if (value == _invalid) {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+        return static_cast<float>(_offset + _scale * value);
+    }
+
+    std::vector<std::uint16_t> _codes;
+    std::size_t _length = 0;
+    std::size_t _width = 0;
+    HeightStorage _storage = HeightStorage::Int16;
+    double _scale = 1.0;
+    double _offset = 0.0;
+};
+
+}}} // namespace isce3::geometry::detail
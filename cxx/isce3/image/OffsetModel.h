@@ -0,0 +1,52 @@
+#pragma once
+
+#include "forward.h"
+
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Poly2d.h>
+
+namespace isce3 { namespace image {
+
+/** Model of range or azimuth offsets, in pixels, used by ResampSlc in
+ *  place of full resolution offset rasters
+ *
+ * Offsets are the sum of a low-order polynomial and of an optional coarse
+ * residual grid (e.g. dense offsets from rubbersheeting), both functions of
+ * the output line (y) and pixel (x) indices. Either term may be omitted: a
+ * default Poly2d and a LUT2d without data both evaluate to zero.
+ */
+class OffsetModel {
+public:
+    /** Zero offsets */
+    OffsetModel() = default;
+
+    /** Offsets given by a polynomial and an optional residual grid */
+    explicit OffsetModel(const isce3::core::Poly2d& poly,
+                         const isce3::core::LUT2d<double>& residual =
+                                 isce3::core::LUT2d<double>())
+        : _poly(poly), _residual(residual)
+    {}
+
+    /** Offsets given by a grid */
+    explicit OffsetModel(const isce3::core::LUT2d<double>& residual)
+        : _residual(residual)
+    {}
+
+    /** Get polynomial term */
+    const isce3::core::Poly2d& poly() const { return _poly; }
+
+    /** Get residual grid term */
+    const isce3::core::LUT2d<double>& residual() const { return _residual; }
+
+    /** Evaluate offset at an output line and pixel */
+    double eval(double line, double pixel) const
+    {
+        return _poly.eval(line, pixel) + _residual.eval(line, pixel);
+    }
+
+private:
+    isce3::core::Poly2d _poly;
+    isce3::core::LUT2d<double> _residual;
+};
+
+}} // namespace isce3::image
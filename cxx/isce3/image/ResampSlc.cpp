@@ -3,7 +3,17 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <pyre/journal.h>
 
@@ -15,6 +25,84 @@ namespace isce3 { namespace image {
 
 using isce3::io::Raster;
 
+namespace {
+
+/** Bounded FIFO queue connecting two stages of the tile pipeline */
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) :
+        _capacity(std::max<size_t>(capacity, 1)) {}
+
+    /** Push an item, waiting for space in the queue.
+     *  Returns false if the queue has been closed. */
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notFull.wait(lock,
+                [this] { return _closed || _items.size() < _capacity; });
+        if (_closed)
+            return false;
+        _items.push_back(std::move(item));
+        lock.unlock();
+        _notEmpty.notify_one();
+        return true;
+    }
+
+    /** Pop an item, waiting for one to be available.
+     *  Returns false once the queue is closed and empty. */
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notEmpty.wait(lock, [this] { return _closed || !_items.empty(); });
+        if (_items.empty())
+            return false;
+        item = std::move(_items.front());
+        _items.pop_front();
+        lock.unlock();
+        _notFull.notify_one();
+        return true;
+    }
+
+    /** Close the queue. Pending items can still be popped. */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+        }
+        _notFull.notify_all();
+        _notEmpty.notify_all();
+    }
+
+private:
+    size_t _capacity;
+    bool _closed = false;
+    std::deque<T> _items;
+    std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+};
+
+// Input SLC data of all bands and offsets of a tile, produced by the
+// reader thread
+struct InputTile {
+    explicit InputTile(size_t nBands) : tiles(nBands) {}
+    int tileCount;
+    std::vector<ResampSlc::Tile_t> tiles;
+    Tile<float> azOffTile;
+    Tile<float> rgOffTile;
+};
+
+// Resampled tile of all bands, consumed by the writer thread
+struct OutputTile {
+    int rowStart;
+    int length;
+    std::vector<std::valarray<std::complex<float>>> data;
+};
+
+} // namespace
+
 // Alternative generic resamp entry point: use filenames to internally create
 // rasters
 void ResampSlc::resamp(
@@ -49,55 +137,246 @@ void ResampSlc::resamp(isce3::io::Raster& inputSlc,
                        bool flatten, int rowBuffer,
                        int chipSize)
 {
+    resamp(std::vector<std::reference_wrapper<Raster>> {inputSlc},
+           std::vector<std::reference_wrapper<Raster>> {outputSlc},
+           rgOffsetRaster, azOffsetRaster, std::vector<int> {inputBand},
+           flatten, rowBuffer, chipSize);
+}
+
+// Multi-band resamp entry point from externally created rasters
+void ResampSlc::resamp(std::vector<std::reference_wrapper<Raster>> inputSlcs,
+                       std::vector<std::reference_wrapper<Raster>> outputSlcs,
+                       isce3::io::Raster& rgOffsetRaster,
+                       isce3::io::Raster& azOffsetRaster,
+                       std::vector<int> inputBands, bool flatten,
+                       int rowBuffer, int chipSize)
+{
+    // Output geometry defined by offset images
+    const size_t outLength = rgOffsetRaster.length();
+    const size_t outWidth = rgOffsetRaster.width();
+
+    // Offsets tiles are read from the offset rasters
+    auto loadOffsets = [&](const Tile_t& tile, Tile<float>& azOffTile,
+                           Tile<float>& rgOffTile, std::mutex& ioMutex) {
+        _initializeOffsetTiles(tile, azOffsetRaster, rgOffsetRaster,
+                               azOffTile, rgOffTile, outWidth, ioMutex);
+    };
+
+    _resamp(inputSlcs, outputSlcs, outLength, outWidth, loadOffsets,
+            inputBands, flatten, rowBuffer, chipSize);
+}
+
+// Multi-band resamp entry point from offset models
+void ResampSlc::resamp(std::vector<std::reference_wrapper<Raster>> inputSlcs,
+                       std::vector<std::reference_wrapper<Raster>> outputSlcs,
+                       const OffsetModel& rgOffsetModel,
+                       const OffsetModel& azOffsetModel, size_t outLength,
+                       size_t outWidth, std::vector<int> inputBands,
+                       bool flatten, int rowBuffer, int chipSize)
+{
+    for (const Raster& outputSlc : outputSlcs) {
+        if (outputSlc.length() != outLength || outputSlc.width() != outWidth) {
+            std::string error_msg{"Output SLCs must match the output "
+                                  "length and width."};
+            throw isce3::except::LengthError(ISCE_SRCINFO(), error_msg);
+        }
+    }
+
+    // Offsets tiles are evaluated from the models, without any raster access
+    auto loadOffsets = [&](const Tile_t& tile, Tile<float>& azOffTile,
+                           Tile<float>& rgOffTile, std::mutex&) {
+        _evaluateOffsetTiles(tile, azOffsetModel, rgOffsetModel, azOffTile,
+                             rgOffTile, outWidth);
+    };
+
+    _resamp(inputSlcs, outputSlcs, outLength, outWidth, loadOffsets,
+            inputBands, flatten, rowBuffer, chipSize);
+}
+
+// Tile pipeline shared by all multi-band resamp entry points
+void ResampSlc::_resamp(std::vector<std::reference_wrapper<Raster>> inputSlcs,
+                        std::vector<std::reference_wrapper<Raster>> outputSlcs,
+                        size_t outputLength, size_t outputWidth,
+                        const OffsetTileLoader& loadOffsets,
+                        std::vector<int> inputBands, bool flatten,
+                        int rowBuffer, int chipSize)
+{
+    // Check consistency of the input and output bands
+    const size_t nBands = inputSlcs.size();
+    if (nBands == 0) {
+        std::string error_msg{"No input SLC to resample."};
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+    if (outputSlcs.size() != nBands) {
+        std::string error_msg{"Number of output SLCs differs from number of "
+                              "input SLCs."};
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+    if (inputBands.empty()) {
+        inputBands.assign(nBands, 1);
+    } else if (inputBands.size() != nBands) {
+        std::string error_msg{"Number of input bands differs from number of "
+                              "input SLCs."};
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
+
     // Set the band number for input SLC
-    _inputBand = inputBand;
+    _inputBand = inputBands[0];
     // Cache width of SLC image
-    const int inLength = inputSlc.length();
-    const int inWidth = inputSlc.width();
-    // Cache output length and width from offset images
-    const int outLength = rgOffsetRaster.length();
-    const int outWidth = rgOffsetRaster.width();
+    const int inLength = inputSlcs[0].get().length();
+    const int inWidth = inputSlcs[0].get().width();
+    for (const Raster& inputSlc : inputSlcs) {
+        if (static_cast<int>(inputSlc.length()) != inLength ||
+            static_cast<int>(inputSlc.width()) != inWidth) {
+            std::string error_msg{"Input SLCs must share the same shape."};
+            throw isce3::except::LengthError(ISCE_SRCINFO(), error_msg);
+        }
+    }
+    const int outLength = outputLength;
+    const int outWidth = outputWidth;
+
+    if (flatten && !_haveRefData) {
+        std::string error_msg{"Unable to flatten; reference data not provided."};
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
+    }
 
-    // Initialize resampling methods
-    _prepareInterpMethods(isce3::core::SINC_METHOD, chipSize - 1);
+    // Single precision sinc kernel shared by all bands
+    const isce3::core::Sinc2dInterpolator<std::complex<float>> sincInterp(
+            chipSize - 1, isce3::core::SINC_SUB);
+    const auto& kernel = sincInterp.kernel();
+    std::vector<float> sincKernel(kernel.size());
+    for (size_t i = 0; i < sincKernel.size(); ++i) {
+        sincKernel[i] = static_cast<float>(kernel.data()[i]);
+    }
 
     // Determine number of tiles needed to process image
     const int nTiles = _computeNumberOfTiles(outLength, _linesPerTile);
-    std::cout << "Resampling using " << nTiles << " tiles of " << _linesPerTile
-              << " lines per tile\n";
+    std::cout << "Resampling " << nBands << " band(s) using " << nTiles
+              << " tiles of " << _linesPerTile << " lines per tile\n";
     // Start timer
     auto timerStart = std::chrono::steady_clock::now();
 
-    // For each full tile of _linesPerTile lines...
-    for (int tileCount = 0; tileCount < nTiles; tileCount++) {
-
-        // Make a tile for representing input SLC data
-        Tile_t tile;
-        tile.width(inWidth);
-        // Set its line index bounds (line number in output image)
-        tile.rowStart(tileCount * _linesPerTile);
-        if (tileCount == (nTiles - 1)) {
-            tile.rowEnd(outLength);
-        } else {
-            tile.rowEnd(tile.rowStart() + _linesPerTile);
-        }
-
-        // Initialize offsets tiles
-        Tile<float> azOffTile, rgOffTile;
-        _initializeOffsetTiles(tile, azOffsetRaster, rgOffsetRaster, azOffTile,
-                               rgOffTile, outWidth);
+    // Tiles are processed by a pipeline: a reader thread reads the offsets
+    // and input SLC data of the next tiles, the tile being interpolated is
+    // shared by all OpenMP threads, and a writer thread writes the previous
+    // tiles. GDAL accesses of the reader and writer are serialized since
+    // some drivers (e.g. HDF5) are not thread-safe.
+    BoundedQueue<std::unique_ptr<InputTile>> readQueue(_tilesInFlight);
+    BoundedQueue<OutputTile> writeQueue(_tilesInFlight);
+    std::mutex ioMutex;
+    std::exception_ptr readError, writeError;
+
+    std::thread reader([&]() {
+        try {
+            // For each full tile of _linesPerTile lines...
+            for (int tileCount = 0; tileCount < nTiles; tileCount++) {
+
+                auto input = std::make_unique<InputTile>(nBands);
+                input->tileCount = tileCount;
+
+                // Make a tile for representing input SLC data
+                Tile_t& tile = input->tiles[0];
+                tile.width(inWidth);
+                // Set its line index bounds (line number in output image)
+                tile.rowStart(tileCount * _linesPerTile);
+                if (tileCount == (nTiles - 1)) {
+                    tile.rowEnd(outLength);
+                } else {
+                    tile.rowEnd(tile.rowStart() + _linesPerTile);
+                }
 
-        // Get corresponding image indices
-        std::cout << "Reading in image data for tile " << tileCount << "\n";
-        _initializeTile(tile, inputSlc, azOffTile, outLength, rowBuffer,
-                        chipSize / 2);
+                std::cout << "Reading in image data for tile " +
+                                     std::to_string(tileCount) + "\n";
+
+                // Initialize offsets tiles
+                loadOffsets(tile, input->azOffTile, input->rgOffTile, ioMutex);
+
+                {
+                    std::lock_guard<std::mutex> lock(ioMutex);
+
+                    // Get corresponding image indices
+                    _initializeTile(tile, inputSlcs[0], input->azOffTile,
+                            outLength, rowBuffer, chipSize / 2);
+
+                    // Other bands share the image indices of the first one
+                    for (size_t band = 1; band < nBands; ++band) {
+                        Tile_t& bandTile = input->tiles[band];
+                        bandTile.width(inWidth);
+                        bandTile.rowStart(tile.rowStart());
+                        bandTile.rowEnd(tile.rowEnd());
+                        bandTile.firstImageRow(tile.firstImageRow());
+                        bandTile.lastImageRow(tile.lastImageRow());
+                        bandTile.allocate();
+                        inputSlcs[band].get().getBlock(&bandTile[0], 0,
+                                bandTile.firstImageRow(), bandTile.width(),
+                                bandTile.length(), inputBands[band]);
+                    }
+                }
 
-        // Perform interpolation
-        std::cout << "Interpolating tile " << tileCount << "\n";
-        _transformTile(tile, outputSlc, rgOffTile, azOffTile, inLength, flatten,
-                       chipSize);
+                if (!readQueue.push(std::move(input)))
+                    break;
+            }
+        } catch (...) {
+            readError = std::current_exception();
+        }
+        readQueue.close();
+    });
+
+    std::thread writer([&]() {
+        OutputTile output;
+        while (writeQueue.pop(output)) {
+            try {
+                std::lock_guard<std::mutex> lock(ioMutex);
+                for (size_t band = 0; band < nBands; ++band) {
+                    outputSlcs[band].get().setBlock(output.data[band], 0,
+                            output.rowStart, outWidth, output.length);
+                }
+            } catch (...) {
+                writeError = std::current_exception();
+                writeQueue.close();
+                return;
+            }
+        }
+    });
+
+    std::exception_ptr computeError;
+    try {
+        std::unique_ptr<InputTile> input;
+        while (readQueue.pop(input)) {
+            // Perform interpolation
+            std::cout << "Interpolating tile " +
+                                 std::to_string(input->tileCount) + "\n";
+            _removeCarrier(input->tiles.data(), nBands);
+
+            OutputTile output;
+            output.rowStart = input->tiles[0].rowStart();
+            output.length = input->azOffTile.length();
+            output.data.resize(nBands);
+            _transformTile(input->tiles, output.data, input->rgOffTile,
+                           input->azOffTile, inLength, flatten, chipSize,
+                           sincKernel);
+            input.reset();
+
+            if (!writeQueue.push(std::move(output)))
+                break;
+        }
+    } catch (...) {
+        computeError = std::current_exception();
     }
 
+    // Stop the reader (if interrupted) and wait for pending writes
+    readQueue.close();
+    writeQueue.close();
+    reader.join();
+    writer.join();
+
+    if (computeError)
+        std::rethrow_exception(computeError);
+    if (readError)
+        std::rethrow_exception(readError);
+    if (writeError)
+        std::rethrow_exception(writeError);
+
     // Print out timing information and reset
     auto timerEnd = std::chrono::steady_clock::now();
     const double elapsed =
@@ -108,10 +387,58 @@ void ResampSlc::resamp(isce3::io::Raster& inputSlc,
 }
 
 // Initialize and read azimuth and range offsets
-void ResampSlc::_initializeOffsetTiles(Tile_t& tile, Raster& azOffsetRaster,
+void ResampSlc::_initializeOffsetTiles(const Tile_t& tile,
+                                       Raster& azOffsetRaster,
                                        Raster& rgOffsetRaster,
                                        Tile<float>& azOffTile,
-                                       Tile<float>& rgOffTile, int outWidth)
+                                       Tile<float>& rgOffTile, int outWidth,
+                                       std::mutex& ioMutex)
+{
+    _allocateOffsetTiles(tile, azOffTile, rgOffTile, outWidth);
+
+    // Read in block of range and azimuth offsets
+    std::lock_guard<std::mutex> lock(ioMutex);
+    azOffsetRaster.getBlock(&azOffTile[0], 0, azOffTile.rowStart(),
+                            azOffTile.width(), azOffTile.length());
+    rgOffsetRaster.getBlock(&rgOffTile[0], 0, rgOffTile.rowStart(),
+                            rgOffTile.width(), rgOffTile.length());
+}
+
+// Initialize and evaluate azimuth and range offsets from models
+void ResampSlc::_evaluateOffsetTiles(const Tile_t& tile,
+                                     const OffsetModel& azOffsetModel,
+                                     const OffsetModel& rgOffsetModel,
+                                     Tile<float>& azOffTile,
+                                     Tile<float>& rgOffTile, int outWidth)
+{
+    _allocateOffsetTiles(tile, azOffTile, rgOffTile, outWidth);
+
+    // Evaluate offsets at output line and pixel indices. Exceptions (e.g.
+    // out of bounds LUT evaluations) cannot leave the parallel region, so
+    // the first one is rethrown afterwards.
+    std::exception_ptr error;
+    _Pragma("omp parallel for")
+    for (int i = 0; i < azOffTile.length(); ++i) {
+        try {
+            const double line = i + azOffTile.rowStart();
+            for (int j = 0; j < outWidth; ++j) {
+                azOffTile(i, j) = azOffsetModel.eval(line, j);
+                rgOffTile(i, j) = rgOffsetModel.eval(line, j);
+            }
+        } catch (...) {
+            _Pragma("omp critical")
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+// Allocate azimuth and range offset tiles matching an output tile
+void ResampSlc::_allocateOffsetTiles(const Tile_t& tile,
+                                     Tile<float>& azOffTile,
+                                     Tile<float>& rgOffTile, int outWidth)
 {
     // Copy size properties and initialize azimuth offset tiles
     azOffTile.width(outWidth);
@@ -128,12 +455,6 @@ void ResampSlc::_initializeOffsetTiles(Tile_t& tile, Raster& azOffsetRaster,
     rgOffTile.firstImageRow(tile.rowStart());
     rgOffTile.lastImageRow(tile.rowEnd());
     rgOffTile.allocate();
-
-    // Read in block of range and azimuth offsets
-    azOffsetRaster.getBlock(&azOffTile[0], 0, azOffTile.rowStart(),
-                            azOffTile.width(), azOffTile.length());
-    rgOffsetRaster.getBlock(&rgOffTile[0], 0, rgOffTile.rowStart(),
-                            rgOffTile.width(), rgOffTile.length());
 }
 
 // Initialize tile bounds
@@ -208,8 +529,15 @@ void ResampSlc::_initializeTile(Tile_t& tile, Raster& inputSlc,
     // block
     inputSlc.getBlock(&tile[0], 0, tile.firstImageRow(), tile.width(),
                       tile.length(), _inputBand);
+}
 
-    // Remove carrier from input data
+// Remove carrier from input data of tiles sharing the same geometry
+void ResampSlc::_removeCarrier(Tile_t* tiles, size_t nTiles)
+{
+    const Tile_t& tile = tiles[0];
+    const int inWidth = tile.width();
+
+    _Pragma("omp parallel for")
     for (int i = 0; i < tile.length(); i++) {
         const double az =  _sensingStart + (i + tile.firstImageRow()) / _prf;
         for (int j = 0; j < inWidth; j++) {
@@ -217,53 +545,61 @@ void ResampSlc::_initializeTile(Tile_t& tile, Raster& inputSlc,
             // Evaluate the pixel's carrier phase
             const double phase = _rgCarrier.eval(az, rng)
                 + _azCarrier.eval(az, rng);
-            // Remove the carrier
+            // Remove the carrier from all tiles
             std::complex<float> cpxPhase(std::cos(phase), -std::sin(phase));
-            tile(i, j) *= cpxPhase;
+            for (size_t k = 0; k < nTiles; ++k) {
+                tiles[k](i, j) *= cpxPhase;
+            }
         }
     }
 }
 
-// Interpolate tile to perform transformation
-void ResampSlc::_transformTile(Tile_t& tile, Raster& outputSlc,
+// Interpolate tiles of all bands to perform transformation
+void ResampSlc::_transformTile(const std::vector<Tile_t>& tiles,
+                               std::vector<std::valarray<std::complex<float>>>& imgOuts,
                                const Tile<float>& rgOffTile,
                                const Tile<float>& azOffTile, int inLength,
-                               bool flatten, int chipSize)
+                               bool flatten, int chipSize,
+                               const std::vector<float>& sincKernel)
 {
-    if (flatten && !_haveRefData) {
-        std::string error_msg{"Unable to flatten; reference data not provided."};
-        throw isce3::except::InvalidArgument(ISCE_SRCINFO(), error_msg);
-    }
-
     // Cache geometry values
+    const Tile_t& tile = tiles[0];
+    const size_t nBands = tiles.size();
     const int inWidth = tile.width();
     const int outWidth = azOffTile.width();
     const int outLength = azOffTile.length();
-    int chipHalf = chipSize / 2;
+    const int chipHalf = chipSize / 2;
+
+    // Sinc kernel length and half length, as in Sinc2dInterpolator
+    const int sincLen = chipSize - 1;
+    const int sincHalf = sincLen / 2;
+    const int sincSub = isce3::core::SINC_SUB;
 
-    // Allocate valarray for output image block
-    std::valarray<std::complex<float>> imgOut(outLength * outWidth);
+    // Allocate valarrays for output image blocks
     // Initialize/fill with invalid values
-    imgOut = _invalid_value;
+    for (auto& imgOut : imgOuts) {
+        imgOut.resize(outLength * outWidth);
+        imgOut = _invalid_value;
+    }
 
     // From this point on, transformation is multithreaded
-    int tileLine = 0;
-    _Pragma("omp parallel shared(imgOut)")
+    _Pragma("omp parallel shared(imgOuts)")
     {
+        // Azimuth weights (sinc kernel and Doppler demodulation) of the
+        // current pixel, shared by all bands
+        std::vector<std::complex<float>> azWeights(sincLen);
 
-        // set half chip size
-        // Allocate matrix for working sinc chip
-        isce3::core::Matrix<std::complex<float>> chip(chipSize, chipSize);
-
-        // Loop over lines to perform interpolation
-        for (int i = tile.rowStart(); i < tile.rowEnd(); ++i) {
+        // Loop over lines and width of the tile to perform interpolation,
+        // without synchronizing the threads between lines
+        _Pragma("omp for collapse(2) schedule(static)")
+        for (int tileLine = 0; tileLine < outLength; ++tileLine) {
+            for (int j = 0; j < outWidth; ++j) {
 
-            // Compute azimuth time at i index
-            const double az = _sensingStart + i / _prf;
+                // Line index in output image
+                const int i = tile.rowStart() + tileLine;
 
-            // Loop over width
-            _Pragma("omp for") for (int j = 0; j < outWidth; ++j)
-            {
+                // Compute azimuth time at i index
+                const double az = _sensingStart + i / _prf;
 
                 // Unpack offsets (units of bins)
                 const float azOff = azOffTile(tileLine, j);
@@ -314,44 +650,52 @@ void ResampSlc::_transformTile(Tile_t& tile, Raster& outputSlc,
                                 (j * _refRangePixelSpacing))) *
                               ((1.0 / _refWavelength) - (1.0 / _wavelength)));
                 }
-
-                // Read data chip without the carrier phases
-                for (int ii = 0; ii < chipSize; ++ii) {
-                    // Row to read from
-                    const int chipRow =
-                            intAz - tile.firstImageRow() + ii - chipHalf;
-                    // Carrier phase
-                    const double chipPhase = dop * (ii - chipHalf);
-                    const std::complex<float> cval(
-                            std::cos(chipPhase), -std::sin(chipPhase));
-                    // Set the data values after removing doppler in azimuth
-                    for (int jj = 0; jj < chipSize; ++jj) {
-                        // Column to read from
-                        const int chipCol = intRg + jj - chipHalf;
-                        chip(ii, jj) = tile(chipRow, chipCol) * cval;
-                    }
+                const std::complex<float> cpxPhase(std::cos(phase),
+                                                   std::sin(phase));
+
+                // Nearest sinc kernel rows of the fractional offsets
+                const int azKernelRow = std::min(
+                        std::max(0, static_cast<int>(fracAz * sincSub)),
+                        sincSub - 1);
+                const int rgKernelRow = std::min(
+                        std::max(0, static_cast<int>(fracRg * sincSub)),
+                        sincSub - 1);
+                const float* azKernel = &sincKernel[azKernelRow * sincLen];
+                const float* rgKernel = &sincKernel[rgKernelRow * sincLen];
+
+                // Azimuth weights including the removal of the Doppler of
+                // each chip line. The chip lines are visited from
+                // intAz + sincHalf downwards, as in Sinc2dInterpolator.
+                for (int ii = 0; ii < sincLen; ++ii) {
+                    const double chipPhase = dop * (sincHalf - ii);
+                    azWeights[ii] = azKernel[ii] *
+                            std::complex<float>(std::cos(chipPhase),
+                                                -std::sin(chipPhase));
                 }
 
-                // Interpolate chip
-                const std::complex<float> cval = _interp->interpolate(
-                        chipHalf + fracRg, chipHalf + fracAz, chip);
+                // Apply the separable sinc kernel to each band
+                const int lastRow = intAz - tile.firstImageRow() + sincHalf;
+                const int lastCol = intRg + sincHalf;
+                for (size_t band = 0; band < nBands; ++band) {
+                    std::complex<float> cval(0.0f, 0.0f);
+                    for (int ii = 0; ii < sincLen; ++ii) {
+                        const std::complex<float>* chipLine =
+                                &tiles[band](lastRow - ii, lastCol);
+                        std::complex<float> lineSum(0.0f, 0.0f);
+                        for (int jj = 0; jj < sincLen; ++jj) {
+                            lineSum += chipLine[-jj] * rgKernel[jj];
+                        }
+                        cval += lineSum * azWeights[ii];
+                    }
 
-                // Add doppler to interpolated value and save
-                imgOut[tileLine * outWidth + j] =
-                        cval *
-                        std::complex<float>(std::cos(phase), std::sin(phase));
+                    // Add doppler to interpolated value and save
+                    imgOuts[band][tileLine * outWidth + j] = cval * cpxPhase;
+                }
 
             } // end for over width
-
-            // Update input line counter
-            _Pragma("omp single") { ++tileLine; }
-
         } // end for over length
 
     } // end multithreaded block
-
-    // Write block of data
-    outputSlc.setBlock(imgOut, 0, tile.rowStart(), outWidth, outLength);
 }
 
 }} // namespace isce3::image
@@ -3,15 +3,20 @@
 #include "forward.h"
 #include <isce3/io/forward.h>
 
+#include <algorithm>
 #include <complex>
 #include <cstdint>
 #include <cstdio>
+#include <functional>
+#include <mutex>
 #include <valarray>
+#include <vector>
 
 #include <pyre/journal.h>
 
 #include <isce3/core/Interpolator.h>
 #include <isce3/core/Poly2d.h>
+#include <isce3/image/OffsetModel.h>
 #include <isce3/product/RadarGridProduct.h>
 #include <isce3/product/RadarGridParameters.h>
 
@@ -111,6 +116,15 @@ public:
     size_t linesPerTile() const;
     void linesPerTile(size_t);
 
+    /** Get maximum number of tiles read ahead of, and waiting to be
+     *  written after, the tile being interpolated */
+    size_t tilesInFlight() const;
+
+    /** Set maximum number of tiles read ahead of, and waiting to be
+     *  written after, the tile being interpolated. Memory usage grows
+     *  with the number of tiles in flight. */
+    void tilesInFlight(size_t);
+
     /** Get flag for reference data */
     bool haveRefData() const { return _haveRefData; }
 
@@ -136,6 +150,63 @@ public:
                 bool flatten = false, int rowBuffer = 40,
                 int chipSize = isce3::core::SINC_ONE);
 
+    /* Multi-band resamp entry point from externally created rasters
+     *
+     * Resample several co-registered bands (e.g. polarizations) sharing
+     * the same offsets in a single pass. Offsets, interpolation positions,
+     * sinc weights, carrier and Doppler phases are computed once per output
+     * pixel and applied to all bands.
+     *
+     * \param[in] inputSlcs         input rasters of SLCs to be resampled
+     * \param[in] outputSlcs        output rasters of resampled SLCs
+     * \param[in] rgOffsetRaster    raster of range shift to be applied
+     * \param[in] azOffsetRaster    raster of azimuth shift to be applied
+     * \param[in] inputBands        band of each input raster to resample.
+     *                              If empty, band 1 of each input raster.
+     * \param[in] flatten           flag to flatten resampled SLCs
+     * \param[in] rowBuffer         number of rows excluded from top/bottom of azimuth
+     *                              raster while searching for min/max indices of
+     *                              resampled SLC
+     * \param[in] chipSize          size of chip used in sinc interpolation
+     */
+    void resamp(std::vector<std::reference_wrapper<isce3::io::Raster>> inputSlcs,
+                std::vector<std::reference_wrapper<isce3::io::Raster>> outputSlcs,
+                isce3::io::Raster& rgOffsetRaster,
+                isce3::io::Raster& azOffsetRaster,
+                std::vector<int> inputBands = {}, bool flatten = false,
+                int rowBuffer = 40, int chipSize = isce3::core::SINC_ONE);
+
+    /* Multi-band resamp entry point from offset models
+     *
+     * Same as the multi-band entry point from offset rasters, with the
+     * offsets given as models (e.g. a low-order polynomial fitted to dense
+     * offsets plus a coarse residual grid) evaluated on the fly for each
+     * tile instead of full resolution offset rasters.
+     *
+     * \param[in] inputSlcs         input rasters of SLCs to be resampled
+     * \param[in] outputSlcs        output rasters of resampled SLCs
+     * \param[in] rgOffsetModel     range shift to be applied, function of
+     *                              output line and pixel indices
+     * \param[in] azOffsetModel     azimuth shift to be applied, function of
+     *                              output line and pixel indices
+     * \param[in] outLength         number of lines of resampled SLCs
+     * \param[in] outWidth          number of pixels of resampled SLCs
+     * \param[in] inputBands        band of each input raster to resample.
+     *                              If empty, band 1 of each input raster.
+     * \param[in] flatten           flag to flatten resampled SLCs
+     * \param[in] rowBuffer         number of rows excluded from top/bottom of azimuth
+     *                              offsets while searching for min/max indices of
+     *                              resampled SLC
+     * \param[in] chipSize          size of chip used in sinc interpolation
+     */
+    void resamp(std::vector<std::reference_wrapper<isce3::io::Raster>> inputSlcs,
+                std::vector<std::reference_wrapper<isce3::io::Raster>> outputSlcs,
+                const OffsetModel& rgOffsetModel,
+                const OffsetModel& azOffsetModel, size_t outLength,
+                size_t outWidth, std::vector<int> inputBands = {},
+                bool flatten = false, int rowBuffer = 40,
+                int chipSize = isce3::core::SINC_ONE);
+
     /* Generic resamp entry point: use filenames to create rasters
      * internally in function.
      *
@@ -160,6 +231,8 @@ public:
 protected:
     // Number of lines per tile
     size_t _linesPerTile = 1000;
+    // Number of tiles in flight in each queue of the tile pipeline
+    size_t _tilesInFlight = 2;
     // Band number
     int _inputBand;
     // Filename of the input product
@@ -184,19 +257,47 @@ protected:
     double _refRangePixelSpacing;
     double _refWavelength;
 
+    // Fill the azimuth and range offset tiles matching an output tile. Raster
+    // accesses must hold the I/O mutex, which is not held on entry.
+    using OffsetTileLoader = std::function<void(const Tile_t&,
+            Tile<float>& azOffTile, Tile<float>& rgOffTile,
+            std::mutex& ioMutex)>;
+
+    // Tile pipeline shared by all multi-band resamp entry points
+    void _resamp(std::vector<std::reference_wrapper<isce3::io::Raster>> inputSlcs,
+                 std::vector<std::reference_wrapper<isce3::io::Raster>> outputSlcs,
+                 size_t outLength, size_t outWidth,
+                 const OffsetTileLoader& loadOffsets,
+                 std::vector<int> inputBands, bool flatten, int rowBuffer,
+                 int chipSize);
+
     // Tile initialization for input offsets
-    void _initializeOffsetTiles(Tile_t&, isce3::io::Raster&, isce3::io::Raster&,
-                                Tile<float>&, Tile<float>&, int);
+    void _initializeOffsetTiles(const Tile_t&, isce3::io::Raster&,
+                                isce3::io::Raster&, Tile<float>&, Tile<float>&,
+                                int, std::mutex&);
+
+    // Tile initialization for offsets evaluated from models
+    void _evaluateOffsetTiles(const Tile_t&, const OffsetModel&,
+                              const OffsetModel&, Tile<float>&, Tile<float>&,
+                              int);
+
+    // Allocate offset tiles matching an output tile
+    void _allocateOffsetTiles(const Tile_t&, Tile<float>&, Tile<float>&, int);
 
     // Tile initialization for input SLC data
     void _initializeTile(Tile_t&, isce3::io::Raster&, const Tile<float>&, int,
                          int, int);
 
-    // Tile transformation
-    void _transformTile(Tile_t& tile, isce3::io::Raster& outputSlc,
+    // Remove carrier from input SLC data of tiles sharing the same geometry
+    void _removeCarrier(Tile_t* tiles, size_t nTiles = 1);
+
+    // Transformation of the tiles of all bands
+    void _transformTile(const std::vector<Tile_t>& tiles,
+                        std::vector<std::valarray<std::complex<float>>>& imgOuts,
                         const Tile<float>& rgOffTile,
                         const Tile<float>& azOffTile, int inLength,
-                        bool flatten, int chipSize);
+                        bool flatten, int chipSize,
+                        const std::vector<float>& sincKernel);
 
     // Convenience functions
     int _computeNumberOfTiles(int, int);
@@ -2,6 +2,7 @@
 
 namespace isce3 { namespace image {
 
+    class OffsetModel;
     class ResampSlc;
 
     template<class> class Tile;
@@ -0,0 +1,138 @@
+#include "DataStream.h"
+
+#include <string>
+
+#include <pyre/journal.h>
+
+#include <isce3/except/Error.h>
+
+namespace isce3 { namespace io {
+
+DataStream::DataStream(std::size_t maxPending) :
+    _maxPending(maxPending), _thread([this]() { _run(); })
+{}
+
+DataStream::~DataStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _queueCondition.notify_all();
+    _thread.join();
+
+    if (_error) {
+        pyre::journal::warning_t warning("isce.io.DataStream");
+        try {
+            std::rethrow_exception(_error);
+        } catch (const std::exception& e) {
+            warning << pyre::journal::at(__HERE__)
+                    << "unchecked error of an I/O operation: " << e.what()
+                    << pyre::journal::endl;
+        } catch (...) {
+            warning << pyre::journal::at(__HERE__)
+                    << "unchecked error of an I/O operation"
+                    << pyre::journal::endl;
+        }
+    }
+}
+
+void DataStream::synchronize()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idleCondition.wait(lock, [this]() { return _pending == 0; });
+    if (_error) {
+        std::exception_ptr error = _error;
+        _error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+std::size_t DataStream::pending() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending;
+}
+
+void DataStream::_run()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _queueCondition.wait(lock,
+                    [this]() { return _stop || !_queue.empty(); });
+            // Pending operations are completed before stopping
+            if (_queue.empty())
+                return;
+            task = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_pending;
+        }
+        _idleCondition.notify_all();
+    }
+}
+
+void DataStream::_recordError(std::exception_ptr error)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_error)
+        _error = error;
+}
+
+void RasterDataStream::set_raster(Raster* raster)
+{
+    synchronize();
+    _raster = raster;
+}
+
+Raster& RasterDataStream::_attached() const
+{
+    if (!_raster) {
+        std::string errmsg = "no raster attached to the data stream";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+    return *_raster;
+}
+
+void H5DataStream::set_dataset(IDataSet* dataset)
+{
+    synchronize();
+    _dataset = dataset;
+}
+
+std::vector<std::slice> H5DataStream::_slices(std::size_t col,
+        std::size_t row, std::size_t width, std::size_t length,
+        std::size_t band) const
+{
+    if (!_dataset) {
+        std::string errmsg = "no dataset attached to the data stream";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    const int rank = _dataset->getRank();
+    if (rank != 2 && rank != 3) {
+        std::string errmsg = "data streams only support 2D or 3D datasets";
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), errmsg);
+    }
+
+    std::vector<std::slice> slices;
+    if (rank == 3) {
+        if (band < 1) {
+            std::string errmsg = "band index must be 1-based";
+            throw isce3::except::OutOfRange(ISCE_SRCINFO(), errmsg);
+        }
+        slices.emplace_back(band - 1, 1, 1);
+    }
+    slices.emplace_back(row, length, 1);
+    slices.emplace_back(col, width, 1);
+    return slices;
+}
+
+}} // namespace isce3::io
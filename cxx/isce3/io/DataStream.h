@@ -0,0 +1,264 @@
+#pragma once
+
+#include "forward.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <valarray>
+#include <vector>
+
+#include "IH5.h"
+#include "Raster.h"
+
+namespace isce3 { namespace io {
+
+/**
+ * Host-side stream of asynchronous I/O operations.
+ *
+ * Operations are executed in the order they were enqueued by a single
+ * background I/O thread, so that reading or writing blocks of data may
+ * overlap with computations on the calling threads. This is the CPU
+ * counterpart of isce3::cuda::io::RasterDataStream.
+ *
+ * Each operation returns a std::future that becomes ready, or holds the
+ * exception thrown by the operation, once the operation completed.
+ * Arbitrary callables (e.g. callbacks) may be enqueued between I/O
+ * operations with enqueue(). The first error of an operation is also
+ * rethrown by synchronize().
+ *
+ * The number of pending operations may be bounded, so that producers
+ * faster than the I/O thread wait for it instead of queueing an unbounded
+ * amount of data.
+ */
+class DataStream {
+public:
+    /**
+     * Constructor. Starts the I/O thread.
+     *
+     * @param[in] maxPending maximum number of pending operations. enqueue()
+     * waits for the I/O thread while it is reached, so that operations of a
+     * bounded stream must not enqueue other operations. Unbounded if zero.
+     */
+    explicit DataStream(std::size_t maxPending = 0);
+
+    /** Destructor. Waits for all enqueued operations to complete. */
+    virtual ~DataStream();
+
+    DataStream(const DataStream&) = delete;
+    DataStream& operator=(const DataStream&) = delete;
+
+    /**
+     * Enqueue a callable to be executed by the I/O thread after all
+     * previously enqueued operations.
+     *
+     * @param[in] task callable taking no arguments
+     * @returns future holding the result of the callable
+     */
+    template<class F>
+    std::future<std::invoke_result_t<std::decay_t<F>&>> enqueue(F&& task);
+
+    /**
+     * Wait for all enqueued operations to complete.
+     *
+     * \throws the first exception thrown by an operation since the last
+     * call to synchronize()
+     */
+    void synchronize();
+
+    /** Number of enqueued operations that have not completed */
+    std::size_t pending() const;
+
+private:
+    // I/O thread loop
+    void _run();
+
+    // Keep the first error of an operation
+    void _recordError(std::exception_ptr error);
+
+    std::size_t _maxPending;
+    mutable std::mutex _mutex;
+    std::condition_variable _queueCondition;
+    std::condition_variable _idleCondition;
+    std::deque<std::function<void()>> _queue;
+    // number of enqueued operations that have not completed
+    std::size_t _pending = 0;
+    std::exception_ptr _error;
+    bool _stop = false;
+    std::thread _thread;
+};
+
+/**
+ * Utility class for asynchronously reading/writing blocks of a Raster.
+ *
+ * Blocks of other rasters may also be read or written on the same stream,
+ * so that all accesses to rasters that must not be accessed concurrently
+ * (e.g. GDAL datasets shared by several rasters) go through its I/O
+ * thread. The rasters must not be accessed by other threads while
+ * operations are pending.
+ */
+class RasterDataStream : public DataStream {
+public:
+    RasterDataStream() = default;
+
+    /**
+     * Constructor
+     *
+     * @param[in] raster pointer to raster
+     */
+    explicit RasterDataStream(Raster* raster) : _raster(raster) {}
+
+    /** Get pointer to Raster object. */
+    Raster* raster() const { return _raster; }
+
+    /** Set raster, after completion of all enqueued operations. */
+    void set_raster(Raster* raster);
+
+    /**
+     * Read a block of data from the Raster asynchronously.
+     *
+     * The destination buffer must remain valid until the returned future is
+     * ready.
+     *
+     * @param[in] dst destination buffer of width x length elements
+     * @param[in] col index of first column to read
+     * @param[in] row index of first row to read
+     * @param[in] width number of columns to read
+     * @param[in] length number of rows to read
+     * @param[in] band band index (1-based)
+     */
+    template<typename T>
+    std::future<void> load(T* dst, std::size_t col, std::size_t row,
+                           std::size_t width, std::size_t length,
+                           std::size_t band = 1);
+
+    /**
+     * Write a block of data to the Raster asynchronously.
+     *
+     * The source data is copied before returning, so that the source buffer
+     * may be reused immediately.
+     *
+     * @param[in] src source buffer of width x length elements
+     * @param[in] col index of first column to write
+     * @param[in] row index of first row to write
+     * @param[in] width number of columns to write
+     * @param[in] length number of rows to write
+     * @param[in] band band index (1-based)
+     */
+    template<typename T>
+    std::future<void> store(const T* src, std::size_t col, std::size_t row,
+                            std::size_t width, std::size_t length,
+                            std::size_t band = 1);
+
+    /**
+     * Read a block of data from another Raster asynchronously.
+     *
+     * The raster and the destination buffer must remain valid until the
+     * returned future is ready.
+     */
+    template<typename T>
+    std::future<void> load(Raster& raster, T* dst, std::size_t col,
+                           std::size_t row, std::size_t width,
+                           std::size_t length, std::size_t band = 1);
+
+    /**
+     * Write a block of data to another Raster asynchronously.
+     *
+     * The raster must remain valid until the returned future is ready. The
+     * source data is copied before returning.
+     */
+    template<typename T>
+    std::future<void> store(Raster& raster, const T* src, std::size_t col,
+                            std::size_t row, std::size_t width,
+                            std::size_t length, std::size_t band = 1);
+
+private:
+    // Raster attached to the stream
+    Raster& _attached() const;
+
+    Raster* _raster = nullptr;
+};
+
+/**
+ * Utility class for asynchronously reading/writing blocks of a 2D or 3D
+ * HDF5 dataset.
+ *
+ * Blocks are windows of the two fastest-varying dimensions. For 3D
+ * datasets, the band is the index along the first dimension.
+ *
+ * HDF5 is not thread-safe: the dataset, and any other HDF5 object, must
+ * not be accessed by other threads while operations are pending.
+ */
+class H5DataStream : public DataStream {
+public:
+    H5DataStream() = default;
+
+    /**
+     * Constructor
+     *
+     * @param[in] dataset pointer to dataset
+     */
+    explicit H5DataStream(IDataSet* dataset) : _dataset(dataset) {}
+
+    /** Get pointer to dataset. */
+    IDataSet* dataset() const { return _dataset; }
+
+    /** Set dataset, after completion of all enqueued operations. */
+    void set_dataset(IDataSet* dataset);
+
+    /**
+     * Read a block of data from the dataset asynchronously.
+     *
+     * The destination buffer must remain valid until the returned future is
+     * ready.
+     *
+     * @param[in] dst destination buffer of width x length elements
+     * @param[in] col index of first column to read
+     * @param[in] row index of first row to read
+     * @param[in] width number of columns to read
+     * @param[in] length number of rows to read
+     * @param[in] band band index (1-based), ignored for 2D datasets
+     */
+    template<typename T>
+    std::future<void> load(T* dst, std::size_t col, std::size_t row,
+                           std::size_t width, std::size_t length,
+                           std::size_t band = 1);
+
+    /**
+     * Write a block of data to the dataset asynchronously.
+     *
+     * The source data is copied before returning, so that the source buffer
+     * may be reused immediately.
+     *
+     * @param[in] src source buffer of width x length elements
+     * @param[in] col index of first column to write
+     * @param[in] row index of first row to write
+     * @param[in] width number of columns to write
+     * @param[in] length number of rows to write
+     * @param[in] band band index (1-based), ignored for 2D datasets
+     */
+    template<typename T>
+    std::future<void> store(const T* src, std::size_t col, std::size_t row,
+                            std::size_t width, std::size_t length,
+                            std::size_t band = 1);
+
+private:
+    // Slices of a block of the dataset
+    std::vector<std::slice> _slices(std::size_t col, std::size_t row,
+                                    std::size_t width, std::size_t length,
+                                    std::size_t band) const;
+
+    IDataSet* _dataset = nullptr;
+};
+
+}} // namespace isce3::io
+
+#define ISCE_IO_DATASTREAM_ICC
+#include "DataStream.icc"
+#undef ISCE_IO_DATASTREAM_ICC
@@ -1,5 +1,17 @@
 #include "IH5.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <type_traits>
+
+#ifdef ISCE3_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 #include <isce3/core/Constants.h>
 
 ///////////////////////// UTILITIES ///////////////////////////////////
@@ -17,6 +29,117 @@ inline unsigned int mapFileAccessMode(const char mode) {
     }
 }
 
+// Filter pipeline of a chunked dataset handled by direct chunk I/O: the
+// index in the pipeline of the shuffle and deflate filters, -1 if absent
+struct ChunkFilters {
+    int shuffle = -1;
+    int deflate = -1;
+    int deflateLevel = 0;
+};
+
+// Parse the filter pipeline of a dataset. Returns false if it has filters
+// other than shuffle and/or deflate, in this order.
+inline bool parseChunkFilters(const H5::DSetCreatPropList& plist,
+                              ChunkFilters& filters) {
+    const int nfilters = plist.getNfilters();
+    for (int i = 0; i < nfilters; ++i) {
+        unsigned int flags, config;
+        unsigned int cdValues[8];
+        size_t cdNelmts = 8;
+        char name[64];
+        const H5Z_filter_t filter = H5Pget_filter2(plist.getId(), i, &flags,
+                &cdNelmts, cdValues, sizeof(name), name, &config);
+        if (filter == H5Z_FILTER_SHUFFLE && filters.shuffle < 0 &&
+            filters.deflate < 0) {
+            filters.shuffle = i;
+        } else if (filter == H5Z_FILTER_DEFLATE && filters.deflate < 0 &&
+                   cdNelmts >= 1) {
+            filters.deflate = i;
+            filters.deflateLevel = cdValues[0];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Dataset access properties with a chunk cache holding the chunks touched
+// by reads of the dataset with the given pattern
+inline H5::DSetAccPropList chunkCacheAccessPlist(const H5::DataSet& dset,
+        isce3::io::ChunkLayout readPattern) {
+
+    H5::DSetAccPropList dapl;
+    const H5::DSetCreatPropList plist = dset.getCreatePlist();
+    const int rank = dset.getSpace().getSimpleExtentNdims();
+    if (plist.getLayout() != H5D_CHUNKED || rank < 1)
+        return dapl;
+
+    std::vector<hsize_t> dims(rank), chunk(rank);
+    dset.getSpace().getSimpleExtentDims(dims.data());
+    plist.getChunk(rank, chunk.data());
+
+    size_t chunkBytes = dset.getDataType().getSize();
+    for (int i = 0; i < rank; ++i)
+        chunkBytes *= chunk[i];
+
+    size_t nchunks;
+    double w0;
+    if (readPattern == isce3::io::ChunkLayout::Rows) {
+        // Line-by-line reads go through a full row of chunks, and each chunk
+        // is entirely read once the last of its rows is: evict those first
+        nchunks = (dims[rank - 1] + chunk[rank - 1] - 1) / chunk[rank - 1];
+        w0 = 1.0;
+    } else {
+        // A block straddles at most four chunks
+        nchunks = 4;
+        w0 = 0.75;
+    }
+    nchunks = std::clamp<size_t>(nchunks, 1,
+            std::max<size_t>(isce3::io::chunkCacheMaxBytes / chunkBytes, 1));
+
+    // Hash table with a prime number of slots about 100 times the number of
+    // cached chunks, as recommended by the HDF5 documentation
+    size_t nslots = 100 * nchunks + 1;
+    auto isPrime = [](size_t n) {
+        for (size_t d = 3; d * d <= n; d += 2)
+            if (n % d == 0)
+                return false;
+        return true;
+    };
+    while (!isPrime(nslots))
+        nslots += 2;
+
+    dapl.setChunkCache(nslots, nchunks * chunkBytes, w0);
+    return dapl;
+}
+
+// Round the mantissa of a finite value to nearest, ties to even, dropping
+// its dropBits least significant bits, and accumulate the error
+template<typename F>
+inline void roundMantissaBits(F& value, int dropBits,
+                              isce3::io::QuantizationError& error) {
+    using U = std::conditional_t<sizeof(F) == 4, std::uint32_t, std::uint64_t>;
+    if (!std::isfinite(value))
+        return;
+
+    U bits;
+    std::memcpy(&bits, &value, sizeof(F));
+    const U half = U(1) << (dropBits - 1);
+    bits += half - 1 + ((bits >> dropBits) & 1);
+    bits &= ~((U(1) << dropBits) - 1);
+    F rounded;
+    std::memcpy(&rounded, &bits, sizeof(F));
+
+    const double diff = std::abs(static_cast<double>(rounded) - value);
+    ++error.count;
+    error.maxAbsolute = std::max(error.maxAbsolute, diff);
+    if (value != 0)
+        error.maxRelative = std::max(error.maxRelative,
+                                     diff / std::abs(static_cast<double>(value)));
+    error.sumSquared += diff * diff;
+    value = rounded;
+}
+
 // The first argument refers to the H5Object that gets used to call
 // this function as an operator.
 void attrsNames(H5::H5Object&, H5std_string nameAttr, void* opdata) {
@@ -306,6 +429,427 @@ std::vector<int> isce3::io::IDataSet::getChunkSize() {
     return out;
 }
 
+std::vector<hsize_t> isce3::io::chunkDimensions(
+        const std::vector<hsize_t>& dims, size_t elementSize,
+        ChunkLayout layout) {
+
+    std::vector<hsize_t> chunks(dims.size(), 1);
+    if (dims.empty())
+        return chunks;
+
+    const hsize_t targetElements =
+            std::max<hsize_t>(chunkTargetBytes / std::max<size_t>(elementSize, 1), 1);
+
+    // 1D dataset: a single run of elements
+    if (dims.size() == 1) {
+        chunks[0] = std::clamp<hsize_t>(targetElements, 1, dims[0]);
+        return chunks;
+    }
+
+    // Only chunk the two fastest-varying dimensions (rows, columns)
+    const size_t rowDim = dims.size() - 2;
+    const size_t colDim = dims.size() - 1;
+    const hsize_t nrows = std::max<hsize_t>(dims[rowDim], 1);
+    const hsize_t ncols = std::max<hsize_t>(dims[colDim], 1);
+
+    if (layout == ChunkLayout::Rows) {
+        // Full-width blocks of rows
+        chunks[colDim] = ncols;
+        chunks[rowDim] = std::clamp<hsize_t>(targetElements / ncols, 1, nrows);
+    } else {
+        // Square tiles, with a power of two side
+        hsize_t side = 1;
+        while (4 * side * side <= targetElements)
+            side *= 2;
+        chunks[colDim] = std::min(side, ncols);
+        chunks[rowDim] = std::clamp<hsize_t>(
+                targetElements / chunks[colDim], 1, std::min(side, nrows));
+    }
+    return chunks;
+}
+
+isce3::io::QuantizationError& isce3::io::QuantizationError::operator+=(
+        const QuantizationError& other) {
+    count += other.count;
+    maxAbsolute = std::max(maxAbsolute, other.maxAbsolute);
+    maxRelative = std::max(maxRelative, other.maxRelative);
+    sumSquared += other.sumSquared;
+    return *this;
+}
+
+template<typename T>
+isce3::io::QuantizationError isce3::io::roundMantissa(T* data, size_t size,
+                                                      int significantBits) {
+
+    using F = typename isce3::real<T>::type;
+    constexpr int mantissaBits = std::numeric_limits<F>::digits - 1;
+    if (significantBits < 1) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "Number of significant bits must be positive");
+    }
+
+    QuantizationError error;
+    if (significantBits >= mantissaBits)
+        return error;
+    const int dropBits = mantissaBits - significantBits;
+
+    // Real and imaginary parts of complex values are rounded separately
+    F* values = reinterpret_cast<F*>(data);
+    const size_t nvalues = size * (sizeof(T) / sizeof(F));
+
+    _Pragma("omp parallel")
+    {
+        QuantizationError threadError;
+        _Pragma("omp for")
+        for (size_t i = 0; i < nvalues; ++i)
+            roundMantissaBits(values[i], dropBits, threadError);
+        _Pragma("omp critical")
+        error += threadError;
+    }
+    return error;
+}
+
+template isce3::io::QuantizationError isce3::io::roundMantissa(
+        float*, size_t, int);
+template isce3::io::QuantizationError isce3::io::roundMantissa(
+        double*, size_t, int);
+template isce3::io::QuantizationError isce3::io::roundMantissa(
+        std::complex<float>*, size_t, int);
+template isce3::io::QuantizationError isce3::io::roundMantissa(
+        std::complex<double>*, size_t, int);
+
+/** @param[in] significantBits Number of explicit mantissa bits kept, or
+ *  zero to disable rounding */
+void isce3::io::IDataSet::setSignificantBits(int significantBits) {
+
+    if (significantBits < 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+                "Number of significant bits cannot be negative");
+    }
+    if (attrExists(significantBitsAttribute))
+        removeAttr(significantBitsAttribute);
+    if (significantBits > 0)
+        createAttribute(significantBitsAttribute, significantBits);
+    _significantBits = significantBits;
+}
+
+int isce3::io::IDataSet::getSignificantBits() {
+
+    // Every write checks the setting, so the attribute is only read once
+    if (_significantBits < 0) {
+        _significantBits = 0;
+        if (attrExists(significantBitsAttribute))
+            read(_significantBits, significantBitsAttribute);
+    }
+    return _significantBits;
+}
+
+bool isce3::io::IDataSet::writeFilteredChunks(const void* buf,
+                                              size_t elementSize) {
+
+#if H5_VERSION_GE(1, 10, 3)
+    // Only full 2D chunked datasets
+    H5::DSetCreatPropList plist = getCreatePlist();
+    if (plist.getLayout() != H5D_CHUNKED || getRank() != 2)
+        return false;
+
+    // Only shuffle and/or deflate, in this order
+    ChunkFilters filters;
+    if (!parseChunkFilters(plist, filters))
+        return false;
+#ifndef ISCE3_HAVE_ZLIB
+    // Without zlib, deflated chunks go through the HDF5 filter pipeline
+    if (filters.deflate >= 0)
+        return false;
+#endif
+    const bool shuffle = filters.shuffle >= 0;
+    const int deflateLevel = filters.deflate >= 0 ? filters.deflateLevel : -1;
+
+    hsize_t dims[2], chunk[2];
+    getSpace().getSimpleExtentDims(dims);
+    plist.getChunk(2, chunk);
+
+    const hsize_t nChunkRows = (dims[0] + chunk[0] - 1) / chunk[0];
+    const hsize_t nChunkCols = (dims[1] + chunk[1] - 1) / chunk[1];
+    const size_t chunkBytes = chunk[0] * chunk[1] * elementSize;
+    const auto* bytes = static_cast<const std::uint8_t*>(buf);
+
+    // Largest size of a filtered chunk
+    size_t filteredBytes = chunkBytes;
+#ifdef ISCE3_HAVE_ZLIB
+    if (deflateLevel >= 0)
+        filteredBytes = compressBound(chunkBytes);
+#endif
+
+    // Filter batches of chunk rows on all threads, then write them. Batches
+    // hold as many rows of filtered chunks as fit in chunkBatchMaxBytes.
+    const hsize_t batchRows = std::min(nChunkRows, std::max<hsize_t>(1,
+            chunkBatchMaxBytes / (nChunkCols * filteredBytes)));
+    std::vector<std::vector<std::uint8_t>> filtered(batchRows * nChunkCols);
+    for (hsize_t cr0 = 0; cr0 < nChunkRows; cr0 += batchRows) {
+
+        const hsize_t nChunks = std::min(batchRows, nChunkRows - cr0) *
+                                nChunkCols;
+        std::exception_ptr error;
+        _Pragma("omp parallel for schedule(dynamic)")
+        for (hsize_t k = 0; k < nChunks; ++k) {
+            try {
+                // Copy the chunk, padding edge chunks with zeros
+                std::vector<std::uint8_t> raw(chunkBytes, 0);
+                const hsize_t row0 = (cr0 + k / nChunkCols) * chunk[0];
+                const hsize_t col0 = (k % nChunkCols) * chunk[1];
+                const hsize_t nrows = std::min(chunk[0], dims[0] - row0);
+                const hsize_t ncols = std::min(chunk[1], dims[1] - col0);
+                for (hsize_t i = 0; i < nrows; ++i) {
+                    std::memcpy(&raw[i * chunk[1] * elementSize],
+                            bytes + ((row0 + i) * dims[1] + col0) * elementSize,
+                            ncols * elementSize);
+                }
+
+                // Byte shuffling: all first bytes, then all second bytes...
+                if (shuffle && elementSize > 1) {
+                    std::vector<std::uint8_t> shuffled(chunkBytes);
+                    const size_t nelements = chunk[0] * chunk[1];
+                    for (size_t e = 0; e < nelements; ++e)
+                        for (size_t b = 0; b < elementSize; ++b)
+                            shuffled[b * nelements + e] =
+                                    raw[e * elementSize + b];
+                    raw.swap(shuffled);
+                }
+
+#ifdef ISCE3_HAVE_ZLIB
+                // Deflate with the same zlib stream format as the HDF5 filter
+                if (deflateLevel >= 0) {
+                    uLongf nbytes = filteredBytes;
+                    std::vector<std::uint8_t> compressed(nbytes);
+                    if (compress2(compressed.data(), &nbytes, raw.data(),
+                                  chunkBytes, deflateLevel) != Z_OK) {
+                        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                                "Chunk compression failed");
+                    }
+                    compressed.resize(nbytes);
+                    raw.swap(compressed);
+                }
+#endif
+                filtered[k].swap(raw);
+            } catch (...) {
+                _Pragma("omp critical")
+                error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+
+        for (hsize_t k = 0; k < nChunks; ++k) {
+            const hsize_t offset[2] = {(cr0 + k / nChunkCols) * chunk[0],
+                                       (k % nChunkCols) * chunk[1]};
+            if (H5Dwrite_chunk(getId(), H5P_DEFAULT, 0, offset,
+                               filtered[k].size(), filtered[k].data()) < 0) {
+                throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                        "Direct chunk write failed");
+            }
+            std::vector<std::uint8_t>().swap(filtered[k]);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool isce3::io::IDataSet::readChunks(void* buf,
+                                     const std::vector<hsize_t>& start,
+                                     const std::vector<hsize_t>& count) {
+
+#if H5_VERSION_GE(1, 10, 2)
+    const int rank = getRank();
+    H5::DSetCreatPropList plist = getCreatePlist();
+    if (rank < 2 || plist.getLayout() != H5D_CHUNKED ||
+        start.size() != static_cast<size_t>(rank) ||
+        count.size() != static_cast<size_t>(rank))
+        return false;
+
+    ChunkFilters filters;
+    if (!parseChunkFilters(plist, filters))
+        return false;
+#ifndef ISCE3_HAVE_ZLIB
+    // Without zlib, deflated chunks go through the HDF5 filter pipeline
+    if (filters.deflate >= 0)
+        return false;
+#endif
+
+    // Chunks are read as raw bytes: the file type must be the native type
+    H5::DataType fileType = getDataType();
+    const hid_t nativeId = H5Tget_native_type(fileType.getId(),
+                                              H5T_DIR_ASCEND);
+    if (nativeId < 0)
+        return false;
+    const bool isNative = H5Tequal(fileType.getId(), nativeId) > 0;
+    H5Tclose(nativeId);
+    if (!isNative)
+        return false;
+    const size_t elementSize = fileType.getSize();
+
+    std::vector<hsize_t> dims(rank), chunk(rank);
+    getSpace().getSimpleExtentDims(dims.data());
+    plist.getChunk(rank, chunk.data());
+
+    const int rowDim = rank - 2;
+    const int colDim = rank - 1;
+    for (int i = 0; i < rank; ++i) {
+        if (count[i] == 0 || start[i] + count[i] > dims[i] ||
+            (i < rowDim && count[i] != 1))
+            return false;
+    }
+
+    // Chunk offset of the window in the leading dimensions, and offset in
+    // elements of the window plane within those chunks
+    std::vector<hsize_t> offset(rank);
+    size_t chunkElements = 1;
+    size_t planeOffset = 0;
+    for (int i = 0; i < rowDim; ++i) {
+        offset[i] = start[i] / chunk[i] * chunk[i];
+        planeOffset = planeOffset * chunk[i] + (start[i] - offset[i]);
+        chunkElements *= chunk[i];
+    }
+    const size_t planeElements = chunk[rowDim] * chunk[colDim];
+    planeOffset *= planeElements;
+    chunkElements *= planeElements;
+    const size_t chunkBytes = chunkElements * elementSize;
+
+    const hsize_t firstChunkRow = start[rowDim] / chunk[rowDim];
+    const hsize_t lastChunkRow = (start[rowDim] + count[rowDim] - 1) /
+                                 chunk[rowDim];
+    const hsize_t firstChunkCol = start[colDim] / chunk[colDim];
+    const hsize_t lastChunkCol = (start[colDim] + count[colDim] - 1) /
+                                 chunk[colDim];
+    const hsize_t nChunkCols = lastChunkCol - firstChunkCol + 1;
+
+    // Stored size of each chunk of the window; chunks never written have no
+    // storage and would have to be filled with the fill value
+    std::vector<hsize_t> storageSize(
+            (lastChunkRow - firstChunkRow + 1) * nChunkCols);
+    for (hsize_t cr = firstChunkRow; cr <= lastChunkRow; ++cr) {
+        for (hsize_t cc = firstChunkCol; cc <= lastChunkCol; ++cc) {
+            offset[rowDim] = cr * chunk[rowDim];
+            offset[colDim] = cc * chunk[colDim];
+            hsize_t& nbytes = storageSize[(cr - firstChunkRow) * nChunkCols +
+                                          cc - firstChunkCol];
+            herr_t status;
+            H5E_BEGIN_TRY {
+                status = H5Dget_chunk_storage_size(getId(), offset.data(),
+                                                   &nbytes);
+            } H5E_END_TRY;
+            if (status < 0 || nbytes == 0)
+                return false;
+        }
+    }
+
+    // Read batches of chunk rows, then inflate them on all threads. Batches
+    // hold as many rows of stored chunks as fit in chunkBatchMaxBytes.
+    auto* out = static_cast<std::uint8_t*>(buf);
+    const hsize_t nChunks = storageSize.size();
+    std::vector<std::vector<std::uint8_t>> raw(nChunks);
+    std::vector<uint32_t> filterMask(nChunks);
+    for (hsize_t k0 = 0; k0 < nChunks;) {
+
+        // Read the raw chunks of the batch
+        size_t batchBytes = 0;
+        hsize_t k1 = k0;
+        while (k1 < nChunks) {
+            size_t rowBytes = 0;
+            for (hsize_t k = k1; k < k1 + nChunkCols; ++k)
+                rowBytes += storageSize[k];
+            if (k1 > k0 && batchBytes + rowBytes > chunkBatchMaxBytes)
+                break;
+            batchBytes += rowBytes;
+            k1 += nChunkCols;
+        }
+        for (hsize_t k = k0; k < k1; ++k) {
+            offset[rowDim] = (firstChunkRow + k / nChunkCols) * chunk[rowDim];
+            offset[colDim] = (firstChunkCol + k % nChunkCols) * chunk[colDim];
+            raw[k].resize(storageSize[k]);
+            if (H5Dread_chunk(getId(), H5P_DEFAULT, offset.data(),
+                              &filterMask[k], raw[k].data()) < 0) {
+                throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                        "Direct chunk read failed");
+            }
+        }
+
+        // Inflate them on all threads, copying their part of the window
+        std::exception_ptr error;
+        _Pragma("omp parallel for schedule(dynamic)")
+        for (hsize_t k = k0; k < k1; ++k) {
+            try {
+                std::vector<std::uint8_t>& data = raw[k];
+
+#ifdef ISCE3_HAVE_ZLIB
+                // A set bit of the filter mask marks a skipped filter
+                if (filters.deflate >= 0 &&
+                    !(filterMask[k] & (1u << filters.deflate))) {
+                    std::vector<std::uint8_t> inflated(chunkBytes);
+                    uLongf nbytes = chunkBytes;
+                    if (uncompress(inflated.data(), &nbytes, data.data(),
+                                   data.size()) != Z_OK ||
+                        nbytes != chunkBytes) {
+                        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                                "Chunk decompression failed");
+                    }
+                    data.swap(inflated);
+                }
+#endif
+                if (data.size() != chunkBytes) {
+                    throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                            "Unexpected chunk size");
+                }
+
+                // Byte unshuffling of the whole chunk
+                if (filters.shuffle >= 0 && elementSize > 1 &&
+                    !(filterMask[k] & (1u << filters.shuffle))) {
+                    std::vector<std::uint8_t> unshuffled(chunkBytes);
+                    for (size_t e = 0; e < chunkElements; ++e)
+                        for (size_t b = 0; b < elementSize; ++b)
+                            unshuffled[e * elementSize + b] =
+                                    data[b * chunkElements + e];
+                    data.swap(unshuffled);
+                }
+
+                const hsize_t cr = firstChunkRow + k / nChunkCols;
+                const hsize_t cc = firstChunkCol + k % nChunkCols;
+                const hsize_t row0 = std::max(start[rowDim],
+                                              cr * chunk[rowDim]);
+                const hsize_t row1 = std::min(start[rowDim] + count[rowDim],
+                                              (cr + 1) * chunk[rowDim]);
+                const hsize_t col0 = std::max(start[colDim],
+                                              cc * chunk[colDim]);
+                const hsize_t col1 = std::min(start[colDim] + count[colDim],
+                                              (cc + 1) * chunk[colDim]);
+                for (hsize_t row = row0; row < row1; ++row) {
+                    const size_t src = planeOffset +
+                            (row - cr * chunk[rowDim]) * chunk[colDim] +
+                            col0 - cc * chunk[colDim];
+                    const size_t dst = (row - start[rowDim]) * count[colDim] +
+                                       col0 - start[colDim];
+                    std::memcpy(out + dst * elementSize,
+                                data.data() + src * elementSize,
+                                (col1 - col0) * elementSize);
+                }
+                std::vector<std::uint8_t>().swap(data);
+            } catch (...) {
+                _Pragma("omp critical")
+                error = std::current_exception();
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+        k0 = k1;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
 /** @param[in] v Name of the attribute (optional).
  *  Returns the actual number of bit used to store the current dataset or given
  *  attribute data in the file. */
@@ -862,6 +1406,19 @@ isce3::io::IDataSet isce3::io::IGroup::openDataSet(const H5std_string& name) {
     return H5::Group::openDataSet(name);
 }
 
+/** @param[in] name        Name of the dataset to open.
+ *  @param[in] readPattern Pattern of the reads of the dataset.
+ *
+ * The chunk cache is sized to hold a full-width row of chunks for
+ * line-by-line reads, or the chunks straddled by a block for block-wise
+ * reads. The cache settings are ignored if the dataset is already open. */
+isce3::io::IDataSet isce3::io::IGroup::openDataSet(const H5std_string& name,
+        ChunkLayout readPattern) {
+    const H5::DSetAccPropList dapl =
+            chunkCacheAccessPlist(H5::Group::openDataSet(name), readPattern);
+    return H5::Group::openDataSet(name, dapl);
+}
+
 /** @param[in] name Name of the group to open.
  *
  * name must contain the full path from root location and name of the group
@@ -1021,6 +1578,20 @@ isce3::io::IDataSet isce3::io::IH5File::openDataSet(const H5std_string& name) {
     return H5::H5File::openDataSet(name);
 }
 
+/** @param[in] name        Name of the dataset to open.
+ *  @param[in] readPattern Pattern of the reads of the dataset.
+ *
+ * name must contain the full path from root location and name of the dataset
+ * to open. The chunk cache is sized to hold a full-width row of chunks for
+ * line-by-line reads, or the chunks straddled by a block for block-wise
+ * reads. The cache settings are ignored if the dataset is already open. */
+isce3::io::IDataSet isce3::io::IH5File::openDataSet(const H5std_string& name,
+        ChunkLayout readPattern) {
+    const H5::DSetAccPropList dapl =
+            chunkCacheAccessPlist(H5::H5File::openDataSet(name), readPattern);
+    return H5::H5File::openDataSet(name, dapl);
+}
+
 /** @param[in] name Name of the group to open.
  *
  * name must contain the full path from root location and name of the group
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <H5Cpp.h>
+#include <cmath>
 #include <complex>
 #include <iostream>
 #include <isce3/core/Constants.h>
@@ -20,6 +21,76 @@ namespace io {
 const hsize_t chunkSizeX = 128;
 const hsize_t chunkSizeY = 128;
 
+// Target size in bytes of chunks selected by chunkDimensions
+const size_t chunkTargetBytes = 1 << 20;
+
+/** Access pattern of a 2D dataset used to select its chunk shape */
+enum class ChunkLayout {
+    /** Square tiles, for block-wise access */
+    Tiles,
+    /** Full-width blocks of rows, for line-by-line access */
+    Rows
+};
+
+/** Select chunk dimensions of about chunkTargetBytes bytes matched to the
+ *  access pattern of a dataset. Only the two fastest-varying dimensions are
+ *  chunked; chunks are clamped to the dataset dimensions.
+ *
+ * @param[in] dims          Dimensions of the dataset
+ * @param[in] elementSize   Size in bytes of each element
+ * @param[in] layout        Access pattern of the dataset
+ */
+std::vector<hsize_t> chunkDimensions(const std::vector<hsize_t>& dims,
+                                     size_t elementSize,
+                                     ChunkLayout layout = ChunkLayout::Tiles);
+
+// Upper bound in bytes of chunk caches sized for a read pattern
+const size_t chunkCacheMaxBytes = 1 << 28;
+
+// Upper bound in bytes of the chunks filtered or inflated together by
+// writeChunks and readChunks; batches hold at least one row of chunks
+const size_t chunkBatchMaxBytes = 1 << 28;
+
+// Attribute holding the number of significant mantissa bits kept when
+// writing floating point data, named as in netCDF for compatibility
+const std::string significantBitsAttribute =
+        "_QuantizeBitRoundNumberOfSignificantBits";
+
+/** Error introduced by rounding floating point mantissas */
+struct QuantizationError {
+    /** Number of rounded values, counting real and imaginary parts of
+     *  complex values separately */
+    size_t count = 0;
+    /** Maximum absolute error */
+    double maxAbsolute = 0.0;
+    /** Maximum error relative to the magnitude of the original value */
+    double maxRelative = 0.0;
+    /** Sum of squared errors */
+    double sumSquared = 0.0;
+
+    /** Root mean square error */
+    double rms() const { return count ? std::sqrt(sumSquared / count) : 0.0; }
+
+    /** Accumulate the errors of another rounding */
+    QuantizationError& operator+=(const QuantizationError& other);
+};
+
+/** Round the mantissa of floating point values to a number of significant
+ *  bits (bit rounding: to nearest, ties to even). The dropped mantissa bits
+ *  are zero so that the values compress much better with shuffle and
+ *  deflate filters. NaN and infinite values are unchanged; the real and
+ *  imaginary parts of complex values are rounded separately.
+ *
+ * @param[in,out] data          Values to round
+ * @param[in] size              Number of values
+ * @param[in] significantBits   Number of explicit mantissa bits kept.
+ *                              Values are unchanged if it is at least the
+ *                              mantissa size of T (23 or 52).
+ * @returns Error introduced by the rounding
+ */
+template<typename T>
+QuantizationError roundMantissa(T* data, size_t size, int significantBits);
+
 // String length (fixed-length string by default in file)
 const int STRLENGTH = 50;
 
@@ -79,6 +150,22 @@ public:
     /** Generate GDALDataset Representation */
     std::string toGDAL() const;
 
+    /** Set the number of significant mantissa bits kept when writing
+     *  floating point data to the dataset (see roundMantissa). The setting
+     *  is stored as an attribute of the dataset. Zero disables rounding. */
+    void setSignificantBits(int significantBits);
+
+    /** Get the number of significant mantissa bits kept when writing
+     *  floating point data to the dataset, zero if writes are lossless. The
+     *  attribute is read once and cached by this object. */
+    int getSignificantBits();
+
+    /** Error introduced by mantissa rounding of writes through this object */
+    const QuantizationError& quantizationError() const
+    {
+        return _quantizationError;
+    }
+
     // Dataset reading queries
 
     /** Reading scalar (non string) dataset or attributes */
@@ -226,6 +313,25 @@ public:
     /** Writing a raw pointer buffer into a dataset */
     template<typename T> inline void write(const T* buf, const size_t sz);
 
+    /** Writing a raw pointer buffer into a full 2D dataset, filtering
+     * (shuffling and compressing) its chunks in parallel */
+    template<typename T> inline void writeChunks(const T* buf, const size_t sz);
+
+    /** Reading a window of a chunked dataset into a raw buffer of its native
+     *  type, inflating (decompressing and unshuffling) the chunks covering
+     *  the window in parallel.
+     *
+     *  Only the two fastest-varying dimensions of the window may have a
+     *  count larger than one. Returns false, without reading, if the dataset
+     *  layout, type or filters are not supported or if a chunk of the window
+     *  was never written.
+     *
+     * @param[out] buf      Buffer of count[rank-2] x count[rank-1] elements
+     * @param[in] start     Start of the window in each dimension
+     * @param[in] count     Size of the window in each dimension */
+    bool readChunks(void* buf, const std::vector<hsize_t>& start,
+                    const std::vector<hsize_t>& count);
+
     /** Writing a raw pointer into a multi-dimensional dataset using std::array
      * for subsetting */
     template<typename T, size_t S>
@@ -305,6 +411,25 @@ private:
 
     template<typename T>
     void write(const T* buf, const H5::DataSpace& filespace);
+
+    // Write without mantissa rounding
+    template<typename T>
+    void writeRaw(const T* buf, const H5::DataSpace& filespace);
+
+    // Round the mantissas of a buffer of floating point data if the dataset
+    // has a number of significant bits. Returns either buf or the data of
+    // the rounded copy.
+    template<typename T>
+    const T* roundForWrite(const T* buf, size_t sz, std::vector<T>& rounded);
+
+    // Filter chunks in parallel and write them with direct chunk writes.
+    // Returns false, without writing, if the dataset layout or filters are
+    // not supported.
+    bool writeFilteredChunks(const void* buf, size_t elementSize);
+
+    QuantizationError _quantizationError;
+    // Cached significant bits attribute, negative until read
+    int _significantBits = -1;
 };
 
 // Specialized instantiations
@@ -363,6 +488,9 @@ public:
     /** Open a given dataset */
     IDataSet openDataSet(const H5std_string& name);
 
+    /** Open a given dataset with a chunk cache sized for a read pattern */
+    IDataSet openDataSet(const H5std_string& name, ChunkLayout readPattern);
+
     /** Open a given group */
     IGroup openGroup(const H5std_string& name);
 
@@ -412,7 +540,8 @@ public:
     template<typename T, typename T2, size_t S>
     IDataSet createDataSet(const std::string& name,
                            const std::array<T2, S>& dims, const int chunk = 0,
-                           const int shuffle = 0, const int deflate = 0);
+                           const int shuffle = 0, const int deflate = 0,
+                           const std::vector<hsize_t>& chunkDims = {});
 
     /** Creating and writing a scalar as an attribute */
     template<typename T>
@@ -478,6 +607,9 @@ public:
     /** Open a given dataset */
     IDataSet openDataSet(const H5std_string& name);
 
+    /** Open a given dataset with a chunk cache sized for a read pattern */
+    IDataSet openDataSet(const H5std_string& name, ChunkLayout readPattern);
+
     /** Open a given group */
     IGroup openGroup(const H5std_string& name);
 
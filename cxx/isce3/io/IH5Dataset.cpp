@@ -14,9 +14,11 @@
 #include <cpl_progress.h>
 #include <cpl_string.h>
 #include <cpl_vsi.h>
+#include <complex>
 #include <gdal.h>
 #include <gdal_frmts.h>
 #include <gdal_priv.h>
+#include <exception>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -209,6 +211,33 @@ CPLErr IH5RasterBand::IWriteBlock( int nBlockXOff,
         << "counts=(" << counts[offset] << "," << counts[offset+1] << ")";
     CPLDebug("GDAL_IH5", "%s", ss.str().c_str());
 
+    //Round mantissas of floating point data if set for the dataset.
+    //The block is rounded in place, as it is stored in the file.
+    if (poGDS->significantBits > 0)
+    {
+        const size_t nValues = static_cast<size_t>(nBlockXSize) * nBlockYSize;
+        const int bits = poGDS->significantBits;
+        try
+        {
+            if (eDataType == GDT_Float32)
+                roundMantissa(static_cast<float *>(pImage), nValues, bits);
+            else if (eDataType == GDT_Float64)
+                roundMantissa(static_cast<double *>(pImage), nValues, bits);
+            else if (eDataType == GDT_CFloat32)
+                roundMantissa(static_cast<std::complex<float> *>(pImage),
+                              nValues, bits);
+            else if (eDataType == GDT_CFloat64)
+                roundMantissa(static_cast<std::complex<double> *>(pImage),
+                              nValues, bits);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failure to round data in Write Block: %s", e.what());
+            return CE_Failure;
+        }
+    }
+
     H5::DataSpace dspace = poGDS->_dataset->getDataSpace(starts, counts, nullptr);
     if (!H5::IdComponent::isValid(dspace.getId()))
     {
@@ -240,8 +269,18 @@ CPLErr IH5RasterBand::IWriteBlock( int nBlockXOff,
         return CE_Failure;
     }
 
-    poGDS->_dataset->H5::DataSet::write(pImage, writeType,
-            mspace, dspace);
+    try
+    {
+        poGDS->_dataset->H5::DataSet::write(pImage, writeType,
+                mspace, dspace);
+    }
+    catch (const H5::Exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Failure to write data in Write Block: %s",
+                 e.getDetailMsg().c_str());
+        return CE_Failure;
+    }
     if (!H5::IdComponent::isValid(poGDS->_dataset->getId()))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -257,6 +296,101 @@ CPLErr IH5RasterBand::IWriteBlock( int nBlockXOff,
     return CE_None;
 }
 
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr IH5RasterBand::IRasterIO( GDALRWFlag eRWFlag,
+                                 int nXOff, int nYOff, int nXSize, int nYSize,
+                                 void * pData, int nBufXSize, int nBufYSize,
+                                 GDALDataType eBufType,
+                                 GSpacing nPixelSpace, GSpacing nLineSpace,
+                                 GDALRasterIOExtraArg* psExtraArg )
+{
+    IH5Dataset *poGDS = static_cast<IH5Dataset *>(poDS);
+    const int nTypeSize = GDALGetDataTypeSizeBytes(eDataType);
+
+    //Blocks are aligned with chunks. Count the blocks covering the window.
+    const int nBlocksX = (nXOff + nXSize - 1) / nBlockXSize
+                            - nXOff / nBlockXSize + 1;
+    const int nBlocksY = (nYOff + nYSize - 1) / nBlockYSize
+                            - nYOff / nBlockYSize + 1;
+
+    //Reads of windows spanning several chunks and covering most of them
+    //are served without the block cache, inflating the chunks in parallel.
+    //Other requests (e.g. line by line reads) go through the block cache
+    //so that each chunk is only inflated once.
+    const double dfCoverage = static_cast<double>(nXSize) * nYSize /
+        (static_cast<double>(nBlocksX) * nBlockXSize * nBlocksY * nBlockYSize);
+    if ( eRWFlag == GF_Read && poGDS->eAccess == GA_ReadOnly
+         && nXSize == nBufXSize && nYSize == nBufYSize
+         && nBlocksX * nBlocksY > 1 && dfCoverage >= 0.5
+         && static_cast<size_t>(nTypeSize) == poGDS->nativeType.getSize() )
+    {
+        int offset = (poGDS->ndims == 3) ? 1 : 0;
+        std::vector<hsize_t> starts(poGDS->ndims);
+        std::vector<hsize_t> counts(poGDS->ndims);
+        if (offset == 1)
+        {
+            starts[0] = nBand-1;
+            counts[0] = 1;
+        }
+        starts[offset] = nYOff;
+        starts[offset+1] = nXOff;
+        counts[offset] = nYSize;
+        counts[offset+1] = nXSize;
+
+        //Read in place if the buffer has the layout of the window
+        const bool bPacked = (eBufType == eDataType)
+                                && (nPixelSpace == nTypeSize)
+                                && (nLineSpace == nPixelSpace * nXSize);
+        std::vector<GByte> window;
+        if (!bPacked)
+            window.resize(static_cast<size_t>(nXSize) * nYSize * nTypeSize);
+        void *pWindow = bPacked ? pData : window.data();
+
+        bool bRead = false;
+        try
+        {
+            bRead = poGDS->_dataset->readChunks(pWindow, starts, counts);
+        }
+        catch (const std::exception &e)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failure to read chunks in RasterIO: %s", e.what());
+            return CE_Failure;
+        }
+
+        if (bRead)
+        {
+            std::stringstream ss;
+            ss << poGDS->_dataset->getId() << " Chunk read, "
+                << "band=" << nBand << ", "
+                << "starts=(" << nYOff << "," << nXOff << "), "
+                << "counts=(" << nYSize << "," << nXSize << ")";
+            CPLDebug("GDAL_IH5", "%s", ss.str().c_str());
+
+            if (!bPacked)
+            {
+                for (int iLine = 0; iLine < nYSize; iLine++)
+                {
+                    GDALCopyWords(window.data() +
+                                    static_cast<size_t>(iLine) * nXSize * nTypeSize,
+                                  eDataType, nTypeSize,
+                                  static_cast<GByte *>(pData) + iLine * nLineSpace,
+                                  eBufType, static_cast<int>(nPixelSpace),
+                                  nXSize);
+                }
+            }
+            return CE_None;
+        }
+    }
+
+    return GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                        pData, nBufXSize, nBufYSize, eBufType,
+                                        nPixelSpace, nLineSpace, psExtraArg);
+}
+
 /************************************************************************/
 /*                            GetNoDataValue()                          */
 /************************************************************************/
@@ -288,7 +422,7 @@ CPLErr IH5RasterBand::SetNoDataValue( double dfNewValue )
 /************************************************************************/
 
 IH5Dataset::IH5Dataset(const hid_t &inputds, GDALAccess eAccessIn ):
-    dimensions(), chunks()
+    dimensions(), chunks(), significantBits(0)
 {
     bGeoTransformSet = false;
     pszProjection = nullptr;
@@ -707,6 +841,18 @@ CPLErr IH5Dataset::populateFromDataset()
         return CE_Failure;
     }
 
+    //Mantissa rounding of floating point writes
+    try
+    {
+        significantBits = _dataset->getSignificantBits();
+    }
+    catch (const std::exception &e)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                "IH5Dataset significant bits detection failure: %s", e.what());
+        return CE_Failure;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Create band information objects.                                */
 /* -------------------------------------------------------------------- */
@@ -46,6 +46,8 @@ class IH5Dataset final: public GDALDataset
     int ndims;
     int dimensions[3];
     int chunks[3];
+    //Significant mantissa bits kept when writing floating point data
+    int significantBits;
 
     protected:
         CPLErr populateFromDataset();
@@ -120,6 +122,10 @@ class IH5RasterBand : public GDALPamRasterBand
 
         virtual CPLErr IReadBlock( int, int, void * ) override;
         virtual CPLErr IWriteBlock( int, int, void * ) override;
+        virtual CPLErr IRasterIO( GDALRWFlag, int, int, int, int,
+                                  void *, int, int, GDALDataType,
+                                  GSpacing, GSpacing,
+                                  GDALRasterIOExtraArg * ) override;
         virtual double GetNoDataValue( int *pbSuccess = nullptr ) override;
         virtual CPLErr SetNoDataValue( double ) override;
 };
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "forward.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Raster.h"
+
+namespace isce3 { namespace io {
+/** Default memory budget of a RasterBlockCache (256 MiB) */
+constexpr static std::size_t RASTER_BLOCK_CACHE_DEFAULT_MEMORY_BUDGET =
+        1ULL << 28;
+}} // namespace isce3::io
+
+/** Thread-safe block cache in front of an isce3::io::Raster.
+ *
+ * Raster is a thin wrapper over a GDAL dataset and is not safe for
+ * concurrent accesses, so that parallel loops usually serialize all their
+ * reads and writes. A RasterBlockCache splits each band of the raster into
+ * blocks of full-width lines kept in a memory cache that may be accessed
+ * concurrently by any number of threads:
+ *
+ * - The cache is sharded: blocks are distributed over buckets each guarded
+ *   by its own lock, and each block has its own lock, so that threads
+ *   accessing different blocks do not wait on each other. GDAL is only
+ *   accessed, under a single lock, to load a missing block or to write a
+ *   modified one. Caches of rasters that must not be accessed concurrently
+ *   (e.g. several datasets of an HDF5 file) may share that lock.
+ * - Sequential reads trigger read-ahead: the blocks following the last
+ *   block read are loaded by a background thread.
+ * - Writes are deferred (write-behind): modified blocks are written to the
+ *   raster when they are evicted to honor the memory budget, on flush()
+ *   and on destruction.
+ *
+ * Blocks are evicted from each bucket in least-recently used order. Each
+ * bucket gets an equal share of the memory budget, and the number of
+ * buckets is reduced so that each share holds at least one block. The
+ * cached blocks thus never exceed the budget, unless a single block is
+ * larger than the budget, in which case one block is cached.
+ *
+ * The raster must outlive the cache and must not be accessed directly while
+ * the cache holds modified blocks. */
+template<typename T>
+class isce3::io::RasterBlockCache {
+public:
+    /** Constructor
+     *
+     * @param[in] raster        Cached raster
+     * @param[in] blockLength   Number of lines per block
+     * @param[in] memoryBudget  Maximum size of cached blocks in bytes
+     * @param[in] readAhead     Number of blocks read ahead of sequential
+     *                          reads. Zero disables read-ahead.
+     * @param[in] numShards     Maximum number of independently locked
+     *                          buckets
+     * @param[in] rasterMutex   Lock serializing raster accesses, which
+     *                          must outlive the cache. A lock owned by the
+     *                          cache is used if null. */
+    RasterBlockCache(Raster& raster, std::size_t blockLength = 256,
+                     std::size_t memoryBudget =
+                             RASTER_BLOCK_CACHE_DEFAULT_MEMORY_BUDGET,
+                     std::size_t readAhead = 2, std::size_t numShards = 16,
+                     std::mutex* rasterMutex = nullptr);
+
+    /** Destructor. Writes modified blocks to the raster. */
+    ~RasterBlockCache();
+
+    RasterBlockCache(const RasterBlockCache&) = delete;
+    RasterBlockCache& operator=(const RasterBlockCache&) = delete;
+
+    /** Read block of data from given band to buffer */
+    void getBlock(T* buffer, std::size_t xidx, std::size_t yidx,
+                  std::size_t iowidth, std::size_t iolength,
+                  std::size_t band = 1);
+
+    /** Write block of data to given band from buffer */
+    void setBlock(const T* buffer, std::size_t xidx, std::size_t yidx,
+                  std::size_t iowidth, std::size_t iolength,
+                  std::size_t band = 1);
+
+    /** Write all modified blocks to the raster */
+    void flush();
+
+    /** Drop all cached blocks after writing modified ones */
+    void clear();
+
+    std::size_t blockLength() const { return _blockLength; }
+    std::size_t memoryBudget() const { return _memoryBudget; }
+    std::size_t readAhead() const { return _readAhead; }
+    std::size_t numShards() const { return _shards.size(); }
+
+    /** Number of requested blocks found in the cache, including blocks
+     * loaded by read-ahead */
+    std::size_t hits() const { return _hits; }
+
+    /** Number of requested blocks loaded from or created for the raster.
+     * Blocks loaded by read-ahead are not counted. */
+    std::size_t misses() const { return _misses; }
+
+private:
+    struct Block {
+        std::mutex mutex;
+        std::vector<T> data;
+        bool dirty = false;
+        // block was removed from the cache and must be acquired again
+        // before being modified
+        bool evicted = false;
+        // block could not be loaded from the raster
+        bool failed = false;
+    };
+
+    using BlockPtr = std::shared_ptr<Block>;
+    using LruList = std::list<std::pair<std::size_t, BlockPtr>>;
+
+    struct Shard {
+        std::mutex mutex;
+        // most recently used blocks at the front
+        LruList lru;
+        std::unordered_map<std::size_t, typename LruList::iterator> index;
+        std::size_t nbytes = 0;
+    };
+
+    // Get a block, loading it from the raster if missing and load is set.
+    // The block is returned locked. Requests of the read-ahead thread are
+    // not counted as hits or misses.
+    std::pair<BlockPtr, std::unique_lock<std::mutex>> _acquire(
+            std::size_t key, bool load, bool readAhead = false);
+
+    // Whether a block is in the cache
+    bool _contains(std::size_t key);
+
+    // Evict least recently used blocks of a shard until it has room for
+    // incoming more bytes within its budget. Caller must hold the shard lock.
+    void _evictToBudget(Shard& shard, std::size_t incoming);
+
+    // Write a block to the raster if modified. Caller must hold the block
+    // lock.
+    void _writeBack(std::size_t key, Block& block);
+
+    // Queue blocks following a read for the read-ahead thread
+    void _scheduleReadAhead(std::size_t band, std::size_t lastBlock);
+
+    // Read-ahead thread loop
+    void _readAheadLoop();
+
+    std::size_t _key(std::size_t band, std::size_t blockIndex) const
+    {
+        return (band - 1) * _numBlocks + blockIndex;
+    }
+    std::size_t _band(std::size_t key) const { return key / _numBlocks + 1; }
+    std::size_t _blockIndex(std::size_t key) const { return key % _numBlocks; }
+    std::size_t _blockLines(std::size_t blockIndex) const;
+    Shard& _shard(std::size_t key) { return *_shards[key % _shards.size()]; }
+
+    Raster& _raster;
+    std::size_t _width;
+    std::size_t _length;
+    std::size_t _blockLength;
+    std::size_t _numBlocks;
+    std::size_t _memoryBudget;
+    std::size_t _readAhead;
+    std::vector<std::unique_ptr<Shard>> _shards;
+
+    // serializes GDAL accesses, unless a lock is shared with other caches
+    std::mutex _ownRasterMutex;
+    std::mutex& _rasterMutex;
+
+    std::atomic<std::size_t> _hits {0};
+    std::atomic<std::size_t> _misses {0};
+
+    // last block read of each band, used to detect sequential reads
+    std::vector<std::atomic<std::size_t>> _lastRead;
+
+    // read-ahead queue and thread
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::deque<std::size_t> _queue;
+    bool _stop = false;
+    std::thread _readAheadThread;
+};
+
+#define ISCE_IO_RASTERBLOCKCACHE_ICC
+#include "RasterBlockCache.icc"
+#undef ISCE_IO_RASTERBLOCKCACHE_ICC
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "forward.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <Eigen/Dense>
+#include <gdal_priv.h>
+
+#include <isce3/core/EMatrix.h>
+#include <isce3/except/Error.h>
+#include <isce3/io/gdal/detail/MemoryMap.h>
+
+#include "Constants.h"
+#include "Raster.h"
+
+/** Zero-copy, memory mapped view of a band of an isce3::io::Raster.
+ *
+ * Rows and blocks of the band are accessed in place through a virtual
+ * memory mapping of the underlying file instead of being copied to caller
+ * buffers by getBlock/setBlock. Mapping is supported for uncompressed
+ * rasters of raw binary formats (e.g. ENVI, ISCE and raw VRT) and for
+ * in-memory rasters. The view is writable if the raster was opened in
+ * update mode; writes go directly to the file.
+ *
+ * Elements of a row are colstride() bytes apart, which is larger than
+ * sizeof(T) for band or pixel interleaved multi-band files.
+ *
+ * The dataset of the raster must outlive the view. */
+template<typename T>
+class isce3::io::RasterView {
+public:
+    /** Eigen map of a block of the view */
+    using BlockMap = Eigen::Map<isce3::core::EArray2D<T>, Eigen::Unaligned,
+                                Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+    /** Read-only Eigen map of a block of the view */
+    using ConstBlockMap =
+            Eigen::Map<const isce3::core::EArray2D<T>, Eigen::Unaligned,
+                       Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>;
+
+    /** Map a band of a raster
+     *
+     * @param[in] raster    Raster to be mapped
+     * @param[in] band      Band number in 1-index
+     *
+     * \throws isce3::except::OutOfRange if the raster has no such band
+     * \throws isce3::except::RuntimeError if the datatype of the band is not
+     * T or if the raster cannot be memory mapped */
+    explicit RasterView(Raster& raster, std::size_t band = 1) :
+        _width(raster.width()),
+        _length(raster.length()),
+        _access(raster.access())
+    {
+        GDALRasterBand* rasterBand = raster.dataset()->GetRasterBand(band);
+        if (rasterBand == nullptr) {
+            std::string error_msg{"Raster has no band " +
+                                  std::to_string(band) + "."};
+            throw isce3::except::OutOfRange(ISCE_SRCINFO(), error_msg);
+        }
+        if (rasterBand->GetRasterDataType() != asGDT<T>) {
+            std::string error_msg{"Raster datatype does not match the "
+                                  "requested view datatype."};
+            throw isce3::except::RuntimeError(ISCE_SRCINFO(), error_msg);
+        }
+
+        _mmap = _map(rasterBand, _access);
+        if (!_aligned(_mmap)) {
+            std::string error_msg{"Memory mapped raster strides are not "
+                                  "aligned to the view datatype."};
+            throw isce3::except::RuntimeError(ISCE_SRCINFO(), error_msg);
+        }
+    }
+
+    /** Whether a band of a raster can be mapped as a RasterView<T>
+     *
+     * Only the mapping itself is attempted, which does not read any data
+     * from the raster. */
+    static bool isMappable(Raster& raster, std::size_t band = 1)
+    {
+        if (band < 1 || band > raster.numBands() ||
+            raster.dtype(band) != asGDT<T>)
+            return false;
+        try {
+            return _aligned(_map(raster.dataset()->GetRasterBand(band),
+                                 raster.access()));
+        } catch (const isce3::except::RuntimeError&) {
+            return false;
+        }
+    }
+
+    /** Number of columns */
+    std::size_t width() const { return _width; }
+
+    /** Number of rows */
+    std::size_t length() const { return _length; }
+
+    /** Access mode */
+    GDALAccess access() const { return _access; }
+
+    /** Stride in bytes between the start of adjacent rows */
+    std::size_t rowstride() const { return _mmap.rowstride(); }
+
+    /** Stride in bytes between the start of adjacent columns */
+    std::size_t colstride() const { return _mmap.colstride(); }
+
+    /** Whether the elements of each row are contiguous */
+    bool contiguousRows() const { return colstride() == sizeof(T); }
+
+    /** Pointer to the first element of a row */
+    T* row(std::size_t i)
+    {
+        return reinterpret_cast<T*>(
+                static_cast<char*>(_mmap.data()) + i * rowstride());
+    }
+
+    /** Pointer to the first element of a row */
+    const T* row(std::size_t i) const
+    {
+        return reinterpret_cast<const T*>(
+                static_cast<const char*>(_mmap.data()) + i * rowstride());
+    }
+
+    /** Access an element */
+    T& operator()(std::size_t i, std::size_t j)
+    {
+        return *reinterpret_cast<T*>(reinterpret_cast<char*>(row(i)) +
+                                     j * colstride());
+    }
+
+    /** Access an element */
+    const T& operator()(std::size_t i, std::size_t j) const
+    {
+        return *reinterpret_cast<const T*>(
+                reinterpret_cast<const char*>(row(i)) + j * colstride());
+    }
+
+    /** Map a block of the view
+     *
+     * @param[in] rowStart  First row of the block
+     * @param[in] colStart  First column of the block
+     * @param[in] nrows     Number of rows of the block
+     * @param[in] ncols     Number of columns of the block */
+    BlockMap block(std::size_t rowStart, std::size_t colStart,
+                   std::size_t nrows, std::size_t ncols)
+    {
+        return BlockMap(&(*this)(rowStart, colStart), nrows, ncols,
+                        _blockStride());
+    }
+
+    /** Map a read-only block of the view */
+    ConstBlockMap block(std::size_t rowStart, std::size_t colStart,
+                        std::size_t nrows, std::size_t ncols) const
+    {
+        return ConstBlockMap(&(*this)(rowStart, colStart), nrows, ncols,
+                             _blockStride());
+    }
+
+    /** Hint that a range of rows will be read soon
+     *
+     * The kernel starts reading the pages that hold the rows in the
+     * background, so that later accesses do not stall on page faults. Rows
+     * past the end of the view are ignored. This is advisory only and has no
+     * effect on the contents of the view.
+     *
+     * @param[in] rowStart  First row of the range
+     * @param[in] nrows     Number of rows in the range */
+    void prefetchRows(std::size_t rowStart, std::size_t nrows) const
+    {
+        if (rowStart >= _length || nrows == 0)
+            return;
+        nrows = std::min(nrows, _length - rowStart);
+
+        // madvise wants page aligned addresses
+        static const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+        auto begin = reinterpret_cast<std::uintptr_t>(row(rowStart));
+        auto end = begin + (nrows - 1) * rowstride() +
+                   (_width - 1) * colstride() + sizeof(T);
+        begin -= begin % page;
+        posix_madvise(reinterpret_cast<void*>(begin), end - begin,
+                      POSIX_MADV_WILLNEED);
+    }
+
+private:
+    // Map the file or memory backing a band. GDAL's default implementation,
+    // which copies the raster to a page cache on access, is not zero-copy
+    // and is treated as a failure.
+    static gdal::detail::MemoryMap _map(GDALRasterBand* rasterBand,
+                                        GDALAccess access)
+    {
+        return gdal::detail::MemoryMap(rasterBand, access, true);
+    }
+
+    static bool _aligned(const gdal::detail::MemoryMap& mmap)
+    {
+        return mmap.rowstride() % sizeof(T) == 0 &&
+               mmap.colstride() % sizeof(T) == 0;
+    }
+
+    Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> _blockStride() const
+    {
+        return {static_cast<Eigen::Index>(rowstride() / sizeof(T)),
+                static_cast<Eigen::Index>(colstride() / sizeof(T))};
+    }
+
+    gdal::detail::MemoryMap _mmap;
+    std::size_t _width;
+    std::size_t _length;
+    GDALAccess _access;
+};
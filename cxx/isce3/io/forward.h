@@ -2,5 +2,10 @@
 
 namespace isce3 { namespace io {
 
+    class DataStream;
+    class H5DataStream;
     class Raster;
+    class RasterDataStream;
+    template<typename T> class RasterBlockCache;
+    template<typename T> class RasterView;
 }}
@@ -9,15 +9,18 @@ MemoryMap::MemoryMap(const GDALRasterBand * raster)
     MemoryMap(const_cast<GDALRasterBand *>(raster), GA_ReadOnly)
 {}
 
-MemoryMap::MemoryMap(GDALRasterBand * raster, GDALAccess access)
+MemoryMap::MemoryMap(GDALRasterBand * raster, GDALAccess access, bool nativeOnly)
 :
     _mmap(nullptr, [](CPLVirtualMem *) {})
 {
     GDALRWFlag rwflag = (access == GA_ReadOnly) ? GF_Read : GF_Write;
 
+    const char * nativeOptions[] = {"USE_DEFAULT_IMPLEMENTATION=NO", nullptr};
+    char ** options = nativeOnly ? const_cast<char **>(nativeOptions) : nullptr;
+
     int colstride;
     GIntBig rowstride;
-    CPLVirtualMem * mmap = raster->GetVirtualMemAuto(rwflag, &colstride, &rowstride, nullptr);
+    CPLVirtualMem * mmap = raster->GetVirtualMemAuto(rwflag, &colstride, &rowstride, options);
     if (!mmap) {
         throw isce3::except::RuntimeError(ISCE_SRCINFO(), "failed to memory map specified raster");
     }
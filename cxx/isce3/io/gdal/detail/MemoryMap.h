@@ -4,6 +4,8 @@
 #include <gdal_priv.h>
 #include <memory>
 
+#include <isce3/io/forward.h>
+
 #include "../forward.h"
 
 namespace isce3 { namespace io { namespace gdal { namespace detail {
@@ -34,12 +36,16 @@ public:
     std::size_t rowstride() const { return _rowstride; }
 
     friend class isce3::io::gdal::Raster;
+    template<typename> friend class isce3::io::RasterView;
 
 private:
 
     MemoryMap(const GDALRasterBand * raster);
 
-    MemoryMap(GDALRasterBand * raster, GDALAccess access);
+    // If nativeOnly is set, only mappings of the underlying file or memory
+    // are allowed, not GDAL's default implementation that reads the raster
+    // into a page cache on access
+    MemoryMap(GDALRasterBand * raster, GDALAccess access, bool nativeOnly = false);
 
     std::shared_ptr<CPLVirtualMem> _mmap;
     std::size_t _colstride = 0;
@@ -0,0 +1,672 @@
+// configuration
+#include <portinfo>
+// STL
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+// openmp
+#include <omp.h>
+// pyre
+#include <pyre/journal.h>
+// fft
+#include <isce3/fft/FFTPlan.h>
+// local declarations
+#include "kernels.h"
+#include "Parallel.h"
+
+
+// per thread scratch space and FFT plans; the plans are bound to the buffers of the
+// workspace, so the buffers are allocated once and never resized
+struct ampcor::correlators::Parallel::workspace_t {
+    // coarse correlation
+    std::vector<value_type> amplitudes;
+    std::vector<value_type> refStats;
+    std::vector<value_type> sat;
+    std::vector<value_type> tgtStats;
+    std::vector<value_type> gamma;
+    std::vector<int> locations;
+    // the plans of the frequency domain correlation, if it is the cheaper method
+    std::unique_ptr<kernels::FFTCorrelation> correlation;
+
+    // refinement
+    std::vector<cell_type> refined;
+    std::vector<value_type> refinedAmplitudes;
+    std::vector<value_type> refinedRefStats;
+    std::vector<value_type> refinedSat;
+    std::vector<value_type> refinedTgtStats;
+    std::vector<value_type> refinedGamma;
+    std::unique_ptr<kernels::FFTCorrelation> refinedCorrelation;
+
+    // zoom
+    std::vector<cell_type> zoomed;
+    std::vector<value_type> zoomedAmplitudes;
+    std::vector<int> fine;
+
+    // the plans that refine the reference and expanded target tiles in place
+    isce3::fft::FwdFFTPlan<value_type> refFwd, tgtFwd;
+    isce3::fft::InvFFTPlan<value_type> refRev, tgtRev;
+    // the plans that zoom the refined correlation matrices in place
+    isce3::fft::FwdFFTPlan<value_type> corFwd;
+    isce3::fft::InvFFTPlan<value_type> corRev;
+};
+
+
+// helpers
+// compute the correlation matrix with the frequency domain plans, if there are any
+static void
+_correlate(ampcor::kernels::FFTCorrelation * plan,
+           const float * rArena, const float * refStats, const float * tgtStats,
+           std::size_t pairs,
+           std::size_t refRows, std::size_t refCols,
+           std::size_t tgtRows, std::size_t tgtCols,
+           std::size_t corRows, std::size_t corCols,
+           float * dCorrelation);
+
+// move the spectrum of a {rows}x{cols} tile transformed in place at the top left corner of a
+// {rowsOut}x{colsOut} buffer to the corners of the buffer and clear the rest, so that the
+// inverse transform of the whole buffer interpolates the tile
+static void
+_spread(std::complex<float> * buffer,
+        std::size_t rows, std::size_t cols, std::size_t rowsOut, std::size_t colsOut);
+
+
+// interface
+void
+ampcor::correlators::Parallel::
+addReferenceTile(size_type pid, const cell_type * ref, size_type rowStride)
+{
+    // find the spot for this tile in the arena
+    auto dst = _arena.data() + pid*(_refCells + _tgtCells);
+    // copy it row by row
+    for (size_type row = 0; row < _refRows; ++row) {
+        std::copy(ref + row*rowStride, ref + row*rowStride + _refCols, dst + row*_refCols);
+    }
+
+    // all done
+    return;
+}
+
+
+void
+ampcor::correlators::Parallel::
+addTargetTile(size_type pid, const cell_type * tgt, size_type rowStride)
+{
+    // find the spot for this tile in the arena; it follows the reference tile of its pair
+    auto dst = _arena.data() + pid*(_refCells + _tgtCells) + _refCells;
+    // copy it row by row
+    for (size_type row = 0; row < _tgtRows; ++row) {
+        std::copy(tgt + row*rowStride, tgt + row*rowStride + _tgtCols, dst + row*_tgtCols);
+    }
+
+    // all done
+    return;
+}
+
+
+auto
+ampcor::correlators::Parallel::
+adjust() -> const value_type *
+{
+    return adjust(_pairs);
+}
+
+
+auto
+ampcor::correlators::Parallel::
+adjust(size_type pairs) -> const value_type *
+{
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // clip the number of pairs to my capacity
+    pairs = std::min(pairs, _pairs);
+    // split them into batches
+    auto batches = (pairs + _batch - 1) / _batch;
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "correlating " << pairs << " pairs in " << batches << " batches on "
+        << _workspaces.size() << " threads"
+        << pyre::journal::endl;
+
+    // errors cannot escape the parallel region; remember the first one
+    std::exception_ptr error = nullptr;
+
+    // each thread runs the whole plan on one batch at a time
+    #pragma omp parallel for schedule(dynamic) num_threads(_workspaces.size())
+    for (size_type b = 0; b < batches; ++b) {
+        try {
+            auto first = b * _batch;
+            auto count = std::min(_batch, pairs - first);
+            _adjust(*_workspaces[omp_get_thread_num()], first, count);
+        } catch (...) {
+            #pragma omp critical
+            if (!error) error = std::current_exception();
+        }
+    }
+
+    // if something went wrong
+    if (error) {
+        // pass it on
+        std::rethrow_exception(error);
+    }
+
+    // all done
+    return _offsets.data();
+}
+
+
+// accessors
+auto
+ampcor::correlators::Parallel::
+pairs() const -> size_type
+{
+    return _pairs;
+}
+
+
+auto
+ampcor::correlators::Parallel::
+arena() const -> cell_type *
+{
+    return const_cast<cell_type *>(_arena.data());
+}
+
+
+auto
+ampcor::correlators::Parallel::
+offsets() const -> const value_type *
+{
+    return _offsets.data();
+}
+
+
+auto
+ampcor::correlators::Parallel::
+snr() const -> const value_type *
+{
+    return _snr.data();
+}
+
+
+auto
+ampcor::correlators::Parallel::
+covariance() const -> const value_type *
+{
+    return _covariance.data();
+}
+
+
+auto
+ampcor::correlators::Parallel::
+workspaceFootprint(size_type refRows, size_type refCols,
+                   size_type tgtRows, size_type tgtCols,
+                   size_type refineFactor, size_type refineMargin,
+                   size_type zoomFactor,
+                   size_type batch) -> size_type
+{
+    // the shapes, as in the constructor
+    auto corRows = tgtRows - refRows + 1, corCols = tgtCols - refCols + 1;
+    auto expRows = refRows + 2*refineMargin, expCols = refCols + 2*refineMargin;
+    auto refRefinedRows = refineFactor * refRows, refRefinedCols = refineFactor * refCols;
+    auto tgtRefinedRows = refineFactor * expRows, tgtRefinedCols = refineFactor * expCols;
+    auto corRefinedRows = 2*refineFactor*refineMargin + 1;
+    auto corRefinedCols = corRefinedRows;
+    auto corZoomedCells = zoomFactor * (corRefinedRows - 1) * zoomFactor * (corRefinedCols - 1);
+
+    auto refCells = refRows * refCols, tgtCells = tgtRows * tgtCols;
+    auto corCells = corRows * corCols;
+    auto tgtRefinedCells = tgtRefinedRows * tgtRefinedCols;
+    auto cellsPerRefinedPair = refRefinedRows * refRefinedCols + tgtRefinedCells;
+    auto corRefinedCells = corRefinedRows * corRefinedCols;
+
+    // the buffers of a workspace
+    size_type values = refCells + tgtCells + 1 + tgtCells + 2*corCells
+        + cellsPerRefinedPair + 1 + tgtRefinedCells + 2*corRefinedCells
+        + corZoomedCells;
+    size_type cells = cellsPerRefinedPair + corZoomedCells;
+    size_type footprint = batch * (values * sizeof(value_type) + cells * sizeof(cell_type)
+                                   + 4 * sizeof(int));
+
+    // and the scratch space of the correlations in the frequency domain
+    if (kernels::useFFTCorrelation(refRows, refCols, tgtRows, tgtCols, corRows, corCols)) {
+        footprint += kernels::FFTCorrelation::footprint(refRows, refCols, tgtRows, tgtCols,
+                                                        corRows, corCols, batch);
+    }
+    if (kernels::useFFTCorrelation(refRefinedRows, refRefinedCols,
+                                   tgtRefinedRows, tgtRefinedCols,
+                                   corRefinedRows, corRefinedCols)) {
+        footprint += kernels::FFTCorrelation::footprint(refRefinedRows, refRefinedCols,
+                                                        tgtRefinedRows, tgtRefinedCols,
+                                                        corRefinedRows, corRefinedCols,
+                                                        batch);
+    }
+
+    // all done
+    return footprint;
+}
+
+
+// meta-methods
+ampcor::correlators::Parallel::
+~Parallel()
+{
+    // destroy the plans while no other thread is planning
+    std::lock_guard<std::mutex> lock(kernels::plannerLock());
+    _workspaces.clear();
+}
+
+
+ampcor::correlators::Parallel::
+Parallel(size_type pairs,
+         size_type refRows, size_type refCols,
+         size_type tgtRows, size_type tgtCols,
+         size_type refineFactor, size_type refineMargin,
+         size_type zoomFactor,
+         size_type batch, int derampMethod,
+         size_type statRows, size_type statCols) :
+    _pairs{ pairs },
+    _refineFactor{ refineFactor },
+    _refineMargin{ refineMargin },
+    _zoomFactor{ zoomFactor },
+    _batch{ std::max<size_type>(1, std::min(batch, pairs)) },
+    _derampMethod{ derampMethod },
+    _refRows{ refRows }, _refCols{ refCols },
+    _tgtRows{ tgtRows }, _tgtCols{ tgtCols },
+    _corRows{ tgtRows - refRows + 1 }, _corCols{ tgtCols - refCols + 1 },
+    _statRows{ statRows }, _statCols{ statCols },
+    _expRows{ refRows + 2*refineMargin }, _expCols{ refCols + 2*refineMargin },
+    _refRefinedRows{ refineFactor * refRows }, _refRefinedCols{ refineFactor * refCols },
+    _tgtRefinedRows{ refineFactor * _expRows }, _tgtRefinedCols{ refineFactor * _expCols },
+    _corRefinedRows{ 2*refineFactor*refineMargin + 1 },
+    _corRefinedCols{ 2*refineFactor*refineMargin + 1 },
+    // the last row and column of the refined correlation matrix are dropped before zooming
+    _corZoomedRows{ zoomFactor * (_corRefinedRows - 1) },
+    _corZoomedCols{ zoomFactor * (_corRefinedCols - 1) },
+    _refCells{ refRows * refCols },
+    _tgtCells{ tgtRows * tgtCols },
+    _refRefinedCells{ _refRefinedRows * _refRefinedCols },
+    _tgtRefinedCells{ _tgtRefinedRows * _tgtRefinedCols }
+{
+    // make a channel; this also registers it before any of the kernels look it up
+    // concurrently
+    pyre::journal::debug_t channel("ampcor");
+
+    // the expanded target tiles must fit within the search windows
+    if (refRows == 0 || refCols == 0 || refineFactor == 0 || refineMargin == 0 ||
+        zoomFactor == 0 || tgtRows < _expRows || tgtCols < _expCols) {
+        // make a channel
+        pyre::journal::error_t error("ampcor");
+        // complain
+        error
+            << pyre::journal::at(__HERE__)
+            << "the " << tgtRows << "x" << tgtCols << " search windows cannot accommodate "
+            << "the " << refRows << "x" << refCols << " reference tiles with a refinement "
+            << "margin of " << refineMargin
+            << pyre::journal::endl;
+        // and bail
+        throw std::runtime_error("invalid tile shapes for the ampcor correlator");
+    }
+
+    // allocate the arena and the results
+    _arena.resize(pairs * (_refCells + _tgtCells));
+    _offsets.resize(2 * pairs);
+    _snr.resize(pairs);
+    _covariance.resize(3 * pairs);
+
+    // get number of threads. omp_get_max_threads is sometimes problematic.
+    size_t nthreads=0;
+    #pragma omp parallel reduction(+:nthreads)
+    nthreads += 1;
+    // there is no point in having more threads than batches
+    nthreads = std::max<size_t>(1, std::min(nthreads, (pairs + _batch - 1) / _batch));
+
+    // the sizes of the workspace buffers
+    auto corCells = _corRows * _corCols;
+    auto corRefinedCells = _corRefinedRows * _corRefinedCols;
+    auto corZoomedCells = _corZoomedRows * _corZoomedCols;
+    auto cellsPerRefinedPair = _refRefinedCells + _tgtRefinedCells;
+
+    // the plan characteristics; FFTW planning is not thread safe, so all plans are built
+    // here, on one thread, under the planner lock shared with the kernels, and each one is
+    // executed by one thread at a time
+    int refRanks[] = { static_cast<int>(_refRows), static_cast<int>(_refCols) };
+    int refEmbed[] = { static_cast<int>(_refRefinedRows), static_cast<int>(_refRefinedCols) };
+    int expRanks[] = { static_cast<int>(_expRows), static_cast<int>(_expCols) };
+    int tgtEmbed[] = { static_cast<int>(_tgtRefinedRows), static_cast<int>(_tgtRefinedCols) };
+    int corRanks[] = { static_cast<int>(_corRefinedRows - 1),
+                       static_cast<int>(_corRefinedCols - 1) };
+    int zmdEmbed[] = { static_cast<int>(_corZoomedRows), static_cast<int>(_corZoomedCols) };
+    int refinedDist = static_cast<int>(cellsPerRefinedPair);
+    int zoomedDist = static_cast<int>(corZoomedCells);
+    int howmany = static_cast<int>(_batch);
+
+    // build the workspaces; the plans of a partial build are destroyed under the lock too
+    std::lock_guard<std::mutex> lock(kernels::plannerLock());
+    try {
+        for (size_t thread = 0; thread < nthreads; ++thread) {
+            auto ws = std::make_unique<workspace_t>();
+
+            ws->amplitudes.resize(_batch * (_refCells + _tgtCells));
+            ws->refStats.resize(_batch);
+            ws->sat.resize(_batch * _tgtCells);
+            ws->tgtStats.resize(_batch * corCells);
+            ws->gamma.resize(_batch * corCells);
+            ws->locations.resize(2 * _batch);
+
+            ws->refined.resize(_batch * cellsPerRefinedPair);
+            ws->refinedAmplitudes.resize(_batch * cellsPerRefinedPair);
+            ws->refinedRefStats.resize(_batch);
+            ws->refinedSat.resize(_batch * _tgtRefinedCells);
+            ws->refinedTgtStats.resize(_batch * corRefinedCells);
+            ws->refinedGamma.resize(_batch * corRefinedCells);
+
+            ws->zoomed.resize(_batch * corZoomedCells);
+            ws->zoomedAmplitudes.resize(_batch * corZoomedCells);
+            ws->fine.resize(2 * _batch);
+
+            // the reference tiles sit at the top left corner of their refined slot
+            auto ref = ws->refined.data();
+            ws->refFwd = isce3::fft::FwdFFTPlan<value_type>(
+                ref, ref, refRanks, refEmbed, 1, refinedDist, refEmbed, 1, refinedDist,
+                howmany, FFTW_MEASURE, 1);
+            ws->refRev = isce3::fft::InvFFTPlan<value_type>(
+                ref, ref, refEmbed, refEmbed, 1, refinedDist, refEmbed, 1, refinedDist,
+                howmany, FFTW_MEASURE, 1);
+            // and are followed by the expanded target tiles
+            auto tgt = ws->refined.data() + _refRefinedCells;
+            ws->tgtFwd = isce3::fft::FwdFFTPlan<value_type>(
+                tgt, tgt, expRanks, tgtEmbed, 1, refinedDist, tgtEmbed, 1, refinedDist,
+                howmany, FFTW_MEASURE, 1);
+            ws->tgtRev = isce3::fft::InvFFTPlan<value_type>(
+                tgt, tgt, tgtEmbed, tgtEmbed, 1, refinedDist, tgtEmbed, 1, refinedDist,
+                howmany, FFTW_MEASURE, 1);
+            // the correlation matrices get zoomed in their own buffer
+            auto zmd = ws->zoomed.data();
+            ws->corFwd = isce3::fft::FwdFFTPlan<value_type>(
+                zmd, zmd, corRanks, zmdEmbed, 1, zoomedDist, zmdEmbed, 1, zoomedDist,
+                howmany, FFTW_MEASURE, 1);
+            ws->corRev = isce3::fft::InvFFTPlan<value_type>(
+                zmd, zmd, zmdEmbed, zmdEmbed, 1, zoomedDist, zmdEmbed, 1, zoomedDist,
+                howmany, FFTW_MEASURE, 1);
+
+            // the correlation plans
+            if (kernels::useFFTCorrelation(_refRows, _refCols, _tgtRows, _tgtCols,
+                                           _corRows, _corCols)) {
+                ws->correlation = std::make_unique<kernels::FFTCorrelation>(
+                    _refRows, _refCols, _tgtRows, _tgtCols, _corRows, _corCols,
+                    _batch, FFTW_MEASURE, 1);
+            }
+            if (kernels::useFFTCorrelation(_refRefinedRows, _refRefinedCols,
+                                           _tgtRefinedRows, _tgtRefinedCols,
+                                           _corRefinedRows, _corRefinedCols)) {
+                ws->refinedCorrelation = std::make_unique<kernels::FFTCorrelation>(
+                    _refRefinedRows, _refRefinedCols, _tgtRefinedRows, _tgtRefinedCols,
+                    _corRefinedRows, _corRefinedCols, _batch, FFTW_MEASURE, 1);
+            }
+
+            // planning may have scribbled over the buffers
+            std::fill(ws->refined.begin(), ws->refined.end(), cell_type(0));
+            std::fill(ws->zoomed.begin(), ws->zoomed.end(), cell_type(0));
+
+            _workspaces.push_back(std::move(ws));
+        }
+    } catch (...) {
+        _workspaces.clear();
+        throw;
+    }
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "new Parallel worker:" << pyre::journal::newline
+        << "    pairs: " << _pairs << " in batches of " << _batch
+        << " on " << nthreads << " threads" << pyre::journal::newline
+        << "    ref shape: " << _refRows << "x" << _refCols << pyre::journal::newline
+        << "    tgt shape: " << _tgtRows << "x" << _tgtCols << pyre::journal::newline
+        << "    cor shape: " << _corRows << "x" << _corCols << pyre::journal::newline
+        << "    refine factor: " << _refineFactor << ", margin: " << _refineMargin
+        << pyre::journal::newline
+        << "    zoom factor: " << _zoomFactor
+        << pyre::journal::endl;
+}
+
+
+// implementation details: methods
+void
+ampcor::correlators::Parallel::
+_adjust(workspace_t & ws, size_type first, size_type count)
+{
+    // the coarse tiles of my batch
+    auto coarse = _arena.data() + first*(_refCells + _tgtCells);
+    // and where my results go
+    auto offsets = _offsets.data() + 2*first;
+
+    // coarse adjustments: compute the amplitudes
+    kernels::detect(coarse, count*(_refCells + _tgtCells), ws.amplitudes.data());
+    // adjust the reference tiles to zero mean and compute the variances
+    kernels::refStats(ws.amplitudes.data(), count, _refRows, _refCols,
+                      _refCells + _tgtCells, ws.refStats.data());
+    // compute the sum area tables for all possible search window placements
+    kernels::sat(ws.amplitudes.data(), count, _refCells, _tgtCells, _tgtRows, _tgtCols,
+                 ws.sat.data());
+    // use the SATs to compute the mean amplitude of all possible window placements
+    kernels::tgtStats(ws.sat.data(), count, _refRows, _refCols, _tgtRows, _tgtCols,
+                      _corRows, _corCols, ws.tgtStats.data());
+    // compute the correlation hyper-surface
+    _correlate(ws.correlation.get(),
+               ws.amplitudes.data(), ws.refStats.data(), ws.tgtStats.data(), count,
+               _refRows, _refCols, _tgtRows, _tgtCols, _corRows, _corCols,
+               ws.gamma.data());
+    // find its maxima
+    kernels::maxcor(ws.gamma.data(), count, _corRows, _corCols, ws.locations.data());
+    // and assess their quality
+    kernels::snr(ws.gamma.data(), count, _corRows, _corCols, ws.locations.data(),
+                 _statRows, _statCols, _snr.data() + first);
+    kernels::covariance(ws.gamma.data(), count, _corRows, _corCols, ws.locations.data(),
+                        _refCells, _covariance.data() + 3*first);
+
+    // refinement: ensure that the expanded target tiles fit within the search windows
+    kernels::nudge(count, _refRows, _refCols, _tgtRows, _tgtCols, _refineMargin,
+                   ws.locations.data(), offsets);
+    // refine the tiles
+    _refine(ws, coarse, count);
+
+    // compute amplitudes
+    auto cellsPerRefinedPair = _refRefinedCells + _tgtRefinedCells;
+    kernels::detect(ws.refined.data(), count*cellsPerRefinedPair,
+                    ws.refinedAmplitudes.data());
+    // adjust the reference tiles to zero mean and compute the variances
+    kernels::refStats(ws.refinedAmplitudes.data(), count, _refRefinedRows, _refRefinedCols,
+                      cellsPerRefinedPair, ws.refinedRefStats.data());
+    // compute the sum area tables
+    kernels::sat(ws.refinedAmplitudes.data(), count, _refRefinedCells, _tgtRefinedCells,
+                 _tgtRefinedRows, _tgtRefinedCols, ws.refinedSat.data());
+    // use the SATs to compute the mean amplitude of all possible window placements
+    kernels::tgtStats(ws.refinedSat.data(), count,
+                      _refRefinedRows, _refRefinedCols, _tgtRefinedRows, _tgtRefinedCols,
+                      _corRefinedRows, _corRefinedCols, ws.refinedTgtStats.data());
+    // compute the correlation hyper-surface
+    _correlate(ws.refinedCorrelation.get(), ws.refinedAmplitudes.data(),
+               ws.refinedRefStats.data(), ws.refinedTgtStats.data(), count,
+               _refRefinedRows, _refRefinedCols, _tgtRefinedRows, _tgtRefinedCols,
+               _corRefinedRows, _corRefinedCols, ws.refinedGamma.data());
+
+    // zoom in
+    _zoomcor(ws, count);
+    // find the maxima
+    kernels::maxcor(ws.zoomedAmplitudes.data(), count, _corZoomedRows, _corZoomedCols,
+                    ws.fine.data());
+    // compute the shifts
+    kernels::offsetField(ws.fine.data(), count,
+                         (_tgtRows - _refRows) / 2, (_tgtCols - _refCols) / 2,
+                         _refineMargin, _refineFactor * _zoomFactor, offsets);
+
+    // all done
+    return;
+}
+
+
+void
+ampcor::correlators::Parallel::
+_refine(workspace_t & ws, const cell_type * coarse, size_type count) const
+{
+    // the layout of the arenas
+    auto cellsPerPair = _refCells + _tgtCells;
+    auto cellsPerRefinedPair = _refRefinedCells + _tgtRefinedCells;
+    auto refined = ws.refined.data();
+
+    // copy the reference tiles to the top left corner of their refined slots
+    for (size_type pid = 0; pid < count; ++pid) {
+        auto src = coarse + pid*cellsPerPair;
+        auto dst = refined + pid*cellsPerRefinedPair;
+        for (size_type row = 0; row < _refRows; ++row) {
+            std::memcpy(dst + row*_refRefinedCols, src + row*_refCols,
+                        _refCols * sizeof(cell_type));
+        }
+    }
+    // collect the expanded target tiles around the correlation maxima
+    kernels::migrate(coarse, count, _refRows, _refCols, _tgtRows, _tgtCols,
+                     _expRows, _expCols, _refRefinedRows, _refRefinedCols,
+                     _tgtRefinedRows, _tgtRefinedCols, ws.locations.data(), refined);
+
+    // treat the phase
+    if (_derampMethod == 0) {
+        // refine the amplitudes only
+        for (size_type pid = 0; pid < count; ++pid) {
+            auto ref = refined + pid*cellsPerRefinedPair;
+            auto tgt = ref + _refRefinedCells;
+            for (size_type row = 0; row < _refRows; ++row)
+                for (size_type col = 0; col < _refCols; ++col)
+                    ref[row*_refRefinedCols + col] = std::abs(ref[row*_refRefinedCols + col]);
+            for (size_type row = 0; row < _expRows; ++row)
+                for (size_type col = 0; col < _expCols; ++col)
+                    tgt[row*_tgtRefinedCols + col] = std::abs(tgt[row*_tgtRefinedCols + col]);
+        }
+    } else {
+        // remove the phase ramps
+        kernels::deramp(refined, count, _refRows, _refCols, _refRefinedCols,
+                        cellsPerRefinedPair);
+        kernels::deramp(refined + _refRefinedCells, count, _expRows, _expCols,
+                        _tgtRefinedCols, cellsPerRefinedPair);
+    }
+
+    // forward transform the tiles in place
+    ws.refFwd.execute();
+    ws.tgtFwd.execute();
+    // zero pad their spectra
+    for (size_type pid = 0; pid < count; ++pid) {
+        auto ref = refined + pid*cellsPerRefinedPair;
+        _spread(ref, _refRows, _refCols, _refRefinedRows, _refRefinedCols);
+        _spread(ref + _refRefinedCells, _expRows, _expCols, _tgtRefinedRows, _tgtRefinedCols);
+    }
+    // and transform back
+    ws.refRev.execute();
+    ws.tgtRev.execute();
+
+    // all done
+    return;
+}
+
+
+void
+ampcor::correlators::Parallel::
+_zoomcor(workspace_t & ws, size_type count) const
+{
+    // the shapes
+    auto corRefinedCells = _corRefinedRows * _corRefinedCols;
+    auto corZoomedCells = _corZoomedRows * _corZoomedCols;
+    // the shape of the part of the correlation matrices that gets zoomed
+    auto rows = _corRefinedRows - 1;
+    auto cols = _corRefinedCols - 1;
+
+    // up-cast and embed
+    for (size_type pid = 0; pid < count; ++pid) {
+        auto src = ws.refinedGamma.data() + pid*corRefinedCells;
+        auto dst = ws.zoomed.data() + pid*corZoomedCells;
+        for (size_type row = 0; row < rows; ++row)
+            for (size_type col = 0; col < cols; ++col)
+                dst[row*_corZoomedCols + col] = src[row*_corRefinedCols + col];
+    }
+
+    // forward transform
+    ws.corFwd.execute();
+    // zero pad the spectra
+    for (size_type pid = 0; pid < count; ++pid) {
+        _spread(ws.zoomed.data() + pid*corZoomedCells, rows, cols,
+                _corZoomedRows, _corZoomedCols);
+    }
+    // and transform back
+    ws.corRev.execute();
+
+    // convert complex to real
+    kernels::detect(ws.zoomed.data(), count*corZoomedCells, ws.zoomedAmplitudes.data());
+
+    // all done
+    return;
+}
+
+
+// helpers
+void
+_correlate(ampcor::kernels::FFTCorrelation * plan,
+           const float * rArena, const float * refStats, const float * tgtStats,
+           std::size_t pairs,
+           std::size_t refRows, std::size_t refCols,
+           std::size_t tgtRows, std::size_t tgtCols,
+           std::size_t corRows, std::size_t corCols,
+           float * dCorrelation)
+{
+    // the workspaces have plans for the shapes that correlate faster in the frequency domain
+    if (plan) {
+        ampcor::kernels::correlateFFT(*plan, rArena, refStats, tgtStats, pairs, dCorrelation);
+    } else {
+        ampcor::kernels::correlateDirect(rArena, refStats, tgtStats, pairs,
+                                         refRows, refCols, tgtRows, tgtCols,
+                                         corRows, corCols, dCorrelation);
+    }
+
+    // all done
+    return;
+}
+
+
+void
+_spread(std::complex<float> * buffer,
+        std::size_t rows, std::size_t cols, std::size_t rowsOut, std::size_t colsOut)
+{
+    // the number of non-negative frequencies along each axis; the rest move to the far end
+    auto rowsLow = (rows + 1) / 2;
+    auto colsLow = (cols + 1) / 2;
+    auto rowShift = rowsOut - rows;
+    auto colShift = colsOut - cols;
+    // normalize the round trip
+    float scale = 1.0f / (rows * cols);
+
+    // cells only move towards the end of the buffer, so go backwards
+    for (std::size_t row = rows; row-- > 0; ) {
+        auto dstRow = row < rowsLow ? row : row + rowShift;
+        for (std::size_t col = cols; col-- > 0; ) {
+            auto dstCol = col < colsLow ? col : col + colShift;
+            buffer[dstRow*colsOut + dstCol] = scale * buffer[row*colsOut + col];
+        }
+    }
+
+    // clear the high frequencies
+    for (std::size_t row = 0; row < rowsOut; ++row) {
+        auto line = buffer + row*colsOut;
+        if (row >= rowsLow && row < rowsLow + rowShift) {
+            std::fill(line, line + colsOut, std::complex<float>(0));
+        } else {
+            std::fill(line + colsLow, line + colsLow + colShift, std::complex<float>(0));
+        }
+    }
+
+    // all done
+    return;
+}
+
+
+// end of file
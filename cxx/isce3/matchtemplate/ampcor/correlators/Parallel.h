@@ -0,0 +1,153 @@
+// code guard
+#if !defined(ampcor_libampcor_correlators_Parallel_h)
+#define ampcor_libampcor_correlators_Parallel_h
+
+// STL
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// forward declarations
+namespace ampcor {
+    namespace correlators {
+        class Parallel;
+    }
+}
+
+
+// resource management and orchestration of the execution of the correlation plan on many
+// tile pairs at once
+//
+// unlike {Sequential}, which runs each stage of the plan over all the pairs before moving on
+// to the next stage, the pairs are split into batches that are processed concurrently, each
+// thread running the whole plan on its batch with its own workspace and FFT plans; the
+// workspaces are sized for a single batch, so the memory needed on top of the arena does not
+// grow with the number of pairs
+class ampcor::correlators::Parallel {
+    // types
+public:
+    // the pixel complex type
+    using cell_type = std::complex<float>;
+    // its support
+    using value_type = float;
+    // for sizing things
+    using size_type = std::size_t;
+
+    // interface
+public:
+    // add a reference tile to the pile; {ref} points to its first cell and {rowStride} is
+    // the distance between its rows
+    void addReferenceTile(size_type pid, const cell_type * ref, size_type rowStride);
+    // add a target search window to the pile
+    void addTargetTile(size_type pid, const cell_type * tgt, size_type rowStride);
+
+    // compute adjustments to the offset map for all pairs
+    auto adjust() -> const value_type *;
+    // compute adjustments to the offset map for the first {pairs} pairs
+    auto adjust(size_type pairs) -> const value_type *;
+
+    // accessors
+    auto pairs() const -> size_type;
+    auto arena() const -> cell_type *;
+    // the (row, col) offsets of each pair
+    auto offsets() const -> const value_type *;
+    // the signal to noise ratio of the correlation peak of each pair
+    auto snr() const -> const value_type *;
+    // the (row, col, cross) covariance of the offsets of each pair
+    auto covariance() const -> const value_type *;
+
+    // the memory used by the workspace of each thread on top of the arena, in bytes
+    static auto workspaceFootprint(size_type refRows, size_type refCols,
+                                   size_type tgtRows, size_type tgtCols,
+                                   size_type refineFactor=2, size_type refineMargin=8,
+                                   size_type zoomFactor=4,
+                                   size_type batch=64) -> size_type;
+
+    // meta-methods
+public:
+    ~Parallel();
+    Parallel(size_type pairs,
+             size_type refRows, size_type refCols,
+             size_type tgtRows, size_type tgtCols,
+             size_type refineFactor=2, size_type refineMargin=8,
+             size_type zoomFactor=4,
+             size_type batch=64, int derampMethod=1,
+             size_type statRows=21, size_type statCols=21);
+
+    // disallow copies
+    Parallel(const Parallel &) = delete;
+    Parallel & operator=(const Parallel &) = delete;
+
+    // implementation details: types
+private:
+    // per thread scratch space and FFT plans
+    struct workspace_t;
+
+    // implementation details: methods
+private:
+    // run the whole correlation plan on {count} pairs starting with {first}
+    void _adjust(workspace_t & ws, size_type first, size_type count);
+    // migrate the reference and expanded target tiles of a batch to the workspace and
+    // refine them
+    void _refine(workspace_t & ws, const cell_type * coarse, size_type count) const;
+    // zoom the refined correlation matrices
+    void _zoomcor(workspace_t & ws, size_type count) const;
+
+    // implementation details: data
+private:
+    // my capacity, in {ref/tgt} pairs
+    const size_type _pairs;
+    const size_type _refineFactor;
+    const size_type _refineMargin;
+    const size_type _zoomFactor;
+    // the number of pairs handed to a thread at a time
+    const size_type _batch;
+    // how to treat the phase of the tiles before refining them
+    const int _derampMethod;
+
+    // the shape of the reference tiles
+    const size_type _refRows, _refCols;
+    // the shape of the search windows in the target image
+    const size_type _tgtRows, _tgtCols;
+    // the shape of the correlation matrix
+    const size_type _corRows, _corCols;
+    // the shape of the window used to estimate the signal to noise ratio
+    const size_type _statRows, _statCols;
+    // the shape of the expanded target tiles around the correlation maxima
+    const size_type _expRows, _expCols;
+    // the shape of the reference tiles after refinement
+    const size_type _refRefinedRows, _refRefinedCols;
+    // the shape of the target tiles after refinement
+    const size_type _tgtRefinedRows, _tgtRefinedCols;
+    // the shape of the correlation matrix after refinement
+    const size_type _corRefinedRows, _corRefinedCols;
+    // the shape of the correlation matrix after zooming
+    const size_type _corZoomedRows, _corZoomedCols;
+
+    // the number of cells in a reference tile
+    const size_type _refCells;
+    // the number of cells in a target search window
+    const size_type _tgtCells;
+    // the number of cells in a refined reference tile
+    const size_type _refRefinedCells;
+    // the number of cells in a refined target tile
+    const size_type _tgtRefinedCells;
+
+    // host storage for the tile pairs
+    std::vector<cell_type> _arena;
+    // host storage for the offset field
+    std::vector<value_type> _offsets;
+    // and its quality metrics
+    std::vector<value_type> _snr;
+    std::vector<value_type> _covariance;
+
+    // one workspace per thread
+    std::vector<std::unique_ptr<workspace_t>> _workspaces;
+};
+
+
+// code guard
+#endif
+
+// end of file
@@ -22,9 +22,9 @@ _correlate(const value_t * arena,
            std::size_t pairId,
            const value_t * refStats,
            const value_t * tgtStats,
-           std::size_t rdim, std::size_t rcells,
-           std::size_t tdim, std::size_t tcells,
-           std::size_t cdim, std::size_t ccells,
+           std::size_t rrows, std::size_t rcols,
+           std::size_t trows, std::size_t tcols,
+           std::size_t crows, std::size_t ccols,
            value_t * correlation);
 
 
@@ -33,10 +33,37 @@ void
 ampcor::kernels::
 correlate(const float * dArena, const float * refStats, const float * tgtStats,
           std::size_t pairs,
-          std::size_t refCells, std::size_t tgtCells, std::size_t corCells,
-          std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+          std::size_t refRows, std::size_t refCols,
+          std::size_t tgtRows, std::size_t tgtCols,
+          std::size_t corRows, std::size_t corCols,
           float * dCorrelation)
 {
+    // large tiles and search windows are much cheaper to correlate in the frequency domain
+    if (useFFTCorrelation(refRows, refCols, tgtRows, tgtCols, corRows, corCols)) {
+        correlateFFT(dArena, refStats, tgtStats, pairs,
+                     refRows, refCols, tgtRows, tgtCols, corRows, corCols,
+                     dCorrelation);
+    } else {
+        correlateDirect(dArena, refStats, tgtStats, pairs,
+                        refRows, refCols, tgtRows, tgtCols, corRows, corCols,
+                        dCorrelation);
+    }
+
+    // all done
+    return;
+}
+
+
+// the direct method
+void
+ampcor::kernels::
+correlateDirect(const float * dArena, const float * refStats, const float * tgtStats,
+                std::size_t pairs,
+                std::size_t refRows, std::size_t refCols,
+                std::size_t tgtRows, std::size_t tgtCols,
+                std::size_t corRows, std::size_t corCols,
+                float * dCorrelation)
+{
 
     // make a channel
     pyre::journal::debug_t channel("ampcor");
@@ -51,7 +78,7 @@ correlate(const float * dArena, const float * refStats, const float * tgtStats,
     #pragma omp parallel for
     for (std::size_t pairId=0; pairId < pairs; pairId++)
         _correlate(dArena, pairId, refStats, tgtStats, 
-                   refDim, refCells, tgtDim, tgtCells, corDim, corCells,
+                   refRows, refCols, tgtRows, tgtCols, corRows, corCols,
                    dCorrelation);
 
 
@@ -67,11 +94,15 @@ _correlate(const value_t * arena, // the dataspace
            std::size_t pairId, // the tile id
            const value_t * refStats, // std dev (unormalized) of the ref tile
            const value_t * tgtStats, // the mean table of the target tile
-           std::size_t rdim, std::size_t rcells, // ref grid shape and size
-           std::size_t tdim, std::size_t tcells, // tgt grid shape and size
-           std::size_t cdim, std::size_t ccells, // cor grid shape and size
+           std::size_t rrows, std::size_t rcols, // ref grid shape
+           std::size_t trows, std::size_t tcols, // tgt grid shape
+           std::size_t crows, std::size_t ccols, // cor grid shape
            value_t * correlation)
 {
+    // the grid sizes
+    std::size_t rcells = rrows * rcols;
+    std::size_t tcells = trows * tcols;
+    std::size_t ccells = crows * ccols;
 
 
     // reference and target grids are interleaved; compute the stride
@@ -92,12 +123,12 @@ _correlate(const value_t * arena, // the dataspace
     value_t tgtVariance = 0;
 
     // go through all possible row offsets for the sliding window
-    for (std::size_t row = 0; row < cdim; row++) {
+    for (std::size_t row = 0; row < crows; row++) {
         // and all possible column offsets
-        for (std::size_t col = 0; col < cdim; col++) {
+        for (std::size_t col = 0; col < ccols; col++) {
 
            // look up the mean target amplitude
-           auto mean = tgtStats[pairId*ccells + row*cdim + col];
+           auto mean = tgtStats[pairId*ccells + row*ccols + col];
 
            // initialize numerator and tgt variance for the 
            // current position {row, col} of the sliding window
@@ -105,15 +136,15 @@ _correlate(const value_t * arena, // the dataspace
            tgtVariance = 0;
 
            // offset in tgt at current {row, col} pos
-           auto offset = row*tdim + col;
+           auto offset = row*tcols + col;
 
            // go through all cell of ref window
-           for (std::size_t idy=0; idy<rdim; idy++) {
-               for (std::size_t idx=0; idx<rdim; idx++) {
+           for (std::size_t idy=0; idy<rrows; idy++) {
+               for (std::size_t idx=0; idx<rcols; idx++) {
                    // get current ref cell 
-                   value_t r = ref[idy*rdim + idx];
+                   value_t r = ref[idy*rcols + idx];
                    // get current tgt cell and mean normalize it
-                   value_t t = tgt[offset + idy*tdim + idx] - mean;
+                   value_t t = tgt[offset + idy*tcols + idx] - mean;
                    // update the numerator
                    numerator += r * t;
                    // and the target variance
@@ -124,9 +155,11 @@ _correlate(const value_t * arena, // the dataspace
            // looks up the sqrt of the reference tile variance
            value_t refVariance = refStats[pairId];
            // computes the correlation
-           auto corr = numerator / (refVariance * std::sqrt(tgtVariance));
+           // flat tiles, e.g. in zero filled areas, do not correlate with anything
+           auto norm = refVariance * std::sqrt(tgtVariance);
+           auto corr = norm > 0 ? numerator / norm : 0;
            // computes the slot where this result goes
-           std::size_t slot = pairId*ccells + row*cdim + col;
+           std::size_t slot = pairId*ccells + row*ccols + col;
            // and writes the sum to the result vector
            correlation[slot] = corr;
         }
@@ -0,0 +1,347 @@
+// configuration
+#include <portinfo>
+// STL
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+// openmp
+#include <omp.h>
+// pyre
+#include <pyre/journal.h>
+// fft
+#include <isce3/fft/FFTPlan.h>
+#include <isce3/fft/FFTUtil.h>
+// pull the declarations
+#include "kernels.h"
+
+
+// the largest number of pairs transformed together; bounds the scratch space
+static constexpr std::size_t maxChunk = 16;
+
+// the shape of the transforms
+static int
+_fftRows(std::size_t tgtRows);
+static int
+_fftCols(std::size_t tgtCols);
+
+// normalize the correlation of a pair
+template <typename value_t = float>
+static void
+_normalize(const value_t * cor,
+           std::size_t corStride,
+           value_t refVariance,
+           const value_t * means,
+           const value_t * squares,
+           std::size_t refCells,
+           std::size_t corRows, std::size_t corCols,
+           value_t scale,
+           value_t * correlation);
+
+
+// FFTW planning is not thread safe and this kernel may run on many threads at once, next
+// to correlators that build their own plans
+std::mutex &
+ampcor::kernels::
+plannerLock()
+{
+    static std::mutex lock;
+    return lock;
+}
+
+
+// the frequency domain method, with plans built for this call; they are built and destroyed
+// under the lock, since this kernel may run on many threads at once
+void
+ampcor::kernels::
+correlateFFT(const float * dArena, const float * refStats, const float * tgtStats,
+             std::size_t pairs,
+             std::size_t refRows, std::size_t refCols,
+             std::size_t tgtRows, std::size_t tgtCols,
+             std::size_t corRows, std::size_t corCols,
+             float * dCorrelation)
+{
+    // if there is nothing to do
+    if (pairs == 0) {
+        // bail
+        return;
+    }
+
+    // split the pairs in evenly sized chunks
+    auto chunks = (pairs + maxChunk - 1) / maxChunk;
+    auto chunk = (pairs + chunks - 1) / chunks;
+    // when called from a parallel region, leave the other cores to the other threads
+    int threads = omp_in_parallel() ? 1 : omp_get_max_threads();
+
+    // make the plans
+    std::unique_ptr<FFTCorrelation> plan;
+    {
+        std::lock_guard<std::mutex> lock(plannerLock());
+        plan = std::make_unique<FFTCorrelation>(refRows, refCols, tgtRows, tgtCols,
+                                                corRows, corCols, chunk,
+                                                FFTW_ESTIMATE, threads);
+    }
+
+    // correlate
+    std::exception_ptr error = nullptr;
+    try {
+        correlateFFT(*plan, dArena, refStats, tgtStats, pairs, dCorrelation);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // destroy the plans
+    {
+        std::lock_guard<std::mutex> lock(plannerLock());
+        plan.reset();
+    }
+
+    // if something went wrong
+    if (error) {
+        // pass it on
+        std::rethrow_exception(error);
+    }
+
+    // all done
+    return;
+}
+
+
+// the frequency domain method: the numerators of the correlation coefficients of all
+// placements are the cross correlation of the zero mean reference tile with the search
+// window, which is the inverse transform of the product of their spectra; the target
+// variances at each placement come from the sum area tables of the amplitudes and of their
+// squares, so there is no sliding window left to sum over
+void
+ampcor::kernels::
+correlateFFT(FFTCorrelation & plan,
+             const float * dArena, const float * refStats, const float * tgtStats,
+             std::size_t pairs,
+             float * dCorrelation)
+{
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "correlating " << pairs << " pairs of tiles in the frequency domain"
+        << pyre::journal::endl;
+
+    // the grid sizes
+    auto refRows = plan._refRows, refCols = plan._refCols;
+    auto tgtRows = plan._tgtRows, tgtCols = plan._tgtCols;
+    auto corRows = plan._corRows, corCols = plan._corCols;
+    auto refCells = refRows * refCols;
+    auto tgtCells = tgtRows * tgtCols;
+    auto corCells = corRows * corCols;
+    // reference and target grids are interleaved; compute the stride
+    auto stride = refCells + tgtCells;
+
+    // the shape of the transforms
+    auto cols = plan._cols;
+    // the number of cells in a padded tile and in its spectrum
+    auto cells = static_cast<std::size_t>(plan._rows) * cols;
+    auto spectrumCells = static_cast<std::size_t>(plan._rows) * (cols/2 + 1);
+
+    // the scratch space
+    auto & ref = plan._ref;
+    auto & tgt = plan._tgt;
+    auto & refSpectra = plan._refSpectra;
+    auto & tgtSpectra = plan._tgtSpectra;
+    auto & sat = plan._sat;
+    auto & tgtSquares = plan._tgtSquares;
+
+    // go through the chunks
+    for (std::size_t first = 0; first < pairs; first += plan._chunk) {
+        // the number of pairs in this one
+        auto count = std::min(plan._chunk, pairs - first);
+        // the start of its tiles
+        auto arena = dArena + first*stride;
+
+        // the average squared amplitude of every placement
+        kernels::satSquares(arena, count, refCells, tgtCells, tgtRows, tgtCols, sat.data());
+        kernels::tgtStats(sat.data(), count, refRows, refCols, tgtRows, tgtCols, corRows, corCols,
+                          tgtSquares.data());
+
+        // embed the tiles in the zero padded buffers; the padding keeps the placements that
+        // we need free of wraparound, and unused slots of the last chunk stay empty
+        std::fill(ref.begin(), ref.end(), 0.0f);
+        std::fill(tgt.begin(), tgt.end(), 0.0f);
+        for (std::size_t pid = 0; pid < count; ++pid) {
+            auto refTile = arena + pid*stride;
+            auto tgtTile = refTile + refCells;
+            for (std::size_t row = 0; row < refRows; ++row) {
+                std::copy(refTile + row*refCols, refTile + (row+1)*refCols,
+                          ref.data() + pid*cells + row*cols);
+            }
+            for (std::size_t row = 0; row < tgtRows; ++row) {
+                std::copy(tgtTile + row*tgtCols, tgtTile + (row+1)*tgtCols,
+                          tgt.data() + pid*cells + row*cols);
+            }
+        }
+
+        // transform
+        plan._refFwd.execute();
+        plan._tgtFwd.execute();
+        // form the spectra of the cross correlations
+        for (std::size_t cell = 0; cell < count*spectrumCells; ++cell) {
+            tgtSpectra[cell] *= std::conj(refSpectra[cell]);
+        }
+        // and bring them back
+        plan._corRev.execute();
+
+        // normalize
+        #pragma omp parallel for
+        for (std::size_t pid = 0; pid < count; ++pid) {
+            _normalize(ref.data() + pid*cells, static_cast<std::size_t>(cols),
+                       refStats[first + pid],
+                       tgtStats + (first + pid)*corCells,
+                       tgtSquares.data() + pid*corCells,
+                       refCells, corRows, corCols,
+                       1.0f / cells,
+                       dCorrelation + (first + pid)*corCells);
+        }
+    }
+
+    // all done
+    return;
+}
+
+
+// the size of the scratch space
+auto
+ampcor::kernels::FFTCorrelation::
+footprint(size_type refRows, size_type refCols,
+          size_type tgtRows, size_type tgtCols,
+          size_type corRows, size_type corCols,
+          size_type capacity) -> size_type
+{
+    auto chunk = std::max<size_type>(1, std::min(capacity, maxChunk));
+    size_type rows = _fftRows(tgtRows);
+    size_type cols = _fftCols(tgtCols);
+
+    // the padded tiles, their spectra, the sum area tables and the mean squares
+    return chunk * (2 * rows * cols * sizeof(float)
+                    + 2 * rows * (cols/2 + 1) * sizeof(std::complex<float>)
+                    + tgtRows * tgtCols * sizeof(float)
+                    + corRows * corCols * sizeof(float));
+}
+
+
+// the scratch space and the plans
+ampcor::kernels::FFTCorrelation::
+FFTCorrelation(size_type refRows, size_type refCols,
+               size_type tgtRows, size_type tgtCols,
+               size_type corRows, size_type corCols,
+               size_type capacity, unsigned flags, int threads) :
+    _refRows{ refRows }, _refCols{ refCols },
+    _tgtRows{ tgtRows }, _tgtCols{ tgtCols },
+    _corRows{ corRows }, _corCols{ corCols },
+    _rows{ _fftRows(tgtRows) }, _cols{ _fftCols(tgtCols) },
+    _chunk{ std::max<size_type>(1, std::min(capacity, maxChunk)) }
+{
+    // the number of cells in a padded tile and in its spectrum
+    int cells = _rows * _cols;
+    int spectrumCells = _rows * (_cols/2 + 1);
+
+    // scratch space
+    _ref.resize(_chunk * cells);
+    _tgt.resize(_chunk * cells);
+    _refSpectra.resize(_chunk * spectrumCells);
+    _tgtSpectra.resize(_chunk * spectrumCells);
+    _sat.resize(_chunk * tgtRows * tgtCols);
+    _tgtSquares.resize(_chunk * corRows * corCols);
+
+    // the plans
+    const int n[] = {_rows, _cols};
+    const int spectrumShape[] = {_rows, _cols/2 + 1};
+    const int howmany = static_cast<int>(_chunk);
+    _refFwd = isce3::fft::FwdFFTPlan<float>(_refSpectra.data(), _ref.data(), n,
+                                            n, 1, cells, spectrumShape, 1, spectrumCells,
+                                            howmany, flags, threads);
+    _tgtFwd = isce3::fft::FwdFFTPlan<float>(_tgtSpectra.data(), _tgt.data(), n,
+                                            n, 1, cells, spectrumShape, 1, spectrumCells,
+                                            howmany, flags, threads);
+    _corRev = isce3::fft::InvFFTPlan<float>(_ref.data(), _tgtSpectra.data(), n,
+                                            spectrumShape, 1, spectrumCells, n, 1, cells,
+                                            howmany, flags, threads);
+}
+
+
+// the two methods cost about the same when the transforms of the padded search window do as
+// much work as sliding the reference tile over every placement
+bool
+ampcor::kernels::
+useFFTCorrelation(std::size_t refRows, std::size_t refCols,
+                  std::size_t tgtRows, std::size_t tgtCols,
+                  std::size_t corRows, std::size_t corCols)
+{
+    // the shape of the transforms
+    double cells = static_cast<double>(_fftRows(tgtRows)) * _fftCols(tgtCols);
+
+    // the direct method does five flops per reference cell and placement
+    double direct = 5.0 * corRows * corCols * refRows * refCols;
+    // three real transforms, and the product of the spectra
+    double spectral = 3 * 2.5 * cells * std::log2(cells) + 3 * cells;
+
+    // pick the cheaper one
+    return spectral < direct;
+}
+
+
+// the transforms span the search windows, padded to sizes that FFTW handles well
+int
+_fftRows(std::size_t tgtRows)
+{
+    return isce3::fft::nextFastPower(static_cast<std::int32_t>(tgtRows));
+}
+
+
+int
+_fftCols(std::size_t tgtCols)
+{
+    return isce3::fft::nextFastPower(static_cast<std::int32_t>(tgtCols));
+}
+
+
+// normalize the correlation of a pair
+template <typename value_t>
+void
+_normalize(const value_t * cor, // the unnormalized cross correlation
+           std::size_t corStride, // the distance between its rows
+           value_t refVariance, // std dev (unormalized) of the ref tile
+           const value_t * means, // the mean target amplitude of each placement
+           const value_t * squares, // and its mean squared amplitude
+           std::size_t refCells,
+           std::size_t corRows, std::size_t corCols,
+           value_t scale, // the normalization of the inverse transform
+           value_t * correlation)
+{
+    // go through all placements
+    for (std::size_t row = 0; row < corRows; ++row) {
+        for (std::size_t col = 0; col < corCols; ++col) {
+            // the slot of this placement
+            auto slot = row*corCols + col;
+            // the reference tile has zero mean, so the target mean drops out of the numerator
+            value_t numerator = scale * cor[row*corStride + col];
+            // the target variance
+            value_t mean = means[slot];
+            value_t tgtVariance = refCells * (squares[slot] - mean*mean);
+            // the difference loses all precision in flat areas, which do not correlate with
+            // anything
+            bool flat = tgtVariance <= 1e-5f * refCells * squares[slot];
+            auto norm = refVariance * std::sqrt(flat ? 0 : tgtVariance);
+            correlation[slot] = norm > 0 ? numerator / norm : 0;
+        }
+    }
+
+    // all done
+    return;
+}
+
+
+// end of file
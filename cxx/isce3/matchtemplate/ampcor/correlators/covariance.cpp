@@ -0,0 +1,116 @@
+// configuration
+#include <portinfo>
+// STL
+#include <algorithm>
+#include <cmath>
+// pyre
+#include <pyre/journal.h>
+// pull the declarations
+#include "kernels.h"
+
+// the offset covariance kernel
+template <typename value_t = float>
+static void
+_covariance(const value_t * gamma,
+            std::size_t pairId,
+            std::size_t corRows, std::size_t corCols,
+            const int * loc,
+            std::size_t refCells,
+            value_t * cov);
+
+
+// estimate the covariance of the offsets from the curvature of the correlation surface at
+// its maximum; the three entries per pair are the row variance, the column variance and the
+// row-column covariance
+void
+ampcor::kernels::
+covariance(const float * gamma,
+           std::size_t pairs, std::size_t corRows, std::size_t corCols,
+           const int * loc,
+           std::size_t refCells,
+           float * cov)
+{
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "launching estimation of the offset covariance"
+        << pyre::journal::endl;
+
+    // launch the threads
+    #pragma omp parallel for
+    for (std::size_t pairId=0; pairId < pairs; pairId++)
+       _covariance(gamma, pairId, corRows, corCols, loc, refCells, cov);
+
+    // all done
+    return;
+}
+
+
+// the offset covariance kernel
+template <typename value_t>
+void
+_covariance(const value_t * gamma,
+            std::size_t pairId,    // the pair index to process
+            std::size_t corRows, std::size_t corCols,    // the shape of the correlation matrix
+            const int * loc,       // the locations of the maxima
+            std::size_t refCells,  // the number of cells in a reference tile
+            value_t * cov)
+{
+    // locate the beginning of my correlation matrix
+    auto cor = gamma + pairId*corRows*corCols;
+    // and where my result goes
+    auto myCov = cov + 3*pairId;
+    // read my maximum
+    int row = loc[2*pairId];
+    int col = loc[2*pairId + 1];
+
+    // the curvature is not available when the peak is on the boundary
+    if (row < 1 || col < 1 ||
+        row + 1 >= static_cast<int>(corRows) || col + 1 >= static_cast<int>(corCols)) {
+        myCov[0] = 99;
+        myCov[1] = 99;
+        myCov[2] = 0;
+        return;
+    }
+
+    // a helper that reads the neighborhood of the peak
+    auto at = [cor, corCols, row, col](int dr, int dc) {
+        return cor[(row+dr)*corCols + (col+dc)];
+    };
+    value_t peak = at(0, 0);
+
+    // the second order derivatives, scaled by the tile size
+    value_t dxx = -(at(1, 0) + at(-1, 0) - 2*peak) * refCells;
+    value_t dyy = -(at(0, 1) + at(0, -1) - 2*peak) * refCells;
+    value_t dxy = (at(1, 1) + at(-1, -1) - at(1, -1) - at(-1, 1)) * value_t(0.25) * refCells;
+
+    // the noise terms
+    value_t n2 = std::max(1 - peak, value_t(0));
+    value_t n4 = n2*n2 * value_t(0.5) * refCells;
+    n2 *= 2;
+
+    // the determinant of the curvature
+    value_t u = dxy*dxy - dxx*dyy;
+    // if the surface is too flat
+    if (std::abs(u) < value_t(1e-2)) {
+        myCov[0] = 99;
+        myCov[1] = 99;
+        myCov[2] = 0;
+        return;
+    }
+
+    // otherwise
+    value_t u2 = u*u;
+    myCov[0] = (-n2*u*dyy + n4*(dyy*dyy + dxy*dxy)) / u2;
+    myCov[1] = (-n2*u*dxx + n4*(dxx*dxx + dxy*dxy)) / u2;
+    myCov[2] = (n2*u*dxy - n4*(dxx + dyy)*dxy) / u2;
+
+    // all done
+    return;
+}
+
+
+// end of file
@@ -0,0 +1,92 @@
+// configuration
+#include <portinfo>
+// STL
+#include <cmath>
+#include <complex>
+// pyre
+#include <pyre/journal.h>
+// pull the declarations
+#include "kernels.h"
+
+// the deramping kernel
+template <typename pixel_t = std::complex<float>>
+static void
+_deramp(pixel_t * arena,
+        std::size_t pairId,
+        std::size_t rows, std::size_t cols,
+        std::size_t rowStride, std::size_t cellsPerTilePair);
+
+
+// estimate the average phase gradient of each tile from the products of neighboring pixels
+// and remove the corresponding phase ramp, so that the spectrum of the tile is centered
+// before it gets refined
+void
+ampcor::kernels::
+deramp(std::complex<float> * arena,
+       std::size_t pairs, std::size_t rows, std::size_t cols,
+       std::size_t rowStride, std::size_t cellsPerTilePair)
+{
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "launching deramping of " << pairs << " tiles of " << rows << "x" << cols
+        << " cells"
+        << pyre::journal::endl;
+
+    // launch the threads
+    #pragma omp parallel for
+    for (std::size_t pairId=0; pairId < pairs; pairId++)
+       _deramp(arena, pairId, rows, cols, rowStride, cellsPerTilePair);
+
+    // all done
+    return;
+}
+
+
+// the deramping kernel
+template <typename pixel_t>
+void
+_deramp(pixel_t * arena,
+        std::size_t pairId,    // the tile index
+        std::size_t rows, std::size_t cols,    // the shape of the tile
+        std::size_t rowStride,    // the distance between successive rows of the tile
+        std::size_t cellsPerTilePair)
+{
+    // the support of the pixel type
+    using value_t = typename pixel_t::value_type;
+
+    // locate my tile
+    auto tile = arena + pairId*cellsPerTilePair;
+
+    // accumulate the products of each pixel with the conjugate of its neighbors
+    pixel_t down = 0;
+    pixel_t across = 0;
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t col = 0; col < cols; ++col) {
+            auto value = tile[row*rowStride + col];
+            if (row + 1 < rows) down += std::conj(value) * tile[(row+1)*rowStride + col];
+            if (col + 1 < cols) across += std::conj(value) * tile[row*rowStride + col + 1];
+        }
+    }
+
+    // the average phase increments; a vanishing sum means no measurable ramp
+    value_t phaseDown = std::abs(down) > 0 ? std::arg(down) : 0;
+    value_t phaseAcross = std::abs(across) > 0 ? std::arg(across) : 0;
+
+    // remove the ramp
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t col = 0; col < cols; ++col) {
+            value_t phase = row*phaseDown + col*phaseAcross;
+            tile[row*rowStride + col] *= pixel_t(std::cos(phase), -std::sin(phase));
+        }
+    }
+
+    // all done
+    return;
+}
+
+
+// end of file
@@ -12,6 +12,11 @@
 
 // STL
 #include <complex>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+// fft
+#include <isce3/fft/FFTPlan.h>
 
 // forward declarations
 namespace ampcor {
@@ -21,47 +26,125 @@ namespace ampcor {
 
         // subtract the tile mean from each reference pixel
         void refStats(float * rArena,
-                      std::size_t pairs, std::size_t refDim, std::size_t cellsPerTilePair,
+                      std::size_t pairs,
+                      std::size_t refRows, std::size_t refCols,
+                      std::size_t cellsPerTilePair,
                       float * stats);
 
         // build the sum area tables for the target tiles
         void sat(const float * rArena,
                  std::size_t pairs,
-                 std::size_t refCells, std::size_t tgtCells, std::size_t tgtDim,
+                 std::size_t refCells, std::size_t tgtCells,
+                 std::size_t tgtRows, std::size_t tgtCols,
                  float * sat);
 
+        // build the sum area tables of the squared amplitudes of the target tiles
+        void satSquares(const float * rArena,
+                        std::size_t pairs,
+                        std::size_t refCells, std::size_t tgtCells,
+                        std::size_t tgtRows, std::size_t tgtCols,
+                        float * sat);
+
         // compute the average amplitude for all possible placements of a reference shape
         // within the search windows
         void tgtStats(const float * sat,
                       std::size_t pairs,
-                      std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+                      std::size_t refRows, std::size_t refCols,
+                      std::size_t tgtRows, std::size_t tgtCols,
+                      std::size_t corRows, std::size_t corCols,
                       float * stats);
 
-        // compute the correlation matrix
+        // compute the correlation matrix, with whichever of the direct and the frequency
+        // domain methods is cheaper for these shapes
         void correlate(const float * rArena, const float * refStats, const float * tgtStats,
                        std::size_t pairs,
-                       std::size_t refCells, std::size_t tgtCells, std::size_t corCells,
-                       std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+                       std::size_t refRows, std::size_t refCols,
+                       std::size_t tgtRows, std::size_t tgtCols,
+                       std::size_t corRows, std::size_t corCols,
                        float * dCorrelation);
 
+        // compute the correlation matrix by summing over the reference tile at each placement
+        void correlateDirect(const float * rArena, const float * refStats,
+                             const float * tgtStats,
+                             std::size_t pairs,
+                             std::size_t refRows, std::size_t refCols,
+                             std::size_t tgtRows, std::size_t tgtCols,
+                             std::size_t corRows, std::size_t corCols,
+                             float * dCorrelation);
+
+        // compute the correlation matrix from the product of the tile spectra
+        void correlateFFT(const float * rArena, const float * refStats,
+                          const float * tgtStats,
+                          std::size_t pairs,
+                          std::size_t refRows, std::size_t refCols,
+                          std::size_t tgtRows, std::size_t tgtCols,
+                          std::size_t corRows, std::size_t corCols,
+                          float * dCorrelation);
+
+        // the scratch space and FFT plans of the frequency domain correlation, for reuse
+        // across calls; FFTW planning and plan destruction are not thread safe, so build
+        // and destroy these on one thread at a time, and hand each one to one thread at a
+        // time
+        class FFTCorrelation;
+
+        // the lock that serializes FFTW planning and plan destruction across the kernels
+        // and the correlators
+        std::mutex & plannerLock();
+
+        // compute the correlation matrix with prebuilt plans
+        void correlateFFT(FFTCorrelation & plan,
+                          const float * rArena, const float * refStats,
+                          const float * tgtStats,
+                          std::size_t pairs,
+                          float * dCorrelation);
+
+        // decide whether the frequency domain correlation is cheaper for these shapes
+        bool useFFTCorrelation(std::size_t refRows, std::size_t refCols,
+                               std::size_t tgtRows, std::size_t tgtCols,
+                               std::size_t corRows, std::size_t corCols);
+
         // compute the locations of the maximum value of the correlation map
         void maxcor(const float * cor,
-                    std::size_t pairs, std::size_t corCells, std::size_t corDim,
+                    std::size_t pairs, std::size_t corRows, std::size_t corCols,
                     int * loc);
 
+        // estimate the signal to noise ratio of the correlation peaks
+        void snr(const float * cor,
+                 std::size_t pairs, std::size_t corRows, std::size_t corCols,
+                 const int * loc,
+                 std::size_t statRows, std::size_t statCols,
+                 float * snr);
+
+        // estimate the covariance of the offsets from the curvature of the correlation peaks
+        void covariance(const float * cor,
+                        std::size_t pairs, std::size_t corRows, std::size_t corCols,
+                        const int * loc,
+                        std::size_t refCells,
+                        float * cov);
+
         // nudge the (row, col) pairs so that they describe sub-tiles within a target tile
         void nudge(std::size_t pairs,
-                   std::size_t refDim,  std::size_t tgtDim, std::size_t margin,
+                   std::size_t refRows, std::size_t refCols,
+                   std::size_t tgtRows, std::size_t tgtCols,
+                   std::size_t margin,
                    int * locations, float * offsets);
 
         // migrate the expanded maxcor tiles to the refinement arena
         void migrate(const std::complex<float>  * arena,
                      std::size_t pairs,
-                     std::size_t refDim, std::size_t tgtDim, std::size_t expDim,
-                     std::size_t refRefinedDim, std::size_t tgtRefinedDim,
+                     std::size_t refRows, std::size_t refCols,
+                     std::size_t tgtRows, std::size_t tgtCols,
+                     std::size_t expRows, std::size_t expCols,
+                     std::size_t refRefinedRows, std::size_t refRefinedCols,
+                     std::size_t tgtRefinedRows, std::size_t tgtRefinedCols,
                      const int * locations,
                      std::complex<float> * refinedArena);
 
+        // remove the average phase ramp of complex tiles before they are refined
+        void deramp(std::complex<float> * arena,
+                    std::size_t pairs, std::size_t rows, std::size_t cols,
+                    std::size_t rowStride, std::size_t cellsPerTilePair);
+
         // upcast the correlation matrix into complex numbers and embed in the zoomed
         // hyper-matrix
         auto r2c(const float * gamma,
@@ -76,11 +159,62 @@ namespace ampcor {
         // assemble the offset field
         void offsetField(const int * zoomed,
                          std::size_t pairs,
-                         std::size_t margin, std::size_t refineMargin, std::size_t zoom,
+                         std::size_t marginRows, std::size_t marginCols,
+                         std::size_t refineMargin, std::size_t zoom,
                          float * field);
     }
 }
 
+
+// the scratch space and FFT plans of the frequency domain correlation of the tile pairs with
+// the given shapes, {capacity} pairs at a time
+class ampcor::kernels::FFTCorrelation {
+    // types
+public:
+    using size_type = std::size_t;
+
+    // meta-methods
+public:
+    FFTCorrelation(size_type refRows, size_type refCols,
+                   size_type tgtRows, size_type tgtCols,
+                   size_type corRows, size_type corCols,
+                   size_type capacity, unsigned flags = FFTW_ESTIMATE, int threads = 1);
+
+    // the size of the scratch space, in bytes
+    static auto footprint(size_type refRows, size_type refCols,
+                          size_type tgtRows, size_type tgtCols,
+                          size_type corRows, size_type corCols,
+                          size_type capacity) -> size_type;
+
+    // disallow copies; the plans are bound to the buffers
+    FFTCorrelation(const FFTCorrelation &) = delete;
+    FFTCorrelation & operator=(const FFTCorrelation &) = delete;
+
+    // implementation details
+private:
+    friend void correlateFFT(FFTCorrelation &, const float *, const float *, const float *,
+                             std::size_t, float *);
+
+    // the shapes of the tiles
+    const size_type _refRows, _refCols;
+    const size_type _tgtRows, _tgtCols;
+    const size_type _corRows, _corCols;
+    // the shape of the padded tiles
+    const int _rows, _cols;
+    // the number of pairs transformed together
+    const size_type _chunk;
+
+    // scratch space
+    std::vector<float> _ref, _tgt;
+    std::vector<std::complex<float>> _refSpectra, _tgtSpectra;
+    std::vector<float> _sat, _tgtSquares;
+
+    // the plans, with the spectra packed in their non-redundant half; the correlation
+    // matrices are transformed back into the reference buffer
+    isce3::fft::FwdFFTPlan<float> _refFwd, _tgtFwd;
+    isce3::fft::InvFFTPlan<float> _corRev;
+};
+
 // code guard
 #endif
 
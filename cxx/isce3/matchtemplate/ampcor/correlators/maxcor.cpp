@@ -17,7 +17,7 @@
 template <typename value_t = float>
 static void
 _maxcor(const value_t * gamma,
-        std::size_t pairs, std::size_t corCells, std::size_t corDim,
+        std::size_t pairs, std::size_t corRows, std::size_t corCols,
         int * loc);
 
 
@@ -25,7 +25,7 @@ _maxcor(const value_t * gamma,
 void
 ampcor::kernels::
 maxcor(const float * gamma,
-         std::size_t pairs, std::size_t corCells, std::size_t corDim,
+         std::size_t pairs, std::size_t corRows, std::size_t corCols,
          int * loc)
 {
     // make a channel
@@ -40,7 +40,7 @@ maxcor(const float * gamma,
     // launch the threads
     #pragma omp parallel for
     for (std::size_t pairId=0; pairId < pairs; pairId++) 
-       _maxcor(gamma, pairId, corCells, corDim, loc);
+       _maxcor(gamma, pairId, corRows, corCols, loc);
 
 
     // all done
@@ -53,10 +53,12 @@ template <typename value_t>
 void
 _maxcor(const value_t * gamma,
       std::size_t pairId,    // the pair index to process
-      std::size_t corCells,  // the number of cells in the correlation hyper-matrix
-      std::size_t corDim,    // and its number of rows
+      std::size_t corRows,   // the number of rows in the correlation hyper-matrix
+      std::size_t corCols,   // and its number of columns
       int * loc)
 {
+    // the number of cells in the correlation hyper-matrix
+    auto corCells = corRows * corCols;
     // locate the beginning of my correlation matrix
     auto cor = gamma + pairId*corCells;
     // locate the beginning of my stats table
@@ -79,8 +81,8 @@ _maxcor(const value_t * gamma,
 
 
     // save
-    myloc[0] = highCell / corDim;  // row
-    myloc[1] = highCell % corDim;  // col
+    myloc[0] = highCell / corCols;  // row
+    myloc[1] = highCell % corCols;  // col
 
     // all done
     return;
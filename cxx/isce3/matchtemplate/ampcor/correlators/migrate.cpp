@@ -23,7 +23,7 @@ _migrate(const pixel_t * coarse,
          std::size_t cellsPerPair, std::size_t cellsPerRefinedPair,
          std::size_t refCells, 
          std::size_t refRefinedCells, 
-         std::size_t tdim, std::size_t edim, std::size_t trdim,
+         std::size_t tcols, std::size_t erows, std::size_t ecols, std::size_t trcols,
          const int * locations,
          pixel_t * refined);
 
@@ -34,8 +34,11 @@ void
 ampcor::kernels::
 migrate(const std::complex<float> * coarse,
         std::size_t pairs,
-        std::size_t refDim, std::size_t tgtDim, std::size_t expDim,
-        std::size_t refRefinedDim, std::size_t tgtRefinedDim,
+        std::size_t refRows, std::size_t refCols,
+        std::size_t tgtRows, std::size_t tgtCols,
+        std::size_t expRows, std::size_t expCols,
+        std::size_t refRefinedRows, std::size_t refRefinedCols,
+        std::size_t tgtRefinedRows, std::size_t tgtRefinedCols,
         const int * locations,
         std::complex<float> * refined)
 {
@@ -50,10 +53,10 @@ migrate(const std::complex<float> * coarse,
         << pyre::journal::endl;
 
     // shape calculations
-    auto refCells = refDim * refDim;
-    auto tgtCells = tgtDim * tgtDim;
-    auto refRefinedCells = refRefinedDim * refRefinedDim;
-    auto tgtRefinedCells = tgtRefinedDim * tgtRefinedDim;
+    auto refCells = refRows * refCols;
+    auto tgtCells = tgtRows * tgtCols;
+    auto refRefinedCells = refRefinedRows * refRefinedCols;
+    auto tgtRefinedCells = tgtRefinedRows * tgtRefinedCols;
 
     // so i can skip over work others are doing
     auto cellsPerPair = refCells + tgtCells;
@@ -66,7 +69,7 @@ migrate(const std::complex<float> * coarse,
                  pairId,
                  cellsPerPair, cellsPerRefinedPair,
                  refCells, refRefinedCells, 
-                 tgtDim, expDim, tgtRefinedDim,
+                 tgtCols, expRows, expCols, tgtRefinedCols,
                  locations,
                  reinterpret_cast<std::complex<float> *>(refined));
 
@@ -83,7 +86,7 @@ _migrate(const pixel_t * coarse,
          std::size_t cellsPerPair, std::size_t cellsPerRefinedPair,
          std::size_t refCells, 
          std::size_t refRefinedCells, 
-         std::size_t tdim, std::size_t edim, std::size_t trdim,
+         std::size_t tcols, std::size_t erows, std::size_t ecols, std::size_t trcols,
          const int * locations,
          pixel_t * refined)
 {
@@ -98,13 +101,13 @@ _migrate(const pixel_t * coarse,
     pixel_t * dest;
 
     // go down the rows in tandem
-    auto rowFootprint = edim * sizeof(pixel_t);
-    for (std::size_t jdx = 0; jdx < edim; ++jdx) {
+    auto rowFootprint = ecols * sizeof(pixel_t);
+    for (std::size_t jdx = 0; jdx < erows; ++jdx) {
         // update the pointers to new row
         // source moves by a whole row in the target tile
-        src  = coarse  + pairId*cellsPerPair + refCells + (row+jdx)*tdim + col;
+        src  = coarse  + pairId*cellsPerPair + refCells + (row+jdx)*tcols + col;
         // destination moves by a whole row in the refined target tile
-        dest = refined + pairId*cellsPerRefinedPair + refRefinedCells + jdx*trdim;
+        dest = refined + pairId*cellsPerRefinedPair + refRefinedCells + jdx*trcols;
         // migrate data
         std::memcpy(dest, src, rowFootprint);
     }
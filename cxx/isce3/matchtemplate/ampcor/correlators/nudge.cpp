@@ -18,8 +18,8 @@
 template <typename value_t = float>
 static void
 _nudge(std::size_t pairId,    // the tile id
-       std::size_t oldDim,    // the old shape of the target tiles
-       std::size_t newDim,    // the new shape of the target tiles
+       std::size_t oldRows, std::size_t oldCols,    // the old shape of the target tiles
+       std::size_t newRows, std::size_t newCols,    // the new shape of the target tiles
        std::size_t margin,    // the new margin of the search window
        int * loc,
        value_t * offset);
@@ -30,8 +30,8 @@ _nudge(std::size_t pairId,    // the tile id
 void
 ampcor::kernels::
 nudge(std::size_t pairs,     // the total number of tiles
-      std::size_t refDim,    // the shape of the reference tiles
-      std::size_t tgtDim,    // the shape of the target tiles
+      std::size_t refRows, std::size_t refCols,    // the shape of the reference tiles
+      std::size_t tgtRows, std::size_t tgtCols,    // the shape of the target tiles
       std::size_t margin,    // the new margin around the reference tile
       int * loc,             // input/output: the updated maxcor location for upcoming refinement step
       float * offset)        // output: the offset (from coarse maxcor location) adjusted for nudging 
@@ -48,7 +48,8 @@ nudge(std::size_t pairs,     // the total number of tiles
     // launch the kernels
     #pragma omp parallel for
     for (std::size_t pairId=0; pairId<pairs; pairId++)
-       _nudge(pairId, tgtDim, refDim+2*margin, margin, loc, offset);
+       _nudge(pairId, tgtRows, tgtCols, refRows+2*margin, refCols+2*margin, margin,
+              loc, offset);
 
     // all done
     return;
@@ -59,8 +60,8 @@ nudge(std::size_t pairs,     // the total number of tiles
 template <typename value_t>
 static void
 _nudge(std::size_t pairId,    // the tile index
-       std::size_t oldDim,    // the shape of the offset target tiles
-       std::size_t newDim,    // the shape of the refined target tiles
+       std::size_t oldRows, std::size_t oldCols,    // the shape of the offset target tiles
+       std::size_t newRows, std::size_t newCols,    // the shape of the refined target tiles
        std::size_t margin,    // the new margin of the search window
        int * loc,
        value_t * offset)
@@ -86,9 +87,9 @@ _nudge(std::size_t pairId,    // the tile index
     
     // if it sticks out on the right move so that it fits and correct the offset
     //offset accordingly.
-    if (left + newDim > oldDim) {
-        myOffset[1] -= (left + static_cast<value_t>(newDim) - static_cast<value_t>(oldDim));
-        left = oldDim - newDim;
+    if (left + newCols > oldCols) {
+        myOffset[1] -= (left + static_cast<value_t>(newCols) - static_cast<value_t>(oldCols));
+        left = oldCols - newCols;
     }
 
     // repeat for row
@@ -103,9 +104,9 @@ _nudge(std::size_t pairId,    // the tile index
     
     // if it sticks out below the bottom row move it up so it fits and correct
     // the offset offset accordingly.
-    if (top + newDim > oldDim) {
-        myOffset[0] -= (top + static_cast<value_t>(newDim) - static_cast<value_t>(oldDim));
-        top = oldDim - newDim;
+    if (top + newRows > oldRows) {
+        myOffset[0] -= (top + static_cast<value_t>(newRows) - static_cast<value_t>(oldRows));
+        top = oldRows - newRows;
     }
     
 
@@ -20,7 +20,8 @@ template <typename value_t = float>
 static void
 _offsetField(const int * fine,         // the fine offsets
              std::size_t pairId,       // the tile id to process
-             std::size_t margin,       // the origin of the coarse shifts
+             std::size_t marginRows,   // the origin of the coarse shifts
+             std::size_t marginCols,
              std::size_t refineMargin, // origin of the refined shifts
              std::size_t zoom,         // the overall zoom factor of the refined shifts
              value_t * field             // results
@@ -32,7 +33,8 @@ void
 ampcor::kernels::
 offsetField(const int * fine,         // the fine offsets
             std::size_t pairs,        // the total number of entries
-            std::size_t margin,       // the origin of the coarse shifts
+            std::size_t marginRows,   // the origin of the coarse shifts
+            std::size_t marginCols,
             std::size_t refineMargin, // origin of the refined shifts
             std::size_t zoom,         // the overall zoom factor of the refined shifts
             float * field             // results (which contains the coarse offsets)
@@ -50,7 +52,7 @@ offsetField(const int * fine,         // the fine offsets
     // launch
     #pragma omp parallel for
     for (std::size_t pairId=0; pairId < pairs; pairId++)
-       _offsetField(fine, pairId, margin, refineMargin, zoom, field);
+       _offsetField(fine, pairId, marginRows, marginCols, refineMargin, zoom, field);
     
     // all done
     return;
@@ -62,7 +64,8 @@ template <typename value_t>
 static void
 _offsetField(const int * fine,          // the fine offsets
              std::size_t pairId,        // the tile id to process
-             std::size_t margin,        // the origin of the coarse shifts
+             std::size_t marginRows,    // the origin of the coarse shifts
+             std::size_t marginCols,
              std::size_t refineMargin,  // origin of the refined shifts
              std::size_t zoom,          // the overall zoom factor of the refined shifts
              value_t * field            // results
@@ -77,8 +80,8 @@ _offsetField(const int * fine,          // the fine offsets
     auto myField = field + 2*pairId;
 
     // do the math
-    myField[0] = (one*myField[0] - margin) + (one * myFine[0] / zoom - refineMargin);
-    myField[1] = (one*myField[1] - margin) + (one * myFine[1] / zoom - refineMargin);
+    myField[0] = (one*myField[0] - marginRows) + (one * myFine[0] / zoom - refineMargin);
+    myField[1] = (one*myField[1] - marginCols) + (one * myFine[1] / zoom - refineMargin);
 
     // all done
     return;
@@ -22,7 +22,7 @@ template <typename value_t = float>
 void
 _refStats(value_t * rArena,
           std::size_t pairId,
-          std::size_t refDim, std::size_t cellsPerTilePair,
+          std::size_t refCells, std::size_t cellsPerTilePair,
           value_t * stats);
 
 
@@ -30,7 +30,9 @@ _refStats(value_t * rArena,
 void
 ampcor::kernels::
 refStats(float * rArena,
-         std::size_t pairs, std::size_t refDim, std::size_t cellsPerTilePair,
+         std::size_t pairs,
+         std::size_t refRows, std::size_t refCols,
+         std::size_t cellsPerTilePair,
          float * stats)
 {
     // make a channel
@@ -39,12 +41,12 @@ refStats(float * rArena,
     channel
         << pyre::journal::at(__HERE__)
         << "arena has " << pairs << " blocks of " << cellsPerTilePair << " cells;"
-        << " the reference tiles are " << refDim << "x" << refDim
+        << " the reference tiles are " << refRows << "x" << refCols
         << pyre::journal::endl;
 
     #pragma omp parallel for
     for (std::size_t pairId = 0; pairId < pairs; pairId++)
-       _refStats(rArena, pairId, refDim, cellsPerTilePair, stats);
+       _refStats(rArena, pairId, refRows*refCols, cellsPerTilePair, stats);
 
     // all done
     return;
@@ -56,7 +58,7 @@ template <typename value_t>
 void
 _refStats(value_t * rArena,
           std::size_t pairId,
-          std::size_t refDim, std::size_t cellsPerTilePair,
+          std::size_t refCells, std::size_t cellsPerTilePair,
           value_t * stats)
 {
 
@@ -64,7 +66,7 @@ _refStats(value_t * rArena,
     auto tile = rArena + pairId*cellsPerTilePair;
 
     // Compute the location of the cell past the end of my tile
-    auto eot = tile + refDim*refDim;
+    auto eot = tile + refCells;
 
     // Initialize the accumulator
     value_t sum = 0;
@@ -74,7 +76,7 @@ _refStats(value_t * rArena,
        sum += *cell;
 
     // Get the mean
-    value_t mean = sum / (refDim*refDim);
+    value_t mean = sum / refCells;
 
 
 
@@ -16,11 +16,12 @@
 #include "kernels.h"
 
 
-// the SAT generation kernel
-template <typename value_t = float>
+// the SAT generation kernel; {squared} tables accumulate the squares of the amplitudes
+template <bool squared = false, typename value_t = float>
 static void
 _sat(const value_t * dArena,
-    std::size_t pairId, std::size_t rcells, std::size_t tcells, std::size_t tdim,
+    std::size_t pairId, std::size_t rcells, std::size_t tcells,
+    std::size_t trows, std::size_t tcols,
     value_t * dSAT);
 
 
@@ -28,7 +29,8 @@ _sat(const value_t * dArena,
 void
 ampcor::kernels::
 sat(const float * dArena,
-    std::size_t pairs, std::size_t refCells, std::size_t tgtCells, std::size_t tgtDim,
+    std::size_t pairs, std::size_t refCells, std::size_t tgtCells,
+    std::size_t tgtRows, std::size_t tgtCols,
     float * dSAT)
 {
     // make a channel
@@ -44,7 +46,35 @@ sat(const float * dArena,
     // launch the SAT kernel
     #pragma omp parallel for
     for (std::size_t pairId = 0; pairId < pairs; pairId++)
-        _sat(dArena, pairId, refCells, tgtCells, tgtDim, dSAT);
+        _sat(dArena, pairId, refCells, tgtCells, tgtRows, tgtCols, dSAT);
+
+    // all done
+    return;
+}
+
+
+// the SATs of the squared amplitudes, for the variances of the target placements
+void
+ampcor::kernels::
+satSquares(const float * dArena,
+           std::size_t pairs, std::size_t refCells, std::size_t tgtCells,
+           std::size_t tgtRows, std::size_t tgtCols,
+           float * dSAT)
+{
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "launching SATs computation of the squared amplitudes"
+        << pyre::journal::endl;
+
+
+    // launch the SAT kernel
+    #pragma omp parallel for
+    for (std::size_t pairId = 0; pairId < pairs; pairId++)
+        _sat<true>(dArena, pairId, refCells, tgtCells, tgtRows, tgtCols, dSAT);
 
     // all done
     return;
@@ -52,14 +82,21 @@ sat(const float * dArena,
 
 
 // the SAT generation kernel
-template <typename value_t>
+template <bool squared, typename value_t>
 void
 _sat(const value_t * dArena,
-    std::size_t pairId, std::size_t rcells, std::size_t tcells, std::size_t tdim,
+    std::size_t pairId, std::size_t rcells, std::size_t tcells,
+    std::size_t trows, std::size_t tcols,
     value_t * dSAT)
 {
     // Get the stride from one pair to the other
     std::size_t stride = rcells + tcells;
+
+    // the value of a cell
+    auto value = [dArena](std::size_t cell) -> value_t {
+        value_t v = dArena[cell];
+        return squared ? v*v : v;
+    };
  
     
     // my starting point for reading data in the arena
@@ -69,27 +106,27 @@ _sat(const value_t * dArena,
 
 
     // First pixel
-    dSAT[write] = dArena[read];
+    dSAT[write] = value(read);
 
     // First row
-    for (std::size_t col=1; col < tdim; col++)
-       dSAT[write+col] = dSAT[write+col-1] + dArena[read+col];
+    for (std::size_t col=1; col < tcols; col++)
+       dSAT[write+col] = dSAT[write+col-1] + value(read+col);
 
     // Next rows
-    for (std::size_t row=1; row < tdim; row++) {
+    for (std::size_t row=1; row < trows; row++) {
 
-        std::size_t offsetWrite1 = write + tdim * row;
-        std::size_t offsetWrite2 = write + tdim * (row - 1);
-        std::size_t offsetRead1  = read  + tdim * row;
+        std::size_t offsetWrite1 = write + tcols * row;
+        std::size_t offsetWrite2 = write + tcols * (row - 1);
+        std::size_t offsetRead1  = read  + tcols * row;
 
         // First pixel of the current row
         // current row cumulative sum
-        value_t sum = dArena[offsetRead1];
+        value_t sum = value(offsetRead1);
         dSAT[offsetWrite1] = dSAT[offsetWrite2] + sum;
 
         // Next pixels
-        for (std::size_t col=1; col < tdim; col++) {
-           sum += dArena[offsetRead1 + col];
+        for (std::size_t col=1; col < tcols; col++) {
+           sum += value(offsetRead1 + col);
            dSAT[offsetWrite1 + col] = dSAT[offsetWrite2 + col] + sum;
         }
     } 
@@ -0,0 +1,97 @@
+// configuration
+#include <portinfo>
+// STL
+#include <algorithm>
+// pyre
+#include <pyre/journal.h>
+// pull the declarations
+#include "kernels.h"
+
+// the signal to noise ratio kernel
+template <typename value_t = float>
+static void
+_snr(const value_t * gamma,
+     std::size_t pairId,
+     std::size_t corRows, std::size_t corCols,
+     const int * loc,
+     std::size_t statRows, std::size_t statCols,
+     value_t * snr);
+
+
+// compare the height of each correlation peak to the mean energy of the correlation surface
+// in a window around it
+void
+ampcor::kernels::
+snr(const float * gamma,
+    std::size_t pairs, std::size_t corRows, std::size_t corCols,
+    const int * loc,
+    std::size_t statRows, std::size_t statCols,
+    float * snr)
+{
+    // make a channel
+    pyre::journal::debug_t channel("ampcor");
+
+    // show me
+    channel
+        << pyre::journal::at(__HERE__)
+        << "launching estimation of the signal to noise ratio over "
+        << statRows << "x" << statCols << " windows"
+        << pyre::journal::endl;
+
+    // launch the threads
+    #pragma omp parallel for
+    for (std::size_t pairId=0; pairId < pairs; pairId++)
+       _snr(gamma, pairId, corRows, corCols, loc, statRows, statCols, snr);
+
+    // all done
+    return;
+}
+
+
+// the signal to noise ratio kernel
+template <typename value_t>
+void
+_snr(const value_t * gamma,
+     std::size_t pairId,    // the pair index to process
+     std::size_t corRows, std::size_t corCols,    // the shape of the correlation matrix
+     const int * loc,       // the locations of the maxima
+     std::size_t statRows, std::size_t statCols,  // the shape of the statistics window
+     value_t * snr)
+{
+    // locate the beginning of my correlation matrix
+    auto cor = gamma + pairId*corRows*corCols;
+    // and my maximum
+    auto row = loc[2*pairId];
+    auto col = loc[2*pairId + 1];
+    auto peak = cor[row*corCols + col];
+
+    // the window centered on the maximum, clipped to the correlation matrix
+    int rowMin = std::max(row - static_cast<int>(statRows/2), 0);
+    int rowMax = std::min(row - static_cast<int>(statRows/2) + static_cast<int>(statRows),
+                          static_cast<int>(corRows));
+    int colMin = std::max(col - static_cast<int>(statCols/2), 0);
+    int colMax = std::min(col - static_cast<int>(statCols/2) + static_cast<int>(statCols),
+                          static_cast<int>(corCols));
+
+    // accumulate the energy of the correlation surface within the window
+    value_t sum = 0;
+    std::size_t count = 0;
+    for (int idy = rowMin; idy < rowMax; ++idy) {
+        for (int idx = colMin; idx < colMax; ++idx) {
+            auto value = cor[idy*corCols + idx];
+            sum += value*value;
+            ++count;
+        }
+    }
+
+    // the mean energy away from the peak
+    value_t noise = count > 1 ? (sum - peak*peak) / (count - 1) : 0;
+    // save
+    snr[pairId] = noise > 0 ? peak*peak / noise : 0;
+
+    // all done
+    return;
+}
+
+
+// end of file
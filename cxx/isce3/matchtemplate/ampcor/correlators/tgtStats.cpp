@@ -18,7 +18,10 @@
 template <typename value_t = float>
 static void
 _tgtStats(const value_t * sat,
-          std::size_t pairId, std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+          std::size_t pairId,
+          std::size_t refRows, std::size_t refCols,
+          std::size_t tgtRows, std::size_t tgtCols,
+          std::size_t corRows, std::size_t corCols,
           value_t * stats);
 
 
@@ -35,7 +38,10 @@ _tgtStats(const value_t * sat,
 void
 ampcor::kernels::
 tgtStats(const float * dSAT,
-         std::size_t pairs, std::size_t refDim, std::size_t tgtDim, std::size_t corDim,
+         std::size_t pairs,
+         std::size_t refRows, std::size_t refCols,
+         std::size_t tgtRows, std::size_t tgtCols,
+         std::size_t corRows, std::size_t corCols,
          float * dStats)
 {
     // make a channel
@@ -50,7 +56,7 @@ tgtStats(const float * dSAT,
     // launch the kernels
     #pragma omp parallel for
     for (std::size_t pairId=0; pairId < pairs; pairId++)
-       _tgtStats(dSAT, pairId, refDim, tgtDim, corDim, dStats);
+       _tgtStats(dSAT, pairId, refRows, refCols, tgtRows, tgtCols, corRows, corCols, dStats);
 
     // all done
     return;
@@ -62,18 +68,18 @@ template <typename value_t>
 void
 _tgtStats(const value_t * dSAT,
       std::size_t pairId,    // the target tile index
-      std::size_t refDim,    // the shape of each reference tile
-      std::size_t tgtDim,    // the shape of each target tile
-      std::size_t corDim,    // the shape of each grid
+      std::size_t refRows, std::size_t refCols,    // the shape of each reference tile
+      std::size_t tgtRows, std::size_t tgtCols,    // the shape of each target tile
+      std::size_t corRows, std::size_t corCols,    // the shape of each grid
       value_t * dStats)
 {
 
     // compute the number of cells in a reference tile
-    auto refCells = refDim * refDim;
+    auto refCells = refRows * refCols;
     // compute the number of cells in a target tile
-    auto tgtCells = tgtDim * tgtDim;
+    auto tgtCells = tgtRows * tgtCols;
     // compute the number of cells in each correlation matrix
-    auto corCells = corDim * corDim;
+    auto corCells = corRows * corCols;
 
     // locate the beginning of my SAT table
     auto sat = dSAT + pairId*tgtCells;
@@ -81,38 +87,38 @@ _tgtStats(const value_t * dSAT,
     auto stats = dStats + pairId*corCells;
 
     // go through all possible row offsets
-    for (std::size_t row = 0; row < corDim; ++row) {
+    for (std::size_t row = 0; row < corRows; ++row) {
         // the row limit of the tile
         // this depends on the shape of the reference tile
-        std::size_t rowMax = row + refDim - 1;
+        std::size_t rowMax = row + refRows - 1;
 
         // go through all possible column offsets
-        for (std::size_t col = 0; col < corDim; ++col) {
+        for (std::size_t col = 0; col < corCols; ++col) {
             // the column limit of the tile
             //  this depends on the shape of the reference tile
-            std::size_t colMax = col + refDim - 1;
+            std::size_t colMax = col + refCols - 1;
 
             // initialize the sum by reading the bottom right corner; it's guaranteed to be
             // within the SAT
-            value_t sum = sat[rowMax*tgtDim + colMax];
+            value_t sum = sat[rowMax*tgtCols + colMax];
 
             // if the slice is not top-aligned
             // subtract the value from the upper right corner
             if (row > 0) 
-                sum -= sat[(row-1)*tgtDim + colMax];
+                sum -= sat[(row-1)*tgtCols + colMax];
 
             // if the slice is not left-aligned
             // subtract the value of the upper left corner
             if (col > 0) 
-                sum -= sat[rowMax*tgtDim + (col - 1)];
+                sum -= sat[rowMax*tgtCols + (col - 1)];
 
             // if the slice is not aligned with the upper left corner
             // restore its contribution to the sum
             if (row > 0 && col > 0) 
-                sum += sat[(row-1)*tgtDim + (col-1)];
+                sum += sat[(row-1)*tgtCols + (col-1)];
             
             // compute the offset that brings us to this placement in this tile
-            std::size_t offset = row*corDim + col;
+            std::size_t offset = row*corCols + col;
 
             // compute the average value and store it
             stats[offset] = sum / refCells;
@@ -0,0 +1,321 @@
+/**
+ * @file cpuAmpcorController.cpp
+ * @brief Implementations of cpuAmpcorController
+ */
+
+// my declaration
+#include "cpuAmpcorController.h"
+
+// dependencies
+#include <algorithm>
+#include <complex>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include <isce3/except/Error.h>
+#include <isce3/io/Raster.h>
+#include <isce3/io/RasterView.h>
+#include <isce3/matchtemplate/ampcor/correlators/Parallel.h>
+
+using cell_t = std::complex<float>;
+using view_t = isce3::io::RasterView<cell_t>;
+
+/// Find the image rows spanned by the windows [first, first+count), clipped
+/// to the image; row0 and rows are set to the range of rows
+static void bandRows(const std::vector<int> & startDown, int first, int count,
+                     int height, int length, int & row0, int & rows)
+{
+    auto begin = startDown.begin() + first;
+    auto end = begin + count;
+    int top = *std::min_element(begin, end);
+    int bottom = *std::max_element(begin, end) + height;
+
+    row0 = std::max(top, 0);
+    rows = std::max(std::min(bottom, length) - row0, 0);
+}
+
+/// Read the image rows spanned by the windows [first, first+count) into
+/// buffer; row0 and rows are set to the range of rows read
+static void loadBand(isce3::io::Raster & image,
+                     const std::vector<int> & startDown, int first, int count,
+                     int height, std::vector<cell_t> & buffer,
+                     int & row0, int & rows)
+{
+    bandRows(startDown, first, count, height, image.length(), row0, rows);
+
+    buffer.resize(static_cast<size_t>(rows) * image.width());
+    if (rows > 0) {
+        image.getBlock(buffer.data(), 0, row0, image.width(), rows);
+    }
+}
+
+/// Hint the rows spanned by the windows [first, first+count) of a memory
+/// mapped image will be read soon
+static void prefetchBand(const view_t & view,
+                         const std::vector<int> & startDown, int first, int count,
+                         int height)
+{
+    int row0, rows;
+    bandRows(startDown, first, count, height, view.length(), row0, rows);
+    view.prefetchRows(row0, rows);
+}
+
+/// Extract a rows x cols chip starting at (startDown, startAcross) from an
+/// image whose rows are returned by imageRow, nullptr for rows that are not
+/// available; pixels outside of the image are set to zero
+template<typename RowFn>
+static void extractChip(RowFn imageRow, int width,
+                        int startDown, int startAcross, int rows, int cols,
+                        cell_t * chip)
+{
+    for (int i = 0; i < rows; ++i) {
+        cell_t * dst = chip + static_cast<size_t>(i) * cols;
+        const cell_t * src = imageRow(startDown + i);
+        if (src == nullptr) {
+            std::fill(dst, dst + cols, cell_t(0));
+            continue;
+        }
+        for (int j = 0; j < cols; ++j) {
+            int col = startAcross + j;
+            dst[j] = (col < 0 || col >= width) ? cell_t(0) : src[col];
+        }
+    }
+}
+
+/// Write a raw binary file
+template<typename T>
+static void outputToFile(const std::string & filename,
+                         const std::vector<T> & data)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (!file) {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+                "unable to open " + filename + " for writing");
+    }
+    file.write(reinterpret_cast<const char *>(data.data()),
+               data.size() * sizeof(T));
+}
+
+// constructor
+cpuAmpcorController::cpuAmpcorController()
+{
+    // create a new set of parameters
+    param.reset(new cpuAmpcorParameter());
+}
+
+
+/**
+ *  Run ampcor
+ *
+ *
+ */
+void cpuAmpcorController::runAmpcor()
+{
+    if (param->oversamplingMethod != 0) {
+        std::cout << "Sinc oversampling of the correlation surface is not "
+                  << "available on the CPU, using FFT oversampling\n";
+    }
+
+    // reference and secondary images; use band=1 as default
+    std::cout << "Opening reference image " << param->referenceImageName << "...\n";
+    isce3::io::Raster referenceImage(param->referenceImageName);
+    std::cout << "Opening secondary image " << param->secondaryImageName << "...\n";
+    isce3::io::Raster secondaryImage(param->secondaryImageName);
+
+    // in streaming mode, the chips come straight out of memory maps of the images
+    std::unique_ptr<view_t> referenceView, secondaryView;
+    if (param->useMmap) {
+        if (view_t::isMappable(referenceImage) && view_t::isMappable(secondaryImage)) {
+            referenceView.reset(new view_t(referenceImage));
+            secondaryView.reset(new view_t(secondaryImage));
+        }
+        if (!referenceView || !referenceView->contiguousRows()
+                || !secondaryView->contiguousRows()) {
+            std::cout << "The images cannot be memory mapped, reading them in bands\n";
+            referenceView.reset();
+            secondaryView.reset();
+        }
+    }
+    const bool streaming = static_cast<bool>(referenceView);
+
+    const int nWindowsAcross = param->numberWindowAcross;
+    const int nWindowsDownInBand = std::min(param->numberWindowDownInChunk,
+                                            param->numberWindowDown);
+    const int nBands = param->numberChunkDown;
+
+    // the number of pairs correlated at once and the number of pairs handed to a thread at
+    // a time, bounded by the memory budget of the arena and of the per thread workspaces
+    const size_t pairBytes = sizeof(cell_t) *
+        (static_cast<size_t>(param->windowSizeHeightRaw) * param->windowSizeWidthRaw
+         + static_cast<size_t>(param->searchWindowSizeHeightRaw) * param->searchWindowSizeWidthRaw);
+    size_t pairs = static_cast<size_t>(nWindowsDownInBand) * nWindowsAcross;
+    size_t batch = std::min(pairs,
+            static_cast<size_t>(param->numberWindowDownInChunk) * param->numberWindowAcrossInChunk);
+    if (param->arenaSizeInMB > 0) {
+        const size_t budget = static_cast<size_t>(param->arenaSizeInMB) << 20;
+        const size_t threads = std::max(omp_get_max_threads(), 1);
+        auto workspaces = [&](size_t batch) {
+            return threads * ampcor::correlators::Parallel::workspaceFootprint(
+                    param->windowSizeHeightRaw, param->windowSizeWidthRaw,
+                    param->searchWindowSizeHeightRaw, param->searchWindowSizeWidthRaw,
+                    param->rawDataOversamplingFactor, param->halfZoomWindowSizeRaw,
+                    param->oversamplingFactor, batch);
+        };
+        // smaller batches until the workspaces leave room for a batch of pairs
+        while (batch > 1 && workspaces(batch) + batch * pairBytes > budget)
+            batch = (batch + 1) / 2;
+        const size_t workspaceBytes = workspaces(batch);
+        const size_t arenaBytes = budget > workspaceBytes ? budget - workspaceBytes : 0;
+        pairs = std::max<size_t>(std::min(pairs, arenaBytes / pairBytes), 1);
+        batch = std::min(batch, pairs);
+    }
+
+    // the correlation engine, reused for all passes
+    ampcor::correlators::Parallel correlator(pairs,
+            param->windowSizeHeightRaw, param->windowSizeWidthRaw,
+            param->searchWindowSizeHeightRaw, param->searchWindowSizeWidthRaw,
+            param->rawDataOversamplingFactor, param->halfZoomWindowSizeRaw,
+            param->oversamplingFactor, batch, param->derampMethod,
+            param->corrRawZoomInHeight, param->corrRawZoomInWidth);
+
+    // the results
+    std::vector<float> offsetImage(2 * param->numberWindows);
+    std::vector<float> snrImage(param->numberWindows);
+    std::vector<float> covImage(3 * param->numberWindows);
+
+    // report info
+    std::cout << "Total number of windows (azimuth x range):  "
+        << param->numberWindowDown << " x " << param->numberWindowAcross
+        << std::endl;
+    std::cout << "to be processed in the number of bands: " << nBands << std::endl;
+    if (pairs < static_cast<size_t>(nWindowsDownInBand) * nWindowsAcross) {
+        std::cout << "with at most " << pairs << " windows at a time to stay within "
+            << param->arenaSizeInMB << " MB" << std::endl;
+    }
+
+    // the windows of a band
+    auto bandWindows = [this, nWindowsAcross](int band, int & first, int & count) {
+        first = band * param->numberWindowDownInChunk * nWindowsAcross;
+        count = std::min(param->numberWindowDownInChunk,
+                         param->numberWindowDown - band*param->numberWindowDownInChunk)
+                * nWindowsAcross;
+    };
+    // start reading the rows of a band in the background
+    auto prefetch = [&](int band) {
+        int first, count;
+        bandWindows(band, first, count);
+        prefetchBand(*referenceView, param->referenceStartPixelDown, first, count,
+                     param->windowSizeHeightRaw);
+        prefetchBand(*secondaryView, param->secondaryStartPixelDown, first, count,
+                     param->searchWindowSizeHeightRaw);
+    };
+
+    std::vector<cell_t> referenceBand, secondaryBand, chip;
+    int refRow0 = 0, refRows = 0, secRow0 = 0, secRows = 0;
+    // the rows of the images, from the memory maps or the bands read
+    auto referenceRow = [&](int row) -> const cell_t * {
+        if (streaming)
+            return (row < 0 || row >= referenceImage.length()) ? nullptr : referenceView->row(row);
+        return (row < refRow0 || row >= refRow0 + refRows) ? nullptr
+            : referenceBand.data() + static_cast<size_t>(row - refRow0) * referenceImage.width();
+    };
+    auto secondaryRow = [&](int row) -> const cell_t * {
+        if (streaming)
+            return (row < 0 || row >= secondaryImage.length()) ? nullptr : secondaryView->row(row);
+        return (row < secRow0 || row >= secRow0 + secRows) ? nullptr
+            : secondaryBand.data() + static_cast<size_t>(row - secRow0) * secondaryImage.width();
+    };
+
+    if (streaming && nBands > 0)
+        prefetch(0);
+
+    int message_interval = std::max(nBands/10, 1);
+    for (int i = 0; i < nBands; i++)
+    {
+        if (i%message_interval == 0)
+            std::cout << "Processing bands " << i+1 << " - "
+                << std::min(nBands, i+message_interval)
+                << " out of " << nBands << std::endl;
+
+        // the windows of this band
+        int first, count;
+        bandWindows(i, first, count);
+
+        if (streaming) {
+            // have the next band on its way while this one is correlated
+            if (i+1 < nBands)
+                prefetch(i+1);
+        }
+        else {
+            // read the rows spanned by the band
+            loadBand(referenceImage, param->referenceStartPixelDown, first, count,
+                     param->windowSizeHeightRaw, referenceBand, refRow0, refRows);
+            loadBand(secondaryImage, param->secondaryStartPixelDown, first, count,
+                     param->searchWindowSizeHeightRaw, secondaryBand, secRow0, secRows);
+        }
+
+        // go through the windows of the band as many at a time as the arena holds
+        for (int pass = 0; pass < count; pass += static_cast<int>(pairs))
+        {
+            int passCount = std::min(static_cast<int>(pairs), count - pass);
+
+            // extract the chips
+            for (int k = 0; k < passCount; k++)
+            {
+                int idx = first + pass + k;
+                chip.resize(static_cast<size_t>(param->windowSizeHeightRaw)
+                            * param->windowSizeWidthRaw);
+                extractChip(referenceRow, referenceImage.width(),
+                            param->referenceStartPixelDown[idx],
+                            param->referenceStartPixelAcross[idx],
+                            param->windowSizeHeightRaw, param->windowSizeWidthRaw,
+                            chip.data());
+                correlator.addReferenceTile(k, chip.data(), param->windowSizeWidthRaw);
+
+                chip.resize(static_cast<size_t>(param->searchWindowSizeHeightRaw)
+                            * param->searchWindowSizeWidthRaw);
+                extractChip(secondaryRow, secondaryImage.width(),
+                            param->secondaryStartPixelDown[idx],
+                            param->secondaryStartPixelAcross[idx],
+                            param->searchWindowSizeHeightRaw,
+                            param->searchWindowSizeWidthRaw, chip.data());
+                correlator.addTargetTile(k, chip.data(), param->searchWindowSizeWidthRaw);
+            }
+
+            // correlate
+            int done = first + pass;
+            const float * offsets = correlator.adjust(passCount);
+            std::copy(offsets, offsets + 2*passCount, offsetImage.begin() + 2*done);
+            std::copy(correlator.snr(), correlator.snr() + passCount, snrImage.begin() + done);
+            std::copy(correlator.covariance(), correlator.covariance() + 3*passCount,
+                      covImage.begin() + 3*done);
+        }
+    }
+
+    /* save the offsets and gross offsets */
+    std::vector<float> grossOffsetImage(2 * param->numberWindows);
+    for (int i = 0; i < param->numberWindows; i++) {
+        grossOffsetImage[2*i] = param->grossOffsetDown[i];
+        grossOffsetImage[2*i+1] = param->grossOffsetAcross[i];
+    }
+
+    // check whether to merge gross offset
+    if (param->mergeGrossOffset)
+    {
+        // if merge, add the gross offsets to offset
+        for (size_t i = 0; i < offsetImage.size(); i++)
+            offsetImage[i] += grossOffsetImage[i];
+    }
+    // output both offset and gross offset
+    outputToFile(param->offsetImageName, offsetImage);
+    outputToFile(param->grossOffsetImageName, grossOffsetImage);
+
+    // save the snr/cov images
+    outputToFile(param->snrImageName, snrImage);
+    outputToFile(param->covImageName, covImage);
+}
+// end of file
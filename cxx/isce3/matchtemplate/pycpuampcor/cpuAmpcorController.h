@@ -0,0 +1,39 @@
+/**
+ * @file  cpuAmpcorController.h
+ * @brief The controller for running cpuAmpcor
+ *
+ * cpuAmpcorController is the CPU counterpart of cuAmpcorController, with the
+ * same parameters and outputs, for hosts without a GPU.
+ * It processes the windows in bands of numberWindowDownInChunk rows of
+ * windows: the chips of a band are extracted and the pairs are correlated on
+ * all threads by an ampcor::correlators::Parallel engine, in batches of
+ * numberWindowDownInChunk*numberWindowAcrossInChunk pairs per thread.
+ *
+ * With useMmap, the chips are extracted directly from memory maps of the
+ * images, and the rows of the next band are prefetched while the current one
+ * is correlated; otherwise the image rows spanned by each band are read.
+ * The arena holding the chips and the per thread workspaces of the
+ * correlator are bounded together by arenaSizeInMB: bands with more windows
+ * than fit are correlated in several passes.
+ */
+
+// code guard
+#ifndef CPU_AMPCOR_CONTROLLER_H
+#define CPU_AMPCOR_CONTROLLER_H
+
+#include <memory>
+
+// dependencies
+#include "cpuAmpcorParameter.h"
+
+class cpuAmpcorController {
+public:
+    std::unique_ptr<cpuAmpcorParameter> param;  ///< the parameter set
+    // constructor
+    cpuAmpcorController();
+    // run interface
+    void runAmpcor();
+};
+#endif
+
+// end of file
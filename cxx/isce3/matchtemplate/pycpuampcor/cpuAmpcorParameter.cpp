@@ -0,0 +1,342 @@
+/**
+ * @file cpuAmpcorParameter.cpp
+ * Input parameters for ampcor
+ */
+
+#include "cpuAmpcorParameter.h"
+
+#include <algorithm>
+#include <string>
+
+#include <isce3/except/Error.h>
+
+#ifndef IDIVUP
+#define IDIVUP(i,j) ((i+j-1)/j)
+#endif
+
+///
+/// Constructor for cpuAmpcorParameter class
+/// also sets the default/initial values of various parameters
+///
+
+cpuAmpcorParameter::cpuAmpcorParameter()
+{
+    // default settings
+    // will be changed if they are set by python scripts
+    algorithm = 0; //0 freq; 1 time
+    deviceID = 0;
+    nStreams = 1;
+    derampMethod = 1;
+
+    windowSizeWidthRaw = 64;
+    windowSizeHeightRaw = 64;
+    halfSearchRangeDownRaw = 20;
+    halfSearchRangeAcrossRaw = 20;
+
+    skipSampleAcrossRaw = 64;
+    skipSampleDownRaw = 64;
+    rawDataOversamplingFactor = 2;
+    zoomWindowSize = 16;
+    oversamplingFactor = 16;
+    oversamplingMethod = 0;
+
+    referenceImageName = "reference.slc";
+    referenceImageWidth = 1000;
+    referenceImageHeight = 1000;
+    secondaryImageName = "secondary.slc";
+    secondaryImageWidth = 1000;
+    secondaryImageHeight = 1000;
+    offsetImageName = "DenseOffset.off";
+    grossOffsetImageName = "GrossOffset.off";
+    snrImageName = "snr.snr";
+    covImageName = "cov.cov";
+    numberWindowDown =  1;
+    numberWindowAcross = 1;
+    numberWindowDownInChunk = 1;
+    numberWindowAcrossInChunk = 1 ;
+
+    referenceStartPixelDown0 = 0;
+    referenceStartPixelAcross0 = 0;
+
+    corrStatWindowSize = 21; // 10*2+1 as in RIOPAC
+
+    useMmap = 1; // use mmap
+    mmapSizeInGB = 1;
+    arenaSizeInMB = 1024;
+
+    mergeGrossOffset = 0; // default to separate gross offset
+
+}
+
+/**
+ * To determine other process parameters after reading essential parameters from python
+ */
+
+void cpuAmpcorParameter::setupParameters()
+{
+    // Size to extract the raw correlation surface for snr/cov
+    corrRawZoomInHeight = std::min(corrStatWindowSize, 2*halfSearchRangeDownRaw+1);
+    corrRawZoomInWidth = std::min(corrStatWindowSize, 2*halfSearchRangeAcrossRaw+1);
+
+    // Size to extract the resampled correlation surface for oversampling
+    // users should use 16 for zoomWindowSize, no need to multiply by 2
+    // zoomWindowSize *= rawDataOversamplingFactor; //8 * 2
+    // to check the search range
+    int corrSurfaceActualSize =
+        std::min(halfSearchRangeAcrossRaw, halfSearchRangeDownRaw)*
+        2*rawDataOversamplingFactor;
+    zoomWindowSize = std::min(zoomWindowSize, corrSurfaceActualSize);
+
+    halfZoomWindowSizeRaw = zoomWindowSize/(2*rawDataOversamplingFactor); // 8*2/(2*2) = 4
+
+    windowSizeWidth = windowSizeWidthRaw*rawDataOversamplingFactor;  //
+    windowSizeHeight = windowSizeHeightRaw*rawDataOversamplingFactor;
+
+    searchWindowSizeWidthRaw =  windowSizeWidthRaw + 2*halfSearchRangeAcrossRaw;
+    searchWindowSizeHeightRaw = windowSizeHeightRaw + 2*halfSearchRangeDownRaw;
+
+    searchWindowSizeWidthRawZoomIn = windowSizeWidthRaw + 2*halfZoomWindowSizeRaw;
+    searchWindowSizeHeightRawZoomIn = windowSizeHeightRaw + 2*halfZoomWindowSizeRaw;
+
+    searchWindowSizeWidth = searchWindowSizeWidthRawZoomIn*rawDataOversamplingFactor;
+    searchWindowSizeHeight = searchWindowSizeHeightRawZoomIn*rawDataOversamplingFactor;
+
+    numberWindows = numberWindowDown*numberWindowAcross;
+    if(numberWindowDown <= 0 || numberWindowAcross <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+            "Incorrect number of windows! (" + std::to_string(numberWindowDown)
+            + ", " + std::to_string(numberWindowAcross) + ")");
+    }
+    if(halfZoomWindowSizeRaw <= 0) {
+        throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+            "The correlation surface zoom-in window is too small for the oversampling factor");
+    }
+
+    numberChunkDown = IDIVUP(numberWindowDown, numberWindowDownInChunk);
+    numberChunkAcross = IDIVUP(numberWindowAcross, numberWindowAcrossInChunk);
+    numberChunks = numberChunkDown*numberChunkAcross;
+    allocateArrays();
+}
+
+
+void cpuAmpcorParameter::allocateArrays()
+{
+    int arraySize = numberWindows;
+    grossOffsetDown.resize(arraySize);
+    grossOffsetAcross.resize(arraySize);
+    referenceStartPixelDown.resize(arraySize);
+    referenceStartPixelAcross.resize(arraySize);
+    secondaryStartPixelDown.resize(arraySize);
+    secondaryStartPixelAcross.resize(arraySize);
+
+    int arraySizeChunk = numberChunks;
+    referenceChunkStartPixelDown.resize(arraySizeChunk);
+    referenceChunkStartPixelAcross.resize(arraySizeChunk);
+    secondaryChunkStartPixelDown.resize(arraySizeChunk);
+    secondaryChunkStartPixelAcross.resize(arraySizeChunk);
+    referenceChunkHeight.resize(arraySizeChunk);
+    referenceChunkWidth.resize(arraySizeChunk);
+    secondaryChunkHeight.resize(arraySizeChunk);
+    secondaryChunkWidth.resize(arraySizeChunk);
+}
+
+/// Set starting pixels for reference and secondary windows from arrays
+/// set also gross offsets between reference and secondary windows
+///
+void cpuAmpcorParameter::setStartPixels(int *mStartD, int *mStartA, int *gOffsetD, int *gOffsetA)
+{
+    for(int i=0; i<numberWindows; i++)
+    {
+        referenceStartPixelDown[i] = mStartD[i];
+        grossOffsetDown[i] = gOffsetD[i];
+        secondaryStartPixelDown[i] = referenceStartPixelDown[i] + grossOffsetDown[i] - halfSearchRangeDownRaw;
+        referenceStartPixelAcross[i] = mStartA[i];
+        grossOffsetAcross[i] = gOffsetA[i];
+        secondaryStartPixelAcross[i] = referenceStartPixelAcross[i] + grossOffsetAcross[i] - halfSearchRangeAcrossRaw;
+    }
+    setChunkStartPixels();
+}
+
+/// set starting pixels for each window with a varying gross offset
+void cpuAmpcorParameter::setStartPixels(int mStartD, int mStartA, int *gOffsetD, int *gOffsetA)
+{
+    for(int row=0; row<numberWindowDown; row++)
+    {
+        for(int col = 0; col < numberWindowAcross; col++)
+        {
+            int i = row*numberWindowAcross + col;
+            referenceStartPixelDown[i] = mStartD + row*skipSampleDownRaw;
+            grossOffsetDown[i] = gOffsetD[i];
+            secondaryStartPixelDown[i] = referenceStartPixelDown[i] + grossOffsetDown[i] - halfSearchRangeDownRaw;
+            referenceStartPixelAcross[i] = mStartA + col*skipSampleAcrossRaw;
+            grossOffsetAcross[i] = gOffsetA[i];
+            secondaryStartPixelAcross[i] = referenceStartPixelAcross[i] + grossOffsetAcross[i] - halfSearchRangeAcrossRaw;
+        }
+    }
+    setChunkStartPixels();
+}
+
+/// set starting pixels for each window with a constant gross offset
+void cpuAmpcorParameter::setStartPixels(int mStartD, int mStartA, int gOffsetD, int gOffsetA)
+{
+    for(int row=0; row<numberWindowDown; row++)
+    {
+        for(int col = 0; col < numberWindowAcross; col++)
+        {
+            int i = row*numberWindowAcross + col;
+            referenceStartPixelDown[i] = mStartD + row*skipSampleDownRaw;
+            grossOffsetDown[i] = gOffsetD;
+            secondaryStartPixelDown[i] = referenceStartPixelDown[i] + grossOffsetDown[i] - halfSearchRangeDownRaw;
+            referenceStartPixelAcross[i] = mStartA + col*skipSampleAcrossRaw;
+            grossOffsetAcross[i] = gOffsetA;
+            secondaryStartPixelAcross[i] = referenceStartPixelAcross[i] + grossOffsetAcross[i] - halfSearchRangeAcrossRaw;
+        }
+    }
+    setChunkStartPixels();
+}
+
+/// set starting pixels for each chunk
+void cpuAmpcorParameter::setChunkStartPixels()
+{
+
+    maxReferenceChunkHeight = 0;
+    maxReferenceChunkWidth = 0;
+    maxSecondaryChunkHeight = 0;
+    maxSecondaryChunkWidth = 0;
+
+    for(int ichunk=0; ichunk <numberChunkDown; ichunk++)
+    {
+        for (int jchunk =0; jchunk<numberChunkAcross; jchunk++)
+        {
+
+            int idxChunk = ichunk*numberChunkAcross+jchunk;
+            int mChunkSD = referenceImageHeight;
+            int mChunkSA = referenceImageWidth;
+            int mChunkED = 0;
+            int mChunkEA = 0;
+            int sChunkSD = secondaryImageHeight;
+            int sChunkSA = secondaryImageWidth;
+            int sChunkED = 0;
+            int sChunkEA = 0;
+
+            int numberWindowDownInChunkRun = numberWindowDownInChunk;
+            int numberWindowAcrossInChunkRun = numberWindowAcrossInChunk;
+            // modify the number of windows in last chunk
+            if(ichunk == numberChunkDown -1)
+                numberWindowDownInChunkRun = numberWindowDown - numberWindowDownInChunk*(numberChunkDown -1);
+            if(jchunk == numberChunkAcross -1)
+                numberWindowAcrossInChunkRun = numberWindowAcross - numberWindowAcrossInChunk*(numberChunkAcross -1);
+
+            for(int i=0; i<numberWindowDownInChunkRun; i++)
+            {
+                for(int j=0; j<numberWindowAcrossInChunkRun; j++)
+                {
+                    int idxWindow = (ichunk*numberWindowDownInChunk+i)*numberWindowAcross + (jchunk*numberWindowAcrossInChunk+j);
+                    int vpixel = referenceStartPixelDown[idxWindow];
+                    if(mChunkSD > vpixel) mChunkSD = vpixel;
+                    if(mChunkED < vpixel) mChunkED = vpixel;
+                    vpixel = referenceStartPixelAcross[idxWindow];
+                    if(mChunkSA > vpixel) mChunkSA = vpixel;
+                    if(mChunkEA < vpixel) mChunkEA = vpixel;
+                    vpixel = secondaryStartPixelDown[idxWindow];
+                    if(sChunkSD > vpixel) sChunkSD = vpixel;
+                    if(sChunkED < vpixel) sChunkED = vpixel;
+                    vpixel = secondaryStartPixelAcross[idxWindow];
+                    if(sChunkSA > vpixel) sChunkSA = vpixel;
+                    if(sChunkEA < vpixel) sChunkEA = vpixel;
+                }
+            }
+            referenceChunkStartPixelDown[idxChunk]   = mChunkSD;
+            referenceChunkStartPixelAcross[idxChunk] = mChunkSA;
+            secondaryChunkStartPixelDown[idxChunk]    = sChunkSD;
+            secondaryChunkStartPixelAcross[idxChunk]  = sChunkSA;
+            referenceChunkHeight[idxChunk] = mChunkED - mChunkSD + windowSizeHeightRaw;
+            referenceChunkWidth[idxChunk]  = mChunkEA - mChunkSA + windowSizeWidthRaw;
+            secondaryChunkHeight[idxChunk]  = sChunkED - sChunkSD + searchWindowSizeHeightRaw;
+            secondaryChunkWidth[idxChunk]   = sChunkEA - sChunkSA + searchWindowSizeWidthRaw;
+            if(maxReferenceChunkHeight < referenceChunkHeight[idxChunk]) maxReferenceChunkHeight = referenceChunkHeight[idxChunk];
+            if(maxReferenceChunkWidth  < referenceChunkWidth[idxChunk] ) maxReferenceChunkWidth  = referenceChunkWidth[idxChunk];
+            if(maxSecondaryChunkHeight  < secondaryChunkHeight[idxChunk]) maxSecondaryChunkHeight = secondaryChunkHeight[idxChunk];
+            if(maxSecondaryChunkWidth   < secondaryChunkWidth[idxChunk] ) maxSecondaryChunkWidth  = secondaryChunkWidth[idxChunk];
+        }
+    }
+}
+
+/// check whether reference and secondary windows are within the image range
+void cpuAmpcorParameter::checkPixelInImageRange()
+{
+    int endPixel;
+    for(int row=0; row<numberWindowDown; row++)
+    {
+        for(int col = 0; col < numberWindowAcross; col++)
+        {
+            int i = row*numberWindowAcross + col;
+            if(referenceStartPixelDown[i] <0)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Reference Window start pixel out of range in Down, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(referenceStartPixelDown[i]));
+            }
+            if(referenceStartPixelAcross[i] <0)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Reference Window start pixel out of range in Across, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(referenceStartPixelAcross[i]));
+            }
+            endPixel = referenceStartPixelDown[i] + windowSizeHeightRaw;
+            if(endPixel >= referenceImageHeight)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Reference Window end pixel out of range in Down, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(endPixel));
+            }
+            endPixel = referenceStartPixelAcross[i] + windowSizeWidthRaw;
+            if(endPixel >= referenceImageWidth)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Reference Window end pixel out of range in Across, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(endPixel));
+            }
+            //secondary
+            if(secondaryStartPixelDown[i] <0)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Secondary Window start pixel out of range in Down, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(secondaryStartPixelDown[i]));
+            }
+            if(secondaryStartPixelAcross[i] <0)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Secondary Window start pixel out of range in Across, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(secondaryStartPixelAcross[i]));
+            }
+            endPixel = secondaryStartPixelDown[i] + searchWindowSizeHeightRaw;
+            if(endPixel >= secondaryImageHeight)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Secondary Window end pixel out of range in Down, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(endPixel));
+            }
+            endPixel = secondaryStartPixelAcross[i] + searchWindowSizeWidthRaw;
+            if(endPixel >= secondaryImageWidth)
+            {
+                throw isce3::except::OutOfRange(ISCE_SRCINFO(),
+                    "Secondary Window end pixel out of range in Across, window ("
+                    + std::to_string(row) + "," + std::to_string(col) + "), pixel "
+                    + std::to_string(endPixel));
+            }
+
+        }
+    }
+}
+
+
+cpuAmpcorParameter::~cpuAmpcorParameter() {}
+// end of file
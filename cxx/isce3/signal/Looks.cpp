@@ -7,6 +7,8 @@
 
 #include "Looks.h"
 
+#include <isce3/io/RasterView.h>
+
 bool isce3::signal::verifyComplexToRealCasting(isce3::io::Raster& input_raster,
                                               isce3::io::Raster& output_raster,
                                               int& exponent) {
@@ -46,7 +48,13 @@ void isce3::signal::Looks<T>::multilook(isce3::io::Raster& input_raster,
         else
             std::cout << "loading slant-range band: " << band << std::endl;
         std::valarray<T> image_ml(_ncolsLooked * _nrowsLooked);
-        if (!flag_complex_to_real) {
+        if (!flag_complex_to_real &&
+            isce3::io::RasterView<T>::isMappable(input_raster, band + 1)) {
+            // Multi-look in place from the memory mapped raster
+            const isce3::io::RasterView<T> view(input_raster, band + 1);
+            _multilook(view.row(0), view.rowstride() / sizeof(T),
+                       view.colstride() / sizeof(T), image_ml);
+        } else if (!flag_complex_to_real) {
             std::valarray<T> image(_ncols * _nrows);
             input_raster.getBlock(image, 0, 0, _ncols, _nrows, band + 1);
             multilook(image, image_ml);
@@ -70,6 +78,19 @@ void isce3::signal::Looks<T>::multilook(isce3::io::Raster& input_raster,
 template<class T>
 void isce3::signal::Looks<T>::multilook(std::valarray<T>& input,
                                        std::valarray<T>& output) {
+    _multilook(&input[0], _ncols, 1, output);
+}
+
+/**
+ * * @param[in] input pointer to the first element of the input array
+ * * @param[in] rowStride stride in elements between adjacent input rows
+ * * @param[in] colStride stride in elements between adjacent input columns
+ * * @param[out] output output multilooked and downsampled array
+ * */
+template<class T>
+void isce3::signal::Looks<T>::_multilook(const T* input, size_t rowStride,
+                                        size_t colStride,
+                                        std::valarray<T>& output) {
 
     // Time-domain multi-looking of an array with following parameters
     // size of input array: _ncols * _nrows
@@ -95,8 +116,9 @@ void isce3::signal::Looks<T>::multilook(std::valarray<T>& input,
         size_t line = kk / _ncolsLooked;
         size_t col = kk % _ncolsLooked;
         T sum = 0.0;
+        const T* inputLine = input + line * rowStride;
         for (size_t j = col * _colsLooks; j < (col + 1) * _colsLooks; ++j) {
-            sum += input[line * _ncols + j];
+            sum += inputLine[j * colStride];
         }
         tempOutput[line * _ncolsLooked + col] = sum;
     }
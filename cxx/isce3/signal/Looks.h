@@ -119,6 +119,10 @@ class isce3::signal::Looks {
         inline void ncolsLooked(int);
 
     private:
+        // Multi-looking of real data with arbitrary strides (in elements)
+        void _multilook(const T* input, size_t rowStride, size_t colStride,
+                        std::valarray<T>& output);
+
         // number of columns before multilooking
         size_t _ncols;
 
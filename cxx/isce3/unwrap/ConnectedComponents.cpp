@@ -0,0 +1,37 @@
+#include "ConnectedComponents.h"
+
+namespace isce3::unwrap
+{
+
+std::vector<size_t> componentSizes(
+    const uint32_t * labels,
+    const size_t size,
+    const uint32_t ncomps)
+{
+    std::vector<size_t> sizes(size_t(ncomps) + 1, 0);
+
+    // Accumulate per-thread histograms.
+    #pragma omp parallel
+    {
+        std::vector<size_t> threadsizes(size_t(ncomps) + 1, 0);
+
+        #pragma omp for nowait
+        for (size_t i = 0; i < size; ++i) { ++threadsizes[labels[i]]; }
+
+        #pragma omp critical
+        for (size_t l = 0; l <= ncomps; ++l) { sizes[l] += threadsizes[l]; }
+    }
+
+    return sizes;
+}
+
+void relabelComponents(
+    uint32_t * labels,
+    const size_t size,
+    const std::vector<uint32_t> & newlabels)
+{
+    #pragma omp parallel for
+    for (size_t i = 0; i < size; ++i) { labels[i] = newlabels[labels[i]]; }
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t
+#include <vector> // std::vector
+
+namespace isce3::unwrap
+{
+
+/**
+ * \brief Label the 4-connected components of a 2-D grid.
+ *
+ * Pixels for which valid(i) is true are grouped into components through the
+ * links between horizontally and vertically adjacent valid pixels for which
+ * right(i) (pixel i and i + 1) or down(i) (pixel i and i + width) is true,
+ * where i is the flat index (row * width + col) of a pixel.
+ *
+ * The grid is labeled in blocks of rows in parallel with a union-find
+ * forest, and the blocks are then merged along their boundaries.
+ * Components are numbered 1, 2, ... in raster order of their first pixel,
+ * which is the order in which a serial flood fill scanning the grid row by
+ * row would find them. Invalid pixels are labeled 0. Labels do not depend on
+ * the number of threads.
+ *
+ * \param[out] labels Component label of each pixel
+ * \param[in] length Number of rows
+ * \param[in] width Number of columns
+ * \param[in] valid Predicate valid(i) for pixels that belong to a component
+ * \param[in] right Predicate right(i) for a link between pixels i and i + 1
+ * \param[in] down Predicate down(i) for a link between pixels i and
+ * i + width
+ * \returns Number of components
+ */
+template<class Valid, class Right, class Down>
+uint32_t labelConnectedComponents(
+        uint32_t * labels,
+        const size_t length,
+        const size_t width,
+        Valid && valid,
+        Right && right,
+        Down && down);
+
+/**
+ * \brief Count the number of pixels of each component.
+ *
+ * \param[in] labels Component labels, as returned by
+ * labelConnectedComponents()
+ * \param[in] size Number of pixels
+ * \param[in] ncomps Number of components
+ * \returns Number of pixels with each label (0 to ncomps)
+ */
+std::vector<size_t> componentSizes(
+        const uint32_t * labels,
+        const size_t size,
+        const uint32_t ncomps);
+
+/**
+ * \brief Relabel components.
+ *
+ * Replaces each label l by newlabels[l] in parallel.
+ *
+ * \param[in,out] labels Component labels
+ * \param[in] size Number of pixels
+ * \param[in] newlabels New label of each label
+ */
+void relabelComponents(
+        uint32_t * labels,
+        const size_t size,
+        const std::vector<uint32_t> & newlabels);
+
+}
+
+// Get template implementations.
+#define ISCE_UNWRAP_CONNECTEDCOMPONENTS_ICC
+#include "ConnectedComponents.icc"
+#undef ISCE_UNWRAP_CONNECTEDCOMPONENTS_ICC
@@ -2,6 +2,9 @@
 #include <cmath> // round
 #include <cstdint> // uint8_t, UINT8_MAX
 #include <exception> // std::out_of_range, std::runtime_error
+#include <vector> // std::vector
+
+#include <isce3/unwrap/ConnectedComponents.h> // labelConnectedComponents, componentSizes
 
 #include "ICU.h" // ICU, LabelMap, idx2_t, offset2_t
 
@@ -106,6 +109,69 @@ void growConnComp(
     delete[] oldlist;
 }
 
+// Number of seeds rejected for growing small connected components before 
+// labelling all components in growGrass(), to skip the seeds of other small 
+// components.
+constexpr size_t maxRejectedGrowths = 32;
+
+// Label connected components of pixels that are not on a branch cut and have 
+// high correlation, get their sizes and flag components that share a branch 
+// cut pixel with another component. Components grown by growConnComp() are 
+// these components plus adjacent branch cut pixels.
+void labelUnwrappableComps(
+    std::vector<uint32_t> & cclabels,
+    std::vector<size_t> & ccsizes,
+    std::vector<uint8_t> & ccshared,
+    const bool * tree, 
+    const float * corr, 
+    const float corrthr, 
+    const size_t length, 
+    const size_t width)
+{
+    const size_t tilesize = length * width;
+    cclabels.resize(tilesize);
+    const uint32_t ncc = labelConnectedComponents(
+        cclabels.data(), length, width,
+        [&](size_t i) { return !tree[i] && corr[i] >= corrthr; },
+        [](size_t) { return true; },
+        [](size_t) { return true; });
+    ccsizes = componentSizes(cclabels.data(), tilesize, ncc);
+
+    ccshared.assign(ncc + 1, 0);
+    #pragma omp parallel for
+    for (size_t j = 0; j < length; ++j)
+    {
+        for (size_t i = 0; i < width; ++i)
+        {
+            size_t ipix = j * width + i;
+            if (!tree[ipix] || corr[ipix] < corrthr) { continue; }
+
+            // Get labels of neighboring components.
+            uint32_t nbrs[4] = {
+                (j > 0) ? cclabels[ipix - width] : 0u,
+                (i > 0) ? cclabels[ipix - 1] : 0u,
+                (i < width - 1) ? cclabels[ipix + 1] : 0u,
+                (j < length - 1) ? cclabels[ipix + width] : 0u};
+            uint32_t first = 0;
+            bool shared = false;
+            for (uint32_t l : nbrs)
+            {
+                if (l == 0) { continue; }
+                if (first == 0) { first = l; }
+                else if (l != first) { shared = true; }
+            }
+            if (shared)
+            {
+                for (uint32_t l : nbrs)
+                {
+                    #pragma omp atomic write
+                    ccshared[l] = 1;
+                }
+            }
+        }
+    }
+}
+
 enum BootstrapStatus_t
 {
     // Successfully obtained bootstrap phase estimate. Apply phase 
@@ -220,7 +286,8 @@ void ICU::growGrass(
     const float * corr, 
     float corrthr,
     const size_t length,
-    const size_t width)
+    const size_t width,
+    std::vector<BootstrapSamples> * bssamples)
 {
     // Make sure bootstrap lines are not out-of-range of tile.
     if (DO_BOOTSTRAP && length < _NumOverlapLines/2 + _NumBsLines/2)
@@ -239,6 +306,13 @@ void ICU::growGrass(
         ccl[i] = 0;
     }
 
+    // Connected components of unwrappable pixels, labelled once enough seeds 
+    // have been rejected for growing small components.
+    std::vector<uint32_t> cclabels;
+    std::vector<size_t> ccsizes;
+    std::vector<uint8_t> ccshared;
+    size_t nrejected = 0;
+
     // Loop over 2D grid of seeds (make sure at least one row & col of seeds 
     // is placed).
     const size_t seedColSpcng = std::min(_MinBsPts, width);
@@ -253,6 +327,16 @@ void ICU::growGrass(
             size_t iseed = sj * width + si;
             if (tree[iseed] || corr[iseed] < corrthr || ccl[iseed] != 0) { continue; }
 
+            // Skip seed if its connected component is known to be too small. 
+            // Components sharing branch cut pixels are still grown, since 
+            // their unwrapped phase may overwrite that of a labelled 
+            // component.
+            if (!cclabels.empty())
+            {
+                const uint32_t cc = cclabels[iseed];
+                if (ccsizes[cc] < _MinCCAreaFrac * tilesize && !ccshared[cc]) { continue; }
+            }
+
             // Grow connected component from seed.
             size_t ccsize;
             growConnComp(
@@ -260,7 +344,16 @@ void ICU::growGrass(
                 width);
 
             // Check if connected component is large enough.
-            if (ccsize < _MinCCAreaFrac * tilesize) { continue; }
+            if (ccsize < _MinCCAreaFrac * tilesize)
+            {
+                if (++nrejected == maxRejectedGrowths)
+                {
+                    labelUnwrappableComps(
+                        cclabels, ccsizes, ccshared, tree, corr, corrthr, 
+                        length, width);
+                }
+                continue;
+            }
 
             if (DO_BOOTSTRAP)
             {
@@ -336,6 +429,22 @@ void ICU::growGrass(
                     if (currcc[i]) { ccl[i] = newlabel; }
                 }
             }
+
+            // Keep the component's top bootstrap lines, which may be 
+            // overwritten by components grown later.
+            const size_t bssize = _NumBsLines * width;
+            if (bssamples && bsoff + bssize <= tilesize)
+            {
+                BootstrapSamples & samples = bssamples->emplace_back();
+                for (size_t i = 0; i < bssize; ++i)
+                {
+                    if (currcc[bsoff + i])
+                    {
+                        samples.index.push_back(i);
+                        samples.unw.push_back(unw[bsoff + i]);
+                    }
+                }
+            }
         }
     }
 
@@ -348,12 +457,14 @@ void ICU::growGrass(
 template void ICU::growGrass<true>(
     float * unw, uint8_t * ccl, bool * currcc, float * bsunw, uint8_t * bsccl, 
     LabelMap & labelmap, const float * phase, const bool * tree, 
-    const float * corr, float corrthr, const size_t length, const size_t width);
+    const float * corr, float corrthr, const size_t length, const size_t width,
+    std::vector<BootstrapSamples> * bssamples);
 
 template void ICU::growGrass<false>(
     float * unw, uint8_t * ccl, bool * currcc, float * bsunw, uint8_t * bsccl, 
     LabelMap & labelmap, const float * phase, const bool * tree, 
-    const float * corr, float corrthr, const size_t length, const size_t width);
+    const float * corr, float corrthr, const size_t length, const size_t width,
+    std::vector<BootstrapSamples> * bssamples);
 
 }
 
@@ -4,6 +4,7 @@
 #include <complex> // std::complex
 #include <cstddef> // size_t
 #include <cstdint> // uint8_t
+#include <vector> // std::vector
 
 #include <isce3/io/Raster.h> // isce3::io::Raster
 
@@ -18,6 +19,15 @@ typedef std::array<size_t, 2> idx2_t;
 // 2-D offset type
 typedef std::array<int, 2> offset2_t;
 
+// Pixels of a connected component in the bootstrap lines at the top of a 
+// tile and their unwrapped phase, as of when the component was grown 
+// (indices relative to the first bootstrap line)
+struct BootstrapSamples
+{
+    std::vector<size_t> index;
+    std::vector<float> unw;
+};
+
 class ICU
 {
 public:
@@ -117,6 +127,25 @@ public:
     /** Set bootstrap phase variance threshold (default: 8.0). */
     void bsPhaseVarThr(const float);
 
+    /** Get parallel tile processing flag. */
+    bool parallelTiles() const;
+    /** 
+     * Set parallel tile processing flag (default: false). If true, tiles are 
+     * unwrapped independently by concurrent threads and then stitched 
+     * together by resolving phase offsets and label equivalences in the 
+     * bootstrap lines of their overlaps. The output is identical to 
+     * sequential processing.
+     */
+    void parallelTiles(const bool);
+
+    /** Get memory budget (bytes) of the tile buffers unwrapped concurrently. */
+    size_t parallelTilesMemory() const;
+    /** 
+     * Set memory budget (bytes) of the tile buffers unwrapped concurrently 
+     * (default: 4 GiB). At least one tile is unwrapped at a time.
+     */
+    void parallelTilesMemory(const size_t);
+
     /** 
      * \brief Unwrap the target interferogram.
      *
@@ -157,7 +186,9 @@ public:
         const size_t width,
         const unsigned int seed = 0);
 
-    // Grow grass (find connected components and unwrap phase).
+    // Grow grass (find connected components and unwrap phase). If bssamples 
+    // is not null, the top bootstrap lines of each labelled connected 
+    // component are appended to it in label order.
     template<bool DO_BOOTSTRAP>
     void growGrass(
         float * unw,
@@ -171,9 +202,19 @@ public:
         const float * corr, 
         float corrthr,
         const size_t length,
-        const size_t width);
+        const size_t width,
+        std::vector<BootstrapSamples> * bssamples = nullptr);
 
 private:
+    // Unwrap tiles in parallel, then stitch them together.
+    void unwrapParallelTiles(
+        isce3::io::Raster & unw,
+        isce3::io::Raster & ccl,
+        isce3::io::Raster & intf,
+        isce3::io::Raster & corr,
+        unsigned int seed,
+        const int ntiles);
+
     // Configuration params
     size_t _NumBufLines = 3700;
     size_t _NumOverlapLines = 200;
@@ -193,6 +234,8 @@ private:
     size_t _NumBsLines = 16;
     size_t _MinBsPts = 16;
     float _BsPhaseVarThr = 8.f;
+    bool _ParallelTiles = false;
+    size_t _ParallelTilesMemory = size_t(4) << 30;
 };
 
 }
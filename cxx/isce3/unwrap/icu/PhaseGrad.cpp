@@ -1,33 +1,34 @@
-#include <complex> // std::complex, std::conj, std::arg
+#include <cmath> // exp, atan2
+#include <complex> // std::complex
+#include <vector> // std::vector
 
 #include "PhaseGrad.h" // calcPhaseGrad
 
 namespace isce3::unwrap::icu
 {
 
-template<int WINSIZE>
-void _calcPhaseGrad(
+void calcPhaseGrad(
     float * phasegradx,
     float * phasegrady,
     const std::complex<float> * intf,
     const size_t length,
-    const size_t width)
+    const size_t width,
+    const int winsize)
 {
-    // Window weights (Gaussian kernel)
-    float weights[WINSIZE * WINSIZE];
+    const int halfwin = winsize / 2;
+
+    // Window weights (Gaussian kernel). The kernel is separable, so the 
+    // window is applied as a weighted sum along columns followed by a 
+    // weighted sum along rows.
+    std::vector<float> weights(winsize);
     float sum = 0.f;
-    for (int jj = 0; jj < WINSIZE; ++jj)
+    for (int k = 0; k < winsize; ++k)
     {
-        for (int ii = 0; ii < WINSIZE; ++ii)
-        {
-            auto x = float(ii - WINSIZE/2);
-            auto y = float(jj - WINSIZE/2);
-            float w = exp(-(x*x + y*y) / (WINSIZE/2.f));
-            weights[jj * WINSIZE + ii] = w;
-            sum += w;
-        }
+        auto x = float(k - halfwin);
+        weights[k] = exp(-(x*x) / (winsize/2.f));
+        sum += weights[k];
     }
-    for (int i = 0; i < WINSIZE * WINSIZE; ++i) { weights[i] /= sum; }
+    for (int k = 0; k < winsize; ++k) { weights[k] /= sum; }
 
     // Init phase slope.
     const size_t tilesize = length * width;
@@ -37,133 +38,100 @@ void _calcPhaseGrad(
         phasegrady[i] = 0.f;
     }
 
-    // Compute smoothed phase slope using a weighted average of phase
-    // differences.
-    #pragma omp parallel for collapse(2)
-    for (size_t j = WINSIZE/2 + 1; j < length - WINSIZE/2; ++j)
-    {
-        for (size_t i = WINSIZE/2 + 1; i < width - WINSIZE/2; ++i)
-        {
-            auto sx = std::complex<float>(0.f, 0.f);
-            auto sy = std::complex<float>(0.f, 0.f);
-
-            for (int jj = -WINSIZE/2; jj <= WINSIZE/2; ++jj)
-            {
-                for (int ii = -WINSIZE/2; ii <= WINSIZE/2; ++ii)
-                {
-                    float w = weights[(jj + WINSIZE/2) * WINSIZE + (ii + WINSIZE/2)];
-
-                    std::complex<float> z_11 = intf[(j+jj) * width + (i+ii)];
-                    std::complex<float> z_10 = intf[(j+jj) * width + (i+ii-1)];
-                    std::complex<float> z_01 = intf[(j+jj-1) * width + (i+ii)];
-
-                    sx += w * z_11 * std::conj(z_10);
-                    sy += w * z_11 * std::conj(z_01);
-                }
-            }
-
-            phasegradx[j * width + i] = std::arg(sx);
-            phasegrady[j * width + i] = std::arg(sy);
-        }
+    if (length < size_t(2 * halfwin + 2) || width < size_t(2 * halfwin + 2)) 
+    { 
+        return; 
     }
-}
 
-void _calcPhaseGrad(
-    float * phasegradx,
-    float * phasegrady,
-    const std::complex<float> * intf,
-    const size_t length,
-    const size_t width,
-    const int winsize)
-{
-    // Window weights (Gaussian kernel)
-    auto weights = new float[winsize * winsize];
-    float sum = 0.f;
-    for (int jj = 0; jj < winsize; ++jj)
+    // Phase differences between adjacent pixels in x & y (z_11 * conj(z_10) 
+    // and z_11 * conj(z_01)), with real and imaginary parts stored separately 
+    // so that the weighted sums below are vectorized.
+    std::vector<float> dxre(tilesize, 0.f), dxim(tilesize, 0.f);
+    std::vector<float> dyre(tilesize, 0.f), dyim(tilesize, 0.f);
+    #pragma omp parallel for schedule(static)
+    for (size_t j = 0; j < length; ++j)
     {
-        for (int ii = 0; ii < winsize; ++ii)
+        const float * z_1 = reinterpret_cast<const float *>(&intf[j * width]);
+        const size_t off = j * width;
+
+        #pragma omp simd
+        for (size_t i = 1; i < width; ++i)
         {
-            auto x = float(ii - winsize/2);
-            auto y = float(jj - winsize/2);
-            float w = exp(-(x*x + y*y) / (winsize/2.f));
-            weights[jj * winsize + ii] = w;
-            sum += w;
+            float re_11 = z_1[2*i], im_11 = z_1[2*i+1];
+            float re_10 = z_1[2*i-2], im_10 = z_1[2*i-1];
+            dxre[off + i] = re_11 * re_10 + im_11 * im_10;
+            dxim[off + i] = im_11 * re_10 - re_11 * im_10;
         }
-    }
-    for (int i = 0; i < winsize * winsize; ++i) { weights[i] /= sum; }
 
-    // Init phase slope.
-    const size_t tilesize = length * width;
-    for (size_t i = 0; i < tilesize; ++i)
-    {
-        phasegradx[i] = 0.f;
-        phasegrady[i] = 0.f;
+        if (j == 0) { continue; }
+        const float * z_0 = reinterpret_cast<const float *>(&intf[(j-1) * width]);
+
+        #pragma omp simd
+        for (size_t i = 0; i < width; ++i)
+        {
+            float re_11 = z_1[2*i], im_11 = z_1[2*i+1];
+            float re_01 = z_0[2*i], im_01 = z_0[2*i+1];
+            dyre[off + i] = re_11 * re_01 + im_11 * im_01;
+            dyim[off + i] = im_11 * re_01 - re_11 * im_01;
+        }
     }
 
     // Compute smoothed phase slope using a weighted average of phase
     // differences.
-    #pragma omp parallel for collapse(2)
-    for (size_t j = winsize/2 + 1; j < length - winsize/2; ++j)
+    #pragma omp parallel
     {
-        for (size_t i = winsize/2 + 1; i < width - winsize/2; ++i)
+        // Row of phase differences summed along columns, and of smoothed 
+        // phase differences
+        std::vector<float> cxre(width), cxim(width), cyre(width), cyim(width);
+        std::vector<float> sxre(width), sxim(width), syre(width), syim(width);
+
+        #pragma omp for schedule(static)
+        for (size_t j = halfwin + 1; j < length - halfwin; ++j)
         {
-            auto sx = std::complex<float>(0.f, 0.f);
-            auto sy = std::complex<float>(0.f, 0.f);
+            for (size_t i = 0; i < width; ++i)
+            {
+                cxre[i] = cxim[i] = cyre[i] = cyim[i] = 0.f;
+                sxre[i] = sxim[i] = syre[i] = syim[i] = 0.f;
+            }
 
-            for (int jj = -winsize/2; jj <= winsize/2; ++jj)
+            for (int jj = -halfwin; jj <= halfwin; ++jj)
             {
-                for (int ii = -winsize/2; ii <= winsize/2; ++ii)
+                const float w = weights[jj + halfwin];
+                const size_t off = (j + jj) * width;
+
+                #pragma omp simd
+                for (size_t i = 0; i < width; ++i)
                 {
-                    float w = weights[(jj + winsize/2) * winsize + (ii + winsize/2)];
+                    cxre[i] += w * dxre[off + i];
+                    cxim[i] += w * dxim[off + i];
+                    cyre[i] += w * dyre[off + i];
+                    cyim[i] += w * dyim[off + i];
+                }
+            }
 
-                    std::complex<float> z_11 = intf[(j+jj) * width + (i+ii)];
-                    std::complex<float> z_10 = intf[(j+jj) * width + (i+ii-1)];
-                    std::complex<float> z_01 = intf[(j+jj-1) * width + (i+ii)];
+            const size_t ibegin = halfwin + 1;
+            const size_t iend = width - halfwin;
+            for (int ii = -halfwin; ii <= halfwin; ++ii)
+            {
+                const float w = weights[ii + halfwin];
 
-                    sx += w * z_11 * std::conj(z_10);
-                    sy += w * z_11 * std::conj(z_01);
+                #pragma omp simd
+                for (size_t i = ibegin; i < iend; ++i)
+                {
+                    sxre[i] += w * cxre[i + ii];
+                    sxim[i] += w * cxim[i + ii];
+                    syre[i] += w * cyre[i + ii];
+                    syim[i] += w * cyim[i + ii];
                 }
             }
 
-            phasegradx[j * width + i] = std::arg(sx);
-            phasegrady[j * width + i] = std::arg(sy);
+            for (size_t i = ibegin; i < iend; ++i)
+            {
+                phasegradx[j * width + i] = std::atan2(sxim[i], sxre[i]);
+                phasegrady[j * width + i] = std::atan2(syim[i], syre[i]);
+            }
         }
     }
-
-    delete[] weights;
 }
 
-void calcPhaseGrad(
-    float * phasegradx,
-    float * phasegrady,
-    const std::complex<float> * intf,
-    const size_t length,
-    const size_t width,
-    const int winsize)
-{
-    // Let the compiler optimize for some common window sizes.
-    switch(winsize)
-    {
-        case 3:
-            _calcPhaseGrad<3>(phasegradx, phasegrady, intf, length, width);
-            break;
-        case 5:
-            _calcPhaseGrad<5>(phasegradx, phasegrady, intf, length, width);
-            break;
-        case 7:
-            _calcPhaseGrad<7>(phasegradx, phasegrady, intf, length, width);
-            break;
-        case 9:
-            _calcPhaseGrad<9>(phasegradx, phasegrady, intf, length, width);
-            break;
-        case 11:
-            _calcPhaseGrad<11>(phasegradx, phasegrady, intf, length, width);
-            break;
-        default:
-            _calcPhaseGrad(phasegradx, phasegrady, intf, length, width, winsize);
-            break;
-    }
 }
-
-}
-
@@ -1,33 +1,40 @@
-#include <cmath> // round
-
 #include "ICU.h" // ICU
 
 namespace isce3::unwrap::icu
 {
 
+// Number of cycles of a wrapped phase difference, in [-2pi, 2pi]. Equivalent 
+// to round(dphi / 2pi) for |dphi / 2pi| < 1.5, without branching or rounding 
+// calls, so that loops over pixels may be vectorized.
+static inline signed char wrapCount(const float dphi)
+{
+    constexpr float twopi = 2.f * M_PI;
+    const float q = dphi / twopi;
+    return (q >= 0.5f) - (q <= -0.5f);
+}
+
 void ICU::getResidues(
     signed char * charge, 
     const float * phase, 
     const size_t length, 
     const size_t width)
 {
-    constexpr float twopi = 2.f * M_PI;
-
     // Get residue charge at each pixel (except last row & col).
+    #pragma omp parallel for schedule(static)
     for (size_t j = 0; j < length-1; ++j)
     {
+        const float * phi_0 = &phase[(j+0) * width];
+        const float * phi_1 = &phase[(j+1) * width];
+        signed char * q = &charge[j * width];
+
+        #pragma omp simd
         for (size_t i = 0; i < width-1; ++i)
         {
             // Compute path integral around a 4 pixel neighborhood.
-            float phi_00 = phase[(j+0) * width + (i+0)];
-            float phi_10 = phase[(j+1) * width + (i+0)];
-            float phi_01 = phase[(j+0) * width + (i+1)];
-            float phi_11 = phase[(j+1) * width + (i+1)];
-
-            charge[j * width + i] = round((phi_10 - phi_00) / twopi) + 
-                                    round((phi_11 - phi_10) / twopi) + 
-                                    round((phi_01 - phi_11) / twopi) + 
-                                    round((phi_00 - phi_01) / twopi);
+            q[i] = wrapCount(phi_1[i+0] - phi_0[i+0]) + 
+                   wrapCount(phi_1[i+1] - phi_1[i+0]) + 
+                   wrapCount(phi_0[i+1] - phi_1[i+1]) + 
+                   wrapCount(phi_0[i+0] - phi_0[i+1]);
         }
     }
 
@@ -37,4 +44,3 @@ void ICU::getResidues(
 }
 
 }
-
@@ -1,12 +1,63 @@
+#include <algorithm> // std::min
+#include <array> // std::array
+#include <cmath> // round
 #include <complex> // std::complex, std::arg
+#include <cstdint> // UINT8_MAX
 #include <cstring> // std::memcpy
-#include <exception> // std::domain_error
+#include <exception> // std::domain_error, std::exception_ptr
+#include <memory> // std::unique_ptr
+#include <numeric> // std::iota
+#include <stdexcept> // std::out_of_range, std::runtime_error
+#include <vector> // std::vector
 
-#include "ICU.h" // ICU, isce3::io::Raster, size_t, uint8_t
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "ICU.h" // ICU, LabelMap, isce3::io::Raster, size_t, uint8_t
 
 namespace isce3::unwrap::icu
 {
 
+namespace
+{
+
+// Work buffers for unwrapping a single tile
+struct TileBuffers
+{
+    explicit TileBuffers(const size_t bufsize) :
+        intf(new std::complex<float>[bufsize]),
+        corr(new float[bufsize]),
+        unw(new float[bufsize]),
+        ccl(new uint8_t[bufsize]),
+        phase(new float[bufsize]),
+        charge(new signed char[bufsize]),
+        neut(new bool[bufsize]),
+        tree(new bool[bufsize]),
+        currcc(new bool[bufsize])
+    {}
+
+    std::unique_ptr<std::complex<float>[]> intf;
+    std::unique_ptr<float[]> corr;
+    std::unique_ptr<float[]> unw;
+    std::unique_ptr<uint8_t[]> ccl;
+    std::unique_ptr<float[]> phase;
+    std::unique_ptr<signed char[]> charge;
+    std::unique_ptr<bool[]> neut;
+    std::unique_ptr<bool[]> tree;
+    std::unique_ptr<bool[]> currcc;
+};
+
+// Phase offsets and stitched labels of the connected components of an 
+// independently unwrapped tile (indexed by the tile's own labels)
+struct TileStitch
+{
+    std::array<float, UINT8_MAX + 1> phaseoffset;
+    std::array<uint8_t, UINT8_MAX + 1> label;
+};
+
+}
+
 void ICU::unwrap(
     isce3::io::Raster & unw,
     isce3::io::Raster & ccl,
@@ -17,6 +68,27 @@ void ICU::unwrap(
     // Raster dims
     const size_t length = intf.length();
     const size_t width = intf.width();
+
+    // Number of lines to next tile
+    const size_t step = _NumBufLines - _NumOverlapLines;
+
+    // Number of tiles
+    int ntiles = 1;
+    if (length > _NumBufLines)
+    {
+        if (step <= 0)
+        {
+            throw std::domain_error("number of overlap lines must be less than number of buffer lines");
+        }
+        ntiles = (length + step-1) / step;
+        if (length % step <= _NumOverlapLines) { --ntiles; }
+    }
+
+    if (_ParallelTiles && ntiles > 1)
+    {
+        unwrapParallelTiles(unw, ccl, intf, corr, seed, ntiles);
+        return;
+    }
     
     // Buffers for single tile from each input, output Raster
     const size_t bufsize = _NumBufLines * width;
@@ -46,21 +118,6 @@ void ICU::unwrap(
     // Table of connected component label equivalences
     auto labelmap = LabelMap();
 
-    // Number of lines to next tile
-    const size_t step = _NumBufLines - _NumOverlapLines;
-
-    // Number of tiles
-    int ntiles = 1;
-    if (length > _NumBufLines)
-    {
-        if (step <= 0)
-        {
-            throw std::domain_error("number of overlap lines must be less than number of buffer lines");
-        }
-        ntiles = (length + step-1) / step;
-        if (length % step <= _NumOverlapLines) { --ntiles; }
-    }
-
     // Loop over tiles.
     for (int t = 0; t < ntiles; ++t)
     {
@@ -72,6 +129,7 @@ void ICU::unwrap(
 
         // Compute wrapped phase.
         size_t tilesize = tilelen * width;
+        #pragma omp parallel for schedule(static)
         for (size_t i = 0; i < tilesize; ++i) { phase[i] = std::arg(intftile[i]); }
 
         // Get residue charges.
@@ -164,5 +222,283 @@ void ICU::unwrap(
     delete[] bslabels;
 }
 
+void ICU::unwrapParallelTiles(
+    isce3::io::Raster & unw,
+    isce3::io::Raster & ccl,
+    isce3::io::Raster & intf,
+    isce3::io::Raster & corr,
+    unsigned int seed,
+    const int ntiles)
+{
+    constexpr float twopi = 2.f * M_PI;
+
+    // Raster dims
+    const size_t length = intf.length();
+    const size_t width = intf.width();
+
+    // Number of lines to next tile
+    const size_t step = _NumBufLines - _NumOverlapLines;
+
+    // Make sure bootstrap lines are within the overlap between tiles.
+    if (_NumOverlapLines/2 < _NumBsLines - _NumBsLines/2)
+    {
+        throw std::out_of_range("bootstrap lines out-of-range");
+    }
+
+    // Offsets to first bootstrap line from start of tile. The bottom 
+    // bootstrap lines of each tile are the top bootstrap lines of the next 
+    // tile.
+    const size_t bssize = _NumBsLines * width;
+    const size_t topoff = (_NumOverlapLines/2 - _NumBsLines/2) * width;
+    const size_t botoff = (_NumBufLines - _NumOverlapLines/2 - _NumBsLines/2) * width;
+
+    auto tileLength = [&](const int t) { 
+        return std::min(_NumBufLines, length - t * step); 
+    };
+
+    // Read interferogram, correlation lines of a tile.
+    auto readTile = [&](TileBuffers & buf, const int t) {
+        intf.getBlock(buf.intf.get(), 0, t * step, width, tileLength(t));
+        corr.getBlock(buf.corr.get(), 0, t * step, width, tileLength(t));
+    };
+
+    // Compute wrapped phase, residue charges, neutrons and branch cuts of a 
+    // tile.
+    auto cutTile = [&](TileBuffers & buf, const size_t tilelen) {
+        const size_t tilesize = tilelen * width;
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < tilesize; ++i) { buf.phase[i] = std::arg(buf.intf[i]); }
+        getResidues(buf.charge.get(), buf.phase.get(), tilelen, width);
+        genNeutrons(buf.neut.get(), buf.intf.get(), buf.corr.get(), tilelen, width);
+        growTrees(buf.tree.get(), buf.charge.get(), buf.neut.get(), tilelen, width, seed);
+    };
+
+    // Number of tiles unwrapped concurrently (each requires its own buffers), 
+    // limited by the memory budget
+    const size_t bufsize = _NumBufLines * width;
+    const size_t bufbytes = bufsize * (sizeof(std::complex<float>) 
+        + 3 * sizeof(float) + sizeof(uint8_t) + sizeof(signed char) 
+        + 3 * sizeof(bool));
+    int nbatch = 1;
+#ifdef _OPENMP
+    nbatch = omp_get_max_threads();
+#endif
+    nbatch = std::min(nbatch, ntiles);
+    nbatch = std::max(1, int(std::min(size_t(nbatch), _ParallelTilesMemory / bufbytes)));
+    std::vector<TileBuffers> bufs;
+    bufs.reserve(nbatch);
+    for (int b = 0; b < nbatch; ++b) { bufs.emplace_back(bufsize); }
+
+    // Bottom bootstrap lines of each tile and top bootstrap lines of each 
+    // connected component of each tile, as unwrapped independently. The 
+    // components' own bootstrap lines are kept since they may be partly 
+    // overwritten by components grown later, while sequential processing 
+    // bootstraps each component as it is grown.
+    std::vector<float> botunw(ntiles * bssize);
+    std::vector<uint8_t> botccl(ntiles * bssize);
+    std::vector<std::vector<BootstrapSamples>> topsamples(ntiles);
+    size_t nlabels0 = 0;
+
+    // Loop over batches of tiles.
+    for (int t0 = 0; t0 < ntiles; t0 += nbatch)
+    {
+        const int t1 = std::min(t0 + nbatch, ntiles);
+
+        // Read inputs (rasters are not thread-safe).
+        for (int t = t0; t < t1; ++t) { readTile(bufs[t - t0], t); }
+
+        // Unwrap each tile without bootstrapping, keeping its bootstrap lines.
+        std::exception_ptr error;
+        #pragma omp parallel for schedule(dynamic)
+        for (int t = t0; t < t1; ++t)
+        {
+            try
+            {
+                TileBuffers & buf = bufs[t - t0];
+                const size_t tilelen = tileLength(t);
+                cutTile(buf, tilelen);
+
+                LabelMap tilelabelmap;
+                growGrass<false>(
+                    buf.unw.get(), buf.ccl.get(), buf.currcc.get(), nullptr, 
+                    nullptr, tilelabelmap, buf.phase.get(), buf.tree.get(), 
+                    buf.corr.get(), _InitCorrThr, tilelen, width, 
+                    (t > 0) ? &topsamples[t] : nullptr);
+                if (t == 0) { nlabels0 = tilelabelmap.size() - 1; }
+
+                if (t < ntiles-1)
+                {
+                    std::memcpy(&botunw[t * bssize], &buf.unw[botoff], bssize * sizeof(float));
+                    std::memcpy(&botccl[t * bssize], &buf.ccl[botoff], bssize * sizeof(uint8_t));
+                }
+            }
+            catch (...)
+            {
+                #pragma omp critical
+                if (!error) { error = std::current_exception(); }
+            }
+        }
+        if (error) { std::rethrow_exception(error); }
+
+        // Write out unwrapped phase, connected component labels in order, so 
+        // that each tile overwrites its overlap with the previous tile.
+        for (int t = t0; t < t1; ++t)
+        {
+            const TileBuffers & buf = bufs[t - t0];
+            unw.setBlock(buf.unw.get(), 0, t * step, width, tileLength(t));
+            ccl.setBlock(buf.ccl.get(), 0, t * step, width, tileLength(t));
+        }
+    }
+
+    // Stitch tiles in order, replaying the bootstrapping of sequential 
+    // processing: the connected components of each tile are visited in the 
+    // order they were grown and bootstrapped from the bottom bootstrap lines 
+    // of the previous tile, once the previous tile has been stitched.
+    auto labelmap = LabelMap();
+    std::vector<TileStitch> stitch(ntiles);
+    stitch[0].phaseoffset.fill(0.f);
+    stitch[0].label[0] = 0;
+    for (size_t l = 1; l <= nlabels0; ++l) { stitch[0].label[l] = labelmap.nextlabel(); }
+
+    std::vector<float> prevunw(bssize);
+    std::vector<uint8_t> prevccl(bssize);
+    for (int t = 1; t < ntiles; ++t)
+    {
+        // Get stitched bootstrap lines of previous tile.
+        const TileStitch & prev = stitch[t-1];
+        for (size_t i = 0; i < bssize; ++i)
+        {
+            const uint8_t l = botccl[(t-1) * bssize + i];
+            prevunw[i] = botunw[(t-1) * bssize + i] - prev.phaseoffset[l];
+            prevccl[i] = prev.label[l];
+        }
+
+        // Bootstrap each connected component in the order it was grown (and 
+        // labelled), as growGrass<true>() does.
+        const std::vector<BootstrapSamples> & samples = topsamples[t];
+        TileStitch & curr = stitch[t];
+        curr.phaseoffset.fill(0.f);
+        curr.label[0] = 0;
+        bool failure = false;
+        for (size_t l = 1; l <= samples.size(); ++l)
+        {
+            // Integrate phase differences (squared) in bootstrap overlap 
+            // region.
+            const BootstrapSamples & cc = samples[l-1];
+            float sum = 0.f;
+            float sumSq = 0.f;
+            size_t npts = 0;
+            for (size_t k = 0; k < cc.index.size(); ++k)
+            {
+                const size_t i = cc.index[k];
+                if (prevccl[i] != 0)
+                {
+                    float phi = cc.unw[k] - prevunw[i];
+                    sum += phi;
+                    sumSq += phi*phi;
+                    ++npts;
+                }
+            }
+
+            if (npts < _MinBsPts)
+            {
+                // Insufficient overlap. Assign a new unique label.
+                curr.label[l] = labelmap.nextlabel();
+                continue;
+            }
+
+            float mu = sum / float(npts);
+            float Sigma = sumSq / float(npts) - (mu * mu);
+            if (!(Sigma < _BsPhaseVarThr))
+            {
+                failure = true;
+                break;
+            }
+
+            // Get bootstrap phase (round mean phase difference to nearest 
+            // two pi) and merge labels of previous connected components in 
+            // the bootstrap overlap region.
+            curr.phaseoffset[l] = twopi * round(mu / twopi);
+            uint8_t minlabel = UINT8_MAX;
+            for (size_t i : cc.index)
+            {
+                if (prevccl[i] != 0)
+                {
+                    minlabel = std::min(minlabel, labelmap.getlabel(prevccl[i]));
+                }
+            }
+            for (size_t i : cc.index)
+            {
+                if (prevccl[i] != 0)
+                {
+                    uint8_t oldlabel = labelmap.getlabel(prevccl[i]);
+                    if (oldlabel != minlabel) { labelmap.setlabel(oldlabel, minlabel); }
+                }
+            }
+            curr.label[l] = minlabel;
+        }
+
+        if (failure)
+        {
+            // Bootstrap phase variance exceeds threshold. As in sequential 
+            // processing, labels assigned and merged so far are kept and the 
+            // tile is unwrapped again with bootstrapping from the stitched 
+            // previous tile, with increased correlation threshold.
+            if (!(_InitCorrThr < _MaxCorrThr))
+            {
+                throw std::runtime_error("failed to unwrap tile at max correlation threshold");
+            }
+            TileBuffers & buf = bufs[0];
+            const size_t tilelen = tileLength(t);
+            readTile(buf, t);
+            cutTile(buf, tilelen);
+            growGrass<true>(
+                buf.unw.get(), buf.ccl.get(), buf.currcc.get(), 
+                prevunw.data(), prevccl.data(), labelmap, buf.phase.get(), 
+                buf.tree.get(), buf.corr.get(), _InitCorrThr + _CorrThrInc, 
+                tilelen, width);
+
+            // Phase and labels of the tile are already stitched.
+            curr.phaseoffset.fill(0.f);
+            std::iota(curr.label.begin(), curr.label.end(), 0);
+            if (t < ntiles-1)
+            {
+                std::memcpy(&botunw[t * bssize], &buf.unw[botoff], bssize * sizeof(float));
+                std::memcpy(&botccl[t * bssize], &buf.ccl[botoff], bssize * sizeof(uint8_t));
+            }
+
+            // Write out lines not overlapped by the next tile.
+            const size_t nlines = (t < ntiles-1) ? step : tilelen;
+            unw.setBlock(buf.unw.get(), 0, t * step, width, nlines);
+            ccl.setBlock(buf.ccl.get(), 0, t * step, width, nlines);
+        }
+    }
+
+    // Apply phase offsets and merged labels to the lines of each tile not 
+    // overlapped by the next tile.
+    TileBuffers & buf = bufs[0];
+    for (int t = 0; t < ntiles; ++t)
+    {
+        const size_t startline = t * step;
+        const size_t nlines = (t < ntiles-1) ? step : length - startline;
+        unw.getBlock(buf.unw.get(), 0, startline, width, nlines);
+        ccl.getBlock(buf.ccl.get(), 0, startline, width, nlines);
+
+        const TileStitch & curr = stitch[t];
+        const size_t size = nlines * width;
+        for (size_t i = 0; i < size; ++i)
+        {
+            const uint8_t l = buf.ccl[i];
+            if (l != 0)
+            {
+                buf.unw[i] -= curr.phaseoffset[l];
+                buf.ccl[i] = labelmap.getlabel(curr.label[l]);
+            }
+        }
+
+        unw.setBlock(buf.unw.get(), 0, startline, width, nlines);
+        ccl.setBlock(buf.ccl.get(), 0, startline, width, nlines);
+    }
 }
 
+}
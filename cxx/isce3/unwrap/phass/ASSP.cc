@@ -15,9 +15,12 @@
 #include "PhaseStatistics.h"
 #include "ASSP.h"
 #include "BMFS.h"
+#include "BucketQueue.h"
 #include "Point.h"
 #include "sort.h"
 
+#include <isce3/unwrap/ConnectedComponents.h>
+
 // with gcc, openmp support requires an include
 #if defined(__GNUC__) && !defined(__clang__)
 #include <omp.h>
@@ -1217,7 +1220,7 @@ void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int&
 {
   int nr_lines = flows_patch->get_nr_lines() - 1;
   int nr_pixels = flows_patch->get_nr_pixels() - 1;
-  int line, pixel, line_plus, line_minus, pixel_plus, pixel_minus;
+  int line, pixel;
   int nrows = nr_lines + 1;
   int ncols = nr_pixels + 1;
 
@@ -1244,11 +1247,10 @@ void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int&
     }
   }
 
-  Point point, seed;
-
   NodeFlow **flows = flows_patch->get_data_lines_ptr();
 
-  queue<Point> workq;
+  // flat indices (line * nr_pixels + pixel), the buffer is reused by all regions
+  FlatQueue workq;
 
   int region_id = 0;
 
@@ -1268,7 +1270,8 @@ void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int&
 
 
       int count = 0;
-      workq.push(Point(jj, ii));
+      workq.clear();
+      workq.push(ii * nr_pixels + jj);
 
       visit[ii][jj] = unwrapped;
 
@@ -1277,10 +1280,10 @@ void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int&
       tmp_seeds[region_id].nr_2pi = 0;
 
       while( !workq.empty() ) {
-	point = workq.front();
+	int index = workq.front();
 	workq.pop();
-	line  = point.get_Y();
-	pixel = point.get_X();
+	line  = index / nr_pixels;
+	pixel = index - line * nr_pixels;
 
 	count ++;
 
@@ -1290,34 +1293,28 @@ void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int&
           tmp_seeds[region_id].nr_2pi = 0;
  	}
 
-
-	line_plus = line + 1;
-	line_minus = line - 1;
-	pixel_plus = pixel + 1;
-	pixel_minus = pixel - 1;
-
 	if(line > 0) {              // facing up ......
-	  if(flows[line][pixel].toRight == 0 && visit[line_minus][pixel] == not_unwrapped) {
-	    workq.push(Point(pixel, line_minus));
-	    visit[line_minus][pixel] = unwrapped;
+	  if(flows[line][pixel].toRight == 0 && visit[line - 1][pixel] == not_unwrapped) {
+	    workq.push(index - nr_pixels);
+	    visit[line - 1][pixel] = unwrapped;
 	  }
 	}
 	if(line < nr_lines - 1) {   // facing down ......
-	  if(flows[line_plus][pixel].toRight == 0 && visit[line_plus][pixel] == not_unwrapped) {
-	    workq.push(Point(pixel, line_plus));
-	    visit[line_plus][pixel] = unwrapped;
+	  if(flows[line + 1][pixel].toRight == 0 && visit[line + 1][pixel] == not_unwrapped) {
+	    workq.push(index + nr_pixels);
+	    visit[line + 1][pixel] = unwrapped;
 	  }
 	}
 	if(pixel > 0) {             // facing left ......
-	  if(flows[line][pixel].toDown == 0 && visit[line][pixel_minus] == not_unwrapped) {
-	    workq.push(Point(pixel_minus, line));
-	    visit[line][pixel_minus] = unwrapped;
+	  if(flows[line][pixel].toDown == 0 && visit[line][pixel - 1] == not_unwrapped) {
+	    workq.push(index - 1);
+	    visit[line][pixel - 1] = unwrapped;
 	  }
 	}
 	if(pixel < nr_pixels - 1) {// facing right ......
-	  if(flows[line][pixel_plus].toDown == 0 && visit[line][pixel_plus] == not_unwrapped) {
-	    workq.push(Point(pixel_plus, line));
-	    visit[line][pixel_plus] = unwrapped;
+	  if(flows[line][pixel + 1].toDown == 0 && visit[line][pixel + 1] == not_unwrapped) {
+	    workq.push(index + 1);
+	    visit[line][pixel + 1] = unwrapped;
 	  }
 	}
       }
@@ -1372,12 +1369,13 @@ void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int&
 }
 
 
+// The seeds are grown in parallel, one region per thread at a time. Each seed
+// must lie in a different region, as the seeds returned by create_seeds().
 DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **phase_data, int nr_seeds, Seed *seeds)
 {
   int patch_start = flows_patch->get_extern_start_line();
   int nr_lines = flows_patch->get_nr_lines() - 1;
   int nr_pixels = flows_patch->get_nr_pixels() - 1;
-  int line, pixel, line_plus, line_minus, pixel_plus, pixel_minus;
   //int nrows = nr_lines + 1;
   //int ncols = nr_pixels + 1;
 
@@ -1389,29 +1387,34 @@ DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **p
   char not_unwrapped = 0;
   char unwrapped = 1;
 
-  for(line = 0; line < nr_lines; line ++) {
+#pragma omp parallel for
+  for(int line = 0; line < nr_lines; line ++) {
     for(int pixel = 0; pixel < nr_pixels; pixel ++) {
       visit[line][pixel] = not_unwrapped;
     }
   }
 
   double two_pi = 2.0 * 3.14159265;
-  double x, seed_phase;
-  Point point, seed;
 
   NodeFlow **flows = flows_patch->get_data_lines_ptr();
 
-  queue<Point> workq, backupq;
-
-  int nr_amb = 21;
-  int *histogram = new int[nr_amb];
-  double *lower_bound = new double[nr_amb];
-  double *upper_bound = new double[nr_amb];
+  const int nr_amb = 21;
+  double lower_bound[nr_amb];
+  double upper_bound[nr_amb];
   for(int i = 0; i < nr_amb; i++) {
     lower_bound[i] = -PI + two_pi * (i - nr_amb/2);
     upper_bound[i] = PI + two_pi * (i - nr_amb/2);
   }
 
+#pragma omp parallel
+  {
+  // per-thread flood fill buffer, also the list of pixels of the region
+  FlatQueue workq;
+  int histogram[nr_amb];
+  int line, pixel;
+  double x, seed_phase;
+
+#pragma omp for schedule(dynamic)
   for(int seed_id = 0; seed_id < nr_seeds; seed_id ++) {
     int seed_x = seeds[seed_id].x;
     int seed_y = seeds[seed_id].y - patch_start;
@@ -1421,16 +1424,16 @@ DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **p
 
     phase_data[seed_y][seed_x] += seeds[seed_id].nr_2pi * two_pi;
 
-    workq.push(Point(seed_x, seed_y));
-    backupq.push(Point(seed_x, seed_y));
+    workq.clear();
+    workq.push(seed_y * nr_pixels + seed_x);
 
     for(int i = 0; i < nr_amb; i++) histogram[i] = 0;
 
     while( !workq.empty() ) {
-      point = workq.front();
+      int index = workq.front();
       workq.pop();
-      line  = point.get_Y();
-      pixel = point.get_X();
+      line  = index / nr_pixels;
+      pixel = index - line * nr_pixels;
       visit[line][pixel] = unwrapped;
 
       seed_phase = phase_data[line][pixel];
@@ -1441,45 +1444,36 @@ DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **p
 	}
       }
 
-      line_plus = line + 1;
-      line_minus = line - 1;
-      pixel_plus = pixel + 1;
-      pixel_minus = pixel - 1;
-
       if(line > 0) {              // facing up ......
-	if(flows[line][pixel].toRight == 0 && visit[line_minus][pixel] == not_unwrapped) {
-	  workq.push(Point(pixel, line_minus));
-	  backupq.push(Point(pixel, line_minus));
-	  x = phase_data[line_minus][pixel] - seed_phase;
-	  phase_data[line_minus][pixel] -= (int)(rint(x/two_pi)) * two_pi;
-	  visit[line_minus][pixel] = unwrapped;
+	if(flows[line][pixel].toRight == 0 && visit[line - 1][pixel] == not_unwrapped) {
+	  workq.push(index - nr_pixels);
+	  x = phase_data[line - 1][pixel] - seed_phase;
+	  phase_data[line - 1][pixel] -= (int)(rint(x/two_pi)) * two_pi;
+	  visit[line - 1][pixel] = unwrapped;
 	}
       }
       if(line < nr_lines - 1) {   // facing down ......
-	if(flows[line + 1][pixel].toRight == 0 && visit[line_plus][pixel] == not_unwrapped) {
-	  workq.push(Point(pixel, line_plus));
-	  backupq.push(Point(pixel, line_plus));
-	  x = phase_data[line_plus][pixel] - seed_phase;
-	  phase_data[line_plus][pixel] -= (int)(rint(x/two_pi)) * two_pi;
-	  visit[line_plus][pixel] = unwrapped;
+	if(flows[line + 1][pixel].toRight == 0 && visit[line + 1][pixel] == not_unwrapped) {
+	  workq.push(index + nr_pixels);
+	  x = phase_data[line + 1][pixel] - seed_phase;
+	  phase_data[line + 1][pixel] -= (int)(rint(x/two_pi)) * two_pi;
+	  visit[line + 1][pixel] = unwrapped;
 	}
       }
       if(pixel > 0) {             // facing left ......
-	if(flows[line][pixel].toDown == 0 && visit[line][pixel_minus] == not_unwrapped) {
-	  workq.push(Point(pixel_minus, line));
-	  backupq.push(Point(pixel_minus, line));
-	  x = phase_data[line][pixel_minus] - seed_phase;
-	  phase_data[line][pixel_minus] -= (int)(rint(x/two_pi)) * two_pi;
-	  visit[line][pixel_minus] = unwrapped;
+	if(flows[line][pixel].toDown == 0 && visit[line][pixel - 1] == not_unwrapped) {
+	  workq.push(index - 1);
+	  x = phase_data[line][pixel - 1] - seed_phase;
+	  phase_data[line][pixel - 1] -= (int)(rint(x/two_pi)) * two_pi;
+	  visit[line][pixel - 1] = unwrapped;
 	}
       }
       if(pixel < nr_pixels - 1) {// facing right ......
-	if(flows[line][pixel_plus].toDown == 0 && visit[line][pixel_plus] == not_unwrapped) {
-	  workq.push(Point(pixel_plus, line));
-	  backupq.push(Point(pixel_plus, line));
-	  x = phase_data[line][pixel_plus] - seed_phase;
-	  phase_data[line][pixel_plus] -= (int)(rint(x/two_pi)) * two_pi;
-	  visit[line][pixel_plus] = unwrapped;
+	if(flows[line][pixel + 1].toDown == 0 && visit[line][pixel + 1] == not_unwrapped) {
+	  workq.push(index + 1);
+	  x = phase_data[line][pixel + 1] - seed_phase;
+	  phase_data[line][pixel + 1] -= (int)(rint(x/two_pi)) * two_pi;
+	  visit[line][pixel + 1] = unwrapped;
 	}
       }
     }
@@ -1498,22 +1492,17 @@ DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **p
     if(N != 0) {
       seeds[seed_id].nr_2pi -= N;
       double phase_adjust = two_pi * N;
-      while( !backupq.empty() ) {
-        point = backupq.front();
-        backupq.pop();
-        line  = point.get_Y();
-        pixel = point.get_X();
+      for(int index : workq.pushed()) {
+        line  = index / nr_pixels;
+        pixel = index - line * nr_pixels;
 	phase_data[line][pixel] -= phase_adjust;
       }
     }
-    else {
-      while( !backupq.empty() ) {
-        backupq.pop();
-      }
-    }
+  }
   }
 
-  for(line = 0; line < nr_lines; line ++) {
+#pragma omp parallel for
+  for(int line = 0; line < nr_lines; line ++) {
     for(int pixel = 0; pixel < nr_pixels; pixel ++) {
       if(visit[line][pixel] == not_unwrapped) {
 	phase_data[line][pixel] = no_data_value;
@@ -1521,175 +1510,70 @@ DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **p
     }
   }
 
-  delete[] histogram;
-  delete[] lower_bound;
-  delete[] upper_bound;
   //delete visit_patch;
 
   return visit_patch;
 }
 
-DataPatch<int> * generate_regions(DataPatch<NodeFlow> *flows_patch, int nr_seeds, Seed *seeds)
+// Label the region of each seed, regions[line][pixel] = seed_id, or -1 for
+// pixels not connected to any seed. Regions are the connected components of
+// the pixels not separated by flows, labeled in parallel.
+static void label_regions(NodeFlow **flows, int nr_lines, int nr_pixels, int patch_start,
+                          int nr_seeds, Seed *seeds, int **regions)
 {
-  int patch_start = flows_patch->get_extern_start_line();
-  int nr_lines = flows_patch->get_nr_lines() - 1;
-  int nr_pixels = flows_patch->get_nr_pixels() - 1;
-  int line, pixel, line_plus, line_minus, pixel_plus, pixel_minus;
-  //int nrows = nr_lines + 1;
-  //int ncols = nr_pixels + 1;
-
-
-  // do unwrapping with flood fill ......
-  DataPatch<int> *visit_patch = new DataPatch<int>(nr_pixels, nr_lines);
-  int **visit = visit_patch->get_data_lines_ptr();
-
   int not_unwrapped = -1;
 
-  for(line = 0; line < nr_lines; line ++) {
-    for(int pixel = 0; pixel < nr_pixels; pixel ++) {
-      visit[line][pixel] = not_unwrapped;
-    }
-  }
-
-  Point point, seed;
-
-  NodeFlow **flows = flows_patch->get_data_lines_ptr();
-
-  queue<Point> workq;
+  vector<uint32_t> labels((size_t)nr_lines * nr_pixels);
+  uint32_t nr_labels = isce3::unwrap::labelConnectedComponents(
+      labels.data(), nr_lines, nr_pixels,
+      [](size_t) { return true; },
+      [&](size_t k) { return flows[k / nr_pixels][k % nr_pixels + 1].toDown == 0; },
+      [&](size_t k) { return flows[k / nr_pixels + 1][k % nr_pixels].toRight == 0; });
 
+  // the first seed in each region names the region
+  vector<int> seed_of_label(nr_labels + 1, not_unwrapped);
   for(int seed_id = 0; seed_id < nr_seeds; seed_id ++) {
-
     int seed_x = seeds[seed_id].x;
     int seed_y = seeds[seed_id].y - patch_start;
     if(seed_y < 0 || seed_y >= nr_lines) continue;
 
-    if(visit[seed_y][seed_x] != not_unwrapped) continue;
-
-    workq.push(Point(seed_x, seed_y));
-
-    while( !workq.empty() ) {
-      point = workq.front();
-      workq.pop();
-      line  = point.get_Y();
-      pixel = point.get_X();
-      visit[line][pixel] = seed_id;
-
-
-      line_plus = line + 1;
-      line_minus = line - 1;
-      pixel_plus = pixel + 1;
-      pixel_minus = pixel - 1;
+    uint32_t label = labels[(size_t)seed_y * nr_pixels + seed_x];
+    if(seed_of_label[label] == not_unwrapped) seed_of_label[label] = seed_id;
+  }
 
-      if(line > 0) {              // facing up ......
-	if(flows[line][pixel].toRight == 0 && visit[line_minus][pixel] == not_unwrapped) {
-	  workq.push(Point(pixel, line_minus));
-	  visit[line_minus][pixel] = seed_id;
-	}
-      }
-      if(line < nr_lines - 1) {   // facing down ......
-	if(flows[line + 1][pixel].toRight == 0 && visit[line_plus][pixel] == not_unwrapped) {
-	  workq.push(Point(pixel, line_plus));
-	  visit[line_plus][pixel] = seed_id;
-	}
-      }
-      if(pixel > 0) {             // facing left ......
-	if(flows[line][pixel].toDown == 0 && visit[line][pixel_minus] == not_unwrapped) {
-	  workq.push(Point(pixel_minus, line));
-	  visit[line][pixel_minus] = seed_id;
-	}
-      }
-      if(pixel < nr_pixels - 1) {// facing right ......
-	if(flows[line][pixel_plus].toDown == 0 && visit[line][pixel_plus] == not_unwrapped) {
-	  workq.push(Point(pixel_plus, line));
-	  visit[line][pixel_plus] = seed_id;
-	}
-      }
+#pragma omp parallel for
+  for(int line = 0; line < nr_lines; line ++) {
+    for(int pixel = 0; pixel < nr_pixels; pixel ++) {
+      regions[line][pixel] = seed_of_label[ labels[(size_t)line * nr_pixels + pixel] ];
     }
   }
-
-  return visit_patch;
 }
 
-
-
-void generate_regions(DataPatch<NodeFlow> *flows_patch, int nr_seeds, Seed *seeds, int **regions)
+DataPatch<int> * generate_regions(DataPatch<NodeFlow> *flows_patch, int nr_seeds, Seed *seeds)
 {
   int patch_start = flows_patch->get_extern_start_line();
   int nr_lines = flows_patch->get_nr_lines() - 1;
   int nr_pixels = flows_patch->get_nr_pixels() - 1;
-  int line, pixel, line_plus, line_minus, pixel_plus, pixel_minus;
-  //int nrows = nr_lines + 1;
-  //int ncols = nr_pixels + 1;
-
-
-  // do unwrapping with flood fill ......
-
-  int not_unwrapped = -1;
-
-  for(line = 0; line < nr_lines; line ++) {
-    for(int pixel = 0; pixel < nr_pixels; pixel ++) {
-      regions[line][pixel] = not_unwrapped;
-    }
-  }
-
-  Point point, seed;
-
-  NodeFlow **flows = flows_patch->get_data_lines_ptr();
-
-  queue<Point> workq;
 
-  for(int seed_id = 0; seed_id < nr_seeds; seed_id ++) {
+  DataPatch<int> *visit_patch = new DataPatch<int>(nr_pixels, nr_lines);
+  label_regions(flows_patch->get_data_lines_ptr(), nr_lines, nr_pixels, patch_start,
+               nr_seeds, seeds, visit_patch->get_data_lines_ptr());
 
-    int seed_x = seeds[seed_id].x;
-    int seed_y = seeds[seed_id].y - patch_start;
-    if(seed_y < 0 || seed_y >= nr_lines) continue;
+  return visit_patch;
+}
 
-    if(regions[seed_y][seed_x] != not_unwrapped) continue;
 
-    workq.push(Point(seed_x, seed_y));
 
-    while( !workq.empty() ) {
-      point = workq.front();
-      workq.pop();
-      line  = point.get_Y();
-      pixel = point.get_X();
-      regions[line][pixel] = seed_id;
-
-
-      line_plus = line + 1;
-      line_minus = line - 1;
-      pixel_plus = pixel + 1;
-      pixel_minus = pixel - 1;
+void generate_regions(DataPatch<NodeFlow> *flows_patch, int nr_seeds, Seed *seeds, int **regions)
+{
+  int patch_start = flows_patch->get_extern_start_line();
+  int nr_lines = flows_patch->get_nr_lines() - 1;
+  int nr_pixels = flows_patch->get_nr_pixels() - 1;
 
-      if(line > 0) {              // facing up ......
-	if(flows[line][pixel].toRight == 0 && regions[line_minus][pixel] == not_unwrapped) {
-	  workq.push(Point(pixel, line_minus));
-	  regions[line_minus][pixel] = seed_id;
-	}
-      }
-      if(line < nr_lines - 1) {   // facing down ......
-	if(flows[line + 1][pixel].toRight == 0 && regions[line_plus][pixel] == not_unwrapped) {
-	  workq.push(Point(pixel, line_plus));
-	  regions[line_plus][pixel] = seed_id;
-	}
-      }
-      if(pixel > 0) {             // facing left ......
-	if(flows[line][pixel].toDown == 0 && regions[line][pixel_minus] == not_unwrapped) {
-	  workq.push(Point(pixel_minus, line));
-	  regions[line][pixel_minus] = seed_id;
-	}
-      }
-      if(pixel < nr_pixels - 1) {// facing right ......
-	if(flows[line][pixel_plus].toDown == 0 && regions[line][pixel_plus] == not_unwrapped) {
-	  workq.push(Point(pixel_plus, line));
-	  regions[line][pixel_plus] = seed_id;
-	}
-      }
-    }
-  }
+  label_regions(flows_patch->get_data_lines_ptr(), nr_lines, nr_pixels, patch_start,
+               nr_seeds, seeds, regions);
 }
 
-
 DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 {
   int nrows = node_patch->get_nr_lines();
@@ -1938,9 +1822,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 
   int nr_queues = cost_scale * min(ncols, nrows) * 2;
 
-  queue<Point> *dist_queues = new queue<Point>[nr_queues];
-
-  Point point;
+  BucketQueue dist_queues(nr_queues);
 
   uint d, curr_dist, reduced_cost;
 
@@ -1961,6 +1843,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 //    cerr << "\n iter: " << iter << endl;
     // (1) initializing ......
 
+    #pragma omp parallel for
     for(int ii = 0; ii < nrows; ii++) {
       for(int jj = 0; jj < ncols; jj ++) {
 	visit[ii][jj] = unlabeled;
@@ -1978,9 +1861,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
       if(nodes[line][pixel].supply == 0) continue;   // if Residue discharged
       dists[ line ][ pixel ] = 0;  // Otherwise set all left-over supplys to zero distance
       visit[line][pixel] = labeled;
-      point.x = pixel;
-      point.y = line;
-      dist_queues[0].push(point);
+      dist_queues.push(0, line * ncols + pixel);
 
 //cerr << "s: " << s << "  point: " << point << "  dist: " << dists[ line ][ pixel ] << endl;
 
@@ -1994,12 +1875,12 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 //    int scanned_count = 0;
     int min_dist = 0;
     int max_dist = 0;
-    while(!dist_queues[min_dist].empty()) {  // as long as the labeled_set is not empty, do the following ......
-      point = dist_queues[min_dist].front();
-      dist_queues[min_dist].pop();
+    while(!dist_queues.empty(min_dist)) {  // as long as the labeled_set is not empty, do the following ......
+      int index = dist_queues.front(min_dist);
+      dist_queues.pop(min_dist);
 
-      line = point.y;
-      pixel = point.x;
+      line = index / ncols;
+      pixel = index - line * ncols;
 
 //	if(pixel == 3 && line == 3) cerr << "iter: " << iter << "   min_dist: " << min_dist << "  scanned: " << point << "  dist: " << dists[line][pixel] << endl;
 
@@ -2008,7 +1889,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
       if(visit[line][pixel] == scanned) {
 	//if(nodes[line][pixel].supply == demand) scanned_count ++;
 
-	while( dist_queues[min_dist].empty()){
+	while( dist_queues.empty(min_dist)){
 	  min_dist ++;
 	  if(min_dist >= nr_queues) break;
 	}
@@ -2042,9 +1923,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
           visit[line][pixel - 1] = labeled;
 	  dists[line][pixel - 1] = d;
 	  branches[line][pixel - 1] = flow_right;
-	  point.x = pixel - 1;
-	  point.y = line;
-	  dist_queues[d].push(point);
+	  dist_queues.push(d, line * ncols + pixel - 1);
 	  if(d > max_dist) max_dist = d;
 	  if(d < tmp_mind) tmp_mind = d;
 
@@ -2068,9 +1947,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 	  visit[line][pixel + 1] = labeled;
 	  dists[line][pixel + 1] = d;
 	  branches[line][pixel + 1] = flow_left;
-	  point.x = pixel + 1;
-	  point.y = line;
-	  dist_queues[d].push(point);
+	  dist_queues.push(d, line * ncols + pixel + 1);
 	  if(d > max_dist) max_dist = d;
 	  if(d < tmp_mind) tmp_mind = d;
 	  // cerr << "Right  d : " << d << endl;
@@ -2093,9 +1970,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 	  visit[line - 1][pixel] = labeled;
 	  dists[line - 1][pixel] = d;
 	  branches[line - 1][pixel] = flow_down;
-	  point.x = pixel;
-	  point.y = line - 1;
-	  dist_queues[d].push(point);
+	  dist_queues.push(d, (line - 1) * ncols + pixel);
 	  if(d > max_dist) max_dist = d;
 	  if(d < tmp_mind) tmp_mind = d;
 	  // cerr << "UP  d : " << d << endl;
@@ -2118,9 +1993,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 	  visit[line + 1][pixel] = labeled;
 	  dists[line + 1][pixel] = d;
 	  branches[line + 1][pixel] = flow_up;
-	  point.x = pixel;
-	  point.y = line + 1;
-	  dist_queues[d].push(point);
+	  dist_queues.push(d, (line + 1) * ncols + pixel);
 	  if(d < tmp_mind) tmp_mind = d;
 	  if(d > max_dist) max_dist = d;
 
@@ -2133,7 +2006,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 
       if(tmp_mind < min_dist) min_dist = tmp_mind;
 
-      while( dist_queues[min_dist].empty()){
+      while( dist_queues.empty(min_dist)){
 	min_dist ++;
 	if(min_dist > max_dist) break;
       }
@@ -2167,6 +2040,7 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
 
 
 //    if(L0L1_mode == 1) {
+      #pragma omp parallel for
       for(int line = 0; line < nrows; line ++) {
         for(int pixel = 0; pixel < ncols; pixel ++) {
 //	  if(dists[line][pixel] > 0 && visit[line][pixel] == scanned) {
@@ -2380,7 +2254,6 @@ DataPatch<NodeFlow> *solve(DataPatch<Node> *node_patch)
   delete[] indexes;
   delete[] dd;
 
-  if(dist_queues) delete[] dist_queues;
   delete[] S;
   delete[] T;
 
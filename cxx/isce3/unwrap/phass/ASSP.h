@@ -81,6 +81,7 @@ void make_node_patch(char *int_file, char *corr_file, char *amp_file, char *layo
 
 
 void create_seeds(DataPatch<NodeFlow> *flows_patch, int minimum_nr_pixels, int& nr_seeds, Seed **seeds); // seeds only
+// seeds in distinct regions (as from create_seeds), grown in parallel
 DataPatch<char>* unwrap_adjust_seeds(DataPatch<NodeFlow> *flows_patch, float **phase_data, int nr_seeds, Seed *seeds); 
 DataPatch<char>* unwrap_assp(DataPatch<NodeFlow> *flows_patch, float **phase_data, int nr_seeds, Seed *seeds);
 
@@ -90,5 +91,6 @@ DataPatch<char>* unwrap_assp(DataPatch<NodeFlow> *flows_patch, float **phase_dat
 //void flood_fill(int line, int pixel, queue<USPoint>& workq, int nr_lines, int nr_pixels, int **region_map, char **visit);
 //void flood_fill_residues(int line, int pixel, queue<USPoint>& workq, int nr_lines, int nr_pixels, int **region_map, char **visit);
 
+// regions labeled in parallel, each named after its first seed
 DataPatch<int> * generate_regions(DataPatch<NodeFlow> *flows_patch, int nr_seeds, Seed *seeds);
 void generate_regions(DataPatch<NodeFlow> *flows_patch, int nr_seeds, Seed *seeds, int **region_map);
@@ -0,0 +1,62 @@
+// Copyright (c) 2017-, California Institute of Technology ("Caltech"). U.S.
+// Government sponsorship acknowledged.
+// All rights reserved.
+//
+//  ======================================================================
+//
+//  FILENAME: BucketQueue.h
+//
+//  ======================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Queues of flat node indices (line * ncols + pixel).
+//
+// FlatQueue is a first-in first-out queue for flood fills. Popped entries
+// stay in the buffer until clear(), so the nodes reached by a flood fill may
+// be revisited afterwards, and the buffer is reused by the next flood fill.
+//
+// BucketQueue is an array of FlatQueues indexed by distance, used as the
+// priority queue of the shortest path search in solve(). Drained buckets keep
+// their storage for later searches.
+
+class FlatQueue {
+  public:
+    bool empty() const { return head == items.size(); }
+    void push(int index) { items.push_back(index); }
+    int front() const { return items[head]; }
+    void pop() { head ++; }
+
+    // all indices pushed since the last clear(), in FIFO order
+    const std::vector<int> & pushed() const { return items; }
+
+    void clear() {
+      items.clear();
+      head = 0;
+    }
+
+  private:
+    std::vector<int> items;
+    std::size_t head = 0;
+};
+
+class BucketQueue {
+  public:
+    explicit BucketQueue(std::size_t nr_buckets) : buckets(nr_buckets) {}
+
+    std::size_t size() const { return buckets.size(); }
+    bool empty(std::size_t d) const { return buckets[d].empty(); }
+    void push(std::size_t d, int index) { buckets[d].push(index); }
+    int front(std::size_t d) const { return buckets[d].front(); }
+
+    void pop(std::size_t d) {
+      buckets[d].pop();
+      if(buckets[d].empty()) buckets[d].clear();
+    }
+
+  private:
+    std::vector<FlatQueue> buckets;
+};
@@ -86,6 +86,7 @@ void phass_unwrap(int nr_lines, int nr_pixels, float **phase_data, float **corr_
 
   DataPatch<Node> *node_patch = new DataPatch<Node>(ncols, nrows);
   Node **node_data = node_patch->get_data_lines_ptr();
+#pragma omp parallel for
   for(int row = 0; row < nrows; row++) {
     for(int col = 0; col < ncols; col ++) {
       node_data[row][col].supply = 0;
@@ -96,8 +97,9 @@ void phass_unwrap(int nr_lines, int nr_pixels, float **phase_data, float **corr_
 
   double pi = PI;
   double two_pi = 2.0 * PI;
-  float *phases = new float[5];
+#pragma omp parallel for
   for(int line=1; line<nr_lines; line++) {
+    float phases[5];
     for(int pixel=1; pixel<nr_pixels; pixel++) {
       phases[0] = phase_data[line-1][pixel-1];
       phases[1] = phase_data[line][pixel-1];
@@ -113,7 +115,6 @@ void phass_unwrap(int nr_lines, int nr_pixels, float **phase_data, float **corr_
       node_data[line][pixel].supply = flag;
     }
   }
-  delete[] phases;
 
   double x, y;
   int mask_th = good_corr * cost_scale;
@@ -8,11 +8,21 @@
 
 *************************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <csignal>
+#include <exception>
 #include <iomanip>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <unistd.h>
-#include <sys/wait.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <isce3/except/Error.h>
 
@@ -41,8 +51,24 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
            long linelen, long nlines, CostTag tag);
 template<class CostTag>
 static
+int UnwrapTiles(infileT *infiles, outfileT *outfiles, paramT *params,
+                Array2D<signed char>& dotilemask, long nlines, long linelen,
+                CostTag tag);
+template<class CostTag>
+static
+long NTileWorkers(paramT *params, long ntiles, long nlines, long linelen,
+                  CostTag tag);
+template<class CostTag>
+static
 int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
-               tileparamT *tileparams, long nlines, long linelen, CostTag tag);
+               tileparamT *tileparams, long nlines, long linelen,
+               int trapsignals, CostTag tag);
+template<class CostTag>
+static
+int CoarseInitFlows(infileT *infiles, outfileT *outfiles, paramT *params,
+                    tileparamT *tileparams, Array2D<float>& mag,
+                    Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
+                    long nlines, long linelen, CostTag tag);
 
 
 
@@ -158,18 +184,12 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
            long linelen, long nlines, CostTag tag){
 
   long optiter, noptiter;
-  long nexttilerow, nexttilecol, ntilerow, ntilecol, nthreads, nchildren;
-  long sleepinterval;
+  long ntilerow, ntilecol;
   tileparamT tileparams[1]={};
   infileT iterinfiles[1]={};
   outfileT iteroutfiles[1]={};
-  outfileT tileoutfiles[1]={};
   paramT iterparams[1]={};
   char tileinitfile[MAXSTRLEN]={};
-  pid_t pid;
-  int childstatus;
-  double tilecputimestart;
-  time_t tiletstart;
 
   auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
 
@@ -227,7 +247,6 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
     /* set up for unwrapping */
     ntilerow=iterparams->ntilerow;
     ntilecol=iterparams->ntilecol;
-    nthreads=iterparams->nthreads;
     dumpresults_global=FALSE;
     requestedstop_global=FALSE;
 
@@ -241,7 +260,9 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
       tileparams->firstcol=iterparams->piecefirstcol;
       tileparams->nrow=iterparams->piecenrow;
       tileparams->ncol=iterparams->piecencol;
-      UnwrapTile(iterinfiles,iteroutfiles,iterparams,tileparams,nlines,linelen,tag);
+      /* on the calling thread, so trap signals for dumping results */
+      UnwrapTile(iterinfiles,iteroutfiles,iterparams,tileparams,nlines,linelen,
+                 TRUE,tag);
 
     }else{
 
@@ -252,158 +273,17 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
         auto dotilemask=SetUpDoTileMask(iterinfiles,ntilerow,ntilecol);
 
         /* make a temporary directory into which tile files will be written */
+        /* (or set up to keep tile files in memory) */
         MakeTileDir(iterparams,iteroutfiles);
 
-        /* different code for parallel or nonparallel operation */
-        if(nthreads>1){
-
-          /* parallel code */
-
-          /* initialize */
-          nexttilerow=0;
-          nexttilecol=0;
-          nchildren=0;
-          sleepinterval=(long )ceil(nlines*linelen
-                                    /((double )(ntilerow*ntilecol))
-                                    *SECONDSPERPIXEL);
-
-          /* trap signals so children get killed if parent dies */
-          CatchSignals(KillChildrenExit);
-
-          /* loop until we're done unwrapping */
-          while(TRUE){
-
-            /* unwrap next tile if there are free processors and tiles left */
-            if(nchildren<nthreads && nexttilerow<ntilerow){
-
-              /* see if next tile needs to be unwrapped */
-              if(dotilemask(nexttilerow,nexttilecol)){
-
-                /* wait to make sure file i/o, threads, and OS are synched */
-                sleep(sleepinterval);
-                
-                /* fork to create new process */
-                fflush(NULL);
-                pid=fork();
-
-              }else{
-
-                /* tile did not need unwrapping, so set pid to parent pid */
-                pid=iterparams->parentpid;
-
-              }
-
-              /* see if parent or child (or error) */
-              if(pid<0){
-
-                /* parent kills children and exits if there was a fork error */
-                fflush(NULL);
-                kill(0,SIGKILL);
-                throw isce3::except::RuntimeError(ISCE_SRCINFO(),
-                        "Error while forking");
-
-              }else if(pid==0){
-
-                /* child executes this code after fork */
-
-                /* reset signal handlers so that children exit nicely */
-                CatchSignals(SignalExit);
-
-                /* start timers for this tile */
-                StartTimers(&tiletstart,&tilecputimestart);
-
-                /* set up tile parameters */
-                pid=getpid();
-                info << pyre::journal::at(__HERE__)
-                     << "Unwrapping tile at row " << nexttilerow
-                     << ", column " << nexttilecol << " (pid "
-                     << ((long )pid) << ")"
-                     << pyre::journal::endl;
-                SetupTile(nlines,linelen,iterparams,tileparams,
-                          iteroutfiles,tileoutfiles,
-                          nexttilerow,nexttilecol);
-              
-                /* unwrap the tile */
-                UnwrapTile(iterinfiles,tileoutfiles,iterparams,tileparams,
-                           nlines,linelen,tag);
-
-                /* log elapsed time */
-                DisplayElapsedTime(tiletstart,tilecputimestart);
-
-                /* child exits when done unwrapping */
-                exit(NORMAL_EXIT);
-
-              }
-              
-              /* parent executes this code after fork */
-
-              /* increment tile counters */
-              if(++nexttilecol==ntilecol){
-                nexttilecol=0;
-                nexttilerow++;
-              }
-
-              /* increment counter of running child processes */
-              if(pid!=iterparams->parentpid){
-                nchildren++;
-              }
-
-            }else{
-
-              /* wait for a child to finish (only parent gets here) */
-              pid=wait(&childstatus);
-
-              /* make sure child exited cleanly */
-              if(!(WIFEXITED(childstatus)) || (WEXITSTATUS(childstatus))!=0){
-                fflush(NULL);
-                signal(SIGTERM,SIG_IGN);
-                kill(0,SIGTERM);
-                throw isce3::except::RuntimeError(ISCE_SRCINFO(),
-                        "Unexpected or abnormal exit of child process " +
-                        std::to_string(pid));
-              }
-
-              /* we're done if there are no more active children */
-              /* shouldn't really need this sleep(), but be extra sure child */
-              /*   outputs are really flushed and written to disk by OS */
-              if(--nchildren==0){
-                sleep(sleepinterval);
-                break;
-              }
-
-            } /* end if free processor and tiles remaining */
-          } /* end while loop */
-
-          /* return signal handlers to default behavior */
-          CatchSignals(SIG_DFL);
-
-        }else{
-
-          /* nonparallel code */
-
-          /* loop over all tiles */
-          for(nexttilerow=0;nexttilerow<ntilerow;nexttilerow++){
-            for(nexttilecol=0;nexttilecol<ntilecol;nexttilecol++){
-              if(dotilemask(nexttilerow,nexttilecol)){
-
-                /* set up tile parameters */
-                info << pyre::journal::at(__HERE__)
-                     << "Unwrapping tile at row " << nexttilerow
-                     << ", column " << nexttilecol
-                     << pyre::journal::endl;
-                SetupTile(nlines,linelen,iterparams,tileparams,
-                          iteroutfiles,tileoutfiles,
-                          nexttilerow,nexttilecol);
-            
-                /* unwrap the tile */
-                UnwrapTile(iterinfiles,tileoutfiles,iterparams,tileparams,
-                           nlines,linelen,tag);
-
-              }
-            }
-          }
+        /* in-memory tile files are not kept, so free them once read */
+        if(iterparams->tilememory){
+          iterparams->rmtmptile=TRUE;
+        }
 
-        } /* end if nthreads>1 */
+        /* unwrap tiles, in parallel if requested */
+        UnwrapTiles(iterinfiles,iteroutfiles,iterparams,dotilemask,
+                    nlines,linelen,tag);
 
       } /* end if !iterparams->assembleonly */
 
@@ -425,14 +305,199 @@ int Unwrap(infileT *infiles, outfileT *outfiles, paramT *params,
 } /* end of Unwrap() */
 
 
+/* function: UnwrapTiles()
+ * -----------------------
+ * Unwraps the tiles selected by the tile mask.  Tiles are taken from a
+ * shared queue by a pool of worker threads, each unwrapping one tile at
+ * a time with its own copy of the parameters.  Tile results are written
+ * to the tile directory or kept in memory, as set up by MakeTileDir().
+ * OpenMP threads used within each tile are split among the workers.
+ * The first error raised by a worker is rethrown after all workers are
+ * done.
+ */
+template<class CostTag>
+static
+int UnwrapTiles(infileT *infiles, outfileT *outfiles, paramT *params,
+                Array2D<signed char>& dotilemask, long nlines, long linelen,
+                CostTag tag){
+
+  long tilerow, tilecol, ntiles, nworkers, nompthreads;
+  std::vector<std::pair<long,long>> tiles;
+  std::atomic<long> nexttile{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  std::mutex errormutex;
+
+  auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
+
+  /* make queue of tiles that need to be unwrapped */
+  for(tilerow=0;tilerow<params->ntilerow;tilerow++){
+    for(tilecol=0;tilecol<params->ntilecol;tilecol++){
+      if(dotilemask(tilerow,tilecol)){
+        tiles.emplace_back(tilerow,tilecol);
+      }
+    }
+  }
+  ntiles=tiles.size();
+  if(!ntiles){
+    return(0);
+  }
+
+  /* worker unwrapping tiles from queue until empty or an error occurred */
+  auto worker=[&](){
+    infileT tileinfiles[1]={};
+    outfileT tileoutfiles[1]={};
+    paramT tileparamsglobal[1]={};
+    tileparamT tileparams[1]={};
+    long itile;
+    double tilecputimestart;
+    time_t tiletstart;
+
+#ifdef _OPENMP
+    omp_set_num_threads(nompthreads);
+#endif
+    try{
+      while(!failed && (itile=nexttile++)<ntiles){
+
+        /* start timers for this tile */
+        StartTimers(&tiletstart,&tilecputimestart);
+
+        /* set up tile parameters */
+        tileinfiles[0]=*infiles;
+        tileparamsglobal[0]=*params;
+        info << pyre::journal::at(__HERE__)
+             << "Unwrapping tile at row " << tiles[itile].first
+             << ", column " << tiles[itile].second
+             << pyre::journal::endl;
+        SetupTile(nlines,linelen,tileparamsglobal,tileparams,
+                  outfiles,tileoutfiles,
+                  tiles[itile].first,tiles[itile].second);
+
+        /* unwrap the tile */
+        UnwrapTile(tileinfiles,tileoutfiles,tileparamsglobal,tileparams,
+                   nlines,linelen,FALSE,tag);
+
+        /* log elapsed time */
+        DisplayElapsedTime(tiletstart,tilecputimestart);
+      }
+    }catch(...){
+      std::lock_guard<std::mutex> lock(errormutex);
+      if(!error){
+        error=std::current_exception();
+      }
+      failed=true;
+    }
+  };
+
+  /* unwrap on this thread if only one worker */
+  nworkers=NTileWorkers(params,ntiles,nlines,linelen,tag);
+  nompthreads=1;
+#ifdef _OPENMP
+  nompthreads=std::max(1L,omp_get_max_threads()/nworkers);
+#endif
+  if(nworkers<=1){
+    worker();
+  }else{
+    info << pyre::journal::at(__HERE__)
+         << "Unwrapping " << ntiles << " tiles with " << nworkers
+         << " threads" << pyre::journal::endl;
+    std::vector<std::thread> threads;
+    threads.reserve(nworkers);
+    for(long i=0;i<nworkers;i++){
+      threads.emplace_back(worker);
+    }
+    for(auto& thread : threads){
+      thread.join();
+    }
+  }
+  if(error){
+    std::rethrow_exception(error);
+  }
+
+  /* done */
+  return(0);
+
+} /* end of UnwrapTiles() */
+
+
+/* function: NTileWorkers()
+ * ------------------------
+ * Returns the number of threads with which to unwrap tiles.  This is
+ * the requested number of threads, limited by the number of tiles and
+ * of hardware threads, and by the number of tiles that fit at once in
+ * the tile memory budget after setting aside memory for the tile files
+ * if they are kept in memory.  If no budget is given, half the physical
+ * memory is used as budget.
+ */
+template<class CostTag>
+static
+long NTileWorkers(paramT *params, long ntiles, long nlines, long linelen,
+                  CostTag /*tag*/){
+
+  using Cost=typename CostTag::Cost;
+  long nworkers, nhwthreads, ni, nj;
+  double budget, tilebytes, filebytes;
+
+  /* limit by requested threads, tiles, and hardware threads */
+  nworkers=std::min(params->nthreads,ntiles);
+  nhwthreads=std::thread::hardware_concurrency();
+  if(nhwthreads>0){
+    nworkers=std::min(nworkers,nhwthreads);
+  }
+  if(nworkers<=1){
+    return(1);
+  }
+
+  /* memory budget in bytes */
+  if(params->tilemembudget>0){
+    budget=params->tilemembudget*(double )MEGABYTE;
+  }else{
+    budget=0.5*sysconf(_SC_PHYS_PAGES)*(double )sysconf(_SC_PAGESIZE);
+    if(budget<=0){
+      return(nworkers);
+    }
+  }
+
+  /* approximate peak memory of UnwrapTile(): nodes, row and column arc */
+  /*   arrays of costs, incremental costs, flows, and apexes, and float */
+  /*   input and output arrays */
+  ni=ceil((nlines+(params->ntilerow-1)*params->rowovrlp)
+          /(double )params->ntilerow);
+  nj=ceil((linelen+(params->ntilecol-1)*params->colovrlp)
+          /(double )params->ntilecol);
+  tilebytes=(double )ni*nj*(sizeof(nodeT)
+                            +2*(sizeof(Cost)+sizeof(incrcostT)+sizeof(short)
+                                +sizeof(nodeT *))
+                            +8*sizeof(float));
+
+  /* in-memory tile files: unwrapped magnitude and phase, regions, costs, */
+  /*   and connected components */
+  filebytes=0;
+  if(params->tilememory){
+    filebytes=(double )ntiles*ni*nj*(2*sizeof(float)+sizeof(short)
+                                     +2*sizeof(Cost)+sizeof(unsigned int));
+  }
+
+  nworkers=std::min(nworkers,(long )((budget-filebytes)/tilebytes));
+  return(std::max(nworkers,1L));
+
+} /* end of NTileWorkers() */
+
+
 /* function: UnwrapTile()
  * ----------------------
- * This is the main phase unwrapping function for a single tile.
+ * This is the main phase unwrapping function for a single tile.  If
+ * trapsignals is set, SIGINT and SIGHUP dump the current solution during
+ * the optimization and the previous handlers are restored afterwards.
+ * Signal dispositions are process-wide, so this must only be set by the
+ * calling thread of a single-tile run, and not for tiles unwrapped by
+ * worker threads or for the coarse solution of the initialization.
  */
 template<class CostTag>
 static
 int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
-               tileparamT *tileparams,  long nlines, long linelen, CostTag tag){
+               tileparamT *tileparams,  long nlines, long linelen,
+               int trapsignals, CostTag tag){
 
   /* variable declarations */
   long nrow, ncol, nnoderow, narcrow, n, ngroundarcs, iincrcostfile;
@@ -517,7 +582,13 @@ int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
   if(!params->unwrapped){
 
     /* see which initialization method to use */
-    if(params->initmethod==MSTINIT){
+    if(params->coarseinit
+       && CoarseInitFlows(infiles,outfiles,params,tileparams,mag,wrappedphase,
+                          &flows,nlines,linelen,tag)){
+
+      /* flows set from upsampled solution of multilooked interferogram */
+
+    }else if(params->initmethod==MSTINIT){
 
       /* use minimum spanning tree (MST) algorithm */
       MSTInitFlows(wrappedphase,&flows,mstcosts,nrow,ncol,
@@ -587,10 +658,22 @@ int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
   /* mask zero-magnitude nodes so they are not considered in optimization */
   MaskNodes(nrow,ncol,nodes,ground,mag);
 
-  /* if we have a single tile, trap signals for dumping results */
-  if(params->ntilerow==1 && params->ntilecol==1){
-    signal(SIGINT,SetDump);
-    signal(SIGHUP,SetDump);
+  /* if requested, trap signals for dumping results */
+  /* previous handlers are restored when done, including on errors */
+  struct signaltrapT{
+    int trapped;
+    void (*oldsiginthandler)(int);
+    void (*oldsighuphandler)(int);
+    ~signaltrapT(){
+      if(trapped){
+        signal(SIGINT,oldsiginthandler);
+        signal(SIGHUP,oldsighuphandler);
+      }
+    }
+  }signaltrap{trapsignals,SIG_DFL,SIG_DFL};
+  if(trapsignals){
+    signaltrap.oldsiginthandler=signal(SIGINT,SetDump);
+    signaltrap.oldsighuphandler=signal(SIGHUP,SetDump);
   }
 
   /* main loop: loop over flow increments and sources */
@@ -729,10 +812,11 @@ int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
     } /* end loop until no more neg cycles */
   } /* end if all pixels masked */
 
-  /* if we have single tile, return signal handlers to default behavior */
-  if(params->ntilerow==1 && params->ntilecol==1){
-    signal(SIGINT,SIG_DFL);
-    signal(SIGHUP,SIG_DFL);
+  /* return signal handlers to their previous behavior */
+  if(signaltrap.trapped){
+    signal(SIGINT,signaltrap.oldsiginthandler);
+    signal(SIGHUP,signaltrap.oldsighuphandler);
+    signaltrap.trapped=FALSE;
   }
 
   /* grow connected component mask */
@@ -781,4 +865,158 @@ int UnwrapTile(infileT *infiles, outfileT *outfiles, paramT *params,
 
 } /* end of UnwrapTile() */
 
+
+/* function: CoarseInitFlows()
+ * ---------------------------
+ * Initializes the flows of a tile from a coarse-resolution solution.
+ * The wrapped phase and magnitude of the tile (after flattening and
+ * masking) are multilooked and unwrapped as a single tile with the same
+ * cost mode.  The coarse unwrapped phase is upsampled to the full
+ * resolution grid, and the flows of the congruent unwrapped phase are
+ * used in place of an MST or MCF initialization.  The multilooked
+ * inputs and the coarse solution are passed through temporary files
+ * named after the output file, so they are kept in memory along with
+ * the other tile files when tile files are kept in memory.  Returns
+ * TRUE if the flows were set, or FALSE if the tile is too small to be
+ * multilooked.
+ */
+template<class CostTag>
+static
+int CoarseInitFlows(infileT *infiles, outfileT *outfiles, paramT *params,
+                    tileparamT *tileparams, Array2D<float>& mag,
+                    Array2D<float>& wrappedphase, Array2D<short>* flowsptr,
+                    long nlines, long linelen, CostTag tag){
+
+  long nrow, ncol, ncoarserow, ncoarsecol, nlooksaz, nlooksrange, nlooks;
+  long row, col;
+  infileT coarseinfiles[1]={};
+  outfileT coarseoutfiles[1]={};
+  paramT coarseparams[1]={};
+  tileparamT coarsetileparams[1]={};
+  char path[MAXSTRLEN]={}, basename[MAXSTRLEN]={};
+  std::string coarsefileroot;
+  Array2D<float> corr, coarsemag, coarsephase, coarsecorr;
+  Array2D<float> coarseunwrappedphase, unwrappedphase;
+
+  auto info=pyre::journal::info_t("isce3.unwrap.snaphu");
+
+  /* get size of tile and of multilooked tile */
+  nrow=tileparams->nrow;
+  ncol=tileparams->ncol;
+  nlooksaz=params->ncoarselooksaz;
+  nlooksrange=params->ncoarselooksrange;
+  nlooks=nlooksaz*nlooksrange;
+  ncoarserow=(nrow+nlooksaz-1)/nlooksaz;
+  ncoarsecol=(ncol+nlooksrange-1)/nlooksrange;
+  if(ncoarserow<2 || ncoarsecol<2){
+    auto warnings=pyre::journal::warning_t("isce3.unwrap.snaphu");
+    warnings << pyre::journal::at(__HERE__)
+             << "WARNING: Tile too small for coarse initialization."
+             << "  Using MST or MCF initialization"
+             << pyre::journal::endl;
+    return(FALSE);
+  }
+
+  /* multilook the interferogram and correlation */
+  if(strlen(infiles->corrfile)){
+    ReadCorrelation(&corr,infiles,linelen,nlines,tileparams);
+  }
+  MultilookInterferogram(mag,wrappedphase,corr,&coarsemag,&coarsephase,
+                         &coarsecorr,nrow,ncol,nlooksaz,nlooksrange);
+
+  /* set names of temporary files for the coarse inputs and output */
+  ParseFilename(outfiles->outfile,path,basename);
+  coarsefileroot=std::string(path)+COARSEINITFILEROOT
+    +std::to_string(params->parentpid)+"_"+basename;
+  StrNCopy(coarseinfiles->infile,(coarsefileroot+".int").c_str(),MAXSTRLEN);
+  StrNCopy(coarseinfiles->corrfile,(coarsefileroot+".cor").c_str(),MAXSTRLEN);
+  StrNCopy(coarseoutfiles->outfile,(coarsefileroot+".unw").c_str(),MAXSTRLEN);
+  coarseinfiles->infileformat=COMPLEX_DATA;
+  coarseinfiles->corrfileformat=FLOAT_DATA;
+  coarseoutfiles->outfileformat=FLOAT_DATA;
+
+  /* remove temporary files when done, including on errors */
+  struct coarsefileguardT{
+    infileT *infiles;
+    outfileT *outfiles;
+    ~coarsefileguardT(){
+      RemoveTileFile(infiles->infile);
+      RemoveTileFile(infiles->corrfile);
+      RemoveTileFile(outfiles->outfile);
+    }
+  }coarsefileguard{coarseinfiles,coarseoutfiles};
+
+  /* write multilooked interferogram and correlation */
+  auto coarseigram=Array2D<float>(ncoarserow,2*ncoarsecol);
+  for(row=0;row<ncoarserow;row++){
+    for(col=0;col<ncoarsecol;col++){
+      coarseigram(row,2*col)=coarsemag(row,col)*cos(coarsephase(row,col));
+      coarseigram(row,2*col+1)=coarsemag(row,col)*sin(coarsephase(row,col));
+    }
+  }
+  Write2DArray(coarseigram,coarseinfiles->infile,
+               ncoarserow,2*ncoarsecol,sizeof(float));
+  Write2DArray(coarsecorr,coarseinfiles->corrfile,
+               ncoarserow,ncoarsecol,sizeof(float));
+
+  /* set parameters for unwrapping the multilooked tile as a single tile */
+  /* phase is already flipped, flattened and masked */
+  coarseparams[0]=*params;
+  coarseparams->coarseinit=FALSE;
+  coarseparams->unwrapped=FALSE;
+  coarseparams->eval=FALSE;
+  coarseparams->initonly=FALSE;
+  coarseparams->regrowconncomps=FALSE;
+  coarseparams->dumpall=FALSE;
+  coarseparams->flipphasesign=FALSE;
+  coarseparams->havemagnitude=TRUE;
+  coarseparams->ntilerow=1;
+  coarseparams->ntilecol=1;
+  coarseparams->rowovrlp=0;
+  coarseparams->colovrlp=0;
+  coarseparams->edgemasktop=0;
+  coarseparams->edgemaskbot=0;
+  coarseparams->edgemaskleft=0;
+  coarseparams->edgemaskright=0;
+  if(strlen(infiles->corrfile)){
+    coarseparams->ncorrlooks=params->ncorrlooks*nlooks;
+  }else{
+    coarseparams->ncorrlooks=nlooks;
+  }
+  coarseparams->nlooksaz=params->nlooksaz*nlooksaz;
+  coarseparams->nlooksrange=params->nlooksrange*nlooksrange;
+  coarseparams->da=params->da*nlooksaz;
+  coarseparams->dr=params->dr*nlooksrange;
+  coarseparams->nearrange=params->nearrange
+    +params->dr*(tileparams->firstcol+(nlooksrange-1)/2.0);
+  coarseparams->maxnflowcycles=LRound(params->maxnflowcycles/(double )nlooks);
+  coarsetileparams->firstrow=0;
+  coarsetileparams->firstcol=0;
+  coarsetileparams->nrow=ncoarserow;
+  coarsetileparams->ncol=ncoarsecol;
+
+  /* unwrap the multilooked tile */
+  info << pyre::journal::at(__HERE__)
+       << "Unwrapping " << ncoarserow << "x" << ncoarsecol
+       << " multilooked interferogram for initialization"
+       << pyre::journal::endl;
+  UnwrapTile(coarseinfiles,coarseoutfiles,coarseparams,coarsetileparams,
+             ncoarserow,ncoarsecol,FALSE,tag);
+  Read2DArray(&coarseunwrappedphase,coarseoutfiles->outfile,
+              ncoarsecol,ncoarserow,coarsetileparams,
+              sizeof(float *),sizeof(float));
+
+  /* upsample coarse solution and get flows of congruent unwrapped phase */
+  info << pyre::journal::at(__HERE__)
+       << "Initializing flows from coarse solution"
+       << pyre::journal::endl;
+  UpsampleUnwrappedPhase(coarseunwrappedphase,wrappedphase,&unwrappedphase,
+                         nrow,ncol,nlooksaz,nlooksrange);
+  CalcFlow(unwrappedphase,flowsptr,nrow,ncol);
+
+  /* done */
+  return(TRUE);
+
+} /* end of CoarseInitFlows() */
+
 } // namespace isce3::unwrap
@@ -13,6 +13,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <ctime>
+#include <memory>
 #include <string>
 
 #include <Eigen/Core>
@@ -102,6 +103,9 @@
 #define NULLFILE             "/dev/null"
 #define DEF_INITONLY         FALSE
 #define DEF_INITMETHOD       MSTINIT
+#define DEF_COARSEINIT       FALSE
+#define DEF_NCOARSELOOKSAZ   4
+#define DEF_NCOARSELOOKSRANGE 4
 #define DEF_UNWRAPPED        FALSE
 #define DEF_REGROWCONNCOMPS  FALSE
 #define DEF_EVAL             FALSE
@@ -117,6 +121,7 @@
 #define ALT_SAMPLE_DATA      4         /* file format */
 #define TILEINITFILEFORMAT   ALT_LINE_DATA
 #define TILEINITFILEROOT     "snaphu_tileinit_"
+#define COARSEINITFILEROOT   "snaphu_coarseinit_"
 #define ABNORMAL_EXIT        1         /* exit code */
 #define NORMAL_EXIT          0         /* exit code */
 #define DUMP_PATH            "/tmp/"   /* default location for writing dumps */
@@ -127,8 +132,8 @@
 #define MSTINIT              1         /* initialization method */
 #define MCFINIT              2         /* initialization method */
 #define BIGGESTDZRHOMAX      10000.0
-#define SECONDSPERPIXEL      0.000001  /* for delay between thread creations */
 #define MAXTHREADS           64
+#define MEGABYTE             1048576
 #define TMPTILEDIRROOT       "snaphu_tiles_"
 #define TILEDIRMODE          511
 #define TMPTILEROOT          "tmptile_"
@@ -293,6 +298,8 @@
 #define DEF_TILEDIR          ""
 #define DEF_ASSEMBLEONLY     FALSE
 #define DEF_RMTMPTILE        TRUE
+#define DEF_TILEMEMORY       TRUE
+#define DEF_TILEMEMBUDGET    0
 
 
 /* default connected component parameters */
@@ -530,6 +537,9 @@ typedef struct nodesuppST{
 }nodesuppT;
 
 
+/* in-memory store of the temporary tile files of a run */
+struct memorytilestoreT;
+
 /* run-time parameter data structure */
 typedef struct paramST{
 
@@ -596,6 +606,9 @@ typedef struct paramST{
   signed char regrowconncomps=0;  /* grow connected components and exit if TRUE */
   signed char initonly=0;       /* exit after initialization if TRUE */
   signed char initmethod=0;     /* MST or MCF initialization */
+  signed char coarseinit=0;     /* flag: initialize from multilooked solution */
+  long ncoarselooksaz=0;        /* azimuth looks for coarse initialization */
+  long ncoarselooksrange=0;     /* range looks for coarse initialization */
   signed char costmode=0;       /* statistical cost mode */
   signed char dumpall=0;        /* dump intermediate files */
   signed char amplitude=0;      /* intensity data is amplitude, not power */
@@ -649,6 +662,9 @@ typedef struct paramST{
   signed char assembleonly=0;   /* flag for assemble-only (no unwrap) mode */
   signed char rmtmptile=0;      /* flag for removing temporary tile files */
   char tiledir[MAXSTRLEN]={};   /* directory for temporary tile files */
+  signed char tilememory=0;     /* flag for keeping tile files in memory */
+  long tilemembudget=0;         /* memory budget (MB) for parallel tiles */
+  std::shared_ptr<memorytilestoreT> tilestore;  /* tile files kept in memory */
 
   /* connected component parameters */
   double minconncompfrac=0.0;   /* min fraction of pixels in connected component */
@@ -910,6 +926,15 @@ int CycleResidue(Array2D<float>& phase, Array2D<signed char>& residue,
                  int nrow, int ncol);
 int NodeResidue(Array2D<float>& wphase, long row, long col);
 int CalcFlow(Array2D<float>& phase, Array2D<short>* flowsptr, long nrow, long ncol);
+int MultilookInterferogram(Array2D<float>& mag, Array2D<float>& wrappedphase,
+                           Array2D<float>& corr, Array2D<float>* coarsemagptr,
+                           Array2D<float>* coarsephaseptr,
+                           Array2D<float>* coarsecorrptr, long nrow, long ncol,
+                           long nlooksrow, long nlookscol);
+int UpsampleUnwrappedPhase(Array2D<float>& coarseunwrappedphase,
+                           Array2D<float>& wrappedphase,
+                           Array2D<float>* unwrappedphaseptr,
+                           long nrow, long ncol, long nlooksrow, long nlookscol);
 int IntegratePhase(Array2D<float>& psi, Array2D<float>& phi, Array2D<short>& flows,
                    long nrow, long ncol);
 Array2D<float> ExtractFlow(Array2D<float>& unwrappedphase, Array2D<short>* flowsptr,
@@ -963,6 +988,7 @@ int WriteOutputFile(Array2D<float>& mag,
                     Array2D<float>& unwrappedphase, char *outfile,
                     outfileT *outfiles, long nrow, long ncol);
 FILE *OpenOutputFile(const char *outfile, char *realoutfile);
+FILE *OpenInputFile(const char *infile);
 int Write2DArray(void **array, char *filename, long nrow, long ncol,
                  size_t size);
 int Write2DRowColArray(void **array, char *filename, long nrow,
@@ -996,6 +1022,8 @@ int SetDumpAll(outfileT *outfiles, paramT *params);
 int DumpIncrCostFiles(Array2D<incrcostT>& incrcosts, long iincrcostfile,
                       long nflow, long nrow, long ncol);
 int MakeTileDir(paramT *params, outfileT *outfiles);
+int RemoveTileDir(paramT *params);
+int RemoveTileFile(const char *filename);
 int ParseFilename(const char *filename, char *path, char *basename);
 int SetTileInitOutfile(char *outfile, long pid);
 
@@ -1142,7 +1170,7 @@ int Read2DArray(Array2D<T>* arr, char *infile, long linelen, long nlines,
   long filesize,row,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(infile,"r"))==NULL){
+  if((fp=OpenInputFile(infile))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(infile));
@@ -1196,7 +1224,7 @@ int Read2DRowColFile(Array2D<T>* arr, char *filename, long linelen, long nlines,
   long row, nel, nrow, ncol, padlen, filelen;
  
   /* open the file */
-  if((fp=fopen(filename,"r"))==NULL){
+  if((fp=OpenInputFile(filename))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(filename));
@@ -1270,7 +1298,7 @@ int Read2DRowColFileRows(Array2D<T>* arr, char *filename, long linelen,
   long row, nel, nrow, ncol, padlen, filelen;
  
   /* open the file */
-  if((fp=fopen(filename,"r"))==NULL){
+  if((fp=OpenInputFile(filename))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(filename));
@@ -13,6 +13,7 @@
 #include <cstring>
 #include <iomanip>
 #include <type_traits>
+#include <vector>
 
 #include <isce3/except/Error.h>
 
@@ -20,8 +21,25 @@
 
 namespace isce3::unwrap {
 
+/* typedef for range-dependent parameters of topography-mode costs */
+typedef struct toporangeparamST{
+  double nomincind;             /* index into incidence angle lookup tables */
+  double dzr0;                  /* height change of flat ground per pixel */
+  double sigsqrhoconst;         /* scale of decorrelation variance */
+  double ztoshort;              /* height to short flow units factor */
+  double ztoshortsq;            /* square of ztoshort */
+  double sigsqlay;              /* variance of layover height */
+  double ambiguityheight;       /* height of one phase cycle */
+  double slope1, const1;        /* EI model below critical intensity */
+  double slope2, const2;        /* EI model above critical intensity */
+  double eicrit;                /* critical intensity */
+  double dphilaypeak;           /* phase of layover peak */
+}toporangeparamT;
+
 /* static (local) function prototypes */
 static
+void CalcDecorrPow(Eigen::ArrayXd& rho, double rhopow);
+static
 Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>& mag,
                                   Array2D<float>& unwrappedest, Array2D<float>& pwr,
                                   Array2D<float>& corr, Array2D<short>& rowweight, Array2D<short>& colweight,
@@ -306,6 +324,8 @@ int BuildCostArrays(Array2D<typename CostTag::Cost>* costsptr, Array2D<short>* m
 
     /* if we got here, we had statistical costs and we need scalar weights */
     /*   from them for MST initialization or for Lp optimization */
+    /* arcs are independent, so bands of rows are done in parallel */
+    #pragma omp parallel for schedule(static) private(col,maxcol,tempcost,poscost,negcost)
     for(row=0;row<2*nrow-1;row++){
       if(row<nrow-1){
         maxcol=ncol;
@@ -417,19 +437,19 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
                                   long nrow, long ncol, tileparamT *tileparams,
                                   outfileT *outfiles, paramT *params){
 
-  long row, col, iei, nrho, nominctablesize;
+  long col, nrho, nominctablesize;
   long kperpdpsi, kpardpsi, sigsqshortmin;
   double a, re, dr, slantrange, nearrange, nominc0, dnominc;
-  double nomincangle, nomincind, sinnomincangle, cosnomincangle, bperp;
+  double nomincangle, sinnomincangle, cosnomincangle, bperp;
   double baseline, baselineangle, lambda, lookangle;
-  double dzlay, dzei, dzr0, dzrcrit, dzeimin, dphilaypeak, dzrhomax;
+  double dzrcrit, dzeimin;
   double azdzfactor, dzeifactor, dzeiweight, dzlayfactor;
-  double avgei, eicrit, layminei, laywidth, slope1, const1, slope2, const2;
-  double rho, rho0, rhomin, drho, rhopow;
-  double sigsqrho, sigsqrhoconst, sigsqei, sigsqlay;
-  double glay, costscale, ambiguityheight, ztoshort, ztoshortsq;
+  double layminei, laywidth;
+  double rho0, rhomin, drho, rhopow;
+  double sigsqei;
+  double glay, costscale;
   double nshortcycle, midrangeambight;
-  signed char noshadow, nolayover;
+  signed char noshadow;
 
   Array2D<float> ei;
 
@@ -534,138 +554,162 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
   CalcWrappedRangeDiffs(dpsi,avgdpsi,wrappedphase,kperpdpsi,kpardpsi,
                         nrow,ncol);
 
-  /* build colcost array (range slopes) */
-  /* loop over range */
-  for(col=0;col<ncol-1;col++){
-
-    /* compute range dependent parameters */
+  /* compute range dependent parameters */
+  auto rangeparams=std::vector<toporangeparamT>(ncol);
+  for(col=0;col<ncol;col++){
+    auto& rp=rangeparams[col];
     slantrange=nearrange+col*dr;
     cosnomincangle=(a*a-slantrange*slantrange-re*re)/(2*slantrange*re);
     nomincangle=acos(cosnomincangle);
     sinnomincangle=sin(nomincangle);
     lookangle=asin(re/a*sinnomincangle);
-    dzr0=-dr*cosnomincangle;
+    rp.dzr0=-dr*cosnomincangle;
     bperp=baseline*cos(lookangle-baselineangle);
-    ambiguityheight=-(lambda*slantrange*sinnomincangle)/(2*bperp);
-    sigsqrhoconst=2.0*ambiguityheight*ambiguityheight/12.0;  
-    ztoshort=nshortcycle/ambiguityheight;
-    ztoshortsq=ztoshort*ztoshort;
-    sigsqlay=ambiguityheight*ambiguityheight*params->sigsqlayfactor;
+    rp.ambiguityheight=-(lambda*slantrange*sinnomincangle)/(2*bperp);
+    rp.sigsqrhoconst=2.0*rp.ambiguityheight*rp.ambiguityheight/12.0;  
+    rp.ztoshort=nshortcycle/rp.ambiguityheight;
+    rp.ztoshortsq=rp.ztoshort*rp.ztoshort;
+    rp.sigsqlay=rp.ambiguityheight*rp.ambiguityheight*params->sigsqlayfactor;
 
     /* interpolate scattering model parameters */
-    nomincind=(nomincangle-nominc0)/dnominc;
-    dzrcrit=LinInterp1D(dzrcrittable,nomincind,nominctablesize);
-    SolveEIModelParams(&slope1,&slope2,&const1,&const2,dzrcrit,dzr0,
-                       sinnomincangle,cosnomincangle,params);
-    eicrit=(dzrcrit-const1)/slope1;
-    dphilaypeak=params->dzlaypeak/ambiguityheight;
-
-    /* loop over azimuth */
-    for(row=0;row<nrow;row++){
+    rp.nomincind=(nomincangle-nominc0)/dnominc;
+    dzrcrit=LinInterp1D(dzrcrittable,rp.nomincind,nominctablesize);
+    SolveEIModelParams(&rp.slope1,&rp.slope2,&rp.const1,&rp.const2,dzrcrit,
+                       rp.dzr0,sinnomincangle,cosnomincangle,params);
+    rp.eicrit=(dzrcrit-rp.const1)/rp.slope1;
+    rp.dphilaypeak=params->dzlaypeak/rp.ambiguityheight;
+  }
 
-      /* see if we have a masked pixel */
-      if(colweight(row,col)==0){
+  /* build colcost array (range slopes) */
+  /* rows are independent, so bands of rows are built in parallel */
+  #pragma omp parallel
+  {
+    Eigen::ArrayXd decorr(ncol-1);
+
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow;row++){
+
+      /* correlation term of decorrelation variance for the whole row */
+      for(long col=0;col<ncol-1;col++){
+        decorr(col)=corr(row,col);
+        if(decorr(col)<rhomin){
+          decorr(col)=0;
+        }
+      }
+      CalcDecorrPow(decorr,rhopow);
 
-        /* masked pixel */
-        MaskCost(&colcost(row,col));
+      /* loop over range */
+      for(long col=0;col<ncol-1;col++){
 
-      }else{
+        const auto& rp=rangeparams[col];
+        long iei;
+        double rho, sigsqrho, dzei, dzlay, dzrhomax;
+        signed char nolayover;
 
-        /* topography-mode costs */
+        /* see if we have a masked pixel */
+        if(colweight(row,col)==0){
 
-        /* calculate variance due to decorrelation */
-        /* factor of 2 in sigsqrhoconst for pdf convolution */
-        rho=corr(row,col);
-        if(rho<rhomin){
-          rho=0;
-        }
-        sigsqrho=sigsqrhoconst*pow(1-rho,rhopow);
+          /* masked pixel */
+          MaskCost(&colcost(row,col));
 
-        /* calculate dz expected from EI if no layover */
-        if(ei(row,col)>eicrit){
-          dzei=(slope2*ei(row,col)+const2)*dzeifactor;
         }else{
-          dzei=(slope1*ei(row,col)+const1)*dzeifactor;
-        }
-        if(noshadow && dzei<dzeimin){
-          dzei=dzeimin;
-        }
 
-        /* calculate dz expected from EI if layover exists */
-        dzlay=0;
-        if(ei(row,col)>layminei){
-          for(iei=0;iei<laywidth;iei++){
-            if(ei(row,col+iei)>eicrit){
-              dzlay+=slope2*ei(row,col+iei)+const2;
-            }else{
-              dzlay+=slope1*ei(row,col+iei)+const1;
-            }
-            if(col+iei>ncol-2){
-              break;
-            }
-          }
-        }
-        if(dzlay){
-          dzlay=(dzlay+iei*(-2.0*dzr0))*dzlayfactor;
-        }
-          
-        /* set maximum dz based on unbiased correlation and layover max */ 
-        if(rho>0){
-          dzrhomax=LinInterp2D(dzrhomaxtable,nomincind,(rho-rhomin)/drho,
-                               nominctablesize,nrho);
-          if(dzrhomax<dzlay){  
-            dzlay=dzrhomax;
+          /* topography-mode costs */
+
+          /* calculate variance due to decorrelation */
+          /* factor of 2 in sigsqrhoconst for pdf convolution */
+          rho=corr(row,col);
+          if(rho<rhomin){
+            rho=0;
           }
-        }
+          sigsqrho=rp.sigsqrhoconst*decorr(col);
 
-        /* set cost parameters in terms of flow, represented as shorts */
-        nolayover=TRUE;
-        if(dzlay){
-          if(rho>0){
-            colcost(row,col).offset=nshortcycle*
-              (dpsi(row,col)-0.5*(avgdpsi(row,col)+dphilaypeak));
+          /* calculate dz expected from EI if no layover */
+          if(ei(row,col)>rp.eicrit){
+            dzei=(rp.slope2*ei(row,col)+rp.const2)*dzeifactor;
           }else{
-            colcost(row,col).offset=nshortcycle*
-              (dpsi(row,col)-0.25*avgdpsi(row,col)-0.75*dphilaypeak);
+            dzei=(rp.slope1*ei(row,col)+rp.const1)*dzeifactor;
           }
-          colcost(row,col).sigsq=(sigsqrho+sigsqei+sigsqlay)*ztoshortsq
-            /(costscale*colweight(row,col));
-          if(colcost(row,col).sigsq<sigsqshortmin){
-            colcost(row,col).sigsq=sigsqshortmin;
+          if(noshadow && dzei<dzeimin){
+            dzei=dzeimin;
           }
-          colcost(row,col).dzmax=dzlay*ztoshort;
-          colcost(row,col).laycost=colweight(row,col)*glay;
-          if(labs(colcost(row,col).dzmax)
-             >floor(sqrt(colcost(row,col).laycost*colcost(row,col).sigsq))){
-            nolayover=FALSE;
+
+          /* calculate dz expected from EI if layover exists */
+          dzlay=0;
+          if(ei(row,col)>layminei){
+            for(iei=0;iei<laywidth;iei++){
+              if(ei(row,col+iei)>rp.eicrit){
+                dzlay+=rp.slope2*ei(row,col+iei)+rp.const2;
+              }else{
+                dzlay+=rp.slope1*ei(row,col+iei)+rp.const1;
+              }
+              if(col+iei>ncol-2){
+                break;
+              }
+            }
           }
-        }
-        if(nolayover){
-          colcost(row,col).sigsq=(sigsqrho+sigsqei)*ztoshortsq
-            /(costscale*colweight(row,col));
-          if(colcost(row,col).sigsq<sigsqshortmin){
-            colcost(row,col).sigsq=sigsqshortmin;
+          if(dzlay){
+            dzlay=(dzlay+iei*(-2.0*rp.dzr0))*dzlayfactor;
           }
+            
+          /* set maximum dz based on unbiased correlation and layover max */ 
           if(rho>0){
-            colcost(row,col).offset=ztoshort*
-              (ambiguityheight*(dpsi(row,col)-0.5*avgdpsi(row,col))
-               -0.5*dzeiweight*dzei);
-          }else{
-            colcost(row,col).offset=ztoshort*
-              (ambiguityheight*(dpsi(row,col)-0.25*avgdpsi(row,col))
-               -0.75*dzeiweight*dzei);
+            dzrhomax=LinInterp2D(dzrhomaxtable,rp.nomincind,
+                                 (rho-rhomin)/drho,nominctablesize,nrho);
+            if(dzrhomax<dzlay){  
+              dzlay=dzrhomax;
+            }
           }
-          colcost(row,col).laycost=NOCOSTSHELF;
-          colcost(row,col).dzmax=LARGESHORT;
-        }
 
-        /* shift PDF to account for flattening by coarse unwrapped estimate */
-        if(unwrappedest.size()){
-          colcost(row,col).offset+=(nshortcycle/TWOPI*
-                                     (unwrappedest(row,col+1)
-                                      -unwrappedest(row,col)));
-        }
+          /* set cost parameters in terms of flow, represented as shorts */
+          nolayover=TRUE;
+          if(dzlay){
+            if(rho>0){
+              colcost(row,col).offset=nshortcycle*
+                (dpsi(row,col)-0.5*(avgdpsi(row,col)+rp.dphilaypeak));
+            }else{
+              colcost(row,col).offset=nshortcycle*
+                (dpsi(row,col)-0.25*avgdpsi(row,col)-0.75*rp.dphilaypeak);
+            }
+            colcost(row,col).sigsq=(sigsqrho+sigsqei+rp.sigsqlay)
+              *rp.ztoshortsq/(costscale*colweight(row,col));
+            if(colcost(row,col).sigsq<sigsqshortmin){
+              colcost(row,col).sigsq=sigsqshortmin;
+            }
+            colcost(row,col).dzmax=dzlay*rp.ztoshort;
+            colcost(row,col).laycost=colweight(row,col)*glay;
+            if(labs(colcost(row,col).dzmax)
+               >floor(sqrt(colcost(row,col).laycost*colcost(row,col).sigsq))){
+              nolayover=FALSE;
+            }
+          }
+          if(nolayover){
+            colcost(row,col).sigsq=(sigsqrho+sigsqei)*rp.ztoshortsq
+              /(costscale*colweight(row,col));
+            if(colcost(row,col).sigsq<sigsqshortmin){
+              colcost(row,col).sigsq=sigsqshortmin;
+            }
+            if(rho>0){
+              colcost(row,col).offset=rp.ztoshort*
+                (rp.ambiguityheight*(dpsi(row,col)-0.5*avgdpsi(row,col))
+                 -0.5*dzeiweight*dzei);
+            }else{
+              colcost(row,col).offset=rp.ztoshort*
+                (rp.ambiguityheight*(dpsi(row,col)-0.25*avgdpsi(row,col))
+                 -0.75*dzeiweight*dzei);
+            }
+            colcost(row,col).laycost=NOCOSTSHELF;
+            colcost(row,col).dzmax=LARGESHORT;
+          }
+
+          /* shift PDF to account for flattening by coarse unwrapped estimate */
+          if(unwrappedest.size()){
+            colcost(row,col).offset+=(nshortcycle/TWOPI*
+                                       (unwrappedest(row,col+1)
+                                        -unwrappedest(row,col)));
+          }
 
+        }
       }
     }
   } /* end of range gradient cost calculation */
@@ -684,123 +728,120 @@ Array2D<costT> BuildStatCostsTopo(Array2D<float>& wrappedphase, Array2D<float>&
   /* build rowcost array */
   /* for the rowcost array, there is symmetry between positive and */
   /*   negative flows, so we average ei[][] and corr[][] values in azimuth */
-  /* loop over range */
-  for(col=0;col<ncol;col++){
-
-    /* compute range dependent parameters */
-    slantrange=nearrange+col*dr;
-    cosnomincangle=(a*a-slantrange*slantrange-re*re)/(2*slantrange*re);
-    nomincangle=acos(cosnomincangle);
-    sinnomincangle=sin(nomincangle);
-    lookangle=asin(re/a*sinnomincangle);
-    dzr0=-dr*cosnomincangle;
-    bperp=baseline*cos(lookangle-baselineangle);
-    ambiguityheight=-lambda*slantrange*sinnomincangle/(2*bperp);
-    sigsqrhoconst=2.0*ambiguityheight*ambiguityheight/12.0;  
-    ztoshort=nshortcycle/ambiguityheight;
-    ztoshortsq=ztoshort*ztoshort;
-    sigsqlay=ambiguityheight*ambiguityheight*params->sigsqlayfactor;
+  /* rows are independent, so bands of rows are built in parallel */
+  #pragma omp parallel
+  {
+    Eigen::ArrayXd decorr(ncol);
+
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow-1;row++){
+
+      /* correlation term of decorrelation variance for the whole row */
+      for(long col=0;col<ncol;col++){
+        decorr(col)=(corr(row,col)+corr(row+1,col))/2.0;
+        if(decorr(col)<rhomin){
+          decorr(col)=0;
+        }
+      }
+      CalcDecorrPow(decorr,rhopow);
 
-    /* interpolate scattering model parameters */
-    nomincind=(nomincangle-nominc0)/dnominc;
-    dzrcrit=LinInterp1D(dzrcrittable,nomincind,nominctablesize);
-    SolveEIModelParams(&slope1,&slope2,&const1,&const2,dzrcrit,dzr0,
-                       sinnomincangle,cosnomincangle,params);
-    eicrit=(dzrcrit-const1)/slope1;
-    dphilaypeak=params->dzlaypeak/ambiguityheight;
+      /* loop over range */
+      for(long col=0;col<ncol;col++){
 
-    /* loop over azimuth */
-    for(row=0;row<nrow-1;row++){
+        const auto& rp=rangeparams[col];
+        long iei;
+        double rho, sigsqrho, avgei, dzlay, dzrhomax;
+        signed char nolayover;
 
-      /* see if we have a masked pixel */
-      if(rowweight(row,col)==0){
+        /* see if we have a masked pixel */
+        if(rowweight(row,col)==0){
 
-        /* masked pixel */
-        MaskCost(&rowcost(row,col));
+          /* masked pixel */
+          MaskCost(&rowcost(row,col));
 
-      }else{
+        }else{
 
-        /* topography-mode costs */
+          /* topography-mode costs */
 
-        /* variance due to decorrelation */
-        /* get correlation and clip small values because of estimator bias */
-        rho=(corr(row,col)+corr(row+1,col))/2.0;
-        if(rho<rhomin){
-          rho=0;
-        }
-        sigsqrho=sigsqrhoconst*pow(1-rho,rhopow);
-
-        /* if no layover, the expected dz for azimuth will always be 0 */
-        dzei=0;
-
-        /* calculate dz expected from EI if layover exists */
-        dzlay=0;
-        avgei=(ei(row,col)+ei(row+1,col))/2.0;
-        if(avgei>layminei){
-          for(iei=0;iei<laywidth;iei++){
-            avgei=(ei(row,col+iei)+ei(row+1,col+iei))/2.0;
-            if(avgei>eicrit){
-              dzlay+=slope2*avgei+const2;
-            }else{
-              dzlay+=slope1*avgei+const1;
-            }
-            if(col+iei>ncol-2){
-              break;
+          /* variance due to decorrelation */
+          /* get correlation and clip small values because of estimator bias */
+          rho=(corr(row,col)+corr(row+1,col))/2.0;
+          if(rho<rhomin){
+            rho=0;
+          }
+          sigsqrho=rp.sigsqrhoconst*decorr(col);
+
+          /* if no layover, the expected dz for azimuth will always be 0 */
+
+          /* calculate dz expected from EI if layover exists */
+          dzlay=0;
+          avgei=(ei(row,col)+ei(row+1,col))/2.0;
+          if(avgei>layminei){
+            for(iei=0;iei<laywidth;iei++){
+              avgei=(ei(row,col+iei)+ei(row+1,col+iei))/2.0;
+              if(avgei>rp.eicrit){
+                dzlay+=rp.slope2*avgei+rp.const2;
+              }else{
+                dzlay+=rp.slope1*avgei+rp.const1;
+              }
+              if(col+iei>ncol-2){
+                break;
+              }
             }
           }
-        }
-        if(dzlay){
-          dzlay=(dzlay+iei*(-2.0*dzr0))*dzlayfactor;
-        }
-          
-        /* set maximum dz based on correlation max and layover max */ 
-        if(rho>0){
-          dzrhomax=LinInterp2D(dzrhomaxtable,nomincind,(rho-rhomin)/drho,
-                               nominctablesize,nrho);
-          if(dzrhomax<dzlay){
-            dzlay=dzrhomax;
+          if(dzlay){
+            dzlay=(dzlay+iei*(-2.0*rp.dzr0))*dzlayfactor;
+          }
+            
+          /* set maximum dz based on correlation max and layover max */ 
+          if(rho>0){
+            dzrhomax=LinInterp2D(dzrhomaxtable,rp.nomincind,
+                                 (rho-rhomin)/drho,nominctablesize,nrho);
+            if(dzrhomax<dzlay){
+              dzlay=dzrhomax;
+            }
           }
-        }
 
-        /* set cost parameters in terms of flow, represented as shorts */
-        if(rho>0){
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
-        }else{
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        nolayover=TRUE;
-        if(dzlay){
-          rowcost(row,col).sigsq=(sigsqrho+sigsqei+sigsqlay)*ztoshortsq
-            /(costscale*rowweight(row,col));
-          if(rowcost(row,col).sigsq<sigsqshortmin){
-            rowcost(row,col).sigsq=sigsqshortmin;
+          /* set cost parameters in terms of flow, represented as shorts */
+          if(rho>0){
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
           }
-          rowcost(row,col).dzmax=fabs(dzlay*ztoshort);
-          rowcost(row,col).laycost=rowweight(row,col)*glay;
-          if(labs(rowcost(row,col).dzmax)
-             >floor(sqrt(rowcost(row,col).laycost*rowcost(row,col).sigsq))){
-            nolayover=FALSE;
+          nolayover=TRUE;
+          if(dzlay){
+            rowcost(row,col).sigsq=(sigsqrho+sigsqei+rp.sigsqlay)
+              *rp.ztoshortsq/(costscale*rowweight(row,col));
+            if(rowcost(row,col).sigsq<sigsqshortmin){
+              rowcost(row,col).sigsq=sigsqshortmin;
+            }
+            rowcost(row,col).dzmax=fabs(dzlay*rp.ztoshort);
+            rowcost(row,col).laycost=rowweight(row,col)*glay;
+            if(labs(rowcost(row,col).dzmax)
+               >floor(sqrt(rowcost(row,col).laycost*rowcost(row,col).sigsq))){
+              nolayover=FALSE;
+            }
           }
-        }
-        if(nolayover){
-          rowcost(row,col).sigsq=(sigsqrho+sigsqei)*ztoshortsq
-            /(costscale*rowweight(row,col));
-          if(rowcost(row,col).sigsq<sigsqshortmin){
-            rowcost(row,col).sigsq=sigsqshortmin;
+          if(nolayover){
+            rowcost(row,col).sigsq=(sigsqrho+sigsqei)*rp.ztoshortsq
+              /(costscale*rowweight(row,col));
+            if(rowcost(row,col).sigsq<sigsqshortmin){
+              rowcost(row,col).sigsq=sigsqshortmin;
+            }
+            rowcost(row,col).laycost=NOCOSTSHELF;
+            rowcost(row,col).dzmax=LARGESHORT;
           }
-          rowcost(row,col).laycost=NOCOSTSHELF;
-          rowcost(row,col).dzmax=LARGESHORT;
-        }
 
-        /* shift PDF to account for flattening by coarse unwrapped estimate */
-        if(unwrappedest.size()){
-          rowcost(row,col).offset+=(nshortcycle/TWOPI*
-                                     (unwrappedest(row+1,col)
-                                      -unwrappedest(row,col)));
-        }
+          /* shift PDF to account for flattening by coarse unwrapped estimate */
+          if(unwrappedest.size()){
+            rowcost(row,col).offset+=(nshortcycle/TWOPI*
+                                       (unwrappedest(row+1,col)
+                                        -unwrappedest(row,col)));
+          }
 
+        }
       }
     }
   }  /* end of azimuth gradient cost calculation */
@@ -822,10 +863,9 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
                                   long nrow, long ncol, tileparamT * /*tileparams*/,
                                   outfileT * /*outfiles*/, paramT *params){
 
-  long row, col;
   long kperpdpsi, kpardpsi, sigsqshortmin, defomax;
-  double rho, rho0, rhopow;
-  double defocorrthresh, sigsqcorr, sigsqrho, sigsqrhoconst;
+  double rho0, rhopow;
+  double defocorrthresh, sigsqcorr, sigsqrhoconst;
   double glay, costscale;
   double nshortcycle, nshortcyclesq;
 
@@ -867,58 +907,77 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
                         nrow,ncol);
 
   /* build colcost array (range slopes) */
-  for(col=0;col<ncol-1;col++){
-    for(row=0;row<nrow;row++){
+  /* rows are independent, so bands of rows are built in parallel */
+  #pragma omp parallel
+  {
+    Eigen::ArrayXd decorr(ncol-1);
+
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow;row++){
+
+      /* correlation term of decorrelation variance for the whole row */
+      for(long col=0;col<ncol-1;col++){
+        decorr(col)=(corr(row,col)+corr(row,col+1))/2.0;
+        if(decorr(col)<defocorrthresh){
+          decorr(col)=0;
+        }
+      }
+      CalcDecorrPow(decorr,rhopow);
 
-      /* see if we have a masked pixel */
-      if(colweight(row,col)==0){
+      for(long col=0;col<ncol-1;col++){
 
-        /* masked pixel */
-        MaskCost(&colcost(row,col));
+        double rho, sigsqrho;
 
-      }else{
+        /* see if we have a masked pixel */
+        if(colweight(row,col)==0){
 
-        /* deformation-mode costs */
+          /* masked pixel */
+          MaskCost(&colcost(row,col));
 
-        /* calculate variance due to decorrelation */
-        /* need symmetry for range if deformation */
-        rho=(corr(row,col)+corr(row,col+1))/2.0;
-        if(rho<defocorrthresh){
-          rho=0;
-        }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
-
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        colcost(row,col).sigsq=sigsqrho/(costscale*colweight(row,col));
-        if(colcost(row,col).sigsq<sigsqshortmin){
-          colcost(row,col).sigsq=sigsqshortmin;
-        }
-        if(rho<defocorrthresh){
-          colcost(row,col).dzmax=defomax;
-          colcost(row,col).laycost=colweight(row,col)*glay;
-          if(colcost(row,col).dzmax<floor(sqrt(colcost(row,col).laycost
-                                                *colcost(row,col).sigsq))){
+
+          /* deformation-mode costs */
+
+          /* calculate variance due to decorrelation */
+          /* need symmetry for range if deformation */
+          rho=(corr(row,col)+corr(row,col+1))/2.0;
+          if(rho<defocorrthresh){
+            rho=0;
+          }
+          sigsqrho=(sigsqrhoconst*decorr(col)+sigsqcorr)*nshortcyclesq;
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rho>0){
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          colcost(row,col).sigsq=sigsqrho/(costscale*colweight(row,col));
+          if(colcost(row,col).sigsq<sigsqshortmin){
+            colcost(row,col).sigsq=sigsqshortmin;
+          }
+          if(rho<defocorrthresh){
+            colcost(row,col).dzmax=defomax;
+            colcost(row,col).laycost=colweight(row,col)*glay;
+            if(colcost(row,col).dzmax<floor(sqrt(colcost(row,col).laycost
+                                                  *colcost(row,col).sigsq))){
+              colcost(row,col).laycost=NOCOSTSHELF;
+              colcost(row,col).dzmax=LARGESHORT;
+            }
+          }else{
             colcost(row,col).laycost=NOCOSTSHELF;
             colcost(row,col).dzmax=LARGESHORT;
           }
-        }else{
-          colcost(row,col).laycost=NOCOSTSHELF;
-          colcost(row,col).dzmax=LARGESHORT;
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        colcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row,col+1)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          colcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row,col+1)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   }  /* end of range gradient cost calculation */
@@ -932,58 +991,77 @@ Array2D<costT> BuildStatCostsDefo(Array2D<float>& wrappedphase, Array2D<float>&
                      nrow,ncol);
 
   /* build rowcost array */
-  for(col=0;col<ncol;col++){
-    for(row=0;row<nrow-1;row++){
-
-      /* see if we have a masked pixel */
-      if(rowweight(row,col)==0){
+  /* rows are independent, so bands of rows are built in parallel */
+  #pragma omp parallel
+  {
+    Eigen::ArrayXd decorr(ncol);
+
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow-1;row++){
+
+      /* correlation term of decorrelation variance for the whole row */
+      for(long col=0;col<ncol;col++){
+        decorr(col)=(corr(row,col)+corr(row+1,col))/2.0;
+        if(decorr(col)<defocorrthresh){
+          decorr(col)=0;
+        }
+      }
+      CalcDecorrPow(decorr,rhopow);
 
-        /* masked pixel */
-        MaskCost(&rowcost(row,col));
+      for(long col=0;col<ncol;col++){
 
-      }else{
+        double rho, sigsqrho;
 
-        /* deformation-mode costs */
+        /* see if we have a masked pixel */
+        if(rowweight(row,col)==0){
 
-        /* variance due to decorrelation */
-        /* get correlation and clip small values because of estimator bias */
-        rho=(corr(row,col)+corr(row+1,col))/2.0;
-        if(rho<defocorrthresh){
-          rho=0;
-        }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
+          /* masked pixel */
+          MaskCost(&rowcost(row,col));
 
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        rowcost(row,col).sigsq=sigsqrho/(costscale*rowweight(row,col));
-        if(rowcost(row,col).sigsq<sigsqshortmin){
-          rowcost(row,col).sigsq=sigsqshortmin;
-        }
-        if(rho<defocorrthresh){
-          rowcost(row,col).dzmax=defomax;
-          rowcost(row,col).laycost=rowweight(row,col)*glay;
-          if(rowcost(row,col).dzmax<floor(sqrt(rowcost(row,col).laycost
-                                                *rowcost(row,col).sigsq))){
+
+          /* deformation-mode costs */
+
+          /* variance due to decorrelation */
+          /* get correlation and clip small values because of estimator bias */
+          rho=(corr(row,col)+corr(row+1,col))/2.0;
+          if(rho<defocorrthresh){
+            rho=0;
+          }
+          sigsqrho=(sigsqrhoconst*decorr(col)+sigsqcorr)*nshortcyclesq;
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rho>0){
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          rowcost(row,col).sigsq=sigsqrho/(costscale*rowweight(row,col));
+          if(rowcost(row,col).sigsq<sigsqshortmin){
+            rowcost(row,col).sigsq=sigsqshortmin;
+          }
+          if(rho<defocorrthresh){
+            rowcost(row,col).dzmax=defomax;
+            rowcost(row,col).laycost=rowweight(row,col)*glay;
+            if(rowcost(row,col).dzmax<floor(sqrt(rowcost(row,col).laycost
+                                                  *rowcost(row,col).sigsq))){
+              rowcost(row,col).laycost=NOCOSTSHELF;
+              rowcost(row,col).dzmax=LARGESHORT;
+            }
+          }else{
             rowcost(row,col).laycost=NOCOSTSHELF;
             rowcost(row,col).dzmax=LARGESHORT;
           }
-        }else{
-          rowcost(row,col).laycost=NOCOSTSHELF;
-          rowcost(row,col).dzmax=LARGESHORT;
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        rowcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row+1,col)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          rowcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row+1,col)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   } /* end of azimuth cost calculation */
@@ -1005,10 +1083,9 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
                                           long nrow, long ncol, tileparamT * /*tileparams*/,
                                           outfileT * /*outfiles*/, paramT *params){
 
-  long row, col;
   long kperpdpsi, kpardpsi, sigsqshortmin;
-  double rho, rho0, rhopow;
-  double defocorrthresh, sigsqcorr, sigsqrho, sigsqrhoconst;
+  double rho0, rhopow;
+  double defocorrthresh, sigsqcorr, sigsqrhoconst;
   double costscale;
   double nshortcycle, nshortcyclesq;
 
@@ -1048,46 +1125,65 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
                         nrow,ncol);
 
   /* build colcost array (range slopes) */
-  for(col=0;col<ncol-1;col++){
-    for(row=0;row<nrow;row++){
+  /* rows are independent, so bands of rows are built in parallel */
+  #pragma omp parallel
+  {
+    Eigen::ArrayXd decorr(ncol-1);
+
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow;row++){
+
+      /* correlation term of decorrelation variance for the whole row */
+      for(long col=0;col<ncol-1;col++){
+        decorr(col)=(corr(row,col)+corr(row,col+1))/2.0;
+        if(decorr(col)<defocorrthresh){
+          decorr(col)=0;
+        }
+      }
+      CalcDecorrPow(decorr,rhopow);
 
-      /* see if we have a masked pixel */
-      if(colweight(row,col)==0){
+      for(long col=0;col<ncol-1;col++){
 
-        /* masked pixel */
-        MaskSmoothCost(&colcost(row,col));
+        double rho, sigsqrho;
 
-      }else{
+        /* see if we have a masked pixel */
+        if(colweight(row,col)==0){
 
-        /* smooth-mode costs */
+          /* masked pixel */
+          MaskSmoothCost(&colcost(row,col));
 
-        /* calculate variance due to decorrelation */
-        /* need symmetry for range if deformation */
-        rho=(corr(row,col)+corr(row,col+1))/2.0;
-        if(rho<defocorrthresh){
-          rho=0;
-        }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
-
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          colcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        colcost(row,col).sigsq=sigsqrho/(costscale*colweight(row,col));
-        if(colcost(row,col).sigsq<sigsqshortmin){
-          colcost(row,col).sigsq=sigsqshortmin;
+
+          /* smooth-mode costs */
+
+          /* calculate variance due to decorrelation */
+          /* need symmetry for range if deformation */
+          rho=(corr(row,col)+corr(row,col+1))/2.0;
+          if(rho<defocorrthresh){
+            rho=0;
+          }
+          sigsqrho=(sigsqrhoconst*decorr(col)+sigsqcorr)*nshortcyclesq;
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rho>0){
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            colcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          colcost(row,col).sigsq=sigsqrho/(costscale*colweight(row,col));
+          if(colcost(row,col).sigsq<sigsqshortmin){
+            colcost(row,col).sigsq=sigsqshortmin;
+          }
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        colcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row,col+1)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          colcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row,col+1)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   }  /* end of range gradient cost calculation */
@@ -1101,46 +1197,65 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
                      nrow,ncol);
 
   /* build rowcost array */
-  for(col=0;col<ncol;col++){
-    for(row=0;row<nrow-1;row++){
+  /* rows are independent, so bands of rows are built in parallel */
+  #pragma omp parallel
+  {
+    Eigen::ArrayXd decorr(ncol);
+
+    #pragma omp for schedule(static)
+    for(long row=0;row<nrow-1;row++){
+
+      /* correlation term of decorrelation variance for the whole row */
+      for(long col=0;col<ncol;col++){
+        decorr(col)=(corr(row,col)+corr(row+1,col))/2.0;
+        if(decorr(col)<defocorrthresh){
+          decorr(col)=0;
+        }
+      }
+      CalcDecorrPow(decorr,rhopow);
 
-      /* see if we have a masked pixel */
-      if(rowweight(row,col)==0){
+      for(long col=0;col<ncol;col++){
 
-        /* masked pixel */
-        MaskSmoothCost(&rowcost(row,col));
+        double rho, sigsqrho;
 
-      }else{
+        /* see if we have a masked pixel */
+        if(rowweight(row,col)==0){
 
-        /* smooth-mode costs */
+          /* masked pixel */
+          MaskSmoothCost(&rowcost(row,col));
 
-        /* variance due to decorrelation */
-        /* get correlation and clip small values because of estimator bias */
-        rho=(corr(row,col)+corr(row+1,col))/2.0;
-        if(rho<defocorrthresh){
-          rho=0;
-        }
-        sigsqrho=(sigsqrhoconst*pow(1-rho,rhopow)+sigsqcorr)*nshortcyclesq;
-
-        /* set cost paramaters in terms of flow, represented as shorts */
-        if(rho>0){
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-avgdpsi(row,col));
         }else{
-          rowcost(row,col).offset=nshortcycle*
-            (dpsi(row,col)-0.5*avgdpsi(row,col));
-        }
-        rowcost(row,col).sigsq=sigsqrho/(costscale*rowweight(row,col));
-        if(rowcost(row,col).sigsq<sigsqshortmin){
-          rowcost(row,col).sigsq=sigsqshortmin;
+
+          /* smooth-mode costs */
+
+          /* variance due to decorrelation */
+          /* get correlation and clip small values because of estimator bias */
+          rho=(corr(row,col)+corr(row+1,col))/2.0;
+          if(rho<defocorrthresh){
+            rho=0;
+          }
+          sigsqrho=(sigsqrhoconst*decorr(col)+sigsqcorr)*nshortcyclesq;
+
+          /* set cost paramaters in terms of flow, represented as shorts */
+          if(rho>0){
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-avgdpsi(row,col));
+          }else{
+            rowcost(row,col).offset=nshortcycle*
+              (dpsi(row,col)-0.5*avgdpsi(row,col));
+          }
+          rowcost(row,col).sigsq=sigsqrho/(costscale*rowweight(row,col));
+          if(rowcost(row,col).sigsq<sigsqshortmin){
+            rowcost(row,col).sigsq=sigsqshortmin;
+          }
         }
-      }
 
-      /* shift PDF to account for flattening by coarse unwrapped estimate */
-      if(unwrappedest.size()){
-        rowcost(row,col).offset+=(nshortcycle/TWOPI*
-                                   (unwrappedest(row+1,col)
-                                    -unwrappedest(row,col)));
+        /* shift PDF to account for flattening by coarse unwrapped estimate */
+        if(unwrappedest.size()){
+          rowcost(row,col).offset+=(nshortcycle/TWOPI*
+                                     (unwrappedest(row+1,col)
+                                      -unwrappedest(row,col)));
+        }
       }
     }
   } /* end of azimuth cost calculation */
@@ -1151,6 +1266,25 @@ Array2D<smoothcostT> BuildStatCostsSmooth(Array2D<float>& wrappedphase, Array2D<
 }
 
 
+/* function: CalcDecorrPow()
+ * --------------------------
+ * Replaces each clipped correlation rho of a row of arcs by the
+ * decorrelation term (1-rho)^rhopow of the phase variance.  The power
+ * is evaluated with pow() as for a single arc, so the costs do not
+ * depend on how the rows are split.
+ */
+static
+void CalcDecorrPow(Eigen::ArrayXd& rho, double rhopow){
+
+  long i;
+
+  for(i=0;i<rho.size();i++){
+    rho(i)=pow(1.0-rho(i),rhopow);
+  }
+
+}
+
+
 /* function: MaskCost()
  * --------------------
  * Set values of costT structure pointed to by input pointer to give zero
@@ -1308,6 +1442,7 @@ int GetIntensityAndCorrelation(Array2D<float>& mag, Array2D<float>& wrappedphase
     /* get real and imaginary parts of interferogram */
     auto realcomp = Array2D<float>(nrow, ncol);
     auto imagcomp = Array2D<float>(nrow, ncol);
+    #pragma omp parallel for schedule(static) private(col)
     for(row=0;row<nrow;row++){
       for(col=0;col<ncol;col++){
         realcomp(row,col)=mag(row,col)*cos(wrappedphase(row,col));
@@ -1340,6 +1475,7 @@ int GetIntensityAndCorrelation(Array2D<float>& mag, Array2D<float>& wrappedphase
 
     /* build correlation data */
     corr = Array2D<float>(nrow, ncol);
+    #pragma omp parallel for schedule(static) private(col)
     for(row=0;row<nrow;row++){
       for(col=0;col<ncol;col++){
         if(avgpwr1(row,col)<=0 || avgpwr2(row,col)<=0){
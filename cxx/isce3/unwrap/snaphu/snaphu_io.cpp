@@ -8,8 +8,12 @@
 
 *************************************************************************/
 
+#include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unistd.h>
 #include <sys/stat.h>
 
@@ -19,8 +23,36 @@
 
 namespace isce3::unwrap {
 
+/* typedef for a temporary tile file held in memory */
+typedef struct memoryfileST{
+  char *buf=nullptr;            /* file contents, managed by open_memstream() */
+  size_t size=0;                /* number of bytes in file */
+  ~memoryfileST(){ free(buf); }
+}memoryfileT;
+
+/* in-memory store of the temporary tile files of one run, keyed by file */
+/*   name; it is owned by the parameters of the run and holds the files in */
+/*   its tile directory */
+struct memorytilestoreT{
+  std::mutex mutex;
+  std::string tiledir;
+  std::map<std::string,std::unique_ptr<memoryfileT>> files;
+  ~memorytilestoreT();
+};
+
+/* static variables local this file */
+
+/* stores of the runs keeping tile files in memory, keyed by tile */
+/*   directory; directory names are unique among the live stores */
+static std::mutex memorytilestoresmutex;
+static std::map<std::string,std::weak_ptr<memorytilestoreT>> memorytilestores;
+
 /* static (local) function prototypes */
 static
+FILE *OpenMemoryTileFile(const char *filename, char mode);
+static
+std::shared_ptr<memorytilestoreT> FindMemoryTileStore(const char *filename);
+static
 int ParseConfigLine(char *buf, const char *conffile, long nlines,
                     infileT *infiles, outfileT *outfiles,
                     long *linelenptr, paramT *params);
@@ -94,6 +126,9 @@ int SetDefaults(infileT *infiles, outfileT *outfiles, paramT *params){
   params->eval=DEF_EVAL;
   params->initonly=DEF_INITONLY;
   params->initmethod=DEF_INITMETHOD;
+  params->coarseinit=DEF_COARSEINIT;
+  params->ncoarselooksaz=DEF_NCOARSELOOKSAZ;
+  params->ncoarselooksrange=DEF_NCOARSELOOKSRANGE;
   params->costmode=DEF_COSTMODE;
   params->amplitude=DEF_AMPLITUDE;
 
@@ -210,6 +245,8 @@ int SetDefaults(infileT *infiles, outfileT *outfiles, paramT *params){
   StrNCopy(params->tiledir,DEF_TILEDIR,MAXSTRLEN);
   params->assembleonly=DEF_ASSEMBLEONLY;
   params->rmtmptile=DEF_RMTMPTILE;
+  params->tilememory=DEF_TILEMEMORY;
+  params->tilemembudget=DEF_TILEMEMBUDGET;
   params->tileedgeweight=DEF_TILEEDGEWEIGHT;
 
   /* connected component parameters */
@@ -518,6 +555,18 @@ int CheckParams(infileT *infiles, outfileT *outfiles,
     throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
             "arcmaxflowconst must be positive");
   }
+  if(params->coarseinit){
+    if(params->ncoarselooksaz<1 || params->ncoarselooksrange<1){
+      fflush(NULL);
+      throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+              "Numbers of coarse initialization looks must be positive");
+    }
+    if(params->ncoarselooksaz==1 && params->ncoarselooksrange==1){
+      fflush(NULL);
+      throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+              "Coarse initialization requires more than one look");
+    }
+  }
   if((params->maxflow)<1){
     fflush(NULL);
     throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
@@ -696,6 +745,25 @@ int CheckParams(infileT *infiles, outfileT *outfiles,
         StrNCopy(params->tiledir,"",MAXSTRLEN);
       }
       params->rmtmptile=FALSE;     /* cowardly avoid removing tile dir input */
+      params->tilememory=FALSE;    /* tiles are read from tile dir input */
+    }
+    if(params->tilememory
+       && (strlen(outfiles->initfile) || strlen(outfiles->flowfile)
+           || strlen(outfiles->eifile) || strlen(outfiles->rowcostfile)
+           || strlen(outfiles->colcostfile) || strlen(outfiles->mstrowcostfile)
+           || strlen(outfiles->mstcolcostfile) || strlen(outfiles->mstcostsfile)
+           || strlen(outfiles->corrdumpfile) || strlen(outfiles->rawcorrdumpfile)
+           || strlen(outfiles->costoutfile))){
+      fflush(NULL);
+      warnings << pyre::journal::at(__HERE__)
+               << "WARNING: Per-tile output files requested--writing tile "
+               << "files to disk" << pyre::journal::endl;
+      params->tilememory=FALSE;
+    }
+    if(params->tilemembudget<0){
+      fflush(NULL);
+      throw isce3::except::InvalidArgument(ISCE_SRCINFO(),
+              "Tile memory budget must be nonnegative");
     }
     if(params->piecefirstrow!=DEF_PIECEFIRSTROW 
        || params->piecefirstcol!=DEF_PIECEFIRSTCOL
@@ -1029,6 +1097,12 @@ int ParseConfigLine(char *buf, const char *conffile, long nlines,
       }else{
         badparam=TRUE;
       }
+    }else if(!strcmp(str1,"COARSEINIT")){
+      badparam=SetBooleanSignedChar(&(params->coarseinit),str2);
+    }else if(!strcmp(str1,"NCOARSELOOKSAZ")){
+      badparam=StringToLong(str2,&(params->ncoarselooksaz));
+    }else if(!strcmp(str1,"NCOARSELOOKSRANGE")){
+      badparam=StringToLong(str2,&(params->ncoarselooksrange));
     }else if(!strcmp(str1,"ORBITRADIUS")){
       if(!(badparam=StringToDouble(str2,&(params->orbitradius)))){
         params->altitude=0;
@@ -1237,6 +1311,10 @@ int ParseConfigLine(char *buf, const char *conffile, long nlines,
     }else if(!strcmp(str1,"RMTMPTILE")){
       badparam=SetBooleanSignedChar(&(params->rmtmptile),str2);
       params->rmtileinit=params->rmtmptile;
+    }else if(!strcmp(str1,"TILEMEMORY")){
+      badparam=SetBooleanSignedChar(&(params->tilememory),str2);
+    }else if(!strcmp(str1,"TILEMEMBUDGET")){
+      badparam=StringToLong(str2,&(params->tilemembudget));
     }else if(!strcmp(str1,"MINCONNCOMPFRAC")){
       badparam=StringToDouble(str2,&(params->minconncompfrac));
     }else if(!strcmp(str1,"CONNCOMPTHRESH")){
@@ -1505,6 +1583,9 @@ int WriteConfigLogFile(infileT *infiles,
     }else if(params->initmethod==MCFINIT){
       fprintf(fp,"INITMETHOD  MCF\n");
     }
+    LogBoolParam(fp,"COARSEINIT",params->coarseinit);
+    fprintf(fp,"NCOARSELOOKSAZ  %ld\n",params->ncoarselooksaz);
+    fprintf(fp,"NCOARSELOOKSRANGE  %ld\n",params->ncoarselooksrange);
 
     /* file formats */
     fprintf(fp,"\n# File Formats\n");
@@ -1672,6 +1753,8 @@ int WriteConfigLogFile(infileT *infiles,
     fprintf(fp,"TILEEDGEWEIGHT  %.8f\n",params->tileedgeweight);
     fprintf(fp,"SCNDRYARCFLOWMAX  %ld\n",params->scndryarcflowmax);
     LogBoolParam(fp,"RMTMPTILE",params->rmtmptile);
+    LogBoolParam(fp,"TILEMEMORY",params->tilememory);
+    fprintf(fp,"TILEMEMBUDGET  %ld\n",params->tilemembudget);
     LogStringParam(fp,"DOTILEMASKFILE",infiles->dotilemaskfile);
     LogStringParam(fp,"TILEDIR",params->tiledir);
     LogBoolParam(fp,"ASSEMBLEONLY",params->assembleonly);
@@ -1844,6 +1927,12 @@ FILE *OpenOutputFile(const char *outfile, char *realoutfile){
   char path[MAXSTRLEN]={}, basename[MAXSTRLEN]={}, dumpfile[MAXSTRLEN]={};
   FILE *fp;
 
+  /* temporary tile files may be kept in memory */
+  if((fp=OpenMemoryTileFile(outfile,'w'))!=NULL){
+    StrNCopy(realoutfile,outfile,MAXSTRLEN);
+    return(fp);
+  }
+
   if((fp=fopen(outfile,"w"))==NULL){
 
     /* if we can't write to the out file, get the file name from the path */
@@ -1873,6 +1962,104 @@ FILE *OpenOutputFile(const char *outfile, char *realoutfile){
 }
 
 
+/* function: OpenInputFile()
+ * -------------------------
+ * Opens a file for reading, either from the in-memory tile file store 
+ * or from disk.  Returns NULL if the file cannot be opened.
+ */
+FILE *OpenInputFile(const char *infile){
+
+  FILE *fp;
+
+  if((fp=OpenMemoryTileFile(infile,'r'))!=NULL){
+    return(fp);
+  }
+  return(fopen(infile,"r"));
+
+}
+
+
+/* function: OpenMemoryTileFile()
+ * ------------------------------
+ * Opens a stream for a temporary tile file kept in memory.  Mode is 'w'
+ * to replace the file contents or 'r' to read them.  Returns NULL if
+ * the file is not managed by an in-memory store (or does not exist in
+ * it, when reading).
+ */
+static
+FILE *OpenMemoryTileFile(const char *filename, char mode){
+
+  FILE *fp;
+
+  auto store=FindMemoryTileStore(filename);
+  if(!store){
+    return(NULL);
+  }
+  std::lock_guard<std::mutex> lock(store->mutex);
+  if(mode=='w'){
+    auto& file=store->files[filename];
+    file=std::make_unique<memoryfileT>();
+    if((fp=open_memstream(&(file->buf),&(file->size)))==NULL){
+      fflush(NULL);
+      throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+              "Unable to allocate memory for tile file " +
+              std::string(filename));
+    }
+    return(fp);
+  }
+  auto it=store->files.find(filename);
+  if(it==store->files.end()){
+    return(NULL);
+  }
+
+  /* fmemopen() does not accept empty buffers */
+  if(!it->second->size){
+    return(fopen(NULLFILE,"r"));
+  }
+  return(fmemopen(it->second->buf,it->second->size,"r"));
+
+}
+
+
+/* function: FindMemoryTileStore()
+ * -------------------------------
+ * Returns the in-memory store of the run whose tile directory holds the
+ * file, or a null pointer if tile files in that directory are on disk.
+ */
+static
+std::shared_ptr<memorytilestoreT> FindMemoryTileStore(const char *filename){
+
+  const char *slash;
+
+  if((slash=strrchr(filename,'/'))==NULL){
+    return(nullptr);
+  }
+  std::lock_guard<std::mutex> lock(memorytilestoresmutex);
+  auto it=memorytilestores.find(std::string(filename,slash-filename));
+  if(it==memorytilestores.end()){
+    return(nullptr);
+  }
+  return(it->second.lock());
+
+}
+
+
+/* function: ~memorytilestoreT()
+ * -----------------------------
+ * Unregisters the tile directory of a store once its run is done with it,
+ * unless the name has since been taken by the store of another run.
+ */
+memorytilestoreT::~memorytilestoreT(){
+
+  std::lock_guard<std::mutex> lock(memorytilestoresmutex);
+  auto it=memorytilestores.find(tiledir);
+  if(it!=memorytilestores.end() && it->second.expired()){
+    memorytilestores.erase(it);
+  }
+
+}
+
+
 /* function: WriteAltLineFile()
  * ----------------------------
  * Writes magnitude and phase data from separate arrays to file.
@@ -2543,7 +2730,7 @@ int ReadAltLineFile(Array2D<float>* mag, Array2D<float>* phase, char *alfile,
   long filesize,row,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(alfile,"r"))==NULL){
+  if((fp=OpenInputFile(alfile))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(alfile));
@@ -2613,7 +2800,7 @@ int ReadAltLineFilePhase(Array2D<float>* phase, char *alfile,
   long filesize,row,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(alfile,"r"))==NULL){
+  if((fp=OpenInputFile(alfile))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(alfile));
@@ -2671,7 +2858,7 @@ int ReadComplexFile(Array2D<float>* mag, Array2D<float>* phase, char *rifile,
   long filesize,ncol,nrow,row,col,padlen;
 
   /* open the file */
-  if((fp=fopen(rifile,"r"))==NULL){
+  if((fp=OpenInputFile(rifile))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(rifile));
@@ -2748,7 +2935,7 @@ int ReadAltSampFile(Array2D<float>* arr1, Array2D<float>* arr2, char *infile,
   long filesize,row,col,nrow,ncol,padlen;
 
   /* open the file */
-  if((fp=fopen(infile,"r"))==NULL){
+  if((fp=OpenInputFile(infile))==NULL){
     fflush(NULL);
     throw isce3::except::RuntimeError(ISCE_SRCINFO(),
             "Can't open file " + std::string(infile));
@@ -2900,7 +3087,9 @@ int DumpIncrCostFiles(Array2D<incrcostT>& incrcosts, long iincrcostfile,
 /* function: MakeTileDir()
  * -----------------------
  * Create a temporary directory for tile files in directory of output file.  
- * Save directory name in buffer in paramT structure.
+ * Save directory name in buffer in paramT structure.  If tile files are
+ * kept in memory, the directory name is only used to identify them and
+ * the directory is not created.
  */
 int MakeTileDir(paramT *params, outfileT *outfiles){
 
@@ -2915,6 +3104,29 @@ int MakeTileDir(paramT *params, outfileT *outfiles){
     std::strcpy(params->tiledir,tiledir.c_str());
   }
 
+  /* keep tile files in memory without creating the directory if requested; */
+  /*   the directory name identifies the store of this run, so it is made */
+  /*   unique among the runs of this process */
+  params->tilestore.reset();
+  if(params->tilememory){
+    std::lock_guard<std::mutex> lock(memorytilestoresmutex);
+    auto tiledir=std::string(params->tiledir);
+    for(long n=1;memorytilestores.count(tiledir)
+          && !memorytilestores[tiledir].expired();n++){
+      tiledir=std::string(params->tiledir)+"_"+std::to_string(n);
+    }
+    if(tiledir.size()>=MAXSTRLEN){
+      fflush(NULL);
+      throw isce3::except::RuntimeError(ISCE_SRCINFO(),
+              "Tile directory name too long: " + tiledir);
+    }
+    StrNCopy(params->tiledir,tiledir.c_str(),MAXSTRLEN);
+    params->tilestore=std::make_shared<memorytilestoreT>();
+    params->tilestore->tiledir=tiledir;
+    memorytilestores[tiledir]=params->tilestore;
+    return(0);
+  }
+
   /* return if directory exists */
   /* this is a hack; tiledir could be file or could give other stat() error */
   /*   but if there is a problem, the error will be caught later */
@@ -2939,6 +3151,41 @@ int MakeTileDir(paramT *params, outfileT *outfiles){
 }
 
 
+/* function: RemoveTileDir()
+ * -------------------------
+ * Remove the temporary tile directory, or discard the in-memory tile
+ * files if tile files were kept in memory.
+ */
+int RemoveTileDir(paramT *params){
+
+  if(params->tilememory){
+    params->tilestore.reset();
+  }else{
+    rmdir(params->tiledir);
+  }
+  return(0);
+
+}
+
+
+/* function: RemoveTileFile()
+ * --------------------------
+ * Remove a temporary tile file from memory or from disk.
+ */
+int RemoveTileFile(const char *filename){
+
+  auto store=FindMemoryTileStore(filename);
+  if(store){
+    std::lock_guard<std::mutex> lock(store->mutex);
+    store->files.erase(filename);
+    return(0);
+  }
+  unlink(filename);
+  return(0);
+
+}
+
+
 /* function: SetTileInitOutfile()
  * ------------------------------
  * Set name of temporary tile-mode output assuming nominal output file
@@ -2977,7 +3224,7 @@ int SetTileInitOutfile(char *outfile, long pid){
 int ParseFilename(const char *filename, char *path, char *basename){
 
   char tempstring[MAXSTRLEN]={};
-  char *tempouttok;
+  char *tempouttok, *saveptr;
 
   /* make sure we have a nonzero filename */
   if(!strlen(filename)){
@@ -2995,10 +3242,10 @@ int ParseFilename(const char *filename, char *path, char *basename){
 
   /* parse the filename */
   StrNCopy(tempstring,filename,MAXSTRLEN);
-  tempouttok=strtok(tempstring,"/");
+  tempouttok=strtok_r(tempstring,"/",&saveptr);
   while(TRUE){
     StrNCopy(basename,tempouttok,MAXSTRLEN);
-    if((tempouttok=strtok(NULL,"/"))==NULL){
+    if((tempouttok=strtok_r(NULL,"/",&saveptr))==NULL){
       break;
     }
     strcat(path,basename);
@@ -23,11 +23,14 @@ namespace isce3::unwrap {
 /* static variables local this file */
 
 /* pointers to functions for tailoring network solver to specific topologies */
-static nodeT *(*NeighborNode)(nodeT *, long, long *, Array2D<nodeT>&, nodeT *, long *,
-                              long *, long *, long, long, boundaryT *,
-                              Array2D<nodesuppT>&);
-static void (*GetArc)(nodeT *, nodeT *, long *, long *, long *, long, long,
-                      Array2D<nodeT>&, Array2D<nodesuppT>&);
+/* (thread local since tiles may be unwrapped concurrently) */
+static thread_local nodeT *(*NeighborNode)(nodeT *, long, long *,
+                                           Array2D<nodeT>&, nodeT *, long *,
+                                           long *, long *, long, long,
+                                           boundaryT *, Array2D<nodesuppT>&);
+static thread_local void (*GetArc)(nodeT *, nodeT *, long *, long *, long *,
+                                   long, long, Array2D<nodeT>&,
+                                   Array2D<nodesuppT>&);
 
 /* static (local) function prototypes */
 static
@@ -15,6 +15,7 @@
 #include <unistd.h>
 
 #include <isce3/except/Error.h>
+#include <isce3/unwrap/ConnectedComponents.h>
 
 #include "snaphu.h"
 
@@ -664,13 +665,11 @@ int GrowConnCompsMask(Array2D<typename CostTag::Cost>& costs, Array2D<short>& fl
                       paramT *params, CostTag tag){
 
   long i, row, col, maxcol;
-  long arcrow, arccol, arcnum;
-  long regioncounter, regionsizeslen, *thisregionsize;
+  long arcrow, arccol;
+  long regioncounter;
   long costthresh, minsize, maxncomps, ntied, newnum;
   unsigned long outtypemax, outtypesize;
-  nodeT *source, *from, *to, *ground;
   void *outbufptr;
-  bucketT bkts[1]={};
   char realoutfile[MAXSTRLEN]={};
   FILE *conncompfp;
 
@@ -721,103 +720,25 @@ int GrowConnCompsMask(Array2D<typename CostTag::Cost>& costs, Array2D<short>& fl
   /* thicken the costs arrays; results stored in negcost field */
   ThickenCosts(incrcosts,nrow,ncol);
 
-  /* initialize nodes and buckets for region growing */
-  ground=NULL;
-  auto nodes=Array2D<nodeT>(nrow,ncol);
-  InitNodeNums(nrow,ncol,nodes,ground);
-  InitNodes(nrow,ncol,nodes,ground);
-  bkts->size=1;
-  bkts->minind=0;
-  bkts->maxind=0;
-  bkts->wrapped=FALSE;
-  bkts->bucketbase=Array1D<nodeT*>(1);
-  bkts->bucket=bkts->bucketbase.data();
-  bkts->bucket[0]=NULL;
-
-  /* initialize region variables */
+  /* label regions connected by arcs of zero thickened cost in parallel */
+  /* regions are numbered in raster order of their first pixel */
+  auto labels=Array2D<uint32_t>(nrow,ncol);
+  uint32_t nlabels=isce3::unwrap::labelConnectedComponents(
+      labels.data(),nrow,ncol,
+      [](size_t){ return true; },
+      [&](size_t k){ return incrcosts(nrow-1+k/ncol,k%ncol).negcost==0; },
+      [&](size_t k){ return incrcosts(k/ncol,k%ncol).negcost==0; });
+  std::vector<size_t> labelsizes=isce3::unwrap::componentSizes(
+      labels.data(),nrow*ncol,nlabels);
+
+  /* zero out regions that are too small and renumber the others */
+  std::vector<uint32_t> newlabels(nlabels+1,0);
   regioncounter=0;
-  regionsizeslen=INITARRSIZE;
-  auto regionsizes=Array1D<long>(regionsizeslen);
-  for(row=0;row<nrow;row++){
-    for(col=0;col<ncol;col++){
-      nodes(row,col).incost=-1;
-    }
-  }
-
-  /* loop over all nodes (pixels) to make sure each is in a group */
-  for(row=0;row<nrow;row++){
-    for(col=0;col<ncol;col++){
-
-      /* see if node is not in a group */
-      if(nodes(row,col).incost<0){
-
-        /* clear the buckets */
-        ClearBuckets(bkts);
-
-        /* make node source and put it in the first bucket */
-        source=&nodes(row,col);
-        source->next=NULL;
-        source->prev=NULL;
-        source->group=INBUCKET;
-        source->outcost=0;
-        bkts->bucket[0]=source;
-        bkts->curr=0;
-
-        /* increment the region counter */
-        if(++regioncounter>=regionsizeslen){
-          regionsizeslen+=INITARRSIZE;
-          regionsizes.conservativeResize(regionsizeslen);
-        }
-        thisregionsize=&regionsizes[regioncounter];
-
-        /* set up */
-        (*thisregionsize)=0;
-
-        /* loop to grow region */
-        while(TRUE){
-
-          /* set from node to closest node in circular bucket structure */
-          from=ClosestNode(bkts);
-          
-          /* break if we can't grow any more and the region is big enough */
-          if(from==NULL){
-            if(regionsizes[regioncounter]>=minsize){
-
-              /* no more nonregion nodes, and current region is big enough */
-              break;
-
-            }else{
-
-              /* no more nonregion nodes, but current region still too small */
-              /* zero out the region */
-              RenumberRegion(nodes,source,0,nrow,ncol);
-              regioncounter--;
-              break;
-
-            }
-          }
-
-          /* make from node a part of the current region */
-          from->incost=regioncounter;
-          (*thisregionsize)++;
-
-          /* scan from's neighbors */
-          arcnum=0;
-          while((to=RegionsNeighborNode(from,&arcnum,nodes,
-                                        &arcrow,&arccol,nrow,ncol))!=NULL){
-
-            /* see if to can be reached */
-            if(to->incost<0 && incrcosts(arcrow,arccol).negcost==0
-               && to->group!=INBUCKET){
-
-              /* update to node */
-              to->pred=from;
-              BucketInsert(to,0,bkts);
-
-            }
-          }
-        }
-      }
+  auto regionsizes=Array1D<long>(nlabels+1);
+  for(i=1;i<=(long )nlabels;i++){
+    if((long )labelsizes[i]>=minsize){
+      newlabels[i]=++regioncounter;
+      regionsizes[regioncounter]=labelsizes[i];
     }
   }
   verbose << pyre::journal::at(__HERE__)
@@ -846,36 +767,27 @@ int GrowConnCompsMask(Array2D<typename CostTag::Cost>& costs, Array2D<short>& fl
       i--;
     }
 
-    /* zero out regions that are too small */
-    newnum=-1;
-    for(row=0;row<nrow;row++){
-      for(col=0;col<ncol;col++){
-        i=nodes(row,col).incost;
-        if(i>0){
-          if(regionsizes[i]<minsize
-             || (regionsizes[i]==minsize && (ntied--)>0)){
+    /* zero out regions that are too small, in raster order */
+    newnum=0;
+    for(i=1;i<=(long )nlabels;i++){
+      long region=newlabels[i];
+      if(region>0){
+        if(regionsizes[region]<minsize
+           || (regionsizes[region]==minsize && (ntied--)>0)){
 
-            /* region too small, so zero it out */
-            RenumberRegion(nodes,&(nodes(row,col)),0,nrow,ncol);
+          /* region too small, so zero it out */
+          newlabels[i]=0;
 
-          }else{
+        }else{
 
-            /* keep region, assign it new region number */
-            /* temporarily assign negative of new number to avoid collisions */
-            RenumberRegion(nodes,&(nodes(row,col)),newnum--,nrow,ncol);
+          /* keep region, assign it new region number */
+          newlabels[i]=++newnum;
 
-          }
         }
       }
     }
-
-    /* flip temporary negative region numbers so they are positive */
-    for(row=0;row<nrow;row++){
-      for(col=0;col<ncol;col++){
-        nodes(row,col).incost=-nodes(row,col).incost;
-      }
-    }
   }
+  isce3::unwrap::relabelComponents(labels.data(),nrow*ncol,newlabels);
 
   /* write connected components as appropriate data type */
   auto ucharbuf=Array1D<unsigned char>(ncol);
@@ -900,12 +812,12 @@ int GrowConnCompsMask(Array2D<typename CostTag::Cost>& costs, Array2D<short>& fl
   conncompfp=OpenOutputFile(outfiles->conncompfile,realoutfile);
   for(row=0;row<nrow;row++){
     for(col=0;col<ncol;col++){
-      if(nodes(row,col).incost>outtypemax){
+      if(labels(row,col)>outtypemax){
         fflush(NULL);
         throw isce3::except::RuntimeError(ISCE_SRCINFO(),
                 "Number of connected components too large for output type");
       }
-      uintbuf[col]=(unsigned int)(nodes(row,col).incost);
+      uintbuf[col]=(unsigned int)(labels(row,col));
     }
     if(params->conncompouttype==CONNCOMPOUTTYPEUCHAR){
       for(col=0;col<ncol;col++){
@@ -1472,10 +1384,10 @@ int AssembleTiles(outfileT *outfiles, paramT *params,
       for(tilecol=0;tilecol<ntilecol;tilecol++){
         auto filename=std::string(params->tiledir)+"/"
           +LOGFILEROOT+std::to_string(tilerow)+"_"+std::to_string(tilecol);
-        unlink(filename.c_str());
+        RemoveTileFile(filename.c_str());
       }
     }
-    rmdir(params->tiledir);
+    RemoveTileDir(params);
   }
 
   /* Give notice about increasing overlap if there are edge artifacts */
@@ -1720,7 +1632,7 @@ int ReadEdgesAboveAndBelow(long tilerow, long tilecol, long nlines,
 
     /* remove temporary tile cost file unless told to save it */
     if(params->rmtmptile && !strlen(outfiles->costoutfile)){
-      unlink(outfilesabove->costoutfile);
+      RemoveTileFile(outfilesabove->costoutfile);
     }
   }
 
@@ -1766,7 +1678,7 @@ int ReadEdgesAboveAndBelow(long tilerow, long tilecol, long nlines,
     if(params->rmtmptile && !strlen(outfiles->costoutfile)){
       SetupTile(nlines,linelen,params,tileparams,outfiles,outfilesbelow,
                 tilerow,tilecol);
-      unlink(outfilesbelow->costoutfile);
+      RemoveTileFile(outfilesbelow->costoutfile);
     }
   }
 
@@ -3447,8 +3359,8 @@ int IntegrateSecondaryFlows(long linelen, long nlines, Array2D<nodeT>& /*scndryn
 
       /* remove temporary files unless told so save them */
       if(params->rmtmptile){
-        unlink(readtileoutfiles->outfile);
-        unlink(readfile);
+        RemoveTileFile(readtileoutfiles->outfile);
+        RemoveTileFile(readfile);
       }
 
       /* zero out primary flow array */
@@ -3904,7 +3816,7 @@ int AssembleTileConnComps(long linelen, long nlines,
           
           /* remove temporary files unless told so save them */
           if(params->rmtmptile){
-            unlink(readtileoutfiles->conncompfile);
+            RemoveTileFile(readtileoutfiles->conncompfile);
           }
 
         }
@@ -8,6 +8,7 @@
 
 *************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 #include <csignal>
@@ -30,6 +31,11 @@ static
 double ModDiff(double f1, double f2);
 static
 int DiffNCycle(double f1, double f2);
+static
+double CoarsePixelCenter(long coarseind, long n, long nlooks);
+static
+int CoarseInterpWeights(long ind, long n, long nlooks, long ncoarse,
+                        long *ind0ptr, long *ind1ptr, double *fracptr);
 
 
 /* function: IsTrue()
@@ -162,6 +168,7 @@ int CalcWrappedRangeDiffs(Array2D<float>& dpsi,
                           long nrow, long ncol){
   long row, col;
 
+  #pragma omp parallel for schedule(static) private(col)
   for(row=0;row<nrow;row++){
     for(col=0;col<ncol-1;col++){
       dpsi(row,col)=(wrappedphase(row,col+1)-wrappedphase(row,col))/TWOPI;
@@ -197,6 +204,7 @@ int CalcWrappedAzDiffs(Array2D<float>& dpsi,
                        long kperpdpsi, long kpardpsi, long nrow, long ncol){
   long row, col;
 
+  #pragma omp parallel for schedule(static) private(col)
   for(row=0;row<nrow-1;row++){
     for(col=0;col<ncol;col++){
       dpsi(row,col)=(wrappedphase(row,col)-wrappedphase(row+1,col))/TWOPI;
@@ -323,6 +331,185 @@ int CalcFlow(Array2D<float>& phase, Array2D<short>* flowsptr, long nrow, long nc
 }
 
 
+/* function: MultilookInterferogram()
+ * ----------------------------------
+ * Averages the complex interferogram over windows of nlooksrow by
+ * nlookscol pixels.  Windows at the far edges may be partial.  The
+ * coarse magnitude is the mean of the magnitudes in each window, so that
+ * windows in which all pixels are masked keep zero magnitude.  The
+ * coarse correlation is the mean of the passed correlation if it is
+ * given, otherwise it is estimated as the magnitude of the mean complex
+ * interferogram normalized by the mean magnitude.  Allocates memory for
+ * the output arrays.
+ */
+int MultilookInterferogram(Array2D<float>& mag, Array2D<float>& wrappedphase,
+                           Array2D<float>& corr, Array2D<float>* coarsemagptr,
+                           Array2D<float>* coarsephaseptr,
+                           Array2D<float>* coarsecorrptr, long nrow, long ncol,
+                           long nlooksrow, long nlookscol){
+
+  long ncoarserow, ncoarsecol;
+
+  /* get memory for output arrays */
+  ncoarserow=(nrow+nlooksrow-1)/nlooksrow;
+  ncoarsecol=(ncol+nlookscol-1)/nlookscol;
+  *coarsemagptr=Array2D<float>(ncoarserow,ncoarsecol);
+  *coarsephaseptr=Array2D<float>(ncoarserow,ncoarsecol);
+  *coarsecorrptr=Array2D<float>(ncoarserow,ncoarsecol);
+
+  /* loop over coarse pixels */
+  #pragma omp parallel for schedule(static)
+  for(long coarserow=0;coarserow<ncoarserow;coarserow++){
+    for(long coarsecol=0;coarsecol<ncoarsecol;coarsecol++){
+
+      /* sum over window */
+      double sumreal=0, sumimag=0, summag=0, sumcorr=0;
+      long rowend=LMin((coarserow+1)*nlooksrow,nrow);
+      long colend=LMin((coarsecol+1)*nlookscol,ncol);
+      long n=0;
+      for(long row=coarserow*nlooksrow;row<rowend;row++){
+        for(long col=coarsecol*nlookscol;col<colend;col++){
+          sumreal+=mag(row,col)*cos(wrappedphase(row,col));
+          sumimag+=mag(row,col)*sin(wrappedphase(row,col));
+          summag+=mag(row,col);
+          if(corr.size()){
+            sumcorr+=corr(row,col);
+          }
+          n++;
+        }
+      }
+
+      /* set coarse pixel */
+      (*coarsemagptr)(coarserow,coarsecol)=summag/n;
+      (*coarsephaseptr)(coarserow,coarsecol)=atan2(sumimag,sumreal);
+      if(corr.size()){
+        (*coarsecorrptr)(coarserow,coarsecol)=sumcorr/n;
+      }else if(summag>0){
+        (*coarsecorrptr)(coarserow,coarsecol)=sqrt(sumreal*sumreal
+                                                   +sumimag*sumimag)/summag;
+      }else{
+        (*coarsecorrptr)(coarserow,coarsecol)=0;
+      }
+    }
+  }
+
+  /* done */
+  return(0);
+
+}
+
+
+/* function: UpsampleUnwrappedPhase()
+ * ----------------------------------
+ * Bilinearly interpolates an unwrapped phase array computed from an
+ * interferogram multilooked by MultilookInterferogram() back to the full
+ * resolution grid, then adds to each wrapped phase value the integer
+ * number of cycles that brings it closest to the interpolated value.
+ * Each coarse pixel is placed at the center of the pixels averaged into
+ * it, so partial windows at the far edges are placed at their own
+ * centers, and the coarse solution is held constant beyond the outermost
+ * centers.  The result is an unwrapped phase array congruent with the
+ * wrapped phase, from which flows may be computed with CalcFlow().
+ * Allocates memory for the output array.
+ */
+int UpsampleUnwrappedPhase(Array2D<float>& coarseunwrappedphase,
+                           Array2D<float>& wrappedphase,
+                           Array2D<float>* unwrappedphaseptr,
+                           long nrow, long ncol, long nlooksrow, long nlookscol){
+
+  long ncoarserow, ncoarsecol;
+
+  /* get memory for output array */
+  ncoarserow=coarseunwrappedphase.rows();
+  ncoarsecol=coarseunwrappedphase.cols();
+  *unwrappedphaseptr=Array2D<float>(nrow,ncol);
+
+  /* coarse columns bracketing each full resolution column */
+  auto col0=Array1D<long>(ncol);
+  auto col1=Array1D<long>(ncol);
+  auto colfrac=Array1D<double>(ncol);
+  for(long col=0;col<ncol;col++){
+    CoarseInterpWeights(col,ncol,nlookscol,ncoarsecol,
+                        &col0[col],&col1[col],&colfrac[col]);
+  }
+
+  /* loop over full resolution pixels */
+  #pragma omp parallel for schedule(static)
+  for(long row=0;row<nrow;row++){
+
+    /* coarse rows bracketing pixel */
+    long row0, row1;
+    double rowfrac;
+    CoarseInterpWeights(row,nrow,nlooksrow,ncoarserow,&row0,&row1,&rowfrac);
+
+    for(long col=0;col<ncol;col++){
+
+      /* interpolate coarse solution */
+      double est=(1-rowfrac)*((1-colfrac[col])
+                              *coarseunwrappedphase(row0,col0[col])
+                              +colfrac[col]
+                              *coarseunwrappedphase(row0,col1[col]))
+        +rowfrac*((1-colfrac[col])*coarseunwrappedphase(row1,col0[col])
+                  +colfrac[col]*coarseunwrappedphase(row1,col1[col]));
+
+      /* add integer cycles to wrapped phase to get closest to estimate */
+      (*unwrappedphaseptr)(row,col)=wrappedphase(row,col)
+        +TWOPI*LRound((est-wrappedphase(row,col))/TWOPI);
+    }
+  }
+
+  /* done */
+  return(0);
+
+}
+
+
+/* function: CoarsePixelCenter()
+ * -----------------------------
+ * Returns the full resolution index, along one dimension of n pixels, of
+ * the center of the window of nlooks pixels averaged into a coarse pixel
+ * by MultilookInterferogram().  The last window may be partial.
+ */
+static
+double CoarsePixelCenter(long coarseind, long n, long nlooks){
+
+  return((coarseind*nlooks+LMin((coarseind+1)*nlooks,n)-1)/2.0);
+
+}
+
+
+/* function: CoarseInterpWeights()
+ * -------------------------------
+ * Finds the coarse pixels ind0 and ind1 whose centers bracket the full
+ * resolution index ind along one dimension, and the fraction of the way
+ * from the center of ind0 to the center of ind1 at which ind lies.  The
+ * fraction is clipped to [0,1] outside the outermost centers.
+ */
+static
+int CoarseInterpWeights(long ind, long n, long nlooks, long ncoarse,
+                        long *ind0ptr, long *ind1ptr, double *fracptr){
+
+  double center0, center1;
+
+  /* single coarse pixel */
+  if(ncoarse<2){
+    *ind0ptr=0;
+    *ind1ptr=0;
+    *fracptr=0;
+    return(0);
+  }
+
+  /* all centers but the last are nlooks apart */
+  *ind0ptr=LClip((long )floor((ind-(nlooks-1)/2.0)/nlooks),0,ncoarse-2);
+  *ind1ptr=*ind0ptr+1;
+  center0=CoarsePixelCenter(*ind0ptr,n,nlooks);
+  center1=CoarsePixelCenter(*ind1ptr,n,nlooks);
+  *fracptr=std::min(std::max((ind-center0)/(center1-center0),0.0),1.0);
+  return(0);
+
+}
+
+
 /* function: IntegratePhase()
  * --------------------------
  * This function takes row and column flow information and integrates
@@ -660,6 +847,9 @@ int Despeckle(Array2D<float>& mag, Array2D<float>* ei, long nrow, long ncol){
 
 
   /* do the filtering */
+  /* pixels are filtered independently, so bands of rows run in parallel */
+  #pragma omp parallel for schedule(static) \
+    private(ratio,ratiomax,wfull,wstick,w,col,i,j,k,Irow,Icol)
   for(row=0;row<nrow;row++){
     Irow=row+ARMLEN;
     for(col=0;col<ncol;col++){
@@ -803,6 +993,8 @@ int BoxCarAvg(Array2D<float>& avgarr, Array2D<float>& padarr,
   double window;
 
   /* loop over all rows */
+  /* rows are independent, so bands of rows are averaged in parallel */
+  #pragma omp parallel for schedule(static) private(i,col,window)
   for(row=0;row<nrow;row++){
 
     /* calculate first cell */
@@ -826,6 +1018,7 @@ int BoxCarAvg(Array2D<float>& avgarr, Array2D<float>& padarr,
 
   /* normalize */
   n=krow*kcol;
+  #pragma omp parallel for schedule(static) private(col)
   for(row=0;row<nrow;row++){
     for(col=0;col<ncol;col++){
       avgarr(row,col)/=n;
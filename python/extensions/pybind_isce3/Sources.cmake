@@ -40,6 +40,7 @@ geocode/GeocodeSlc.cpp
 geometry/boundingbox.cpp
 geometry/DEMInterpolator.cpp
 geocode/GeocodeCov.cpp
+geocode/GeocodePlan.cpp
 geocode/GeocodePolygon.cpp
 geometry/geometry.cpp
 geometry/geo2rdr.cpp
@@ -52,6 +53,7 @@ geogrid/relocateRaster.cpp
 geogrid/geogrid.cpp
 geometry/lookIncFromSr.cpp
 image/image.cpp
+image/OffsetModel.cpp
 image/ResampSlc.cpp
 io/gdal/Dataset.cpp
 io/gdal/GDALAccess.cpp
@@ -61,6 +63,8 @@ io/gdal/Raster.cpp
 io/Raster.cpp
 io/serialization.cpp
 io/io.cpp
+matchtemplate/matchtemplate.cpp
+matchtemplate/pycpuampcor.cpp
 math/math.cpp
 math/Stats.cpp
 polsar/symmetrize.cpp
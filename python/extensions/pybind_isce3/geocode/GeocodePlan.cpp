@@ -0,0 +1,146 @@
+#include "GeocodePlan.h"
+
+#include <limits>
+
+#include <pybind11/stl.h>
+
+#include <isce3/container/RadarGeometry.h>
+#include <isce3/core/Constants.h>
+#include <isce3/geometry/detail/Geo2Rdr.h>
+#include <isce3/io/Raster.h>
+#include <isce3/product/GeoGridParameters.h>
+
+namespace py = pybind11;
+
+using isce3::geocode::GeocodePlan;
+
+void addbinding(pybind11::class_<GeocodePlan>& pyGeocodePlan)
+{
+    const isce3::geometry::detail::Geo2RdrParams defaults;
+    pyGeocodePlan
+            .def(py::init<const isce3::product::GeoGridParameters&,
+                         const isce3::container::RadarGeometry&,
+                         const isce3::io::Raster&, const size_t,
+                         const isce3::core::dataInterpMethod,
+                         const isce3::core::dataInterpMethod, const double,
+                         const int, const double, const float, const int>(),
+                    py::arg("geogrid_params"), py::arg("radar_geometry"),
+                    py::arg("dem_raster"), py::arg("lines_per_block") = 1000,
+                    py::arg("data_interp_method") =
+                            isce3::core::BILINEAR_METHOD,
+                    py::arg("dem_interp_method") =
+                            isce3::core::BIQUINTIC_METHOD,
+                    py::arg("threshold") = defaults.threshold,
+                    py::arg("maxiter") = defaults.maxiter,
+                    py::arg("delta_range") = defaults.delta_range,
+                    py::arg("invalid_value") =
+                            std::numeric_limits<float>::quiet_NaN(),
+                    py::arg("interp_margin") = 5,
+                    R"(
+            Create geocode plan shared by rasters with a common radar grid
+            and geogrid.
+
+            Parameters
+            ----------
+            geogrid_params: GeoGridParameters
+                Geogrid defining output product
+            radar_geometry: RadarGeometry
+                Radar grid describing input rasters
+            dem_raster: Raster
+                DEM used to calculate radar grid indices
+            lines_per_block: int
+                Number of lines to be processed
+                Default 1000
+            data_interp_method: enum
+                Default interpolation method used by data interpolator
+            dem_interp_method: enum
+                Interpolation method used by DEM interpolator
+            threshold: double
+                Convergence threshold for geo2rdr
+            maxiter: int
+                Maximum iterations for geo2rdr
+            delta_range: double
+                Step size for numerical gradient for geo2rdr
+            invalid_value: float
+                Default value assigned to invalid geogrid pixels. NaN is
+                mapped to the maximum value of unsigned integer rasters.
+            interp_margin: int
+                Margin (in radar pixels) kept around the radar block and
+                required between a valid pixel and the border of the radar
+                block. Raised to the half-width of the kernel of
+                data_interp_method; rasters geocoded with wider kernels are
+                rejected.
+            )")
+            .def("set_block_radar_coord_grid",
+                    &GeocodePlan::setBlockRdrCoordGrid,
+                    py::arg("block_number"),
+                    R"(
+            Solve geo2rdr for a given block number and store the radar grid
+            indices and interpolation weights of its geogrid pixels.
+
+            Parameters
+            ----------
+            block_number: int
+                Index of block where radar grid coordinates are calculated
+                and set.
+            )")
+            .def("geocode_raster_block",
+                    py::overload_cast<isce3::io::Raster&, isce3::io::Raster&,
+                            isce3::core::dataInterpMethod, float>(
+                            &GeocodePlan::geocodeRasterBlock),
+                    py::arg("output_raster"), py::arg("input_raster"),
+                    py::arg("interp_method"), py::arg("invalid_value"),
+                    R"(
+            Geocode all bands of a raster over the block last set with
+            set_block_radar_coord_grid.
+
+            Parameters
+            ----------
+            output_raster: io::Raster
+                Geocoded raster
+            input_raster: io::Raster
+                Raster to be geocoded
+            interp_method: enum
+                Data interpolation method
+            invalid_value: float
+                Value assigned to invalid geogrid pixels. NaN is mapped to
+                the maximum value of unsigned integer rasters.
+            )")
+            .def("geocode_raster_block",
+                    py::overload_cast<isce3::io::Raster&, isce3::io::Raster&,
+                            isce3::core::dataInterpMethod>(
+                            &GeocodePlan::geocodeRasterBlock),
+                    py::arg("output_raster"), py::arg("input_raster"),
+                    py::arg("interp_method"))
+            .def("geocode_raster_block",
+                    py::overload_cast<isce3::io::Raster&, isce3::io::Raster&>(
+                            &GeocodePlan::geocodeRasterBlock),
+                    py::arg("output_raster"), py::arg("input_raster"))
+            .def("geocode_rasters", &GeocodePlan::geocodeRasters,
+                    py::arg("output_rasters"), py::arg("input_rasters"),
+                    py::arg("interp_methods") =
+                            std::vector<isce3::core::dataInterpMethod> {},
+                    py::arg("invalid_values") = std::vector<float> {},
+                    R"(
+            Geocode rasters with a shared geogrid in a single pass. The
+            geometry of each block is solved once and applied to all rasters.
+
+            Parameters
+            ----------
+            output_rasters: list(io::Raster)
+                List of geocoded rasters.
+            input_rasters: list(io::Raster)
+                List of rasters to be geocoded.
+            interp_methods: list(enum)
+                Data interpolation method of each raster. If empty, the
+                default data interpolation method is used for all rasters.
+            invalid_values: list(float)
+                Invalid value of each raster. If empty, the default invalid
+                value is used for all rasters.
+            )")
+            .def_property_readonly("n_blocks", &GeocodePlan::numBlocks)
+            .def_property_readonly(
+                    "lines_per_block", &GeocodePlan::linesPerBlock)
+            .def_property_readonly(
+                    "interp_margin", &GeocodePlan::interpMargin);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <isce3/geocode/GeocodePlan.h>
+#include <pybind11/pybind11.h>
+
+void addbinding(pybind11::class_<isce3::geocode::GeocodePlan>&);
@@ -11,6 +11,7 @@
 
 #include <pybind11/complex.h>
 #include <pybind11/stl.h>
+#include <functional>
 #include <vector>
 
 namespace py = pybind11;
@@ -158,6 +159,78 @@ void addbinding_geocodeslc(py::module & m)
         invalid_value: complex
             invalid pixel fill value
         )");
+    m.def("geocode_slc", py::overload_cast<
+            std::vector<std::reference_wrapper<isce3::io::Raster>>,
+            std::vector<std::reference_wrapper<isce3::io::Raster>>,
+            isce3::io::Raster &,
+            const isce3::product::RadarGridParameters &,
+            const isce3::product::GeoGridParameters &,
+            const isce3::core::Orbit &,
+            const isce3::core::LUT2d<double> &,
+            const isce3::core::LUT2d<double> &,
+            const isce3::core::Ellipsoid &,
+            const double &, const int &,
+            const size_t &,
+            const bool,
+            const AzRgFunc &,
+            const AzRgFunc &,
+            const std::complex<float>>(&isce3::geocode::geocodeSlc<AzRgFunc>),
+        py::arg("output_rasters"),
+        py::arg("input_rasters"),
+        py::arg("dem_raster"),
+        py::arg("radargrid"),
+        py::arg("geogrid"),
+        py::arg("orbit"),
+        py::arg("native_doppler"),
+        py::arg("image_grid_doppler"),
+        py::arg("ellipsoid"),
+        py::arg("threshold_geo2rdr") = 1.0e-9,
+        py::arg("numiter_geo2rdr") = 25,
+        py::arg("lines_per_block") = 1000,
+        py::arg("flatten") = true,
+        py::arg("azimuth_carrier") = AzRgFunc(),
+        py::arg("range_carrier") = AzRgFunc(),
+        py::arg("invalid_value") =
+            std::complex<float>(std::numeric_limits<float>::quiet_NaN(),
+                                std::numeric_limits<float>::quiet_NaN()),
+        R"(
+        Geocode several SLCs sharing a radar grid, e.g. all the polarizations
+        of a frequency. The geometry, interpolation weights and carrier phases
+        of each block are computed once and applied to all rasters.
+
+        Parameters
+        ----------
+        output_rasters: list(Raster)
+            Output rasters containing geocoded SLCs
+        input_rasters: list(Raster)
+            Input rasters of the SLCs in radar coordinates
+        demRaster: Raster
+            Raster of the DEM
+        radargrid: RadarGridParameters
+            Radar grid parameters of input SLC rasters
+        geogrid: GeoGridParameters
+            Geo grid parameters of output rasters
+        native_doppler: LUT2d
+            2D LUT doppler of the SLC image
+        image_grid_doppler: LUT2d
+            2d LUT doppler of the image grid
+        ellipsoid: Ellipsoid
+            Ellipsoid object
+        threshold_geo2rdr: float
+            Threshold for geo2rdr computations
+        numiter_geo2rdr: int
+            Maximum number of iterations for geo2rdr convergence
+        lines_per_block: int
+            Number of lines per block
+        flatten: bool
+            Flag to flatten the geocoded SLC
+        azimuth_carrier: [LUT2d, Poly2d]
+            Azimuth carrier phase of the SLC data, in radians, as a function of azimuth and range
+        range_carrier: [LUT2d, Poly2d]
+            Range carrier phase of the SLC data, in radians, as a function of azimuth and range
+        invalid_value: complex
+            invalid pixel fill value
+        )");
 }
 
 template void addbinding_geocodeslc<isce3::core::LUT2d<double>>(py::module & m);
@@ -1,6 +1,7 @@
 #include "geocode.h"
 
 #include "GeocodeCov.h"
+#include "GeocodePlan.h"
 #include "GeocodePolygon.h"
 #include "GeocodeSlc.h"
 
@@ -23,6 +24,9 @@ void addsubmodule_geocode(py::module & m)
     py::class_<isce3::geocode::Geocode<std::complex<double>>>
         pyGeocodeCFloat64(geocode, "GeocodeCFloat64");
 
+    py::class_<isce3::geocode::GeocodePlan>
+        pyGeocodePlan(geocode, "GeocodePlan");
+
     py::class_<isce3::geocode::GeocodePolygon<float>>
         pyGeocodePolygonFloat32(geocode, "GeocodePolygonFloat32");
     py::class_<isce3::geocode::GeocodePolygon<double>>
@@ -44,6 +48,8 @@ void addsubmodule_geocode(py::module & m)
     addbinding(pyGeocodeCFloat32);
     addbinding(pyGeocodeCFloat64);
 
+    addbinding(pyGeocodePlan);
+
     addbinding(pyGeocodePolygonFloat32);
     addbinding(pyGeocodePolygonFloat64);
     addbinding(pyGeocodePolygonCFloat32);
@@ -1,5 +1,6 @@
 #include "DEMInterpolator.h"
 
+#include <limits>
 #include <memory>
 #include <pybind11/eigen.h>
 #include <stdexcept>
@@ -49,6 +50,29 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                     py::arg("raster"), py::arg("min_x"), py::arg("max_x"),
                     py::arg("min_y"), py::arg("max_y"), py::arg("raster_band") = 1)
 
+            .def("compute_min_max_mean_height",
+                    [](const DEMInterp& self, double min_x, double max_x,
+                            double min_y, double max_y) {
+                        float min_h, max_h, mean_h;
+                        self.computeHeightStats(min_h, max_h, mean_h, min_x,
+                                max_x, min_y, max_y);
+                        return py::make_tuple(min_h, max_h, mean_h);
+                    },
+                    R"(
+    Compute min, max and mean height over a window in native DEM coordinates.
+
+    The window is clipped to the loaded DEM. If no DEM is loaded the
+    reference height is returned for all three values.
+    )",
+                    py::arg("min_x") = -std::numeric_limits<double>::infinity(),
+                    py::arg("max_x") = std::numeric_limits<double>::infinity(),
+                    py::arg("min_y") = -std::numeric_limits<double>::infinity(),
+                    py::arg("max_y") = std::numeric_limits<double>::infinity())
+
+            .def("update_height_stats", &DEMInterp::updateHeightStats,
+                    "Rebuild the min/max/mean height statistics after "
+                    "modifying the DEM heights")
+
             .def("interpolate_lonlat", &DEMInterp::interpolateLonLat)
             .def("interpolate_xy", &DEMInterp::interpolateXY)
 
@@ -60,6 +84,16 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                     py::overload_cast<>(&DEMInterp::interpMethod, py::const_),
                     py::overload_cast<isce3::core::dataInterpMethod>(
                             &DEMInterp::interpMethod))
+            .def_property("height_storage",
+                    py::overload_cast<>(&DEMInterp::heightStorage, py::const_),
+                    py::overload_cast<isce3::geometry::HeightStorage>(
+                            &DEMInterp::heightStorage),
+                    R"(
+    Storage format of the DEM heights.
+
+    INT16 and FLOAT16 halve the memory held by the DEM at the cost of
+    quantizing the heights. Setting it re-encodes a DEM already loaded.
+    )")
 
             // Define all these as readonly even though writable in C++ API.
             // Probably better to just convert your data to a GDAL format than
@@ -71,6 +105,11 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                             throw std::out_of_range(
                                     "Tried to access DEM data but size=0");
                         }
+                        if (self.data() == nullptr) {
+                            throw std::runtime_error(
+                                    "DEM heights are stored quantized; use "
+                                    "heights() for a decoded copy");
+                        }
                         using namespace Eigen;
                         using MatF = Eigen::Matrix<float, Dynamic, Dynamic,
                                 RowMajor>;
@@ -79,6 +118,15 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
                         return mat;
                     },
                     py::return_value_policy::reference_internal)
+            .def("heights",
+                    [](const DEMInterp& self) {
+                        using namespace Eigen;
+                        using MatF = Eigen::Matrix<float, Dynamic, Dynamic,
+                                RowMajor>;
+                        return MatF(self.heights().matrix());
+                    },
+                    "Copy of the loaded DEM heights, decoded if they are "
+                    "stored quantized")
             .def_property_readonly("x_start",
                     py::overload_cast<>(&DEMInterp::xStart, py::const_))
             .def_property_readonly("y_start",
@@ -94,3 +142,11 @@ void addbinding(pybind11::class_<DEMInterp>& pyDEMInterpolator)
             .def_property_readonly("epsg_code",
                     py::overload_cast<>(&DEMInterp::epsgCode, py::const_));
 }
+
+void addbinding(pybind11::enum_<isce3::geometry::HeightStorage>& pyHeightStorage)
+{
+    pyHeightStorage
+            .value("FLOAT32", isce3::geometry::HeightStorage::Float32)
+            .value("INT16", isce3::geometry::HeightStorage::Int16)
+            .value("FLOAT16", isce3::geometry::HeightStorage::Float16);
+}
@@ -4,3 +4,4 @@
 #include <pybind11/pybind11.h>
 
 void addbinding(pybind11::class_<isce3::geometry::DEMInterpolator>&);
+void addbinding(pybind11::enum_<isce3::geometry::HeightStorage>&);
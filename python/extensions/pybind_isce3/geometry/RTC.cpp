@@ -3,6 +3,7 @@
 #include <isce3/io/Raster.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Orbit.h>
+#include <isce3/geometry/RTCAreaCache.h>
 #include <isce3/geometry/detail/Geo2Rdr.h>
 #include <isce3/product/RadarGridParameters.h>
 
@@ -314,3 +315,35 @@ void addbinding_compute_rtc_bbox(pybind11::module& m)
                  Step size used for computing Doppler derivative
              )");
 }
+
+void addbinding_rtc_area_cache(pybind11::module& m)
+{
+    m.def("set_rtc_area_cache_memory_budget",
+            &isce3::geometry::setRtcAreaCacheMemoryBudget, py::arg("nbytes"),
+            R"(
+            Set the memory budget (in bytes) of the in-memory RTC area cache.
+            Least-recently used entries are evicted when the budget is
+            exceeded. A budget of zero (default) disables the in-memory
+            cache.
+            )")
+            .def("get_rtc_area_cache_memory_budget",
+                    &isce3::geometry::getRtcAreaCacheMemoryBudget,
+                    "Get the memory budget (in bytes) of the in-memory RTC "
+                    "area cache")
+            .def("set_rtc_area_cache_directory",
+                    &isce3::geometry::setRtcAreaCacheDirectory,
+                    py::arg("path"), R"(
+            Set the directory of the on-disk RTC area cache. An empty path
+            disables the on-disk cache.
+            )")
+            .def("get_rtc_area_cache_directory",
+                    &isce3::geometry::getRtcAreaCacheDirectory,
+                    "Get the directory of the on-disk RTC area cache")
+            .def("clear_rtc_area_cache", &isce3::geometry::clearRtcAreaCache,
+                    "Drop all entries of the in-memory RTC area cache and "
+                    "reset its hit count")
+            .def("get_rtc_area_cache_hit_count",
+                    &isce3::geometry::getRtcAreaCacheHitCount,
+                    "Number of RTC areas served from the cache since it was "
+                    "last cleared");
+}
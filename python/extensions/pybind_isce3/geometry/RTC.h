@@ -18,3 +18,4 @@ void addbinding(pybind11::enum_<rtcAreaMode> & pyRtcAreaMode);
 void addbinding_apply_rtc(pybind11::module& m);
 void addbinding_compute_rtc(pybind11::module& m);
 void addbinding_compute_rtc_bbox(pybind11::module& m);
+void addbinding_rtc_area_cache(pybind11::module& m);
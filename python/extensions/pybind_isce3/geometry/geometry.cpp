@@ -33,6 +33,8 @@ void addsubmodule_geometry(py::module & m)
         pyRtcAlgorithm(geometry, "RtcAlgorithm");
     py::enum_<isce3::geometry::rtcAreaMode>
         pyRtcAreaMode(geometry, "RtcAreaMode");
+    py::enum_<isce3::geometry::HeightStorage>
+        pyHeightStorage(geometry, "HeightStorage");
 
     // add bindings
     addbinding(pyDEMInterpolator);
@@ -42,10 +44,12 @@ void addsubmodule_geometry(py::module & m)
     addbinding(pyOutputTerrainRadiometry);
     addbinding(pyRtcAlgorithm);
     addbinding(pyRtcAreaMode);
+    addbinding(pyHeightStorage);
 
     addbinding_apply_rtc(geometry);
     addbinding_compute_rtc(geometry);
     addbinding_compute_rtc_bbox(geometry);
+    addbinding_rtc_area_cache(geometry);
     addbinding_geo2rdr(geometry);
     addbinding_rdr2geo(geometry);
     addbinding_boundingbox(geometry);
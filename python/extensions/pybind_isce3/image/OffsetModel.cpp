@@ -0,0 +1,34 @@
+#include "OffsetModel.h"
+
+#include <isce3/core/LUT2d.h>
+#include <isce3/core/Poly2d.h>
+
+using isce3::core::LUT2d;
+using isce3::core::Poly2d;
+using isce3::image::OffsetModel;
+
+namespace py = pybind11;
+
+void addbinding(py::class_<OffsetModel> & pyOffsetModel)
+{
+    pyOffsetModel.doc() = R"(
+        Range or azimuth offsets, in pixels, modeled as the sum of a
+        polynomial and of a coarse residual grid, both functions of output
+        line (y) and pixel (x) indices. Either term may be omitted.
+        )";
+
+    pyOffsetModel
+        .def(py::init<>())
+        .def(py::init<const Poly2d &, const LUT2d<double> &>(),
+                py::arg("poly"),
+                py::arg("residual") = LUT2d<double>())
+        .def(py::init<const LUT2d<double> &>(),
+                py::arg("residual"))
+        .def_property_readonly("poly", &OffsetModel::poly)
+        .def_property_readonly("residual", &OffsetModel::residual)
+        .def("eval", &OffsetModel::eval,
+                py::arg("line"),
+                py::arg("pixel"),
+                "Evaluate offset at an output line and pixel")
+        ;
+}
@@ -1,6 +1,7 @@
 #include "ResampSlc.h"
 
 #include <pybind11/complex.h>
+#include <pybind11/stl.h>
 #include <isce3/core/Constants.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Poly2d.h>
@@ -65,6 +66,11 @@ void addbinding(py::class_<ResampSlc> & pyResampSlc)
         .def_property("lines_per_tile",
                 py::overload_cast<>(&ResampSlc::linesPerTile, py::const_),
                 py::overload_cast<size_t>(&ResampSlc::linesPerTile))
+        .def_property("tiles_in_flight",
+                py::overload_cast<>(&ResampSlc::tilesInFlight, py::const_),
+                py::overload_cast<size_t>(&ResampSlc::tilesInFlight),
+                "Maximum number of tiles read ahead of, and waiting to be "
+                "written after, the tile being interpolated")
         .def_property_readonly("start_range", &ResampSlc::startingRange)
         .def_property_readonly("range_pixel_spacing", &ResampSlc::rangePixelSpacing)
         .def_property_readonly("sensing_start", &ResampSlc::sensingStart)
@@ -137,5 +143,84 @@ void addbinding(py::class_<ResampSlc> & pyResampSlc)
                     Rows excluded from top/bottom of azimuth raster while searching
                     for min/max row indices of resampled SLC
                 )")
+        .def("resamp", py::overload_cast<
+                    std::vector<std::reference_wrapper<isce3::io::Raster>>,
+                    std::vector<std::reference_wrapper<isce3::io::Raster>>,
+                    isce3::io::Raster &, isce3::io::Raster &,
+                    std::vector<int>, bool, int, int>(&ResampSlc::resamp),
+                py::arg("input_slcs"),
+                py::arg("output_slcs"),
+                py::arg("rg_offset_raster"),
+                py::arg("az_offset_raster"),
+                py::arg("input_bands") = std::vector<int>{},
+                py::arg("flatten") = false,
+                py::arg("row_buffer") = 40,
+                py::arg("chip_size") = isce3::core::SINC_ONE,
+                R"(
+                Resample several co-registered SLCs (e.g. polarizations)
+                sharing the same offsets in a single pass
+
+                Parameters
+                ----------
+                input_slcs: list(isce3.io.Raster)
+                    Input rasters containing SLCs to be resampled
+                output_slcs: list(isce3.io.Raster)
+                    Output rasters containing resampled SLCs
+                rg_offset_raster: isce3.io.Raster
+                    Raster containing range shift to be applied
+                az_offset_raster: isce3.io.Raster
+                    Raster containing azimuth shift to be applied
+                input_bands: list(int)
+                    Band of each input raster to resample. Band 1 of each
+                    raster if empty.
+                flatten: bool
+                    Flag to flatten resampled SLCs
+                row_buffer: int
+                    Rows excluded from top/bottom of azimuth raster while searching
+                    for min/max row indices of resampled SLC
+                )")
+        .def("resamp", py::overload_cast<
+                    std::vector<std::reference_wrapper<isce3::io::Raster>>,
+                    std::vector<std::reference_wrapper<isce3::io::Raster>>,
+                    const isce3::image::OffsetModel &,
+                    const isce3::image::OffsetModel &, size_t, size_t,
+                    std::vector<int>, bool, int, int>(&ResampSlc::resamp),
+                py::arg("input_slcs"),
+                py::arg("output_slcs"),
+                py::arg("rg_offset_model"),
+                py::arg("az_offset_model"),
+                py::arg("out_length"),
+                py::arg("out_width"),
+                py::arg("input_bands") = std::vector<int>{},
+                py::arg("flatten") = false,
+                py::arg("row_buffer") = 40,
+                py::arg("chip_size") = isce3::core::SINC_ONE,
+                R"(
+                Resample several co-registered SLCs with offsets evaluated
+                on the fly from models instead of offset rasters
+
+                Parameters
+                ----------
+                input_slcs: list(isce3.io.Raster)
+                    Input rasters containing SLCs to be resampled
+                output_slcs: list(isce3.io.Raster)
+                    Output rasters containing resampled SLCs
+                rg_offset_model: isce3.image.OffsetModel
+                    Range shift to be applied
+                az_offset_model: isce3.image.OffsetModel
+                    Azimuth shift to be applied
+                out_length: int
+                    Number of lines of resampled SLCs
+                out_width: int
+                    Number of pixels of resampled SLCs
+                input_bands: list(int)
+                    Band of each input raster to resample. Band 1 of each
+                    raster if empty.
+                flatten: bool
+                    Flag to flatten resampled SLCs
+                row_buffer: int
+                    Rows excluded from top/bottom of azimuth offsets while
+                    searching for min/max row indices of resampled SLC
+                )")
         ;
 }
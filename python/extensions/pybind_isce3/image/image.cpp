@@ -1,5 +1,6 @@
 #include "image.h"
 
+#include "OffsetModel.h"
 #include "ResampSlc.h"
 
 namespace py = pybind11;
@@ -9,8 +10,11 @@ void addsubmodule_image(py::module & m)
     py::module m_image = m.def_submodule("image");
 
     // forward declare bound classes
+    py::class_<isce3::image::OffsetModel>
+        pyOffsetModel(m_image, "OffsetModel");
     py::class_<isce3::image::ResampSlc> pyResampSlc(m_image, "ResampSlc");
 
     // add bindings
+    addbinding(pyOffsetModel);
     addbinding(pyResampSlc);
 }
@@ -372,6 +372,13 @@ class TilingParams:
         then using the unwrapped output as the input to a new, single-tile run
         of snaphu to make iterative improvements to the solution. This may
         improve speed compared to a single single-tile run. (default: False)
+    tile_memory : bool, optional
+        If True, keep the temporary files of each tile in memory instead of
+        writing them to the scratch directory. Tile files are written to disk
+        regardless if debug outputs are requested. (default: True)
+    tile_memory_budget : int, optional
+        Memory budget, in megabytes, limiting the number of tiles unwrapped
+        in parallel. If zero, use half of the physical memory. (default: 0)
     """
 
     nproc: int = 1
@@ -384,6 +391,8 @@ class TilingParams:
     tile_edge_weight: float = 2.5
     secondary_arc_flow_max: int = 8
     single_tile_reoptimize: bool = False
+    tile_memory: bool = True
+    tile_memory_budget: int = 0
 
     def tostring(self):
         """Convert to string in SNAPHU config file format."""
@@ -402,10 +411,13 @@ class TilingParams:
         s += f"TILEEDGEWEIGHT {self.tile_edge_weight}\n"
         s += f"SCNDRYARCFLOWMAX {self.secondary_arc_flow_max}\n"
         s += f"SINGLETILEREOPTIMIZE {self.single_tile_reoptimize}\n"
+        s += f"TILEMEMORY {self.tile_memory}\n"
+        s += f"TILEMEMBUDGET {self.tile_memory_budget}\n"
 
-        # Don't remove temporary files for each tile since they may be useful
-        # for debugging. If the scratch directory is cleaned up, they'll be
-        # removed as well.
+        # Tile results are kept in memory if `tile_memory` is True, unless
+        # debug outputs are requested. In that case, don't remove temporary files for each tile since they
+        # may be useful for debugging. If the scratch directory is cleaned up,
+        # they'll be removed as well.
         s += "RMTMPTILE FALSE\n"
 
         return s
@@ -465,6 +477,17 @@ class SolverParams:
     prune_cost_thresh : int, optional
         Cost threshold for pruning the tree. A lower threshold prunes more
         aggressively. (default: 2000000000)
+    coarse_init : bool, optional
+        If True, the interferogram is multilooked and unwrapped at reduced
+        resolution first, and the upsampled solution is used in place of the
+        MST/MCF initialization of the full-resolution solver.
+        (default: False)
+    coarse_nlooks_az : int, optional
+        Number of looks in azimuth of the coarse initialization. Must be
+        positive. (default: 4)
+    coarse_nlooks_range : int, optional
+        Number of looks in range of the coarse initialization. Must be
+        positive. (default: 4)
     """
 
     max_flow_inc: int = 4
@@ -480,6 +503,9 @@ class SolverParams:
     n_conn_node_min: int = 0
     n_major_prune: int = 2_000_000_000
     prune_cost_thresh: int = 2_000_000_000
+    coarse_init: bool = False
+    coarse_nlooks_az: int = 4
+    coarse_nlooks_range: int = 4
 
     def tostring(self):
         """Convert to string in SNAPHU config file format."""
@@ -499,6 +525,9 @@ class SolverParams:
         s += f"NCONNNODEMIN {self.n_conn_node_min}\n"
         s += f"NMAJORPRUNE {self.n_major_prune}\n"
         s += f"PRUNECOSTTHRESH {self.prune_cost_thresh}\n"
+        s += f"COARSEINIT {self.coarse_init}\n"
+        s += f"NCOARSELOOKSAZ {self.coarse_nlooks_az}\n"
+        s += f"NCOARSELOOKSRANGE {self.coarse_nlooks_range}\n"
         return s
 
 
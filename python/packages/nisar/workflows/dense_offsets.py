@@ -35,7 +35,6 @@ def run(cfg: dict):
     # Get coregistered SLC path
     coregistered_slc_path = pathlib.Path(offset_params['coregistered_slc_path'])
 
-    error_channel = journal.error('dense_offsets.run')
     info_channel = journal.info('dense_offsets.run')
     info_channel.log('Start dense offsets estimation')
 
@@ -53,9 +52,12 @@ def run(cfg: dict):
         # and secondary raster are memory-mappable)
         ampcor.useMmap = 1
     else:
-        err_str = "Currently, ISCE3 supports only GPU dense offsets"
-        error_channel.log(err_str)
-        raise NotImplementedError(err_str)
+        # Correlate the windows on all CPU threads; the CUDA-only
+        # parameters (device, streams, mmapSize) are accepted and ignored
+        ampcor = isce3.matchtemplate.PyCpuAmpcor()
+        # Extract windows directly from memory maps of the reference and
+        # secondary rasters (not exposed to user, both are memory-mappable)
+        ampcor.useMmap = 1
 
     # Looping over frequencies and polarizations
     t_all = time.time()
@@ -224,6 +226,10 @@ def set_optional_attributes(ampcor_obj, cfg, length, width):
     if cfg['cuda_streams'] is not None:
         ampcor_obj.nStreams = cfg['cuda_streams']
 
+    if isinstance(ampcor_obj, isce3.matchtemplate.PyCpuAmpcor) and \
+            cfg['cpu_arena_size'] is not None:
+        ampcor_obj.arenaSizeInMB = cfg['cpu_arena_size']
+
     # Setup object parameters
     ampcor_obj.setupParams()
     if (cfg['use_gross_offsets'] is not None) and (
@@ -288,28 +288,79 @@ def get_raster_lists(gunw_datasets, desired, freq, pol_list, runw_hdf5, dst_h5,
 
     return geocoded_rasters, geocoded_datasets, input_rasters
 
-def cpu_geocode_rasters(cpu_geo_obj, gunw_datasets, desired, freq, pol_list,
-                        runw_hdf5, dst_h5, radar_grid, dem_raster,
-                        scratch_path='', compute_stats=True):
+def cpu_geocode_rasters(geocode_plan, gunw_datasets, desired_interp, freq,
+                        pol_list, runw_hdf5, dst_h5, scratch_path='',
+                        compute_stats=True, invalid_values=None):
+    '''
+    Geocode rasters sharing a radar grid in a single pass of a geocode plan
 
-    geocoded_rasters, geocoded_datasets, input_rasters = \
-        get_raster_lists(gunw_datasets, desired, freq, pol_list, runw_hdf5,
-                         dst_h5, scratch_path)
+    Parameters
+    ----------
+    geocode_plan : isce3.geocode.GeocodePlan
+        Geocode plan of the radar grid shared by the rasters
+    gunw_datasets : dict
+        Dict of all dataset names and whether or not to geocode as key/value
+    desired_interp : dict
+        Dict of dataset names to be geocoded and their interpolation method
+    freq : str
+        Frequency of datasets to be geocoded
+    pol_list : list
+        List of polarizations of frequency to be geocoded
+    runw_hdf5: str
+        Path to input RUNW HDF5
+    dst_h5 : h5py.File
+        h5py.File object where geocoded data is to be written
+    scratch_path : str
+        Path to scratch where layover shadow raster is saved
+    compute_stats : bool
+        Whether to compute statistics of the geocoded datasets
+    invalid_values : dict or None
+        Dict of dataset names and their invalid value. Datasets not found
+        use the invalid value of the geocode plan.
+    '''
+    if invalid_values is None:
+        invalid_values = {}
+
+    geocoded_rasters = []
+    geocoded_datasets = []
+    input_rasters = []
+    interp_methods = []
+    raster_invalid_values = []
+
+    for ds_name, interp_method in desired_interp.items():
+        ds_geocoded_rasters, ds_geocoded_datasets, ds_input_rasters = \
+            get_raster_lists(gunw_datasets, [ds_name], freq, pol_list,
+                             runw_hdf5, dst_h5, scratch_path)
+        geocoded_rasters.extend(ds_geocoded_rasters)
+        geocoded_datasets.extend(ds_geocoded_datasets)
+        input_rasters.extend(ds_input_rasters)
+        interp_methods.extend([interp_method] * len(ds_input_rasters))
+        raster_invalid_values.extend(
+            [invalid_values.get(ds_name, np.nan)] * len(ds_input_rasters))
 
     if input_rasters:
-        geocode_tuples = zip(input_rasters, geocoded_rasters)
-        for input_raster, geocoded_raster in geocode_tuples:
-            cpu_geo_obj.geocode(
-                radar_grid=radar_grid,
-                input_raster=input_raster,
-                output_raster=geocoded_raster,
-                dem_raster=dem_raster,
-                output_mode=isce3.geocode.GeocodeOutputMode.INTERP)
+        # geo2rdr is solved once per block and shared by all rasters
+        geocode_plan.geocode_rasters(geocoded_rasters, input_rasters,
+                                     interp_methods, raster_invalid_values)
 
         if compute_stats:
             for raster, ds in zip(geocoded_rasters, geocoded_datasets):
                 compute_stats_real_data(raster, ds)
 
+def _get_interp_method(interp_method):
+    '''
+    Convert interpolation method name to isce3.core.DataInterpMethod
+    '''
+    if interp_method == 'BILINEAR':
+        interp_method = isce3.core.DataInterpMethod.BILINEAR
+    if interp_method == 'BICUBIC':
+        interp_method = isce3.core.DataInterpMethod.BICUBIC
+    if interp_method == 'NEAREST':
+        interp_method = isce3.core.DataInterpMethod.NEAREST
+    if interp_method == 'BIQUINTIC':
+        interp_method = isce3.core.DataInterpMethod.BIQUINTIC
+    return interp_method
+
 def cpu_run(cfg, runw_hdf5, output_hdf5):
     """ Geocode RUNW products on CPU
 
@@ -336,6 +387,10 @@ def cpu_run(cfg, runw_hdf5, output_hdf5):
     gunw_datasets = cfg["processing"]["geocode"]["datasets"]
     scratch_path = pathlib.Path(cfg['product_path_group']['scratch_path'])
     offset_cfg = cfg["processing"]["dense_offsets"]
+    interp_margin = cfg["processing"]["geocode"]["interp_margin"]
+
+    interp_method = _get_interp_method(interp_method)
+    nearest = isce3.core.DataInterpMethod.NEAREST
 
     slc = SLC(hdf5file=ref_hdf5)
 
@@ -347,70 +402,63 @@ def cpu_run(cfg, runw_hdf5, output_hdf5):
 
     # set defaults shared by both frequencies
     dem_raster = isce3.io.Raster(dem_file)
-    epsg = dem_raster.get_epsg()
-    proj = isce3.core.make_projection(epsg)
-    ellipsoid = proj.ellipsoid
-
-    # init geocode object
-    geo = isce3.geocode.GeocodeFloat32()
-
-    # init geocode members
     orbit = slc.getOrbit()
-    geo.orbit = orbit
-    geo.ellipsoid = ellipsoid
-    geo.doppler = grid_zero_doppler
-    geo.threshold_geo2rdr = threshold_geo2rdr
-    geo.numiter_geo2rdr = iteration_geo2rdr
-    geo.lines_per_block = lines_per_block
-    geo.data_interpolator = interp_method
+
+    def make_plan(radar_grid, geogrid, invalid_value=np.nan):
+        rdr_geometry = isce3.container.RadarGeometry(radar_grid, orbit,
+                                                     grid_zero_doppler)
+        return isce3.geocode.GeocodePlan(geogrid, rdr_geometry, dem_raster,
+                                         lines_per_block, interp_method,
+                                         threshold=threshold_geo2rdr,
+                                         maxiter=iteration_geo2rdr,
+                                         invalid_value=invalid_value,
+                                         interp_margin=interp_margin)
 
     t_all = time.time()
     with h5py.File(output_hdf5, "a") as dst_h5:
         for freq, pol_list in freq_pols.items():
             radar_grid_slc = slc.getRadarGrid(freq)
-            if az_looks > 1 or rg_looks > 1:
-                radar_grid_mlook = radar_grid_slc.multilook(az_looks, rg_looks)
-
             geo_grid = geogrids[freq]
-            geo.geogrid(
-                geo_grid.start_x,
-                geo_grid.start_y,
-                geo_grid.spacing_x,
-                geo_grid.spacing_y,
-                geo_grid.width,
-                geo_grid.length,
-                geo_grid.epsg,
-            )
 
             # Assign correct radar grid
             if az_looks > 1 or rg_looks > 1:
-                radar_grid = radar_grid_mlook
+                radar_grid = radar_grid_slc.multilook(az_looks, rg_looks)
             else:
                 radar_grid = radar_grid_slc
 
-            desired = ['coherence_magnitude', 'unwrapped_phase']
-            geo.data_interpolator = interp_method
-            cpu_geocode_rasters(geo, gunw_datasets, desired, freq, pol_list,
-                                runw_hdf5, dst_h5, radar_grid, dem_raster)
-
-            desired = ["connected_components"]
-            geo.data_interpolator = 'NEAREST'
-            cpu_geocode_rasters(geo, gunw_datasets, desired, freq, pol_list,
-                                runw_hdf5, dst_h5, radar_grid, dem_raster)
-
-            desired = ['along_track_offset', 'slant_range_offset']
-            geo.data_interpolator = interp_method
+            '''
+            Datasets on the interferogram radar grid share a single plan.
+            connected_components uses 255 as invalid value, as the GPU
+            geocode does, while the other datasets use NaN.
+            '''
+            desired_interp = {'coherence_magnitude': interp_method,
+                              'unwrapped_phase': interp_method,
+                              'connected_components': nearest}
+            cpu_geocode_rasters(make_plan(radar_grid, geo_grid),
+                                gunw_datasets, desired_interp, freq, pol_list,
+                                runw_hdf5, dst_h5,
+                                invalid_values={'connected_components': 255})
+
+            desired_interp = {'along_track_offset': interp_method,
+                              'slant_range_offset': interp_method}
             radar_grid_offset = get_offset_radar_grid(offset_cfg,
                                                       radar_grid_slc)
-            cpu_geocode_rasters(geo, gunw_datasets, desired, freq, pol_list,
-                                runw_hdf5, dst_h5, radar_grid_offset,
-                                dem_raster)
+            cpu_geocode_rasters(make_plan(radar_grid_offset, geo_grid),
+                                gunw_datasets, desired_interp, freq, pol_list,
+                                runw_hdf5, dst_h5)
 
-            desired = ["layover_shadow_mask"]
-            geo.data_interpolator = 'NEAREST'
-            cpu_geocode_rasters(geo, gunw_datasets, desired, freq, pol_list,
-                                runw_hdf5, dst_h5, radar_grid_slc, dem_raster,
-                                scratch_path, compute_stats=False)
+            '''
+            layover shadow raster has type char and an invalid
+            value of NaN becomes 0 which conflicts with 0 being used
+            to indicate an unmasked value/pixel. 127 is chosen as it is
+            the most distant value from the allowed set of [0, 1, 2, 3].
+            '''
+            desired_interp = {'layover_shadow_mask': nearest}
+            cpu_geocode_rasters(make_plan(radar_grid_slc, geo_grid,
+                                          invalid_value=127),
+                                gunw_datasets, desired_interp, freq, pol_list,
+                                runw_hdf5, dst_h5, scratch_path,
+                                compute_stats=False)
 
             # spec for NISAR GUNW does not require freq B so skip radar cube
             if freq.upper() == 'B':
@@ -462,14 +510,7 @@ def gpu_run(cfg, runw_hdf5, output_hdf5):
     offset_cfg = cfg["processing"]["dense_offsets"]
     scratch_path = pathlib.Path(cfg['product_path_group']['scratch_path'])
 
-    if interp_method == 'BILINEAR':
-        interp_method = isce3.core.DataInterpMethod.BILINEAR
-    if interp_method == 'BICUBIC':
-        interp_method = isce3.core.DataInterpMethod.BICUBIC
-    if interp_method == 'NEAREST':
-        interp_method = isce3.core.DataInterpMethod.NEAREST
-    if interp_method == 'BIQUINTIC':
-        interp_method = isce3.core.DataInterpMethod.BIQUINTIC
+    interp_method = _get_interp_method(interp_method)
 
     info_channel = journal.info("geocode.run")
     info_channel.log("starting geocode")
@@ -57,41 +57,50 @@ def run(cfg):
             # get doppler centroid
             native_doppler = slc.getDopplerCentroid(frequency=freq)
 
-            for polarization in pol_list:
-                t_pol = time.time()
+            t_freq = time.time()
 
-                output_dir = os.path.dirname(os.path.abspath(output_hdf5))
-                os.makedirs(output_dir, exist_ok=True)
+            output_dir = os.path.dirname(os.path.abspath(output_hdf5))
+            os.makedirs(output_dir, exist_ok=True)
 
+            # geocode all polarizations of the frequency at once so that
+            # the geometry of each block is shared by all of them
+            slc_rasters = []
+            gslc_rasters = []
+            gslc_datasets = []
+            for polarization in pol_list:
                 raster_ref = f'HDF5:{input_hdf5}:/{slc.slcPath(freq, polarization)}'
-                slc_raster = isce3.io.Raster(raster_ref)
+                slc_rasters.append(isce3.io.Raster(raster_ref))
 
                 # access the HDF5 dataset for a given frequency and polarization
                 dataset_path = f'/science/LSAR/GSLC/grids/{frequency}/{polarization}'
                 gslc_dataset = dst_h5[dataset_path]
+                gslc_datasets.append(gslc_dataset)
 
                 # Construct the output ratster directly from HDF5 dataset
-                gslc_raster = isce3.io.Raster(f"IH5:::ID={gslc_dataset.id.id}".encode("utf-8"), update=True)
-
-                # run geocodeSlc
-                isce3.geocode.geocode_slc(gslc_raster, slc_raster, dem_raster,
-                                          radar_grid, geo_grid,
-                                          orbit,
-                                          native_doppler, image_grid_doppler,
-                                          ellipsoid,
-                                          threshold_geo2rdr, iteration_geo2rdr,
-                                          lines_per_block, flatten)
-
-                # the rasters need to be deleted
-                del gslc_raster
-                del slc_raster
-
+                gslc_rasters.append(isce3.io.Raster(
+                    f"IH5:::ID={gslc_dataset.id.id}".encode("utf-8"),
+                    update=True))
+
+            # run geocodeSlc
+            isce3.geocode.geocode_slc(gslc_rasters, slc_rasters, dem_raster,
+                                      radar_grid, geo_grid,
+                                      orbit,
+                                      native_doppler, image_grid_doppler,
+                                      ellipsoid,
+                                      threshold_geo2rdr, iteration_geo2rdr,
+                                      lines_per_block, flatten)
+
+            # the rasters need to be deleted
+            del gslc_rasters
+            del slc_rasters
+
+            for gslc_dataset in gslc_datasets:
                 # output_raster_ref = f'HDF5:{output_hdf5}:/{dataset_path}'
                 gslc_raster = isce3.io.Raster(f"IH5:::ID={gslc_dataset.id.id}".encode("utf-8"))
                 compute_stats_complex_data(gslc_raster, gslc_dataset)
 
-                t_pol_elapsed = time.time() - t_pol
-                info_channel.log(f'polarization {polarization} ran in {t_pol_elapsed:.3f} seconds')
+            t_freq_elapsed = time.time() - t_freq
+            info_channel.log(f'frequency {freq} polarizations {pol_list} ran in {t_freq_elapsed:.3f} seconds')
 
             if freq.upper() == 'B':
                 continue
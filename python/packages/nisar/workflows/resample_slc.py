@@ -90,6 +90,8 @@ def run(cfg, resample_type):
         # Get polarization list for which resample SLCs
         pol_list = freq_pols[freq]
 
+        input_rasters = []
+        output_rasters = []
         for pol in pol_list:
             # Create directory for each polarization
             out_dir = resample_slc_scratch_path / pol
@@ -99,12 +101,23 @@ def run(cfg, resample_type):
             # Extract and create raster of SLC to resample
             h5_ds = f'/{slc.SwathPath}/frequency{freq}/{pol}'
             raster_path = f'HDF5:{input_hdf5}:{h5_ds}'
-            raster = isce3.io.Raster(raster_path)
+            input_rasters.append(isce3.io.Raster(raster_path))
 
             # Create output raster
-            resamp_slc = isce3.io.Raster(str(out_path), rg_off.width,
-                                         rg_off.length, rg_off.num_bands, gdal.GDT_CFloat32, 'ENVI')
-            resamp_obj.resamp(raster, resamp_slc, rg_off, az_off)
+            output_rasters.append(
+                isce3.io.Raster(str(out_path), rg_off.width, rg_off.length,
+                                rg_off.num_bands, gdal.GDT_CFloat32, 'ENVI'))
+
+        if use_gpu:
+            for raster, resamp_slc in zip(input_rasters, output_rasters):
+                resamp_obj.resamp(raster, resamp_slc, rg_off, az_off)
+        else:
+            # Resample all polarizations in a single pass sharing
+            # the offsets and interpolation weights
+            resamp_obj.resamp(input_rasters, output_rasters, rg_off, az_off)
+
+        # Close rasters to flush the resampled SLCs
+        del input_rasters, output_rasters
 
     t_all_elapsed = time.time() - t_all
     info_channel.log(f"successfully ran resample in {t_all_elapsed:.3f} seconds")
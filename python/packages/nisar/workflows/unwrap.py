@@ -316,6 +316,7 @@ def set_icu_attributes(cfg: dict):
     unwrap.num_bs_lines = cfg['bootstrap_lines']
     unwrap.min_overlap_area = cfg['min_overlap_area']
     unwrap.phase_var_thr = cfg['phase_variance_threshold']
+    unwrap.parallel_tiles = cfg['parallel_tiles']
 
     return unwrap
 
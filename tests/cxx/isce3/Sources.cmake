@@ -32,6 +32,7 @@ focus/dry-troposphere-model.cpp
 focus/gaps.cpp
 focus/presum.cpp
 focus/rangecomp.cpp
+geocode/async_block_writer.cpp
 geocode/geocode.cpp
 geometry/dem/dem.cpp
 geometry/geo2rdr/geo2rdr.cpp
@@ -44,6 +45,7 @@ geometry/bbox/geoperimeter_equator.cpp
 geometry/metadata_cubes/metadata_cubes.cpp
 geogrid/relocate_raster.cpp
 image/resampslc/resampslc.cpp
+io/datastream/datastream.cpp
 io/gdal/buffer.cpp
 io/gdal/gdal-dataset.cpp
 io/gdal/geotransform.cpp
@@ -54,10 +56,14 @@ io/IH5/ih5.cpp
 io/IH5/ih5gdal.cpp
 io/IH5/ih5nativeread.cpp
 io/IH5/ih5nativewrite.cpp
+io/raster/mmapview.cpp
 io/raster/raster.cpp
+io/raster/rasterblockcache.cpp
 io/raster/rasterepsg.cpp
 io/raster/rastermatrix.cpp
 io/raster/rasterview.cpp
+matchtemplate/ampcor/ampcorcorrelate.cpp
+matchtemplate/ampcor/ampcorparallel.cpp
 math/bessel/bessel53.cpp
 math/sinc.cpp
 math/polyfunc.cpp
@@ -78,9 +84,14 @@ signal/nfft.cpp
 signal/shift_signal.cpp
 signal/signal.cpp
 signal/signal_utils.cpp
+unwrap/connectedcomponents.cpp
 unwrap/icu/icu.cpp
+unwrap/icu/icukernels.cpp
 unwrap/phass/phass.cpp
+unwrap/snaphu/costs.cpp
 unwrap/snaphu/mcf.cpp
+unwrap/snaphu/multilook.cpp
+unwrap/snaphu/tiles.cpp
 )
 
 #This is a temporary fix - since GDAL does not support
@@ -0,0 +1,93 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <isce3/core/Matrix.h>
+#include <isce3/except/Error.h>
+#include <isce3/geocode/detail/AsyncBlockWriter.h>
+#include <isce3/io/Raster.h>
+
+using isce3::geocode::detail::AsyncBlockWriter;
+
+TEST(AsyncBlockWriter, ParallelBlocks)
+{
+    const int width = 37, block_length = 5, nblocks = 23;
+    const int length = block_length * nblocks;
+    isce3::io::Raster raster("async_block_writer.bin", width, length, 2,
+            GDT_Float32, "ENVI");
+
+    {
+        // small queue to exercise back pressure on the compute threads
+        AsyncBlockWriter writer(2);
+
+        _Pragma("omp parallel for schedule(dynamic)")
+        for (int block = 0; block < nblocks; ++block) {
+            isce3::core::Matrix<float> data(block_length, width);
+            for (int i = 0; i < block_length; ++i)
+                for (int j = 0; j < width; ++j)
+                    data(i, j) = (block * block_length + i) * width + j;
+
+            // band 2 receives a copy, band 1 takes ownership of the data
+            writer.setBlock(raster, data, 0, block * block_length, width,
+                    block_length, 2);
+            writer.setBlock(raster, std::move(data), 0, block * block_length,
+                    width, block_length, 1);
+        }
+        writer.finish();
+    }
+
+    isce3::core::Matrix<float> band1(length, width), band2(length, width);
+    raster.getBlock(band1.data(), 0, 0, width, length, 1);
+    raster.getBlock(band2.data(), 0, 0, width, length, 2);
+    for (int i = 0; i < length; ++i) {
+        for (int j = 0; j < width; ++j) {
+            EXPECT_EQ(band1(i, j), i * width + j);
+            EXPECT_EQ(band2(i, j), i * width + j);
+        }
+    }
+}
+
+TEST(AsyncBlockWriter, ErrorIsRethrown)
+{
+    const std::string filename = "async_block_writer_err.bin";
+    {
+        isce3::io::Raster raster(filename, 4, 4, 1, GDT_Float32, "ENVI");
+    }
+    isce3::core::Matrix<float> data(4, 4);
+    data.fill(1);
+
+    // writes to a read-only raster fail on the I/O thread
+    isce3::io::Raster readonly(filename);
+    AsyncBlockWriter writer;
+    writer.setBlock(readonly, data, 0, 0, 4, 4, 1);
+    EXPECT_THROW(writer.finish(), isce3::except::RuntimeError);
+
+    // the writer remains usable after reporting the error
+    isce3::io::Raster raster(filename, GA_Update);
+    writer.setBlock(raster, data, 0, 0, 4, 4, 1);
+    EXPECT_NO_THROW(writer.finish());
+
+    // and reports blocks outside of the raster the same way
+    writer.setBlock(raster, data, 0, 2, 4, 4, 1);
+    EXPECT_THROW(writer.finish(), isce3::except::OutOfRange);
+}
+
+TEST(AsyncBlockWriter, BufferTooSmall)
+{
+    isce3::io::Raster raster("async_block_writer_len.bin", 4, 4, 1,
+            GDT_Float32, "ENVI");
+    AsyncBlockWriter writer;
+
+    // requested block larger than the data buffer
+    isce3::core::Matrix<float> data(2, 2);
+    data.fill(1);
+    EXPECT_THROW(writer.setBlock(raster, data, 0, 0, 4, 4, 1),
+            isce3::except::LengthError);
+    EXPECT_NO_THROW(writer.finish());
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -3,17 +3,21 @@
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include <gtest/gtest.h>
 
+#include <isce3/container/RadarGeometry.h>
 #include <isce3/core/Ellipsoid.h>
 #include <isce3/core/LUT2d.h>
 #include <isce3/core/Metadata.h>
 #include <isce3/core/Orbit.h>
 #include <isce3/core/Poly2d.h>
+#include <isce3/except/Error.h>
 #include <isce3/geocode/geocodeSlc.h>
 #include <isce3/geocode/GeocodeCov.h>
+#include <isce3/geocode/GeocodePlan.h>
 #include <isce3/geometry/Topo.h>
 #include <isce3/io/IH5.h>
 #include <isce3/io/Raster.h>
@@ -529,6 +533,155 @@ TEST(GeocodeTest, CheckGeocodeCovResults) {
     }
 }
 
+TEST(GeocodeTest, TestGeocodePlan) {
+    // Geocode the latitude and longitude radar grids in a single pass of a
+    // geocode plan, each with a different interpolation method, and check
+    // the geocoded values against the geogrid pixel locations.
+
+    std::string h5file(TESTDATA_DIR "envisat.h5");
+    isce3::io::IH5File file(h5file);
+    isce3::product::RadarGridProduct product(file);
+
+    const isce3::product::Swath & swath = product.swath('A');
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::LUT2d<double> doppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::product::RadarGridParameters radar_grid(swath, product.lookSide());
+    isce3::container::RadarGeometry rdr_geom(radar_grid, orbit, doppler);
+
+    const int reduction_factor = 10;
+    const double dx = reduction_factor * 0.0002;
+    const double dy = reduction_factor * -8.0e-5;
+    isce3::product::GeoGridParameters geogrid(-115.6, 34.832, dx, dy,
+            400 / reduction_factor, 380 / reduction_factor, 4326);
+
+    isce3::io::Raster demRaster("zero_height_dem_geo.bin");
+
+    // small blocks to exercise block processing
+    const size_t lines_per_block = 7;
+    isce3::geocode::GeocodePlan plan(geogrid, rdr_geom, demRaster,
+            lines_per_block, isce3::core::BILINEAR_METHOD,
+            isce3::core::BIQUINTIC_METHOD, 1.0e-9, 25);
+    ASSERT_EQ(plan.numBlocks(), (geogrid.length() + lines_per_block - 1) /
+                                        lines_per_block);
+
+    isce3::io::Raster xRaster("x.rdr");
+    isce3::io::Raster yRaster("y.rdr");
+    isce3::io::Raster xGeoRaster("x_plan_geo.bin", geogrid.width(),
+            geogrid.length(), 1, GDT_Float64, "ENVI");
+    isce3::io::Raster yGeoRaster("y_plan_geo.bin", geogrid.width(),
+            geogrid.length(), 1, GDT_Float64, "ENVI");
+    isce3::io::Raster xFilledGeoRaster("x_plan_filled_geo.bin",
+            geogrid.width(), geogrid.length(), 1, GDT_Float64, "ENVI");
+
+    // the last raster overrides the default invalid value of the plan
+    const float fill_value = -9999.0f;
+    plan.geocodeRasters({xGeoRaster, yGeoRaster, xFilledGeoRaster},
+            {xRaster, yRaster, xRaster},
+            {isce3::core::BIQUINTIC_METHOD, isce3::core::BILINEAR_METHOD,
+                    isce3::core::BIQUINTIC_METHOD},
+            {std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<float>::quiet_NaN(), fill_value});
+
+    const size_t length = geogrid.length();
+    const size_t width = geogrid.width();
+    std::valarray<double> geoX(length * width);
+    std::valarray<double> geoY(length * width);
+    std::valarray<double> geoXFilled(length * width);
+    xGeoRaster.getBlock(geoX, 0, 0, width, length);
+    yGeoRaster.getBlock(geoY, 0, 0, width, length);
+    xFilledGeoRaster.getBlock(geoXFilled, 0, 0, width, length);
+
+    const double x0 = geogrid.startX() + dx / 2.0;
+    const double y0 = geogrid.startY() + dy / 2.0;
+
+    size_t n_valid = 0;
+    double max_err_x = 0, square_sum_y = 0;
+    for (size_t line = 0; line < length; ++line) {
+        for (size_t pixel = 0; pixel < width; ++pixel) {
+            const size_t index = line * width + pixel;
+            // both rasters share the same valid pixels
+            ASSERT_EQ(std::isnan(geoX[index]), std::isnan(geoY[index]));
+            if (std::isnan(geoX[index])) {
+                ASSERT_EQ(geoXFilled[index], fill_value);
+                continue;
+            }
+            ASSERT_EQ(geoXFilled[index], geoX[index]);
+            ++n_valid;
+            max_err_x = std::max(max_err_x,
+                    std::abs(geoX[index] - (x0 + pixel * dx)));
+            square_sum_y += std::pow(geoY[index] - (y0 + line * dy), 2);
+        }
+    }
+
+    ASSERT_GE(n_valid, 800);
+    ASSERT_LT(max_err_x, 1.0e-8);
+    ASSERT_LT(std::sqrt(square_sum_y / n_valid), 0.5 * std::abs(dy));
+}
+
+TEST(GeocodeTest, TestGeocodePlanMargin) {
+    // A margin smaller than the interpolation kernel is raised to its
+    // half-width, so that bicubic kernels never read past the radar block,
+    // and rasters needing a wider kernel than the plan margin are rejected.
+
+    std::string h5file(TESTDATA_DIR "envisat.h5");
+    isce3::io::IH5File file(h5file);
+    isce3::product::RadarGridProduct product(file);
+
+    const isce3::product::Swath & swath = product.swath('A');
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::LUT2d<double> doppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::product::RadarGridParameters radar_grid(swath, product.lookSide());
+    isce3::container::RadarGeometry rdr_geom(radar_grid, orbit, doppler);
+
+    const int reduction_factor = 10;
+    const double dx = reduction_factor * 0.0002;
+    const double dy = reduction_factor * -8.0e-5;
+    isce3::product::GeoGridParameters geogrid(-115.6, 34.832, dx, dy,
+            400 / reduction_factor, 380 / reduction_factor, 4326);
+
+    isce3::io::Raster demRaster("zero_height_dem_geo.bin");
+
+    const size_t lines_per_block = 7;
+    const int interp_margin = 0;
+    isce3::geocode::GeocodePlan plan(geogrid, rdr_geom, demRaster,
+            lines_per_block, isce3::core::BICUBIC_METHOD,
+            isce3::core::BIQUINTIC_METHOD, 1.0e-9, 25, 10,
+            std::numeric_limits<float>::quiet_NaN(), interp_margin);
+    ASSERT_EQ(plan.interpMargin(), 2);
+
+    isce3::io::Raster xRaster("x.rdr");
+    isce3::io::Raster xGeoRaster("x_plan_margin_geo.bin", geogrid.width(),
+            geogrid.length(), 1, GDT_Float64, "ENVI");
+    plan.geocodeRasters({xGeoRaster}, {xRaster});
+
+    const size_t length = geogrid.length();
+    const size_t width = geogrid.width();
+    std::valarray<double> geoX(length * width);
+    xGeoRaster.getBlock(geoX, 0, 0, width, length);
+
+    const double x0 = geogrid.startX() + dx / 2.0;
+    size_t n_valid = 0;
+    double max_err_x = 0;
+    for (size_t line = 0; line < length; ++line) {
+        for (size_t pixel = 0; pixel < width; ++pixel) {
+            const double x = geoX[line * width + pixel];
+            if (std::isnan(x))
+                continue;
+            ++n_valid;
+            max_err_x = std::max(max_err_x, std::abs(x - (x0 + pixel * dx)));
+        }
+    }
+    ASSERT_GE(n_valid, 800);
+    ASSERT_LT(max_err_x, 1.0e-8);
+
+    // kernels wider than the margin of the plan are rejected
+    ASSERT_THROW(plan.geocodeRasters({xGeoRaster}, {xRaster},
+                         {isce3::core::SINC_METHOD}),
+            isce3::except::InvalidArgument);
+}
+
 TEST(GeocodeTest, TestGeocodeSlc)
 {
 
@@ -688,6 +841,69 @@ TEST(GeocodeTest, CheckGeocodeSlcResults)
     ASSERT_LT(maxErrY, 1.0e-5);
 }
 
+TEST(GeocodeTest, TestGeocodeSlcMultiRaster)
+{
+    // Geocoding both rasters in a single call must reproduce the rasters
+    // geocoded one at a time.
+    std::string h5file(TESTDATA_DIR "envisat.h5");
+    isce3::io::IH5File file(h5file);
+    isce3::product::RadarGridProduct product(file);
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::Ellipsoid ellipsoid;
+
+    isce3::core::LUT2d<double> imageGridDoppler =
+            product.metadata().procInfo().dopplerCentroid('A');
+    isce3::core::Matrix<double> M(imageGridDoppler.length(),
+                                  imageGridDoppler.width());
+    M.zeros();
+    isce3::core::LUT2d<double> nativeDoppler(
+            imageGridDoppler.xStart(), imageGridDoppler.yStart(),
+            imageGridDoppler.xSpacing(), imageGridDoppler.ySpacing(), M);
+
+    isce3::product::RadarGridParameters radarGrid(product, 'A');
+
+    int geoGridLength = 500;
+    int geoGridWidth = 500;
+    isce3::product::GeoGridParameters geoGrid(-115.65, 34.84, 0.0002, -8.0e-5,
+            geoGridWidth, geoGridLength, 4326);
+
+    isce3::io::Raster demRaster("zero_height_dem_geo.bin");
+    isce3::io::Raster inputSlcX("xslc_rdr.bin", GA_ReadOnly);
+    isce3::io::Raster inputSlcY("yslc_rdr.bin", GA_ReadOnly);
+    isce3::io::Raster geocodedSlcX("xslc_geo_multi.bin", geoGridWidth,
+            geoGridLength, 1, GDT_CFloat32, "ENVI");
+    isce3::io::Raster geocodedSlcY("yslc_geo_multi.bin", geoGridWidth,
+            geoGridLength, 1, GDT_CFloat32, "ENVI");
+
+    // use several blocks to exercise the reuse of the block buffers
+    size_t linesPerBlock = 128;
+    bool flatten = false;
+    isce3::geocode::geocodeSlc({geocodedSlcX, geocodedSlcY},
+            {inputSlcX, inputSlcY}, demRaster, radarGrid, geoGrid, orbit,
+            nativeDoppler, imageGridDoppler, ellipsoid, 1.0e-9, 25,
+            linesPerBlock, flatten);
+
+    for (std::string name : {"xslc_geo", "yslc_geo"}) {
+        isce3::io::Raster singleRaster(name + ".bin");
+        isce3::io::Raster multiRaster(name + "_multi.bin");
+
+        std::valarray<std::complex<float>> single(geoGridLength * geoGridWidth);
+        std::valarray<std::complex<float>> multi(geoGridLength * geoGridWidth);
+        singleRaster.getBlock(single, 0, 0, geoGridWidth, geoGridLength);
+        multiRaster.getBlock(multi, 0, 0, geoGridWidth, geoGridLength);
+
+        size_t nValid = 0;
+        for (size_t i = 0; i < single.size(); ++i) {
+            ASSERT_EQ(std::isnan(single[i].real()), std::isnan(multi[i].real()));
+            if (std::isnan(single[i].real()))
+                continue;
+            ++nValid;
+            ASSERT_NEAR(std::abs(single[i] - multi[i]), 0.0, 1.0e-6);
+        }
+        ASSERT_GT(nValid, 0);
+    }
+}
+
 int main(int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -276,6 +276,48 @@ TEST_P(PerimeterTest, DateLine) {
 }
 
 
+TEST_P(PerimeterTest, HeightSearchDEM) {
+
+    LookSide side = std::get<0>(GetParam());
+    int azlooks = std::get<1>(GetParam());
+    int rglooks = std::get<2>(GetParam());
+
+    //Moving at 0.1 degrees / sec
+    const double degrees = 180.0 / M_PI;
+    const double lon0 = 0.0;
+    const double omega = 0.1/degrees;
+    const int Nvec = 10;
+
+    //Setup orbit
+    Setup_orbit(lon0, omega, Nvec);
+
+    //Set up grid
+    Setup_grid(azlooks, rglooks,side);
+
+    //Setup projection system
+    isce3::core::ProjectionBase *proj = isce3::core::createProj(4326);
+
+    //The search is bounded by the heights of the DEM, padded by the
+    //height threshold
+    const double height_threshold = 100.0;
+    isce3::geometry::DEMInterpolator dem(250.0);
+    isce3::geometry::BoundingBox box =
+            isce3::geometry::getGeoBoundingBoxHeightSearch(grid, orbit, proj,
+                    {}, dem, 0.0, 11, 1.0e-8, 15, height_threshold);
+    isce3::geometry::BoundingBox expected =
+            isce3::geometry::getGeoBoundingBoxHeightSearch(grid, orbit, proj,
+                    {}, 150.0, 350.0, 0.0, 11, 1.0e-8, 15, height_threshold);
+
+    ASSERT_DOUBLE_EQ( box.MinX, expected.MinX);
+    ASSERT_DOUBLE_EQ( box.MaxX, expected.MaxX);
+    ASSERT_DOUBLE_EQ( box.MinY, expected.MinY);
+    ASSERT_DOUBLE_EQ( box.MaxY, expected.MaxY);
+
+    delete proj;
+
+}
+
+
 INSTANTIATE_TEST_SUITE_P(PerimeterTests, PerimeterTest,
                         testing::Values(
                             std::make_tuple(LookSide::Right,1,1),
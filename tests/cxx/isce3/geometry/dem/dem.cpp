@@ -3,6 +3,10 @@
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
 #include <gtest/gtest.h>
 
 // isce3::core
@@ -13,6 +17,8 @@
 
 // isce3::geometry
 #include <isce3/geometry/DEMInterpolator.h>
+#include <isce3/geometry/detail/HeightStatsPyramid.h>
+#include <isce3/geometry/detail/QuantizedHeights.h>
 
 
 TEST(DEMTest, ConstDEM) {
@@ -46,6 +52,194 @@ TEST(DEMTest, MethodConstruct) {
 }
 
 
+TEST(DEMTest, HeightStatsPyramid) {
+
+    // Synthetic DEM with a non-power-of-two shape and a few invalid posts
+    const size_t length = 101, width = 77;
+    std::vector<float> hgt(length * width);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            hgt[i * width + j] = 100.0f * std::sin(0.1f * i) +
+                                 50.0f * std::cos(0.07f * j) + 0.5f * i;
+        }
+    }
+    hgt[3 * width + 5] = std::numeric_limits<float>::quiet_NaN();
+    hgt[60 * width + 40] = std::numeric_limits<float>::quiet_NaN();
+
+    const size_t leaf_size = 8;
+    isce3::geometry::detail::HeightStatsPyramid pyramid(
+            hgt.data(), length, width, leaf_size);
+    ASSERT_FALSE(pyramid.empty());
+
+    // Compare pyramid queries against a brute-force scan of each window
+    auto check = [&](size_t row0, size_t col0, size_t nrows, size_t ncols) {
+        isce3::geometry::detail::HeightStats ref;
+        for (size_t i = row0; i < std::min(row0 + nrows, length); ++i) {
+            for (size_t j = col0; j < std::min(col0 + ncols, width); ++j) {
+                ref.add(hgt[i * width + j]);
+            }
+        }
+        const auto stats = pyramid.stats(hgt.data(), row0, col0, nrows,
+                                         ncols);
+        EXPECT_EQ(stats.count, ref.count);
+        EXPECT_EQ(stats.min, ref.min);
+        EXPECT_EQ(stats.max, ref.max);
+        EXPECT_NEAR(stats.sum, ref.sum, 1.0e-6 * std::abs(ref.sum) + 1e-6);
+    };
+
+    check(0, 0, length, width);
+    check(0, 0, 1, 1);
+    check(3, 5, 1, 1);
+    check(7, 9, 33, 41);
+    check(16, 16, 32, 32);
+    check(50, 30, 200, 200);
+    check(100, 76, 10, 10);
+
+    // Whole-DEM statistics come from the top level
+    const auto all = pyramid.stats();
+    EXPECT_EQ(all.count, length * width - 2);
+    EXPECT_NEAR(all.mean(),
+                pyramid.stats(hgt.data(), 0, 0, length, width).mean(),
+                1.0e-9);
+}
+
+
+TEST(DEMTest, HalfPrecision) {
+
+    using isce3::geometry::detail::floatToHalf;
+    using isce3::geometry::detail::halfToFloat;
+
+    EXPECT_EQ(floatToHalf(1.0f), 0x3c00);
+    EXPECT_EQ(floatToHalf(-2.0f), 0xc000);
+    EXPECT_EQ(floatToHalf(65504.0f), 0x7bff);
+    EXPECT_EQ(floatToHalf(65520.0f), 0x7c00);
+    EXPECT_EQ(floatToHalf(std::ldexp(1.0f, -24)), 0x0001);
+    // ties round to the even mantissa
+    EXPECT_EQ(floatToHalf(2049.0f), floatToHalf(2048.0f));
+    EXPECT_EQ(floatToHalf(2051.0f), floatToHalf(2052.0f));
+    EXPECT_TRUE(std::isnan(halfToFloat(floatToHalf(
+            std::numeric_limits<float>::quiet_NaN()))));
+
+    // every finite half survives the round trip
+    for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+        const auto half = static_cast<std::uint16_t>(bits);
+        const float value = halfToFloat(half);
+        if (std::isfinite(value)) {
+            ASSERT_EQ(floatToHalf(value), half) << bits;
+        }
+    }
+}
+
+
+TEST(DEMTest, QuantizedStorage) {
+
+    using isce3::geometry::DEMInterpolator;
+    using isce3::geometry::HeightStorage;
+
+    // Synthetic DEM with an invalid post
+    const int length = 64, width = 48;
+    std::vector<float> hgt(length * width);
+    for (int i = 0; i < length; ++i) {
+        for (int j = 0; j < width; ++j) {
+            hgt[i * width + j] = 3000.0f * std::sin(0.09f * i) +
+                                 800.0f * std::cos(0.13f * j) + 10.0f * i;
+        }
+    }
+    hgt[20 * width + 30] = std::numeric_limits<float>::quiet_NaN();
+
+    double geotransform[] = {10.0, 0.001, 0.0, 20.0, 0.0, -0.001};
+    auto make_raster = [&](const std::string& filename,
+                           std::vector<float> data) {
+        std::remove(filename.c_str());
+        isce3::io::Raster raster(filename, width, length, 1, GDT_Float32,
+                                 "ENVI");
+        raster.setGeoTransform(geotransform);
+        raster.setEPSG(4326);
+        raster.setBlock(data, 0, 0, width, length);
+    };
+    make_raster("quantized_dem.bin", hgt);
+
+    for (auto storage : {HeightStorage::Int16, HeightStorage::Float16}) {
+
+        isce3::io::Raster raster("quantized_dem.bin");
+        DEMInterpolator exact;
+        exact.loadDEM(raster);
+        DEMInterpolator quantized;
+        quantized.heightStorage(storage);
+        quantized.loadDEM(raster);
+        ASSERT_EQ(quantized.data(), nullptr);
+        ASSERT_EQ(quantized.length(), length);
+        ASSERT_EQ(quantized.width(), width);
+
+        // Heights are within half a quantization step
+        const double step = storage == HeightStorage::Int16
+                ? (exact.maxHeight() - exact.minHeight()) / 65534.0
+                : 4.0;
+        const auto decoded = quantized.heights();
+        for (int i = 0; i < length; ++i) {
+            for (int j = 0; j < width; ++j) {
+                const float h = hgt[i * width + j];
+                if (std::isnan(h)) {
+                    EXPECT_TRUE(std::isnan(decoded(i, j)));
+                } else {
+                    EXPECT_NEAR(decoded(i, j), h, 0.5 * step + 1e-3);
+                }
+            }
+        }
+
+        // Statistics describe the stored heights
+        float min_q, max_q, mean_q;
+        quantized.computeHeightStats(min_q, max_q, mean_q, 10.01, 10.02,
+                                     19.97, 19.98);
+        float min_h, max_h, mean_h;
+        exact.computeHeightStats(min_h, max_h, mean_h, 10.01, 10.02,
+                                 19.97, 19.98);
+        EXPECT_NEAR(min_q, min_h, 0.5 * step + 1e-3);
+        EXPECT_NEAR(max_q, max_h, 0.5 * step + 1e-3);
+        EXPECT_NEAR(mean_q, mean_h, 0.5 * step + 1e-3);
+
+        // Interpolating quantized heights matches interpolating the same
+        // heights stored as floats, top and left edges included (bicubic
+        // kernels read past the last two rows and columns, so stay clear)
+        std::vector<float> stored(decoded.data(),
+                                  decoded.data() + length * width);
+        make_raster("quantized_dem_decoded.bin", stored);
+        isce3::io::Raster decoded_raster("quantized_dem_decoded.bin");
+        for (auto method : {isce3::core::BILINEAR_METHOD,
+                            isce3::core::BICUBIC_METHOD,
+                            isce3::core::BIQUINTIC_METHOD,
+                            isce3::core::NEAREST_METHOD,
+                            isce3::core::SINC_METHOD}) {
+            DEMInterpolator ref(0.0, method);
+            ref.loadDEM(decoded_raster);
+            DEMInterpolator dem(0.0, method);
+            dem.heightStorage(storage);
+            dem.loadDEM(raster);
+            for (double y = 19.999; y > 19.938; y -= 0.00037) {
+                for (double x = 10.001; x < 10.046; x += 0.00041) {
+                    const double expected = ref.interpolateXY(x, y);
+                    const double value = dem.interpolateXY(x, y);
+                    if (std::isnan(expected)) {
+                        EXPECT_TRUE(std::isnan(value));
+                    } else {
+                        ASSERT_EQ(value, expected) << x << " " << y;
+                    }
+                }
+            }
+        }
+
+        // Switching back to floats keeps the decoded heights
+        quantized.heightStorage(HeightStorage::Float32);
+        ASSERT_NE(quantized.data(), nullptr);
+        for (int k = 0; k < length * width; ++k) {
+            if (!std::isnan(stored[k])) {
+                ASSERT_EQ(quantized.data()[k], stored[k]);
+            }
+        }
+    }
+}
+
+
 void test_dateline(double x0, double xf, double y0, double yf,
                    double sampling_factor) {
     /*
@@ -1,11 +1,19 @@
 #include <gtest/gtest.h>
+#include <omp.h>
 #include <isce3/core/Constants.h>
 #include <isce3/core/Orbit.h>
+#include <isce3/core/Projections.h>
 #include <isce3/geometry/RTC.h>
+#include <isce3/geometry/RTCAreaCache.h>
+#include <isce3/geometry/boundingbox.h>
 #include <isce3/io/IH5.h>
 #include <isce3/io/Raster.h>
 #include <isce3/product/RadarGridProduct.h>
+#include <isce3/product/GeoGridParameters.h>
 #include <isce3/product/RadarGridParameters.h>
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <string>
 
 // Create set of RadarGridParameters to process
@@ -189,6 +197,142 @@ TEST(TestRTC, CheckResults) {
     }
 }
 
+TEST(TestRTC, AreaCache) {
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::RadarGridProduct product(file);
+    char frequency = 'A';
+    isce3::io::Raster dem(TESTDATA_DIR "srtm_cropped.tif");
+
+    isce3::product::RadarGridParameters radar_grid =
+            isce3::product::RadarGridParameters(product, frequency)
+                    .multilook(5, 5);
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::LUT2d<double> dop =
+            product.metadata().procInfo().dopplerCentroid(frequency);
+    dop.boundsError(false);
+
+    // the cache is opt-in
+    isce3::geometry::clearRtcAreaCache();
+    EXPECT_FALSE(isce3::geometry::isRtcAreaCacheEnabled());
+    const std::size_t memory_budget = 1ULL << 28;
+    isce3::geometry::setRtcAreaCacheMemoryBudget(memory_budget);
+    EXPECT_TRUE(isce3::geometry::isRtcAreaCacheEnabled());
+
+    // First call computes and caches the RTC area, second call must be
+    // served from the cache with identical values
+    isce3::io::Raster rtc_1("./rtc_area_cache_1.bin", radar_grid.width(),
+            radar_grid.length(), 1, GDT_Float32, "ENVI");
+    isce3::io::Raster rtc_2("./rtc_area_cache_2.bin", radar_grid.width(),
+            radar_grid.length(), 1, GDT_Float32, "ENVI");
+    isce3::geometry::computeRtc(radar_grid, orbit, dop, dem, rtc_1);
+    ASSERT_EQ(isce3::geometry::getRtcAreaCacheHitCount(), 0u);
+    isce3::geometry::computeRtc(radar_grid, orbit, dop, dem, rtc_2);
+    ASSERT_EQ(isce3::geometry::getRtcAreaCacheHitCount(), 1u);
+
+    isce3::core::Matrix<float> data_1(radar_grid.length(), radar_grid.width());
+    isce3::core::Matrix<float> data_2(radar_grid.length(), radar_grid.width());
+    rtc_1.getBlock(data_1.data(), 0, 0, radar_grid.width(),
+            radar_grid.length(), 1);
+    rtc_2.getBlock(data_2.data(), 0, 0, radar_grid.width(),
+            radar_grid.length(), 1);
+    for (size_t i = 0; i < radar_grid.length(); ++i)
+        for (size_t j = 0; j < radar_grid.width(); ++j)
+            if (!std::isnan(data_1(i, j)))
+                ASSERT_EQ(data_1(i, j), data_2(i, j));
+
+    // A different geometry misses the cache
+    isce3::io::Raster rtc_3("./rtc_area_cache_3.bin", radar_grid.width() - 1,
+            radar_grid.length(), 1, GDT_Float32, "ENVI");
+    isce3::geometry::computeRtc(radar_grid.offsetAndResize(0, 0,
+                                        radar_grid.length(),
+                                        radar_grid.width() - 1),
+            orbit, dop, dem, rtc_3);
+    ASSERT_EQ(isce3::geometry::getRtcAreaCacheHitCount(), 1u);
+
+    // Disabling the cache drops its entries
+    isce3::geometry::setRtcAreaCacheMemoryBudget(0);
+    EXPECT_FALSE(isce3::geometry::isRtcAreaCacheEnabled());
+    isce3::geometry::clearRtcAreaCache();
+}
+
+TEST(TestRTC, ThreadCountIndependence) {
+    isce3::io::IH5File file(TESTDATA_DIR "envisat.h5");
+    isce3::product::RadarGridProduct product(file);
+    char frequency = 'A';
+    isce3::io::Raster dem(TESTDATA_DIR "srtm_cropped.tif");
+
+    isce3::product::RadarGridParameters radar_grid =
+            isce3::product::RadarGridParameters(product, frequency)
+                    .multilook(5, 5);
+    isce3::core::Orbit orbit = product.metadata().orbit();
+    isce3::core::LUT2d<double> dop =
+            product.metadata().procInfo().dopplerCentroid(frequency);
+    dop.boundsError(false);
+
+    // Geogrid over the radar grid, on the DEM posting
+    double geotransform[6];
+    dem.getGeoTransform(geotransform);
+    const double dx = geotransform[1], dy = geotransform[5];
+    std::unique_ptr<isce3::core::ProjectionBase> proj(
+            isce3::core::createProj(dem.getEPSG()));
+    const auto bbox = isce3::geometry::getGeoBoundingBoxHeightSearch(
+            radar_grid, orbit, proj.get(), dop);
+    const isce3::product::GeoGridParameters geogrid(bbox.MinX, bbox.MaxY, dx,
+            dy, std::ceil((bbox.MaxX - bbox.MinX) / dx),
+            std::ceil((bbox.MaxY - bbox.MinY) / std::abs(dy)), dem.getEPSG());
+
+    // Small blocks, so that facets of many blocks land on the same
+    // radar-grid pixels
+    const double geogrid_upsampling = 2;
+    const int min_block_size = 8 * sizeof(float) * geogrid.width() *
+                               geogrid_upsampling;
+
+    auto run = [&](int nthreads, const std::string& suffix) {
+        const int max_threads = omp_get_max_threads();
+        omp_set_num_threads(nthreads);
+        isce3::io::Raster rtc("./rtc_threads_" + suffix + ".bin",
+                radar_grid.width(), radar_grid.length(), 1, GDT_Float32,
+                "ENVI");
+        isce3::io::Raster nlooks("./rtc_threads_nlooks_" + suffix + ".bin",
+                radar_grid.width(), radar_grid.length(), 1, GDT_Float32,
+                "ENVI");
+        isce3::geometry::computeRtcAreaProj(dem, rtc, radar_grid, orbit, dop,
+                geogrid,
+                isce3::geometry::rtcInputTerrainRadiometry::BETA_NAUGHT,
+                isce3::geometry::rtcOutputTerrainRadiometry::GAMMA_NAUGHT,
+                isce3::geometry::rtcAreaMode::AREA, geogrid_upsampling,
+                std::numeric_limits<float>::quiet_NaN(), 1, nullptr, nullptr,
+                &nlooks, isce3::core::MemoryModeBlockY::AutoBlocksY,
+                isce3::core::dataInterpMethod::BIQUINTIC_METHOD, 1e-8, 100,
+                1e-8, min_block_size);
+        omp_set_num_threads(max_threads);
+
+        isce3::core::Matrix<float> data(
+                2 * radar_grid.length(), radar_grid.width());
+        rtc.getBlock(data.data(), 0, 0, radar_grid.width(),
+                radar_grid.length(), 1);
+        nlooks.getBlock(data.data() + radar_grid.length() * radar_grid.width(),
+                0, 0, radar_grid.width(), radar_grid.length(), 1);
+        return data;
+    };
+
+    const auto reference = run(1, "1");
+    size_t n_valid = 0;
+    for (int nthreads : {2, 4, 7}) {
+        const auto data = run(nthreads, std::to_string(nthreads));
+        for (Eigen::Index k = 0; k < reference.size(); ++k) {
+            if (std::isnan(reference.data()[k])) {
+                ASSERT_TRUE(std::isnan(data.data()[k]));
+                continue;
+            }
+            ASSERT_EQ(data.data()[k], reference.data()[k])
+                    << nthreads << " threads, element " << k;
+            n_valid += reference.data()[k] > 0;
+        }
+    }
+    EXPECT_GT(n_valid, 0);
+}
+
 int main(int argc, char* argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -9,11 +9,13 @@
 #include <complex>
 #include <string>
 #include <sstream>
+#include <valarray>
 #include <gtest/gtest.h>
 #include <cpl_conv.h>
 
 // isce3::core
 #include "isce3/core/Constants.h"
+#include "isce3/core/Poly2d.h"
 #include "isce3/core/Serialization.h"
 
 // isce3::io
@@ -24,6 +26,7 @@
 #include "isce3/product/RadarGridProduct.h"
 
 // isce3::image
+#include "isce3/image/OffsetModel.h"
 #include "isce3/image/ResampSlc.h"
 
 
@@ -51,6 +54,9 @@ TEST(ResampSlcTest, Resamp) {
     
     // Set lines per tile to be a weird multiple of the number of output lines
     resamp.linesPerTile(249);
+    // Keep more tiles in flight in the read/interpolate/write pipeline
+    resamp.tilesInFlight(4);
+    ASSERT_EQ(resamp.tilesInFlight(), 4);
     // Re-run resamp
     resamp.resamp(input_data, "warped.slc",
                   TESTDATA_DIR "offsets/range.off", TESTDATA_DIR "offsets/azimuth.off");
@@ -79,6 +85,127 @@ TEST(ResampSlcTest, Validate) {
     ASSERT_LT(abs_error, 1.0e-6);
 }
 
+// Resample two bands in a single pass and compare with single band output
+TEST(ResampSlcTest, MultiBand) {
+    const std::string filename = TESTDATA_DIR "envisat.h5";
+    isce3::io::IH5File file(filename);
+    isce3::product::RadarGridProduct product(file);
+    isce3::image::ResampSlc resamp(product);
+    resamp.linesPerTile(249);
+
+    const std::string input_data = "HDF5:\"" + filename +
+        "\"://science/LSAR/SLC/swaths/frequencyA/HH";
+    isce3::io::Raster inputSlc(input_data, GA_ReadOnly);
+    isce3::io::Raster rgOffRaster(TESTDATA_DIR "offsets/range.off", GA_ReadOnly);
+    isce3::io::Raster azOffRaster(TESTDATA_DIR "offsets/azimuth.off", GA_ReadOnly);
+
+    const size_t width = rgOffRaster.width();
+    const size_t length = rgOffRaster.length();
+    isce3::io::Raster outputSlc1("warped_band1.slc", width, length, 1,
+                                 GDT_CFloat32, "ISCE");
+    isce3::io::Raster outputSlc2("warped_band2.slc", width, length, 1,
+                                 GDT_CFloat32, "ISCE");
+
+    // Same input band twice
+    resamp.resamp({inputSlc, inputSlc}, {outputSlc1, outputSlc2},
+                  rgOffRaster, azOffRaster, {1, 1});
+
+    isce3::io::Raster singleSlc("warped.slc");
+    std::valarray<std::complex<float>> single(width * length);
+    std::valarray<std::complex<float>> band1(width * length);
+    std::valarray<std::complex<float>> band2(width * length);
+    singleSlc.getBlock(single, 0, 0, width, length);
+    outputSlc1.getBlock(band1, 0, 0, width, length);
+    outputSlc2.getBlock(band2, 0, 0, width, length);
+
+    for (size_t i = 0; i < single.size(); ++i) {
+        ASSERT_EQ(band1[i], band2[i]);
+        ASSERT_LT(std::abs(band1[i] - single[i]), 1.0e-6);
+    }
+}
+
+// Offsets evaluated from models match the same offsets read from rasters
+TEST(ResampSlcTest, OffsetModel) {
+    const std::string filename = TESTDATA_DIR "envisat.h5";
+    isce3::io::IH5File file(filename);
+    isce3::product::RadarGridProduct product(file);
+    isce3::image::ResampSlc resamp(product);
+    resamp.linesPerTile(249);
+
+    const std::string input_data = "HDF5:\"" + filename +
+        "\"://science/LSAR/SLC/swaths/frequencyA/HH";
+    isce3::io::Raster inputSlc(input_data, GA_ReadOnly);
+    const size_t width = inputSlc.width();
+    const size_t length = inputSlc.length();
+
+    // Range offsets linear in pixel, constant azimuth offsets
+    isce3::core::Poly2d rgPoly(1, 0, 0.0, 0.0, 1.0, 1.0);
+    rgPoly.setCoeff(0, 0, 0.25);
+    rgPoly.setCoeff(0, 1, 1.0e-3);
+    isce3::core::Poly2d azPoly(0, 0, 0.0, 0.0, 1.0, 1.0);
+    azPoly.setCoeff(0, 0, -0.5);
+    const isce3::image::OffsetModel rgModel(rgPoly);
+    const isce3::image::OffsetModel azModel(azPoly);
+
+    // Same offsets written to rasters
+    std::valarray<float> rgOff(width * length), azOff(width * length);
+    for (size_t i = 0; i < length; ++i) {
+        for (size_t j = 0; j < width; ++j) {
+            rgOff[i * width + j] = rgModel.eval(i, j);
+            azOff[i * width + j] = azModel.eval(i, j);
+        }
+    }
+    isce3::io::Raster rgOffRaster("model_range.off", width, length, 1,
+                                  GDT_Float32, "ISCE");
+    isce3::io::Raster azOffRaster("model_azimuth.off", width, length, 1,
+                                  GDT_Float32, "ISCE");
+    rgOffRaster.setBlock(rgOff, 0, 0, width, length);
+    azOffRaster.setBlock(azOff, 0, 0, width, length);
+
+    isce3::io::Raster rasterSlc("warped_offset_raster.slc", width, length, 1,
+                                GDT_CFloat32, "ISCE");
+    isce3::io::Raster modelSlc("warped_offset_model.slc", width, length, 1,
+                               GDT_CFloat32, "ISCE");
+    resamp.resamp(inputSlc, rasterSlc, rgOffRaster, azOffRaster);
+    resamp.resamp({inputSlc}, {modelSlc}, rgModel, azModel, length, width);
+
+    std::valarray<std::complex<float>> fromRaster(width * length);
+    std::valarray<std::complex<float>> fromModel(width * length);
+    rasterSlc.getBlock(fromRaster, 0, 0, width, length);
+    modelSlc.getBlock(fromModel, 0, 0, width, length);
+    for (size_t i = 0; i < fromRaster.size(); ++i) {
+        ASSERT_EQ(fromRaster[i], fromModel[i]);
+    }
+}
+
+// Errors evaluating the models on the reader thread reach the caller
+TEST(ResampSlcTest, OffsetModelOutOfBounds) {
+    const std::string filename = TESTDATA_DIR "envisat.h5";
+    isce3::io::IH5File file(filename);
+    isce3::product::RadarGridProduct product(file);
+    isce3::image::ResampSlc resamp(product);
+    resamp.linesPerTile(249);
+
+    const std::string input_data = "HDF5:\"" + filename +
+        "\"://science/LSAR/SLC/swaths/frequencyA/HH";
+    isce3::io::Raster inputSlc(input_data, GA_ReadOnly);
+    const size_t width = inputSlc.width();
+    const size_t length = inputSlc.length();
+
+    // Residual grid covering the first half of the lines only
+    isce3::core::Matrix<double> residual(2, 2);
+    residual.zeros();
+    const isce3::core::LUT2d<double> halfGrid(0.0, 0.0, width - 1.0,
+                                              length / 2.0, residual);
+    const isce3::image::OffsetModel rgModel(halfGrid);
+    const isce3::image::OffsetModel azModel;
+
+    isce3::io::Raster outputSlc("warped_offset_bounds.slc", width, length, 1,
+                                GDT_CFloat32, "ISCE");
+    EXPECT_ANY_THROW(resamp.resamp({inputSlc}, {outputSlc}, rgModel, azModel,
+                                   length, width));
+}
+
 int main(int argc, char * argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
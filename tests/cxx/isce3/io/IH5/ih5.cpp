@@ -1,5 +1,7 @@
 //
 
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <gtest/gtest.h>
 
@@ -1168,6 +1170,237 @@ TEST_F(IH5Test, createFloat16Dataset) {
 }
 
 
+TEST_F(IH5Test, chunkDimensions) {
+
+    const std::vector<hsize_t> dims {1000, 3000};
+
+    // Full-width blocks of rows
+    auto chunks = isce3::io::chunkDimensions(dims, 8,
+                                             isce3::io::ChunkLayout::Rows);
+    ASSERT_EQ(chunks.size(), 2);
+    EXPECT_EQ(chunks[1], dims[1]);
+    EXPECT_EQ(chunks[0], isce3::io::chunkTargetBytes / 8 / dims[1]);
+
+    // Square tiles
+    chunks = isce3::io::chunkDimensions(dims, 8, isce3::io::ChunkLayout::Tiles);
+    EXPECT_EQ(chunks[0], chunks[1]);
+    EXPECT_LE(chunks[0] * chunks[1] * 8, isce3::io::chunkTargetBytes);
+
+    // Chunks are clamped to small datasets
+    chunks = isce3::io::chunkDimensions({10, 20}, 4);
+    EXPECT_EQ(chunks[0], 10);
+    EXPECT_EQ(chunks[1], 20);
+}
+
+
+TEST_F(IH5Test, writeChunks) {
+
+    isce3::io::IH5File fic;
+    EXPECT_NO_THROW(fic = isce3::io::IH5File(wFileName,'w'));
+    isce3::io::IGroup grp = fic.openGroup("/");
+
+    // Edge chunks are partial
+    const std::array<size_t, 2> dims {300, 500};
+    const std::vector<hsize_t> chunkDims {128, 96};
+    std::vector<std::complex<float>> v(dims[0] * dims[1]);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = std::complex<float>(i % 251, i % 17);
+
+    // Filters handled by parallel chunk writes, then a fallback (NBIT)
+    struct Case { std::string name; int shuffle; int deflate; };
+    for (const auto& c : {Case{"chunked", 0, 0}, Case{"shuffled", 1, 0},
+                          Case{"deflated", 0, 6}, Case{"compressed", 1, 6}}) {
+        isce3::io::IDataSet dset = grp.createDataSet<std::complex<float>>(
+                c.name, dims, 1, c.shuffle, c.deflate, chunkDims);
+        dset.writeChunks(v.data(), v.size());
+
+        std::vector<std::complex<float>> vr;
+        dset.read(vr);
+        ASSERT_EQ(vr, v);
+        ASSERT_EQ(dset.getChunkSize(), std::vector<int>({128, 96}));
+    }
+
+    // Full writes go through writeChunks
+    for (const std::string name : {"fullVector", "fullValarray"}) {
+        isce3::io::IDataSet dset = grp.createDataSet<std::complex<float>>(
+                name, dims, 1, 1, 6, chunkDims);
+        if (name == "fullVector")
+            dset.write(v);
+        else
+            dset.write(std::valarray<std::complex<float>>(v.data(), v.size()));
+        std::vector<std::complex<float>> vr;
+        dset.read(vr);
+        ASSERT_EQ(vr, v);
+    }
+
+    std::vector<float> f(dims[0] * dims[1]);
+    std::iota(f.begin(), f.end(), 0.0f);
+    isce3::io::IDataSet dset = grp.createDataSet<isce3::io::float16>(
+            std::string("float16"), dims, 1, 0, 6);
+    dset.writeChunks(f.data(), f.size());
+    std::vector<float> fr;
+    dset.read(fr);
+    ASSERT_EQ(fr.size(), f.size());
+    EXPECT_EQ(fr[100], f[100]);
+}
+
+// Reading windows with parallel inflating of chunks
+TEST_F(IH5Test, readChunks) {
+
+    isce3::io::IH5File fic;
+    EXPECT_NO_THROW(fic = isce3::io::IH5File(wFileName,'w'));
+    isce3::io::IGroup grp = fic.openGroup("/");
+
+    const std::array<size_t, 2> dims {300, 500};
+    const std::vector<hsize_t> chunkDims {128, 96};
+    std::vector<std::complex<float>> v(dims[0] * dims[1]);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = std::complex<float>(i % 251, i % 17);
+
+    // Window straddling partial and edge chunks
+    const std::vector<hsize_t> start {37, 50};
+    const std::vector<hsize_t> count {263, 413};
+
+    struct Case { std::string name; int shuffle; int deflate; };
+    for (const auto& c : {Case{"readChunked", 0, 0},
+                          Case{"readShuffled", 1, 0},
+                          Case{"readDeflated", 0, 6},
+                          Case{"readCompressed", 1, 6}}) {
+        isce3::io::IDataSet dset = grp.createDataSet<std::complex<float>>(
+                c.name, dims, 1, c.shuffle, c.deflate, chunkDims);
+        dset.write(v);
+
+        std::vector<std::complex<float>> vr(count[0] * count[1]);
+#ifndef ISCE3_HAVE_ZLIB
+        // Without zlib, deflated chunks are left to the HDF5 filter pipeline
+        if (c.deflate != 0) {
+            EXPECT_FALSE(dset.readChunks(vr.data(), start, count));
+            continue;
+        }
+#endif
+        ASSERT_TRUE(dset.readChunks(vr.data(), start, count));
+        for (size_t i = 0; i < count[0]; ++i)
+            for (size_t j = 0; j < count[1]; ++j)
+                ASSERT_EQ(vr[i * count[1] + j],
+                          v[(start[0] + i) * dims[1] + start[1] + j]);
+    }
+
+    // Chunks never written are not supported
+    isce3::io::IDataSet dset = grp.createDataSet<std::complex<float>>(
+            std::string("readPartial"), dims, 1, 1, 6, chunkDims);
+    const std::array<int, 2> wstart {0, 0}, wcount {128, 96}, wstride {1, 1};
+    std::vector<std::complex<float>> w(wcount[0] * wcount[1]);
+    dset.write(w, wstart, wcount, wstride);
+    std::vector<std::complex<float>> vr(count[0] * count[1]);
+    EXPECT_FALSE(dset.readChunks(vr.data(), start, count));
+#ifdef ISCE3_HAVE_ZLIB
+    EXPECT_TRUE(dset.readChunks(vr.data(), {0, 0}, {128, 96}));
+#endif
+
+    // Chunk cache holding a full-width row of chunks
+    dset.close();
+    grp.close();
+    fic.close();
+    fic = isce3::io::IH5File(wFileName, 'r');
+    isce3::io::IDataSet rows = fic.openDataSet("/readCompressed",
+            isce3::io::ChunkLayout::Rows);
+    size_t nslots, nbytes;
+    double w0;
+    hid_t dapl = H5Dget_access_plist(rows.getId());
+    H5Pget_chunk_cache(dapl, &nslots, &nbytes, &w0);
+    H5Pclose(dapl);
+    EXPECT_EQ(nbytes, 6 * 128 * 96 * sizeof(std::complex<float>));
+    EXPECT_GE(nslots, 600);
+    EXPECT_EQ(w0, 1.0);
+}
+
+// Bit rounding of floating point mantissas
+TEST_F(IH5Test, roundMantissa) {
+
+    // Round to nearest, ties to even
+    std::vector<float> f {1.0f, 1.75f, 1.625f, 1.875f, -1.375f,
+                          std::numeric_limits<float>::quiet_NaN(),
+                          std::numeric_limits<float>::infinity()};
+    auto error = isce3::io::roundMantissa(f.data(), f.size(), 2);
+    EXPECT_EQ(f[0], 1.0f);
+    EXPECT_EQ(f[1], 1.75f);
+    EXPECT_EQ(f[2], 1.5f);
+    EXPECT_EQ(f[3], 2.0f);
+    EXPECT_EQ(f[4], -1.5f);
+    EXPECT_TRUE(std::isnan(f[5]));
+    EXPECT_TRUE(std::isinf(f[6]));
+    EXPECT_EQ(error.count, 5);
+    EXPECT_DOUBLE_EQ(error.maxAbsolute, 0.125);
+    EXPECT_DOUBLE_EQ(error.maxRelative, 0.125 / 1.375);
+
+    // Relative error is bounded by half a unit in the last kept bit
+    std::vector<std::complex<double>> z(1000);
+    for (size_t i = 0; i < z.size(); ++i)
+        z[i] = std::complex<double>(std::sin(0.1 * i) * 1e3, 1.0 / (i + 1));
+    const auto zin = z;
+    error = isce3::io::roundMantissa(z.data(), z.size(), 10);
+    EXPECT_EQ(error.count, 2 * z.size());
+    EXPECT_LE(error.maxRelative, std::pow(2.0, -11));
+    EXPECT_GT(error.rms(), 0.0);
+    for (size_t i = 0; i < z.size(); ++i)
+        EXPECT_LE(std::abs(z[i].imag() - zin[i].imag()),
+                  std::pow(2.0, -11) * std::abs(zin[i].imag()));
+
+    // Nothing to drop
+    std::vector<float> g {0.1f};
+    error = isce3::io::roundMantissa(g.data(), g.size(), 23);
+    EXPECT_EQ(g[0], 0.1f);
+    EXPECT_EQ(error.count, 0);
+    EXPECT_THROW(isce3::io::roundMantissa(g.data(), g.size(), 0),
+                 isce3::except::InvalidArgument);
+}
+
+// Datasets with a number of significant bits are written rounded
+TEST_F(IH5Test, significantBits) {
+
+    isce3::io::IH5File fic;
+    EXPECT_NO_THROW(fic = isce3::io::IH5File(wFileName,'w'));
+    isce3::io::IGroup grp = fic.openGroup("/");
+
+    const std::array<size_t, 2> dims {256, 256};
+    std::vector<float> v(dims[0] * dims[1]);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = std::sin(0.001f * i) + 0.01f * std::cos(0.37f * i);
+
+    isce3::io::IDataSet full = grp.createDataSet<float>(
+            std::string("groomFull"), dims, 1, 1, 4);
+    full.writeChunks(v.data(), v.size());
+    EXPECT_EQ(full.getSignificantBits(), 0);
+    EXPECT_EQ(full.quantizationError().count, 0);
+
+    isce3::io::IDataSet groomed = grp.createDataSet<float>(
+            std::string("groomRounded"), dims, 1, 1, 4);
+    groomed.setSignificantBits(8);
+    EXPECT_EQ(groomed.getSignificantBits(), 8);
+    groomed.write(v);
+
+    const auto& error = groomed.quantizationError();
+    EXPECT_EQ(error.count, v.size());
+    EXPECT_LE(error.maxRelative, std::pow(2.0, -9));
+
+    std::vector<float> vr;
+    groomed.read(vr);
+    auto expected = v;
+    isce3::io::roundMantissa(expected.data(), expected.size(), 8);
+    EXPECT_EQ(vr, expected);
+
+    // Rounded data compresses better
+    EXPECT_LT(groomed.getStorageSize(), full.getStorageSize() * 3 / 4);
+
+    // The setting is stored with the dataset
+    isce3::io::IDataSet reopened = grp.openDataSet("groomRounded");
+    EXPECT_EQ(reopened.getSignificantBits(), 8);
+
+    groomed.setSignificantBits(0);
+    EXPECT_EQ(groomed.getSignificantBits(), 0);
+}
+
+
 int main( int argc, char * argv[] ) {
     testing::InitGoogleTest( &argc, argv );
     return RUN_ALL_TESTS();
@@ -0,0 +1,114 @@
+#include <array>
+#include <cstdio>
+#include <future>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <isce3/except/Error.h>
+#include <isce3/io/DataStream.h>
+#include <isce3/io/IH5.h>
+#include <isce3/io/Raster.h>
+
+TEST(DataStreamTest, Enqueue)
+{
+    isce3::io::DataStream stream;
+
+    // Operations complete in order
+    std::vector<int> order;
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 16; ++i) {
+        results.push_back(stream.enqueue([&order, i]() {
+            order.push_back(i);
+            return i;
+        }));
+    }
+    stream.synchronize();
+    EXPECT_EQ(stream.pending(), 0);
+
+    std::vector<int> expected(16);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(order, expected);
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(results[i].get(), i);
+}
+
+TEST(DataStreamTest, Errors)
+{
+    isce3::io::DataStream stream;
+    auto failed = stream.enqueue([]() {
+        throw isce3::except::RuntimeError(ISCE_SRCINFO(), "I/O failure");
+    });
+    auto next = stream.enqueue([]() { return 1; });
+
+    // Errors are reported by the future and by synchronize, once
+    EXPECT_THROW(failed.get(), isce3::except::RuntimeError);
+    EXPECT_EQ(next.get(), 1);
+    EXPECT_THROW(stream.synchronize(), isce3::except::RuntimeError);
+    EXPECT_NO_THROW(stream.synchronize());
+}
+
+TEST(DataStreamTest, RasterStoreThenLoad)
+{
+    const std::size_t width = 40;
+    const std::size_t length = 30;
+    const std::size_t blockLength = 7;
+    const std::string filename = "./datastream_raster.bin";
+    std::remove(filename.c_str());
+    isce3::io::Raster raster(filename, width, length, 2, GDT_Float32, "ENVI");
+
+    isce3::io::RasterDataStream stream(&raster);
+    EXPECT_EQ(stream.raster(), &raster);
+
+    // Store blocks of each band, reusing the same source buffer
+    std::vector<float> src(width * blockLength);
+    for (std::size_t band = 1; band <= 2; ++band) {
+        for (std::size_t row = 0; row < length; row += blockLength) {
+            const std::size_t nrows = std::min(blockLength, length - row);
+            for (std::size_t i = 0; i < nrows * width; ++i)
+                src[i] = band * 10000.0f + row * width + i;
+            stream.store(src.data(), 0, row, width, nrows, band);
+        }
+    }
+
+    // Load the second band after the stores
+    std::vector<float> dst(width * length);
+    auto loaded = stream.load(dst.data(), 0, 0, width, length, 2);
+    loaded.get();
+    for (std::size_t i = 0; i < width * length; ++i)
+        ASSERT_EQ(dst[i], 20000.0f + i);
+}
+
+TEST(DataStreamTest, H5StoreThenLoad)
+{
+    const std::string filename = "./datastream.h5";
+    std::remove(filename.c_str());
+    isce3::io::IH5File file(filename, 'x');
+    isce3::io::IGroup group = file.openGroup("/");
+
+    // 3D dataset of two bands
+    const std::array<int, 3> dims {2, 30, 40};
+    isce3::io::IDataSet dataset = group.createDataSet<float>(
+            std::string("data"), dims);
+
+    isce3::io::H5DataStream stream(&dataset);
+    std::vector<float> src(20 * 10);
+    std::iota(src.begin(), src.end(), 0.0f);
+    stream.store(src.data(), 5, 3, 20, 10, 2);
+
+    std::vector<float> dst(20 * 10);
+    stream.load(dst.data(), 5, 3, 20, 10, 2).get();
+    EXPECT_EQ(dst, src);
+
+    // Out of range blocks report HDF5 errors
+    stream.load(dst.data(), 30, 0, 20, 10, 1);
+    EXPECT_ANY_THROW(stream.synchronize());
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
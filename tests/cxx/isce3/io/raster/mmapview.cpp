@@ -0,0 +1,177 @@
+#include <complex>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "isce3/except/Error.h"
+#include "isce3/io/Raster.h"
+#include "isce3/io/RasterView.h"
+
+struct RasterViewTest : public ::testing::Test {
+    const size_t width = 37;
+    const size_t length = 23;
+    const std::string filename = "mmapview.bin";
+
+    std::complex<float> value(size_t i, size_t j) const
+    {
+        return {static_cast<float>(i), static_cast<float>(j)};
+    }
+};
+
+// Write in place through a view and read back through the Raster API
+TEST_F(RasterViewTest, WriteInPlace)
+{
+    std::remove(filename.c_str());
+    {
+        isce3::io::Raster raster(filename, width, length, 1, GDT_CFloat32,
+                                 "ENVI");
+        ASSERT_TRUE(isce3::io::RasterView<std::complex<float>>::isMappable(
+                raster));
+        isce3::io::RasterView<std::complex<float>> view(raster);
+        ASSERT_EQ(view.width(), width);
+        ASSERT_EQ(view.length(), length);
+        ASSERT_TRUE(view.contiguousRows());
+        for (size_t i = 0; i < length; ++i) {
+            std::complex<float>* row = view.row(i);
+            for (size_t j = 0; j < width; ++j)
+                row[j] = value(i, j);
+        }
+    }
+
+    isce3::io::Raster raster(filename);
+    std::vector<std::complex<float>> data(width * length);
+    raster.getBlock(data, 0, 0, width, length);
+    for (size_t i = 0; i < length; ++i)
+        for (size_t j = 0; j < width; ++j)
+            ASSERT_EQ(data[i * width + j], value(i, j));
+}
+
+// Read elements and blocks written through the Raster API
+TEST_F(RasterViewTest, Read)
+{
+    std::remove(filename.c_str());
+    {
+        isce3::io::Raster raster(filename, width, length, 1, GDT_CFloat32,
+                                 "ENVI");
+        std::vector<std::complex<float>> data(width * length);
+        for (size_t i = 0; i < length; ++i)
+            for (size_t j = 0; j < width; ++j)
+                data[i * width + j] = value(i, j);
+        raster.setBlock(data, 0, 0, width, length);
+    }
+
+    isce3::io::Raster raster(filename);
+    const isce3::io::RasterView<std::complex<float>> view(raster);
+    for (size_t i = 0; i < length; ++i)
+        for (size_t j = 0; j < width; ++j)
+            ASSERT_EQ(view(i, j), value(i, j));
+
+    const auto block = view.block(3, 5, 7, 11);
+    for (int i = 0; i < block.rows(); ++i)
+        for (int j = 0; j < block.cols(); ++j)
+            ASSERT_EQ(block(i, j), value(i + 3, j + 5));
+}
+
+// Prefetch hints leave the contents alone and ignore rows past the end
+TEST_F(RasterViewTest, Prefetch)
+{
+    std::remove(filename.c_str());
+    {
+        isce3::io::Raster raster(filename, width, length, 1, GDT_CFloat32,
+                                 "ENVI");
+        std::vector<std::complex<float>> data(width * length);
+        for (size_t i = 0; i < length; ++i)
+            for (size_t j = 0; j < width; ++j)
+                data[i * width + j] = value(i, j);
+        raster.setBlock(data, 0, 0, width, length);
+    }
+
+    isce3::io::Raster raster(filename);
+    const isce3::io::RasterView<std::complex<float>> view(raster);
+    view.prefetchRows(0, length);
+    view.prefetchRows(5, 3);
+    view.prefetchRows(length - 2, 10);
+    view.prefetchRows(length, 1);
+    view.prefetchRows(0, 0);
+    for (size_t i = 0; i < length; ++i)
+        for (size_t j = 0; j < width; ++j)
+            ASSERT_EQ(view(i, j), value(i, j));
+}
+
+// Views of a band interleaved by pixel file have strided rows
+TEST_F(RasterViewTest, PixelInterleaved)
+{
+    const std::string bipFilename = "mmapview_bip.bin";
+    std::remove(bipFilename.c_str());
+    GDALAllRegister();
+    GDALDriver* driver = GetGDALDriverManager()->GetDriverByName("ENVI");
+    char** options = CSLSetNameValue(nullptr, "INTERLEAVE", "BIP");
+    GDALDataset* dataset = driver->Create(bipFilename.c_str(), width, length,
+                                          2, GDT_Float32, options);
+    CSLDestroy(options);
+    isce3::io::Raster raster(dataset);
+
+    std::vector<float> band1(width * length), band2(width * length);
+    for (size_t k = 0; k < band1.size(); ++k) {
+        band1[k] = k;
+        band2[k] = -1.0f * k;
+    }
+    raster.setBlock(band1, 0, 0, width, length, 1);
+    raster.setBlock(band2, 0, 0, width, length, 2);
+    raster.dataset()->FlushCache();
+
+    const isce3::io::RasterView<float> view(raster, 2);
+    EXPECT_FALSE(view.contiguousRows());
+    const auto block = view.block(0, 0, length, width);
+    for (size_t i = 0; i < length; ++i)
+        for (size_t j = 0; j < width; ++j)
+            ASSERT_EQ(block(i, j), band2[i * width + j]);
+}
+
+// Views must match the raster datatype
+TEST_F(RasterViewTest, Datatype)
+{
+    std::remove(filename.c_str());
+    isce3::io::Raster raster(filename, width, length, 1, GDT_Float32, "ENVI");
+    EXPECT_FALSE(isce3::io::RasterView<double>::isMappable(raster));
+    EXPECT_THROW(isce3::io::RasterView<double> view(raster),
+                 isce3::except::RuntimeError);
+}
+
+// Compressed rasters are not mapped through a copy to a page cache
+TEST_F(RasterViewTest, Compressed)
+{
+    const std::string tifFilename = "mmapview_deflate.tif";
+    std::remove(tifFilename.c_str());
+    GDALAllRegister();
+    GDALDriver* driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+    char** options = CSLSetNameValue(nullptr, "COMPRESS", "DEFLATE");
+    GDALDataset* dataset = driver->Create(tifFilename.c_str(), width, length,
+                                          1, GDT_Float32, options);
+    CSLDestroy(options);
+    isce3::io::Raster raster(dataset);
+
+    EXPECT_FALSE(isce3::io::RasterView<float>::isMappable(raster));
+    EXPECT_THROW(isce3::io::RasterView<float> view(raster),
+                 isce3::except::RuntimeError);
+}
+
+// Views of bands the raster does not have are rejected
+TEST_F(RasterViewTest, BadBand)
+{
+    std::remove(filename.c_str());
+    isce3::io::Raster raster(filename, width, length, 1, GDT_Float32, "ENVI");
+    EXPECT_FALSE(isce3::io::RasterView<float>::isMappable(raster, 2));
+    EXPECT_THROW(isce3::io::RasterView<float> view(raster, 2),
+                 isce3::except::OutOfRange);
+    EXPECT_THROW(isce3::io::RasterView<float> view(raster, 0),
+                 isce3::except::OutOfRange);
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,198 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "isce3/except/Error.h"
+#include "isce3/io/Raster.h"
+#include "isce3/io/RasterBlockCache.h"
+
+class RasterBlockCacheTest : public ::testing::Test {
+public:
+    const size_t width = 120;
+    const size_t length = 1000;
+    const size_t nthreads = 4;
+
+    float value(size_t i, size_t j) const
+    {
+        return static_cast<float>(i * width + j);
+    }
+
+    void initTestRaster(const std::string& filename)
+    {
+        std::remove(filename.c_str());
+        isce3::io::Raster raster(filename, width, length, 1, GDT_Float32,
+                                 "GTiff");
+        std::vector<float> data(width * length);
+        for (size_t i = 0; i < length; ++i)
+            for (size_t j = 0; j < width; ++j)
+                data[i * width + j] = value(i, j);
+        raster.setBlock(data, 0, 0, width, length);
+    }
+};
+
+// Concurrent reads of disjoint windows with frequent evictions
+TEST_F(RasterBlockCacheTest, ConcurrentReads)
+{
+    const std::string filename = "blockcache_read.tif";
+    initTestRaster(filename);
+
+    isce3::io::Raster raster(filename);
+    // Budget of a few blocks of 32 lines
+    isce3::io::RasterBlockCache<float> cache(raster, 32,
+                                             8 * 32 * width * sizeof(float),
+                                             2, 4);
+
+    // Windows of 37 lines and 50 pixels straddling block boundaries
+    const size_t winLength = 37, winWidth = 50;
+    std::vector<int> errors(nthreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nthreads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<float> buffer(winLength * winWidth);
+            for (size_t y0 = t * winLength; y0 + winLength <= length;
+                 y0 += nthreads * winLength) {
+                const size_t x0 = (y0 / winLength) % (width - winWidth);
+                cache.getBlock(buffer.data(), x0, y0, winWidth, winLength);
+                for (size_t i = 0; i < winLength; ++i)
+                    for (size_t j = 0; j < winWidth; ++j)
+                        if (buffer[i * winWidth + j] !=
+                            value(y0 + i, x0 + j))
+                            ++errors[t];
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < nthreads; ++t)
+        EXPECT_EQ(errors[t], 0);
+}
+
+// Partial block reads of a sequential scan are served from the cache
+TEST_F(RasterBlockCacheTest, SequentialReads)
+{
+    const std::string filename = "blockcache_read.tif";
+    initTestRaster(filename);
+
+    isce3::io::Raster raster(filename);
+    isce3::io::RasterBlockCache<float> cache(raster, 40);
+
+    std::vector<float> line(width);
+    for (size_t i = 0; i < length; ++i) {
+        cache.getBlock(line.data(), 0, i, width, 1);
+        for (size_t j = 0; j < width; ++j)
+            ASSERT_EQ(line[j], value(i, j));
+    }
+    // At most one load per block, all other lines are hits
+    EXPECT_GE(cache.hits(), length - length / cache.blockLength());
+    // Blocks loaded by read-ahead are only counted when requested
+    EXPECT_EQ(cache.hits() + cache.misses(), length);
+}
+
+// The number of shards is reduced to keep the cache within its budget
+TEST_F(RasterBlockCacheTest, MemoryBudget)
+{
+    const std::string filename = "blockcache_read.tif";
+    initTestRaster(filename);
+
+    isce3::io::Raster raster(filename);
+    const size_t blockBytes = 32 * width * sizeof(float);
+    isce3::io::RasterBlockCache<float> cache(raster, 32, 3 * blockBytes, 2,
+                                             16);
+    EXPECT_EQ(cache.numShards(), 3);
+
+    // A budget smaller than a block still caches one block
+    isce3::io::RasterBlockCache<float> small(raster, 32, blockBytes / 2, 0,
+                                             16);
+    EXPECT_EQ(small.numShards(), 1);
+    std::vector<float> line(width);
+    small.getBlock(line.data(), 0, 0, width, 1);
+    small.getBlock(line.data(), 0, 1, width, 1);
+    EXPECT_EQ(small.misses(), 1);
+    EXPECT_EQ(small.hits(), 1);
+}
+
+// Concurrent writes of disjoint windows are written back to the raster
+TEST_F(RasterBlockCacheTest, WriteBehind)
+{
+    const std::string filename = "blockcache_write.tif";
+    std::remove(filename.c_str());
+    {
+        isce3::io::Raster raster(filename, width, length, 1, GDT_Float32,
+                                 "GTiff");
+        isce3::io::RasterBlockCache<float> cache(raster, 32,
+                                                 4 * 32 * width *
+                                                         sizeof(float),
+                                                 0, 4);
+
+        // Each thread writes every other pixel column range of its lines
+        const size_t winLength = 25;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < nthreads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (size_t y0 = t * winLength; y0 < length;
+                     y0 += nthreads * winLength) {
+                    for (size_t x0 = 0; x0 < width; x0 += width / 2) {
+                        std::vector<float> buffer(winLength * width / 2);
+                        for (size_t i = 0; i < winLength; ++i)
+                            for (size_t j = 0; j < width / 2; ++j)
+                                buffer[i * width / 2 + j] =
+                                        value(y0 + i, x0 + j);
+                        cache.setBlock(buffer.data(), x0, y0, width / 2,
+                                       winLength);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        // Remaining blocks are written on destruction
+    }
+
+    isce3::io::Raster raster(filename);
+    std::vector<float> data(width * length);
+    raster.getBlock(data, 0, 0, width, length);
+    for (size_t i = 0; i < length; ++i)
+        for (size_t j = 0; j < width; ++j)
+            ASSERT_EQ(data[i * width + j], value(i, j));
+}
+
+// Failed write backs of evicted blocks leave the cache consistent
+TEST_F(RasterBlockCacheTest, FailedWriteBack)
+{
+    const std::string filename = "blockcache_read.tif";
+    initTestRaster(filename);
+
+    // Read-only raster with room for a single block
+    isce3::io::Raster raster(filename);
+    isce3::io::RasterBlockCache<float> cache(raster, 32,
+                                             32 * width * sizeof(float), 0, 1);
+
+    std::vector<float> line(width, -1.0f);
+    cache.setBlock(line.data(), 0, 0, width, 1);
+
+    // Reading the next block must evict the modified one, which fails
+    std::vector<float> buffer(width);
+    EXPECT_THROW(cache.getBlock(buffer.data(), 0, 40, width, 1),
+                 isce3::except::RuntimeError);
+    // and is not served from an empty block afterwards
+    EXPECT_THROW(cache.getBlock(buffer.data(), 0, 40, width, 1),
+                 isce3::except::RuntimeError);
+
+    // The modified block is still cached
+    cache.getBlock(buffer.data(), 0, 0, width, 1);
+    for (size_t j = 0; j < width; ++j)
+        EXPECT_EQ(buffer[j], -1.0f);
+    cache.getBlock(buffer.data(), 0, 1, width, 1);
+    for (size_t j = 0; j < width; ++j)
+        EXPECT_EQ(buffer[j], value(1, j));
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <random>
+#include <vector>
+
+#include <isce3/matchtemplate/ampcor/correlators/kernels.h>
+
+// the direct and frequency domain correlations of the same pairs
+struct AmpcorCorrelateTest : public ::testing::Test {
+    std::vector<float> arena, refStats, tgtStats;
+
+    const size_t pairs = 21;
+    const size_t refRows = 24, refCols = 20;
+    const size_t tgtRows = 40, tgtCols = 34;
+    const size_t corRows = tgtRows - refRows + 1;
+    const size_t corCols = tgtCols - refCols + 1;
+
+    std::vector<float> direct, spectral;
+
+    void SetUp() override
+    {
+        auto refCells = refRows * refCols, tgtCells = tgtRows * tgtCols;
+        auto corCells = corRows * corCols;
+
+        // random amplitudes
+        arena.resize(pairs * (refCells + tgtCells));
+        std::mt19937 generator(11);
+        std::gamma_distribution<float> amplitude(2.0f, 1.0f);
+        for (auto & cell : arena)
+            cell = amplitude(generator);
+        // with a flat search window, e.g. in a zero filled area
+        auto flat = arena.begin() + 3 * (refCells + tgtCells) + refCells;
+        std::fill(flat, flat + tgtCells, 0.0f);
+
+        std::vector<float> sat(pairs * tgtCells);
+        refStats.resize(pairs);
+        tgtStats.resize(pairs * corCells);
+        ampcor::kernels::refStats(arena.data(), pairs, refRows, refCols,
+                                  refCells + tgtCells, refStats.data());
+        ampcor::kernels::sat(arena.data(), pairs, refCells, tgtCells, tgtRows,
+                             tgtCols, sat.data());
+        ampcor::kernels::tgtStats(sat.data(), pairs, refRows, refCols, tgtRows,
+                                  tgtCols, corRows, corCols, tgtStats.data());
+
+        direct.resize(pairs * corCells);
+        spectral.resize(pairs * corCells);
+        ampcor::kernels::correlateDirect(arena.data(), refStats.data(),
+                tgtStats.data(), pairs, refRows, refCols, tgtRows, tgtCols,
+                corRows, corCols, direct.data());
+        ampcor::kernels::correlateFFT(arena.data(), refStats.data(),
+                tgtStats.data(), pairs, refRows, refCols, tgtRows, tgtCols,
+                corRows, corCols, spectral.data());
+    }
+};
+
+TEST_F(AmpcorCorrelateTest, SameSurface)
+{
+    for (size_t k = 0; k < direct.size(); ++k) {
+        EXPECT_NEAR(spectral[k], direct[k], 1e-4) << "at cell " << k;
+    }
+}
+
+TEST_F(AmpcorCorrelateTest, FlatWindow)
+{
+    auto corCells = corRows * corCols;
+    for (size_t k = 3 * corCells; k < 4 * corCells; ++k) {
+        EXPECT_EQ(spectral[k], 0.0f);
+    }
+}
+
+TEST_F(AmpcorCorrelateTest, ConcurrentCalls)
+{
+    // every thread plans, correlates one pair at a time and destroys its plans
+    auto refCells = refRows * refCols, tgtCells = tgtRows * tgtCols;
+    auto corCells = corRows * corCols;
+    std::vector<float> concurrent(pairs * corCells);
+    #pragma omp parallel for num_threads(4) schedule(dynamic)
+    for (size_t pid = 0; pid < pairs; ++pid) {
+        ampcor::kernels::correlateFFT(
+                arena.data() + pid * (refCells + tgtCells),
+                refStats.data() + pid, tgtStats.data() + pid * corCells, 1,
+                refRows, refCols, tgtRows, tgtCols, corRows, corCols,
+                concurrent.data() + pid * corCells);
+    }
+    for (size_t k = 0; k < direct.size(); ++k) {
+        EXPECT_NEAR(concurrent[k], direct[k], 1e-4) << "at cell " << k;
+    }
+}
+
+TEST(AmpcorCorrelate, Selection)
+{
+    // 64 pixel chips with a +/-20 pixel search
+    EXPECT_TRUE(ampcor::kernels::useFFTCorrelation(64, 64, 104, 104, 41, 41));
+    // a search of a pixel or so is cheaper to do directly
+    EXPECT_FALSE(ampcor::kernels::useFFTCorrelation(64, 64, 66, 66, 3, 3));
+}
+
+int main(int argc, char * argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,187 @@
+#include <cmath>
+#include <complex>
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <random>
+#include <vector>
+
+#include <isce3/matchtemplate/ampcor/correlators/Parallel.h>
+
+using cell_t = std::complex<float>;
+
+// A smooth complex scene made of random Gaussian blobs that can be sampled at
+// arbitrary positions, so that shifted chips are exact.
+struct Scene {
+    struct Blob {
+        double row, col;
+        std::complex<double> weight;
+    };
+    std::vector<Blob> blobs;
+    double sigma = 1.5;
+
+    Scene(double rows, double cols, size_t count, unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        for (size_t i = 0; i < count; ++i) {
+            blobs.push_back({rows * uniform(generator), cols * uniform(generator),
+                             std::polar(0.5 + uniform(generator),
+                                        2 * M_PI * uniform(generator))});
+        }
+    }
+
+    cell_t operator()(double row, double col) const
+    {
+        std::complex<double> value = 0;
+        for (const auto & blob : blobs) {
+            double r2 = (row - blob.row) * (row - blob.row) +
+                        (col - blob.col) * (col - blob.col);
+            value += blob.weight * std::exp(-r2 / (2 * sigma * sigma));
+        }
+        return cell_t(value);
+    }
+};
+
+struct AmpcorParallelTest : public ::testing::Test {
+    const size_t pairs = 5;
+    const size_t refRows = 32, refCols = 24;
+    const size_t halfSearchRows = 10, halfSearchCols = 8;
+    const size_t tgtRows = refRows + 2 * halfSearchRows;
+    const size_t tgtCols = refCols + 2 * halfSearchCols;
+    const size_t refineFactor = 2, refineMargin = 4, zoomFactor = 8;
+
+    // the true (row, col) shift of each pair, away from the edges of the search
+    // windows where the interpolation of the correlation surface is biased
+    const std::vector<double> shifts = {
+        3.25, -2.5, -5.75, 1.125, 0.0, 0.0, 5.5, -4.25, -1.375, 4.875};
+
+    // fill a correlator with pairs of chips of the same scene, the target
+    // shifted by the offset of its pair
+    void load(ampcor::correlators::Parallel & correlator) const
+    {
+        Scene scene(120, 120, 600, 7);
+        std::vector<cell_t> ref(refRows * refCols), tgt(tgtRows * tgtCols);
+        for (size_t pid = 0; pid < pairs; ++pid) {
+            double r0 = 40 + 2 * pid, c0 = 45 - 3 * pid;
+            double dr = shifts[2 * pid], dc = shifts[2 * pid + 1];
+            for (size_t i = 0; i < refRows; ++i)
+                for (size_t j = 0; j < refCols; ++j)
+                    ref[i * refCols + j] = scene(r0 + i, c0 + j);
+            for (size_t i = 0; i < tgtRows; ++i)
+                for (size_t j = 0; j < tgtCols; ++j)
+                    tgt[i * tgtCols + j] =
+                            scene(r0 - halfSearchRows + i - dr,
+                                  c0 - halfSearchCols + j - dc);
+            correlator.addReferenceTile(pid, ref.data(), refCols);
+            correlator.addTargetTile(pid, tgt.data(), tgtCols);
+        }
+    }
+};
+
+TEST_F(AmpcorParallelTest, Offsets)
+{
+    for (int derampMethod : {0, 1}) {
+        ampcor::correlators::Parallel correlator(
+                pairs, refRows, refCols, tgtRows, tgtCols, refineFactor,
+                refineMargin, zoomFactor, 2, derampMethod);
+        load(correlator);
+        auto offsets = correlator.adjust();
+        auto snr = correlator.snr();
+        auto cov = correlator.covariance();
+
+        for (size_t pid = 0; pid < pairs; ++pid) {
+            EXPECT_NEAR(offsets[2 * pid], shifts[2 * pid], 0.1);
+            EXPECT_NEAR(offsets[2 * pid + 1], shifts[2 * pid + 1], 0.1);
+            EXPECT_GT(snr[pid], 1.0f);
+            // vanishes for the perfectly correlated pair without a shift
+            EXPECT_GE(cov[3 * pid], 0.0f);
+            EXPECT_LT(cov[3 * pid], 1.0f);
+            EXPECT_GE(cov[3 * pid + 1], 0.0f);
+            EXPECT_LT(cov[3 * pid + 1], 1.0f);
+        }
+    }
+}
+
+TEST_F(AmpcorParallelTest, BatchIndependence)
+{
+    // serial reference
+    ampcor::correlators::Parallel serial(pairs, refRows, refCols, tgtRows,
+            tgtCols, refineFactor, refineMargin, zoomFactor, 1);
+    load(serial);
+    serial.adjust();
+
+    // batches that do not divide the number of pairs
+    for (size_t batch : {2, 3, 8}) {
+        ampcor::correlators::Parallel correlator(pairs, refRows, refCols,
+                tgtRows, tgtCols, refineFactor, refineMargin, zoomFactor, batch);
+        load(correlator);
+        // run twice to exercise the reuse of the workspaces
+        correlator.adjust();
+        correlator.adjust();
+        for (size_t k = 0; k < 2 * pairs; ++k) {
+            EXPECT_NEAR(correlator.offsets()[k], serial.offsets()[k], 1e-4);
+        }
+        for (size_t k = 0; k < pairs; ++k) {
+            EXPECT_NEAR(correlator.snr()[k], serial.snr()[k],
+                        1e-4 * serial.snr()[k]);
+        }
+    }
+
+    // only the leading pairs
+    ampcor::correlators::Parallel partial(pairs, refRows, refCols, tgtRows,
+            tgtCols, refineFactor, refineMargin, zoomFactor, 2);
+    load(partial);
+    partial.adjust(3);
+    for (size_t k = 0; k < 2 * 3; ++k) {
+        EXPECT_NEAR(partial.offsets()[k], serial.offsets()[k], 1e-4);
+    }
+}
+
+TEST_F(AmpcorParallelTest, ThreadIndependence)
+{
+    // one pair per batch, so that every thread gets its own workspace
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    ampcor::correlators::Parallel serial(pairs, refRows, refCols, tgtRows,
+            tgtCols, refineFactor, refineMargin, zoomFactor, 1);
+    load(serial);
+    serial.adjust();
+
+    omp_set_num_threads(4);
+    ampcor::correlators::Parallel threaded(pairs, refRows, refCols, tgtRows,
+            tgtCols, refineFactor, refineMargin, zoomFactor, 1);
+    load(threaded);
+    // run a few times to exercise the concurrent use of the plans
+    for (int run = 0; run < 3; ++run) {
+        threaded.adjust();
+        for (size_t k = 0; k < 2 * pairs; ++k) {
+            EXPECT_EQ(threaded.offsets()[k], serial.offsets()[k]);
+        }
+        for (size_t k = 0; k < pairs; ++k) {
+            EXPECT_EQ(threaded.snr()[k], serial.snr()[k]);
+        }
+    }
+    omp_set_num_threads(maxThreads);
+}
+
+TEST(AmpcorParallel, WorkspaceFootprint)
+{
+    using ampcor::correlators::Parallel;
+    // grows with the batches and covers at least the refined tiles
+    auto one = Parallel::workspaceFootprint(32, 32, 48, 48, 2, 4, 8, 1);
+    EXPECT_GE(one, sizeof(Parallel::cell_type) * (64 * 64 + 80 * 80));
+    EXPECT_GT(Parallel::workspaceFootprint(32, 32, 48, 48, 2, 4, 8, 4), one);
+}
+
+TEST(AmpcorParallel, InvalidShapes)
+{
+    // the search window cannot hold the refinement margin
+    EXPECT_THROW(ampcor::correlators::Parallel(1, 32, 32, 36, 36, 2, 4, 8),
+                 std::runtime_error);
+}
+
+int main(int argc, char * argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
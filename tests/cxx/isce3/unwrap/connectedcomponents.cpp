@@ -0,0 +1,148 @@
+#include <cstdint> // uint32_t
+#include <gtest/gtest.h> // TEST, ASSERT_EQ, testing::InitGoogleTest, RUN_ALL_TESTS
+#include <random> // std::mt19937, std::uniform_real_distribution
+#include <vector> // std::vector
+
+#include "isce3/unwrap/ConnectedComponents.h" // isce3::unwrap::labelConnectedComponents
+
+// Reference labeling by serial flood fill in raster order
+template<class Valid, class Right, class Down>
+uint32_t floodFillLabels(
+    uint32_t * labels, size_t length, size_t width, Valid valid, Right right,
+    Down down)
+{
+    for (size_t k = 0; k < length * width; ++k) { labels[k] = 0; }
+    uint32_t ncomps = 0;
+    std::vector<size_t> queue;
+    for (size_t k0 = 0; k0 < length * width; ++k0)
+    {
+        if (!valid(k0) || labels[k0] != 0) { continue; }
+        labels[k0] = ++ncomps;
+        queue.assign(1, k0);
+        for (size_t q = 0; q < queue.size(); ++q)
+        {
+            size_t k = queue[q];
+            size_t j = k / width, i = k % width;
+            auto visit = [&](size_t n, bool link) {
+                if (link && valid(n) && labels[n] == 0)
+                {
+                    labels[n] = ncomps;
+                    queue.push_back(n);
+                }
+            };
+            if (i > 0) { visit(k-1, right(k-1)); }
+            if (i < width-1) { visit(k+1, right(k)); }
+            if (j > 0) { visit(k-width, down(k-width)); }
+            if (j < length-1) { visit(k+width, down(k)); }
+        }
+    }
+    return ncomps;
+}
+
+TEST(ConnectedComponents, RandomMask)
+{
+    // Grids smaller and larger than a block of rows, near the percolation
+    // threshold so that components span many blocks.
+    for (size_t length : {1, 5, 64, 65, 300})
+    {
+        for (float p : {0.f, 0.3f, 0.4f, 0.7f})
+        {
+            const size_t width = 123;
+            std::mt19937 generator(length);
+            std::uniform_real_distribution<float> uniform(0.f, 1.f);
+            std::vector<char> mask(length * width);
+            for (auto & m : mask) { m = uniform(generator) >= p; }
+
+            auto valid = [&](size_t k) { return mask[k] != 0; };
+            auto link = [](size_t) { return true; };
+            std::vector<uint32_t> labels(length * width), reflabels(length * width);
+            uint32_t n = isce3::unwrap::labelConnectedComponents(
+                labels.data(), length, width, valid, link, link);
+            uint32_t nref = floodFillLabels(
+                reflabels.data(), length, width, valid, link, link);
+
+            ASSERT_EQ(n, nref);
+            ASSERT_EQ(labels, reflabels);
+        }
+    }
+}
+
+TEST(ConnectedComponents, Links)
+{
+    // All pixels valid, components separated by missing links
+    const size_t length = 200;
+    const size_t width = 150;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> uniform(0.f, 1.f);
+    std::vector<char> rightlinks(length * width), downlinks(length * width);
+    for (size_t k = 0; k < length * width; ++k)
+    {
+        rightlinks[k] = uniform(generator) < 0.55f;
+        downlinks[k] = uniform(generator) < 0.45f;
+    }
+
+    auto valid = [](size_t) { return true; };
+    auto right = [&](size_t k) { return rightlinks[k] != 0; };
+    auto down = [&](size_t k) { return downlinks[k] != 0; };
+    std::vector<uint32_t> labels(length * width), reflabels(length * width);
+    uint32_t n = isce3::unwrap::labelConnectedComponents(
+        labels.data(), length, width, valid, right, down);
+    uint32_t nref = floodFillLabels(
+        reflabels.data(), length, width, valid, right, down);
+
+    ASSERT_EQ(n, nref);
+    ASSERT_EQ(labels, reflabels);
+
+    // Component sizes add up to the number of pixels.
+    auto sizes = isce3::unwrap::componentSizes(labels.data(), length * width, n);
+    ASSERT_EQ(sizes.size(), n + 1);
+    ASSERT_EQ(sizes[0], 0);
+    size_t total = 0;
+    for (auto s : sizes) { total += s; }
+    ASSERT_EQ(total, length * width);
+}
+
+TEST(ConnectedComponents, Spiral)
+{
+    // A single path winding back and forth across all blocks of rows, so that
+    // each block sees many pieces that are merged across block boundaries.
+    const size_t length = 257;
+    const size_t width = 40;
+    std::vector<char> mask(length * width, 0);
+    for (size_t j = 0; j < length; ++j)
+    {
+        if (j % 2 == 0)
+        {
+            for (size_t i = 0; i < width; ++i) { mask[j * width + i] = 1; }
+        }
+        else
+        {
+            // Connect alternately at the right and left ends.
+            size_t i = (j % 4 == 1) ? width - 1 : 0;
+            mask[j * width + i] = 1;
+        }
+    }
+
+    auto valid = [&](size_t k) { return mask[k] != 0; };
+    auto link = [](size_t) { return true; };
+    std::vector<uint32_t> labels(length * width);
+    uint32_t n = isce3::unwrap::labelConnectedComponents(
+        labels.data(), length, width, valid, link, link);
+
+    ASSERT_EQ(n, 1);
+    for (size_t k = 0; k < length * width; ++k)
+    {
+        ASSERT_EQ(labels[k], mask[k] ? 1u : 0u);
+    }
+
+    // Drop the component.
+    std::vector<uint32_t> newlabels = {0, 0};
+    isce3::unwrap::relabelComponents(labels.data(), length * width, newlabels);
+    for (size_t k = 0; k < length * width; ++k) { ASSERT_EQ(labels[k], 0); }
+}
+
+int main(int argc, char * argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
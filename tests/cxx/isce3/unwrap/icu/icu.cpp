@@ -47,6 +47,10 @@ TEST(ICU, GetSetters)
     ASSERT_EQ(icuobj.minBsPts(), 12);
     icuobj.bsPhaseVarThr(3.f);
     ASSERT_EQ(icuobj.bsPhaseVarThr(), 3.f);
+    icuobj.parallelTiles(true);
+    ASSERT_EQ(icuobj.parallelTiles(), true);
+    icuobj.parallelTilesMemory(1 << 20);
+    ASSERT_EQ(icuobj.parallelTilesMemory(), 1 << 20);
 }
 
 TEST(ICU, ResidueCalculation)
@@ -291,6 +295,105 @@ TEST(ICU, CheckConnCompLabels)
     ASSERT_TRUE((ccl == refccl).min());
 }
 
+TEST(ICU, RunICUParallelTiles)
+{
+    // Read interferogram, correlation from prior test.
+    isce3::io::Raster intfRaster("./intf");
+    isce3::io::Raster corrRaster("./corr");
+    const size_t l = intfRaster.length();
+    const size_t w = intfRaster.width();
+
+    // Unwrap the same tiles in parallel and stitch them.
+    isce3::io::Raster unwRaster("./unw_par", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster cclRaster("./ccl_par", w, l, 1, GDT_Byte, "ENVI");
+
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.numBufLines(400);
+    icuobj.numOverlapLines(50);
+    icuobj.parallelTiles(true);
+
+    icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster);
+
+    // Results should match sequential processing.
+    isce3::io::Raster refUnwRaster("./unw");
+    std::valarray<float> refunw(l*w), unw(l*w);
+    refUnwRaster.getBlock(refunw, 0, 0, w, l);
+    unwRaster.getBlock(unw, 0, 0, w, l);
+    ASSERT_TRUE((unw == refunw).min());
+
+    isce3::io::Raster refCclRaster("./ccl");
+    std::valarray<uint8_t> refccl(l*w), ccl(l*w);
+    refCclRaster.getBlock(refccl, 0, 0, w, l);
+    cclRaster.getBlock(ccl, 0, 0, w, l);
+    ASSERT_TRUE((ccl == refccl).min());
+}
+
+TEST(ICU, RunICUParallelTilesBootstrapFailure)
+{
+    // Read interferogram, correlation from prior test.
+    isce3::io::Raster refIntfRaster("./intf");
+    isce3::io::Raster refCorrRaster("./corr");
+    const size_t l = refIntfRaster.length();
+    const size_t w = refIntfRaster.width();
+    std::valarray<std::complex<float>> intf(l*w);
+    std::valarray<float> corr(l*w);
+    refIntfRaster.getBlock(intf, 0, 0, w, l);
+    refCorrRaster.getBlock(corr, 0, 0, w, l);
+
+    // Add a noisy, low correlation patch across the overlap of the first two 
+    // tiles. The two tiles unwrap it differently, so bootstrapping the 
+    // second tile fails until the correlation threshold excludes the patch.
+    uint32_t state = 1;
+    for (size_t j = 330; j < 430; ++j)
+    {
+        for (size_t i = 206; i < 250; ++i)
+        {
+            state = 1664525u * state + 1013904223u;
+            float noise = 2.f * (2.f * float(state) / 4294967296.f - 1.f);
+            float y = float(j) / float(l) * 50.f + noise;
+            intf[j * w + i] = std::complex<float>{cosf(y), sinf(y)};
+            corr[j * w + i] = 0.25f;
+        }
+    }
+
+    isce3::io::Raster intfRaster("./intf_bsfail", w, l, 1, GDT_CFloat32, "ENVI");
+    intfRaster.setBlock(intf, 0, 0, w, l);
+    isce3::io::Raster corrRaster("./corr_bsfail", w, l, 1, GDT_Float32, "ENVI");
+    corrRaster.setBlock(corr, 0, 0, w, l);
+
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.numBufLines(400);
+    icuobj.numOverlapLines(50);
+    icuobj.bsPhaseVarThr(0.1f);
+
+    // Unwrap sequentially and in parallel.
+    isce3::io::Raster refUnwRaster("./unw_bsfail", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster refCclRaster("./ccl_bsfail", w, l, 1, GDT_Byte, "ENVI");
+    icuobj.unwrap(refUnwRaster, refCclRaster, intfRaster, corrRaster);
+
+    isce3::io::Raster unwRaster("./unw_bsfail_par", w, l, 1, GDT_Float32, "ENVI");
+    isce3::io::Raster cclRaster("./ccl_bsfail_par", w, l, 1, GDT_Byte, "ENVI");
+    icuobj.parallelTiles(true);
+    icuobj.unwrap(unwRaster, cclRaster, intfRaster, corrRaster);
+
+    std::valarray<float> refunw(l*w), unw(l*w);
+    refUnwRaster.getBlock(refunw, 0, 0, w, l);
+    unwRaster.getBlock(unw, 0, 0, w, l);
+    std::valarray<uint8_t> refccl(l*w), ccl(l*w);
+    refCclRaster.getBlock(refccl, 0, 0, w, l);
+    cclRaster.getBlock(ccl, 0, 0, w, l);
+
+    // The second tile was unwrapped again without the patch.
+    for (size_t j = 350; j < 430; ++j)
+    {
+        for (size_t i = 206; i < 250; ++i) { ASSERT_EQ(ccl[j * w + i], 0); }
+    }
+
+    // Results should match sequential processing.
+    ASSERT_TRUE((unw == refunw).min());
+    ASSERT_TRUE((ccl == refccl).min());
+}
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
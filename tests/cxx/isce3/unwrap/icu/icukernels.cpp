@@ -0,0 +1,195 @@
+#include <chrono> // std::chrono
+#include <cmath> // cos, sin, exp, round, M_PI
+#include <complex> // std::complex, std::conj, std::arg
+#include <cstdio> // printf
+#include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_TRUE, testing::InitGoogleTest, RUN_ALL_TESTS
+#include <random> // std::mt19937, std::normal_distribution
+#include <valarray> // std::valarray
+
+#include "isce3/unwrap/icu/ICU.h" // isce3::unwrap::icu::ICU
+#include "isce3/unwrap/icu/PhaseGrad.h" // isce3::unwrap::icu::calcPhaseGrad
+
+// Microbenchmarks of the ICU preprocessing kernels (residues, phase gradient
+// and intensity neutrons) against straightforward scalar implementations.
+
+constexpr size_t l = 1024;
+constexpr size_t w = 1024;
+
+// Noisy interferogram with a smooth phase ramp
+std::valarray<std::complex<float>> makeIntf()
+{
+    std::valarray<std::complex<float>> intf(l*w);
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> noise(0.f, 0.8f);
+    for (size_t j = 0; j < l; ++j)
+    {
+        for (size_t i = 0; i < w; ++i)
+        {
+            float phi = 0.05f * float(i) + 0.002f * float(j * j) / float(l) + noise(generator);
+            float amp = 1.f + 0.5f * std::abs(noise(generator));
+            intf[j * w + i] = std::polar(amp, phi);
+        }
+    }
+    return intf;
+}
+
+template<class F>
+double timeit(F && f, int nrepeat = 5)
+{
+    double best = 1e30;
+    for (int r = 0; r < nrepeat; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+void scalarResidues(signed char * charge, const float * phase)
+{
+    constexpr float twopi = 2.f * M_PI;
+    for (size_t j = 0; j < l-1; ++j)
+    {
+        for (size_t i = 0; i < w-1; ++i)
+        {
+            float phi_00 = phase[(j+0) * w + (i+0)];
+            float phi_10 = phase[(j+1) * w + (i+0)];
+            float phi_01 = phase[(j+0) * w + (i+1)];
+            float phi_11 = phase[(j+1) * w + (i+1)];
+
+            charge[j * w + i] = round((phi_10 - phi_00) / twopi) +
+                                round((phi_11 - phi_10) / twopi) +
+                                round((phi_01 - phi_11) / twopi) +
+                                round((phi_00 - phi_01) / twopi);
+        }
+    }
+    for (size_t i = 0; i < w; ++i) { charge[(l-1) * w + i] = 0; }
+    for (size_t j = 0; j < l; ++j) { charge[j * w + (w-1)] = 0; }
+}
+
+void scalarPhaseGrad(
+    float * phasegradx, float * phasegrady, const std::complex<float> * intf,
+    const int winsize)
+{
+    std::valarray<float> weights(winsize * winsize);
+    for (int jj = 0; jj < winsize; ++jj)
+    {
+        for (int ii = 0; ii < winsize; ++ii)
+        {
+            auto x = float(ii - winsize/2);
+            auto y = float(jj - winsize/2);
+            weights[jj * winsize + ii] = exp(-(x*x + y*y) / (winsize/2.f));
+        }
+    }
+    weights /= weights.sum();
+
+    for (size_t i = 0; i < l*w; ++i) { phasegradx[i] = phasegrady[i] = 0.f; }
+    for (size_t j = winsize/2 + 1; j < l - winsize/2; ++j)
+    {
+        for (size_t i = winsize/2 + 1; i < w - winsize/2; ++i)
+        {
+            std::complex<float> sx = 0.f, sy = 0.f;
+            for (int jj = -winsize/2; jj <= winsize/2; ++jj)
+            {
+                for (int ii = -winsize/2; ii <= winsize/2; ++ii)
+                {
+                    float wt = weights[(jj + winsize/2) * winsize + (ii + winsize/2)];
+                    std::complex<float> z_11 = intf[(j+jj) * w + (i+ii)];
+                    std::complex<float> z_10 = intf[(j+jj) * w + (i+ii-1)];
+                    std::complex<float> z_01 = intf[(j+jj-1) * w + (i+ii)];
+                    sx += wt * z_11 * std::conj(z_10);
+                    sy += wt * z_11 * std::conj(z_01);
+                }
+            }
+            phasegradx[j * w + i] = std::arg(sx);
+            phasegrady[j * w + i] = std::arg(sy);
+        }
+    }
+}
+
+TEST(ICUKernels, Residues)
+{
+    auto intf = makeIntf();
+    std::valarray<float> phase(l*w);
+    for (size_t i = 0; i < l*w; ++i) { phase[i] = std::arg(intf[i]); }
+
+    std::valarray<signed char> charge(l*w), refcharge(l*w);
+    isce3::unwrap::icu::ICU icuobj;
+    double t = timeit([&]() { icuobj.getResidues(&charge[0], &phase[0], l, w); });
+    double tref = timeit([&]() { scalarResidues(&refcharge[0], &phase[0]); });
+    printf("residues: %.2f ms (scalar %.2f ms)\n", 1e3 * t, 1e3 * tref);
+
+    // Residue charges must match exactly.
+    ASSERT_TRUE((charge == refcharge).min());
+    ASSERT_TRUE(std::abs(charge).max() > 0);
+}
+
+TEST(ICUKernels, PhaseGrad)
+{
+    auto intf = makeIntf();
+    for (int winsize : {3, 5, 7})
+    {
+        std::valarray<float> gx(l*w), gy(l*w), refgx(l*w), refgy(l*w);
+        double t = timeit([&]() {
+            isce3::unwrap::icu::calcPhaseGrad(&gx[0], &gy[0], &intf[0], l, w, winsize);
+        });
+        double tref = timeit([&]() {
+            scalarPhaseGrad(&refgx[0], &refgy[0], &intf[0], winsize);
+        }, 1);
+        printf("phase gradient (window %d): %.2f ms (scalar %.2f ms)\n",
+               winsize, 1e3 * t, 1e3 * tref);
+
+        // Phase slopes match up to rounding (the window sum is reordered).
+        std::valarray<float> dx = std::abs(gx - refgx);
+        std::valarray<float> dy = std::abs(gy - refgy);
+        ASSERT_LT(dx.max(), 1e-4f);
+        ASSERT_LT(dy.max(), 1e-4f);
+    }
+}
+
+TEST(ICUKernels, IntensityNeutrons)
+{
+    auto intf = makeIntf();
+    std::valarray<float> corr(0.9f, l*w);
+    for (size_t i = 0; i < l*w; i += 3) { corr[i] = 0.2f; }
+
+    isce3::unwrap::icu::ICU icuobj;
+    icuobj.useIntensityNeut(true);
+    icuobj.neutIntensityThr(2.f);
+    std::valarray<bool> neut(l*w);
+    double t = timeit([&]() {
+        icuobj.genNeutrons(&neut[0], &intf[0], &corr[0], l, w);
+    });
+    printf("intensity neutrons: %.2f ms\n", 1e3 * t);
+
+    // Check against thresholds computed from sampled intensity statistics.
+    float sum = 0.f, sumSq = 0.f;
+    size_t n = 0;
+    for (size_t j = 16; j < l - 16; j += 4)
+    {
+        for (size_t i = 32; i < w - 32; i += 4)
+        {
+            float s = std::norm(intf[j * w + i]);
+            sum += s;
+            sumSq += s*s;
+            ++n;
+        }
+    }
+    float mu = sum / float(n);
+    float thr = mu + 2.f * sqrt(sumSq / float(n) - mu*mu);
+    size_t nneut = 0;
+    for (size_t i = 0; i < l*w; ++i)
+    {
+        ASSERT_EQ(neut[i], std::norm(intf[i]) > thr && corr[i] < 0.8f);
+        nneut += neut[i];
+    }
+    ASSERT_TRUE(nneut > 0);
+}
+
+int main(int argc, char * argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
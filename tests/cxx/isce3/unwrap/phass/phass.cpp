@@ -1,10 +1,14 @@
+#include <algorithm> // std::max
 #include <cmath> // cos, sin, sqrt, fmod
 #include <complex> // std::complex, std::arg
 #include <cstdint> // uint8_t
 #include <gtest/gtest.h> // TEST, ASSERT_EQ, ASSERT_TRUE, testing::InitGoogleTest, RUN_ALL_TE  STS
+#include <omp.h> // omp_get_max_threads, omp_set_num_threads
 #include <valarray> // std::valarray, std::abs
+#include <vector> // std::vector
 
 #include "isce3/unwrap/phass/Phass.h" // isce3::unwrap::phass::Phass
+#include "isce3/unwrap/phass/PhassUnwrapper.h" // phass_unwrap
 #include "isce3/io/Raster.h" // isce3::io::Raster
 
 void runPhass();
@@ -89,6 +93,69 @@ TEST(Phass, CheckConnCompLabels)
 }
 
 
+// Unwrap a noisy interferogram with several disconnected regions, so that
+// the regions of many seeds are grown concurrently, with a number of threads.
+void runPhassThreads(int nthreads, std::vector<float> & phase,
+                     std::vector<int> & labels)
+{
+    constexpr int l = 400;
+    constexpr int w = 300;
+
+    // Wrapped phase of a curved surface with deterministic phase noise, and
+    // correlation in bands separated by low correlation gaps
+    phase.assign(l*w, 0.f);
+    labels.assign(l*w, 0);
+    std::vector<float> corr(l*w, 0.f);
+    unsigned int seed = 1;
+    for (int j = 0; j < l; ++j)
+    {
+        for (int i = 0; i < w; ++i)
+        {
+            seed = 1664525u * seed + 1013904223u;
+            float noise = 1.2f * (seed / 4294967296.f - 0.5f);
+            float x = float(i) / w, y = float(j) / l;
+            float p = 60.f * sinf(3.f * x + 2.f * y) + 40.f * y * y + noise;
+            phase[j * w + i] = std::arg(std::complex<float>{cosf(p), sinf(p)});
+            bool gap = (j % 100) < 8 || (i % 75) < 6;
+            corr[j * w + i] = gap ? 0.05f : 0.6f + 0.3f * sinf(9.f * x * y);
+        }
+    }
+
+    std::vector<float *> phaseLines(l), corrLines(l);
+    std::vector<int *> labelLines(l);
+    for (int j = 0; j < l; ++j)
+    {
+        phaseLines[j] = &phase[j * w];
+        corrLines[j] = &corr[j * w];
+        labelLines[j] = &labels[j * w];
+    }
+
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(nthreads);
+    phass_unwrap(l, w, phaseLines.data(), corrLines.data(), nullptr,
+                 labelLines.data(), 0.2, 0.7, 200);
+    omp_set_num_threads(maxThreads);
+}
+
+
+// Unwrapped phase and labels do not depend on the number of threads
+TEST(Phass, Threads)
+{
+    std::vector<float> serialPhase, parallelPhase;
+    std::vector<int> serialLabels, parallelLabels;
+    runPhassThreads(1, serialPhase, serialLabels);
+    runPhassThreads(4, parallelPhase, parallelLabels);
+
+    // Many regions were unwrapped
+    int nregions = 0;
+    for (int label : serialLabels) { nregions = std::max(nregions, label); }
+    ASSERT_GT(nregions, 4);
+
+    ASSERT_EQ(parallelLabels, serialLabels);
+    ASSERT_EQ(parallelPhase, serialPhase);
+}
+
+
 int main(int argc, char * argv[])
 {
     testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,103 @@
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include <isce3/unwrap/snaphu/snaphu_unwrap.h>
+
+/** Read the contents of a file. */
+std::vector<char> readFile(const std::string& filename)
+{
+    std::ifstream f(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(f),
+                             std::istreambuf_iterator<char>());
+}
+
+struct SnaphuCostsTest : public ::testing::TestWithParam<std::string> {
+    const long nrow = 200;
+    const long ncol = 160;
+    const std::string infile = "snaphu_costs.c8";
+    const std::string corrfile = "snaphu_costs.cor";
+
+    void SetUp() override
+    {
+        // Interferogram of a phase ramp with a few bumps and some
+        // deterministic phase noise, and correlation varying across the
+        // scene, including low correlation values that are clipped.
+        std::vector<std::complex<float>> igram(nrow * ncol);
+        std::vector<float> corr(nrow * ncol);
+        unsigned int seed = 1;
+        for (long i = 0; i < nrow; ++i) {
+            for (long j = 0; j < ncol; ++j) {
+                seed = 1664525u * seed + 1013904223u;
+                const double noise = 0.8 * (seed / 4294967296.0 - 0.5);
+                const double phase = 0.15 * i + 0.1 * j +
+                                     8.0 * std::sin(i / 40.0) *
+                                             std::cos(j / 30.0) +
+                                     noise;
+                const float amp = 1.0f + 0.5f * std::cos(i / 7.0 + j / 11.0);
+                igram[i * ncol + j] = std::polar(amp, float(phase));
+                corr[i * ncol + j] = 0.5f + 0.45f * std::sin(i / 25.0 - j / 19.0);
+            }
+        }
+        std::ofstream f(infile, std::ios::binary);
+        f.write(reinterpret_cast<const char*>(igram.data()),
+                igram.size() * sizeof(igram[0]));
+        std::ofstream g(corrfile, std::ios::binary);
+        g.write(reinterpret_cast<const char*>(corr.data()),
+                corr.size() * sizeof(corr[0]));
+    }
+
+    /** Unwrap with a number of threads, writing the unwrapped phase and
+     *  the cost arrays to files named after the cost mode and threads. */
+    std::string unwrap(int nthreads) const
+    {
+        const std::string name =
+                "snaphu_costs_" + GetParam() + "_" + std::to_string(nthreads);
+        const std::string configfile = name + ".conf";
+        {
+            std::ofstream f(configfile);
+            f << "INFILE " << infile << "\n"
+              << "CORRFILE " << corrfile << "\n"
+              << "CORRFILEFORMAT FLOAT_DATA\n"
+              << "LINELENGTH " << ncol << "\n"
+              << "OUTFILE " << name << ".unw\n"
+              << "COSTOUTFILE " << name << ".cost\n"
+              << "STATCOSTMODE " << GetParam() << "\n";
+        }
+        const int maxThreads = omp_get_max_threads();
+        omp_set_num_threads(nthreads);
+        isce3::unwrap::snaphuUnwrap(configfile);
+        omp_set_num_threads(maxThreads);
+        return name;
+    }
+};
+
+// Cost arrays and unwrapped phase do not depend on the number of threads
+TEST_P(SnaphuCostsTest, Threads)
+{
+    const auto serial = unwrap(1);
+    const auto parallel = unwrap(4);
+
+    const auto costs = readFile(serial + ".cost");
+    ASSERT_FALSE(costs.empty());
+    EXPECT_EQ(readFile(parallel + ".cost"), costs);
+
+    const auto unw = readFile(serial + ".unw");
+    ASSERT_EQ(unw.size(), 2 * nrow * ncol * sizeof(float));
+    EXPECT_EQ(readFile(parallel + ".unw"), unw);
+}
+
+INSTANTIATE_TEST_SUITE_P(CostModes, SnaphuCostsTest,
+                         testing::Values("TOPO", "DEFO", "SMOOTH"));
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include <gtest/gtest.h>
+
+#include <isce3/unwrap/snaphu/snaphu.h>
+
+using isce3::unwrap::Array2D;
+
+// Windows of 3x2 looks over a 7x5 interferogram, partial along both
+// dimensions at the far edges
+struct SnaphuMultilookTest : public ::testing::Test {
+    const long nrow = 7;
+    const long ncol = 5;
+    const long nlooksrow = 3;
+    const long nlookscol = 2;
+
+    Array2D<float> mag = Array2D<float>(nrow, ncol);
+    Array2D<float> phase = Array2D<float>(nrow, ncol);
+    Array2D<float> corr = Array2D<float>(nrow, ncol);
+
+    void SetUp() override
+    {
+        for (long i = 0; i < nrow; ++i) {
+            for (long j = 0; j < ncol; ++j) {
+                mag(i, j) = 1.0f + 0.25f * i + 0.5f * j;
+                phase(i, j) = 0.3f * i - 0.2f * j;
+                corr(i, j) = 0.05f * (i + 2 * j);
+            }
+        }
+
+        // Mask the top-left window
+        mag.topLeftCorner(nlooksrow, nlookscol) = 0.0f;
+    }
+};
+
+// Coarse pixels average the pixels of their (possibly partial) windows
+TEST_F(SnaphuMultilookTest, Multilook)
+{
+    Array2D<float> coarsemag, coarsephase, coarsecorr;
+    isce3::unwrap::MultilookInterferogram(mag, phase, corr, &coarsemag,
+            &coarsephase, &coarsecorr, nrow, ncol, nlooksrow, nlookscol);
+    ASSERT_EQ(coarsemag.rows(), 3);
+    ASSERT_EQ(coarsemag.cols(), 3);
+
+    for (long ci = 0; ci < 3; ++ci) {
+        for (long cj = 0; cj < 3; ++cj) {
+            std::complex<double> sum = 0;
+            double summag = 0, sumcorr = 0;
+            long n = 0;
+            for (long i = ci * nlooksrow;
+                 i < std::min((ci + 1) * nlooksrow, nrow); ++i) {
+                for (long j = cj * nlookscol;
+                     j < std::min((cj + 1) * nlookscol, ncol); ++j) {
+                    sum += std::polar<double>(mag(i, j), phase(i, j));
+                    summag += mag(i, j);
+                    sumcorr += corr(i, j);
+                    ++n;
+                }
+            }
+            EXPECT_NEAR(coarsemag(ci, cj), summag / n, 1e-6);
+            EXPECT_NEAR(coarsecorr(ci, cj), sumcorr / n, 1e-6);
+            if (summag > 0) {
+                EXPECT_NEAR(coarsephase(ci, cj), std::arg(sum), 1e-6);
+            }
+        }
+    }
+
+    // The last window is a single pixel
+    EXPECT_FLOAT_EQ(coarsemag(2, 2), mag(6, 4));
+    EXPECT_FLOAT_EQ(coarsephase(2, 2), phase(6, 4));
+    EXPECT_FLOAT_EQ(coarsecorr(2, 2), corr(6, 4));
+}
+
+// Without correlation, it is estimated from the coherence of each window
+TEST_F(SnaphuMultilookTest, EstimatedCorrelation)
+{
+    Array2D<float> nocorr, coarsemag, coarsephase, coarsecorr;
+    isce3::unwrap::MultilookInterferogram(mag, phase, nocorr, &coarsemag,
+            &coarsephase, &coarsecorr, nrow, ncol, nlooksrow, nlookscol);
+
+    // Masked window
+    EXPECT_EQ(coarsemag(0, 0), 0.0f);
+    EXPECT_EQ(coarsecorr(0, 0), 0.0f);
+
+    // Single-pixel window is fully coherent
+    EXPECT_FLOAT_EQ(coarsecorr(2, 2), 1.0f);
+
+    for (long ci = 0; ci < 3; ++ci) {
+        for (long cj = 0; cj < 3; ++cj) {
+            EXPECT_GE(coarsecorr(ci, cj), 0.0f);
+            EXPECT_LE(coarsecorr(ci, cj), 1.0f + 1e-6f);
+        }
+    }
+}
+
+// Upsampling a coarse solution of a phase ramp sampled at the window
+// centers recovers the ramp, including next to partial edge windows
+TEST(SnaphuUpsampleTest, PartialWindows)
+{
+    // 9 rows in windows of 8 (the last one has a single row) and 13 columns
+    // in windows of 4 (the last one has a single column)
+    const long nrow = 9, ncol = 13;
+    const long nlooksrow = 8, nlookscol = 4;
+    const long ncoarserow = 2, ncoarsecol = 4;
+    const double a = 1.8, b = 0.9;
+    auto ramp = [&](double i, double j) { return a * i + b * j; };
+
+    Array2D<float> wrapped(nrow, ncol);
+    for (long i = 0; i < nrow; ++i) {
+        for (long j = 0; j < ncol; ++j) {
+            wrapped(i, j) = std::arg(std::polar(1.0, ramp(i, j)));
+        }
+    }
+
+    // Coarse solution at the centers of the pixels of each window
+    auto center = [](long k, long n, long nlooks) {
+        return (k * nlooks + std::min((k + 1) * nlooks, n) - 1) / 2.0;
+    };
+    Array2D<float> coarse(ncoarserow, ncoarsecol);
+    for (long ci = 0; ci < ncoarserow; ++ci) {
+        for (long cj = 0; cj < ncoarsecol; ++cj) {
+            coarse(ci, cj) = ramp(center(ci, nrow, nlooksrow),
+                                  center(cj, ncol, nlookscol));
+        }
+    }
+
+    Array2D<float> unwrapped;
+    isce3::unwrap::UpsampleUnwrappedPhase(coarse, wrapped, &unwrapped, nrow,
+                                          ncol, nlooksrow, nlookscol);
+    ASSERT_EQ(unwrapped.rows(), nrow);
+    ASSERT_EQ(unwrapped.cols(), ncol);
+
+    // Bilinear interpolation of the coarse solution is exact between the
+    // first and last centers (beyond them it is held constant)
+    for (long i = std::ceil(center(0, nrow, nlooksrow)); i < nrow; ++i) {
+        for (long j = std::ceil(center(0, ncol, nlookscol)); j < ncol; ++j) {
+            EXPECT_NEAR(unwrapped(i, j), ramp(i, j), 1e-4)
+                    << "at row " << i << ", column " << j;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
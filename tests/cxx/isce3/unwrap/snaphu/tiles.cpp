@@ -0,0 +1,119 @@
+#include <cmath>
+#include <complex>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <isce3/unwrap/snaphu/snaphu_unwrap.h>
+
+/** Read the contents of a file. */
+std::vector<char> readFile(const std::string& filename)
+{
+    std::ifstream f(filename, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(f),
+                             std::istreambuf_iterator<char>());
+}
+
+struct SnaphuTilesTest : public ::testing::Test {
+    const long nrow = 300;
+    const long ncol = 240;
+    const std::string infile = "snaphu_tilemode.c8";
+
+    void SetUp() override
+    {
+        // Interferogram of a phase ramp with a few bumps and some
+        // deterministic phase noise, so that tiles need to be stitched.
+        std::vector<std::complex<float>> igram(nrow * ncol);
+        unsigned int seed = 1;
+        for (long i = 0; i < nrow; ++i) {
+            for (long j = 0; j < ncol; ++j) {
+                seed = 1664525u * seed + 1013904223u;
+                const double noise = 0.8 * (seed / 4294967296.0 - 0.5);
+                const double phase = 0.15 * i + 0.1 * j +
+                                     8.0 * std::sin(i / 40.0) *
+                                             std::cos(j / 30.0) +
+                                     noise;
+                igram[i * ncol + j] = std::polar(1.0f, float(phase));
+            }
+        }
+        std::ofstream f(infile, std::ios::binary);
+        f.write(reinterpret_cast<const char*>(igram.data()),
+                igram.size() * sizeof(igram[0]));
+    }
+
+    /** Write the configuration of a tiled run and return its file name. */
+    std::string configure(const std::string& name, bool tilememory) const
+    {
+        const std::string configfile = "snaphu_tilemode_" + name + ".conf";
+        std::ofstream f(configfile);
+        f << "INFILE " << infile << "\n"
+          << "LINELENGTH " << ncol << "\n"
+          << "OUTFILE snaphu_tilemode_" << name << ".unw\n"
+          << "CONNCOMPFILE snaphu_tilemode_" << name << ".cc\n"
+          << "STATCOSTMODE SMOOTH\n"
+          << "NTILEROW 2\n"
+          << "NTILECOL 2\n"
+          << "ROWOVRLP 30\n"
+          << "COLOVRLP 30\n"
+          << "NPROC 2\n"
+          << "TILEMEMORY " << (tilememory ? "TRUE" : "FALSE") << "\n";
+        return configfile;
+    }
+};
+
+// Tile files kept in memory and on disk give the same results
+TEST_F(SnaphuTilesTest, MemoryMatchesDisk)
+{
+    isce3::unwrap::snaphuUnwrap(configure("disk", false));
+    isce3::unwrap::snaphuUnwrap(configure("memory", true));
+
+    const auto unw = readFile("snaphu_tilemode_disk.unw");
+    ASSERT_EQ(unw.size(), 2 * nrow * ncol * sizeof(float));
+    EXPECT_EQ(readFile("snaphu_tilemode_memory.unw"), unw);
+    EXPECT_EQ(readFile("snaphu_tilemode_memory.cc"),
+              readFile("snaphu_tilemode_disk.cc"));
+}
+
+// Concurrent runs keeping tile files in memory do not share them
+TEST_F(SnaphuTilesTest, ConcurrentMemoryRuns)
+{
+    isce3::unwrap::snaphuUnwrap(configure("reference", true));
+
+    // Errors are passed from the threads to the test
+    auto unwrap = [](const std::string& configfile, std::exception_ptr& error) {
+        try {
+            isce3::unwrap::snaphuUnwrap(configfile);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    };
+    std::exception_ptr error1, error2;
+    std::thread run1(unwrap, configure("concurrent1", true), std::ref(error1));
+    std::thread run2(unwrap, configure("concurrent2", true), std::ref(error2));
+    run1.join();
+    run2.join();
+    if (error1)
+        std::rethrow_exception(error1);
+    if (error2)
+        std::rethrow_exception(error2);
+
+    const auto unw = readFile("snaphu_tilemode_reference.unw");
+    ASSERT_EQ(unw.size(), 2 * nrow * ncol * sizeof(float));
+    for (const std::string name : {"concurrent1", "concurrent2"}) {
+        EXPECT_EQ(readFile("snaphu_tilemode_" + name + ".unw"), unw);
+        EXPECT_EQ(readFile("snaphu_tilemode_" + name + ".cc"),
+                  readFile("snaphu_tilemode_reference.cc"));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+'''
+Unit tests for CPU pybind ampcor
+'''
+import numpy.testing as npt
+import numpy as np
+import isce3.ext.isce3 as isce3
+from osgeo import gdal
+import os
+
+width = 256
+length = 256
+shift_down = 3
+shift_across = -2
+
+
+def write_slc(path, data, driver_name):
+    driver = gdal.GetDriverByName(driver_name)
+    ds = driver.Create(path, data.shape[1], data.shape[0], 1,
+                       gdal.GDT_CFloat32)
+    ds.GetRasterBand(1).WriteArray(data)
+    ds.FlushCache()
+    ds = None
+
+
+def make_scene():
+    # smooth complex speckle: low-pass filtered white noise
+    rng = np.random.default_rng(2022)
+    noise = (rng.standard_normal((length, width)) +
+             1j * rng.standard_normal((length, width)))
+    ky = np.fft.fftfreq(length)[:, None]
+    kx = np.fft.fftfreq(width)[None, :]
+    taper = np.exp(-(kx**2 + ky**2) / (2 * 0.1**2))
+    return np.fft.ifft2(np.fft.fft2(noise) * taper).astype(np.complex64)
+
+
+def test_getter_setter():
+    ampcor = isce3.matchtemplate.PyCpuAmpcor()
+
+    ampcor.windowSizeHeight = 48
+    npt.assert_equal(ampcor.windowSizeHeight, 48)
+
+    ampcor.halfSearchRangeAcross = 12
+    npt.assert_equal(ampcor.halfSearchRangeAcross, 12)
+
+    ampcor.corrSurfaceOverSamplingFactor = 32
+    npt.assert_equal(ampcor.corrSurfaceOverSamplingFactor, 32)
+
+    # CUDA only parameters are accepted for compatibility
+    ampcor.nStreams = 2
+    npt.assert_equal(ampcor.nStreams, 2)
+
+    ampcor.arenaSizeInMB = 256
+    npt.assert_equal(ampcor.arenaSizeInMB, 256)
+
+
+def run_ampcor(driver, arena_size):
+    reference = make_scene()
+    # the secondary image is the reference moved by a known shift
+    secondary = np.roll(reference, (shift_down, shift_across), axis=(0, 1))
+    write_slc('ampcor_reference.slc', reference, driver)
+    write_slc('ampcor_secondary.slc', secondary, driver)
+
+    ampcor = isce3.matchtemplate.PyCpuAmpcor()
+    ampcor.referenceImageName = 'ampcor_reference.slc'
+    ampcor.referenceImageHeight = length
+    ampcor.referenceImageWidth = width
+    ampcor.secondaryImageName = 'ampcor_secondary.slc'
+    ampcor.secondaryImageHeight = length
+    ampcor.secondaryImageWidth = width
+
+    ampcor.windowSizeHeight = 32
+    ampcor.windowSizeWidth = 32
+    ampcor.halfSearchRangeDown = 8
+    ampcor.halfSearchRangeAcross = 8
+    ampcor.skipSampleDown = 40
+    ampcor.skipSampleAcross = 40
+    ampcor.referenceStartPixelDownStatic = 8
+    ampcor.referenceStartPixelAcrossStatic = 8
+    ampcor.numberWindowDown = 5
+    ampcor.numberWindowAcross = 5
+    ampcor.numberWindowDownInChunk = 2
+    ampcor.numberWindowAcrossInChunk = 2
+    ampcor.useMmap = 1
+    ampcor.arenaSizeInMB = arena_size
+
+    ampcor.offsetImageName = 'ampcor_offsets.bin'
+    ampcor.grossOffsetImageName = 'ampcor_gross_offsets.bin'
+    ampcor.snrImageName = 'ampcor_snr.bin'
+    ampcor.covImageName = 'ampcor_cov.bin'
+
+    ampcor.setupParams()
+    ampcor.setConstantGrossOffset(0, 0)
+    ampcor.checkPixelInImageRange()
+    ampcor.runAmpcor()
+
+    windows = ampcor.numberWindowDown * ampcor.numberWindowAcross
+    offsets = np.fromfile('ampcor_offsets.bin', dtype=np.float32)
+    snr = np.fromfile('ampcor_snr.bin', dtype=np.float32)
+    cov = np.fromfile('ampcor_cov.bin', dtype=np.float32)
+    npt.assert_equal(offsets.size, 2 * windows)
+    npt.assert_equal(snr.size, windows)
+    npt.assert_equal(cov.size, 3 * windows)
+
+    npt.assert_allclose(offsets[0::2], shift_down, atol=0.1)
+    npt.assert_allclose(offsets[1::2], shift_across, atol=0.1)
+    assert np.all(snr > 1)
+
+    for path in ['ampcor_offsets.bin', 'ampcor_gross_offsets.bin',
+                 'ampcor_snr.bin', 'ampcor_cov.bin']:
+        os.remove(path)
+    for path in ['ampcor_reference.slc', 'ampcor_secondary.slc']:
+        gdal.GetDriverByName(driver).Delete(path)
+
+
+def test_run_ampcor():
+    # GeoTIFFs cannot be memory mapped and are read in bands
+    run_ampcor('GTiff', 1024)
+
+
+def test_run_ampcor_streaming():
+    # chips come straight out of memory maps of the ENVI files, and the
+    # workspaces of the correlator leave room in the small arena for only a
+    # few of the 10 windows of each band at a time
+    run_ampcor('ENVI', 1)
@@ -511,3 +511,52 @@ class TestSnaphu:
             munw = unw_raster.data[mask]
             offset = mphase[0] - munw[0]
             assert np.allclose(mphase - offset, munw, rtol=1e-6, atol=1e-6)
+
+    def test_tile_memory(self):
+        """Test that tile files kept in memory and on disk give the same
+        results."""
+        # Interferogram dimensions
+        l, w = 600, 256
+
+        # Noisy interferogram with a linear diagonal phase gradient
+        x = np.linspace(0.0, 50.0, w, dtype=np.float32)
+        y = np.linspace(0.0, 50.0, l, dtype=np.float32)
+        phase = x + y[:, None]
+        corr = np.full((l, w), fill_value=0.7, dtype=np.float32)
+        phase += simulate_phase_noise(corr, nlooks=20.0, seed=1234)
+        igram = np.exp(1j * phase)
+
+        igram_raster = isce3.io.gdal.Raster(igram)
+        corr_raster = isce3.io.gdal.Raster(corr)
+
+        unw = {}
+        ccl = {}
+        for tile_memory in [True, False]:
+            unw_raster = isce3.io.gdal.Raster(
+                f"unw_{tile_memory}.tif", w, l, np.float32, "GTiff"
+            )
+            ccl_raster = isce3.io.gdal.Raster(
+                f"ccl_{tile_memory}.tif", w, l, np.uint32, "GTiff"
+            )
+            tiling_params = snaphu.TilingParams(
+                nproc=2,
+                tile_nrows=2,
+                tile_ncols=2,
+                row_overlap=16,
+                col_overlap=16,
+                tile_memory=tile_memory,
+            )
+            snaphu.unwrap(
+                unw_raster,
+                ccl_raster,
+                igram_raster,
+                corr_raster,
+                nlooks=20.0,
+                cost="defo",
+                tiling_params=tiling_params,
+            )
+            unw[tile_memory] = unw_raster.data.copy()
+            ccl[tile_memory] = ccl_raster.data.copy()
+
+        np.testing.assert_array_equal(unw[True], unw[False])
+        np.testing.assert_array_equal(ccl[True], ccl[False])